@@ -274,7 +274,7 @@ void MRDAEncodeManager::ReceiveFrameThread()
             MRDA_LOG(LOG_ERROR, "[thread][%d], AVPacket is nullptr", m_uThreadId);
             return;
         }
-        pPkt->data = outBuffer->bufferItem->buf_ptr + sizeof(outBuffer->bufferItem->state);
+        pPkt->data = outBuffer->bufferItem->buf_ptr;
         pPkt->size = outBuffer->bufferItem->occupied_size;
         pPkt->pts = outBuffer->pts;
         pPkt->dts = pPkt->pts;
@@ -329,7 +329,7 @@ MRDAStatus MRDAEncodeManager::FlushFrame()
             MRDA_LOG(LOG_ERROR, "[thread][%d], AVPacket is nullptr", m_uThreadId);
             return MRDA_STATUS_INVALID_DATA;
         }
-        pPkt->data = outBuffer->bufferItem->buf_ptr + sizeof(outBuffer->bufferItem->state);
+        pPkt->data = outBuffer->bufferItem->buf_ptr;
         pPkt->size = outBuffer->bufferItem->occupied_size;
         pPkt->pts = outBuffer->pts;
         pPkt->dts = pPkt->pts;
@@ -92,7 +92,7 @@ MRDAStatus ReadFrame(AVFormatContext *input_ctx, FrameBufferItem *data)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    memcpy(data->bufferItem->buf_ptr + sizeof(data->bufferItem->state), av_packet->data, av_packet->size);
+    memcpy(data->bufferItem->buf_ptr, av_packet->data, av_packet->size);
     data->bufferItem->occupied_size = av_packet->size;
     data->pts = cnt++;
 
@@ -115,7 +115,7 @@ MRDAStatus WriteDecodedFrame(FILE *f, FrameBufferItem *data)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    fwrite(data->bufferItem->buf_ptr + sizeof(data->bufferItem->state), 1, data->bufferItem->occupied_size, f);
+    fwrite(data->bufferItem->buf_ptr, 1, data->bufferItem->occupied_size, f);
 
     return MRDA_STATUS_SUCCESS;
 }
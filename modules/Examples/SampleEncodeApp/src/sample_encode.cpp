@@ -34,6 +34,7 @@
 
 
 #include "common.h"
+#include "SyntheticFrameGenerator.h"
 
 // #pragma comment(lib, "libWinGuest.lib")
 
@@ -89,13 +90,35 @@ MRDAStatus ReadRawFrame(FILE *f, FrameBufferItem *data, ColorFormat format)
     fseek(f, current_frame_offset, SEEK_SET);
 
     // read frame to data buffer
-    fread(data->bufferItem->buf_ptr + sizeof(data->bufferItem->state), 1, frame_size, f);
+    fread(data->bufferItem->buf_ptr, 1, frame_size, f);
     data->bufferItem->occupied_size = frame_size;
 
     data->pts = cnt++;
     return MRDA_STATUS_SUCCESS;
 }
 
+MRDAStatus GenerateRawFrame(VDI::MRDALib::SyntheticFrameGenerator *generator, FrameBufferItem *data, ColorFormat format)
+{
+    static int cnt = 0;
+
+    if (data->bufferItem == nullptr || data->bufferItem->buf_ptr == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "ERROR: invalid input buffer");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    // frames are packed like the raw input files, rows take no padding
+    uint32_t pitch = format == ColorFormat::COLOR_FORMAT_RGBA32 ? data->width * 4 : data->width;
+    if (MRDA_STATUS_SUCCESS != generator->Generate(cnt, data->bufferItem->buf_ptr, pitch, data->bufferItem->size))
+    {
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    data->bufferItem->occupied_size = generator->FrameSize(pitch);
+
+    data->pts = cnt++;
+    return MRDA_STATUS_SUCCESS;
+}
+
 MRDAStatus WriteEncodedFrame(FILE *f, FrameBufferItem *data)
 {
     if (f == nullptr)
@@ -110,7 +133,7 @@ MRDAStatus WriteEncodedFrame(FILE *f, FrameBufferItem *data)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    fwrite(data->bufferItem->buf_ptr + sizeof(data->bufferItem->state), 1, data->bufferItem->occupied_size, f);
+    fwrite(data->bufferItem->buf_ptr, 1, data->bufferItem->occupied_size, f);
 
     return MRDA_STATUS_SUCCESS;
 }
@@ -375,7 +398,7 @@ void PrintHelp()
     printf("%s", "Options: \n");
     printf("%s", "    [--help]                                 - print help README document. \n");
     printf("%s", "    [--hostSessionAddr host_session_address] - specifies host session address. \n");
-    printf("%s", "    [-i input_file]                          - specifies input file. \n");
+    printf("%s", "    [-i input_file]                          - specifies input file, synthetic generates desktop-like frames. \n");
     printf("%s", "    [-o output_file]                         - specifies output file. \n");
     printf("%s", "    [--memDevSize memory_device_size]        - specifies memory device size. \n");
     printf("%s", "    [--bufferNum buffer_number]              - specifies number of buffers. \n");
@@ -398,7 +421,7 @@ void PrintHelp()
     printf("%s", "    [--colorFormat color_format]             - specifies the color format. option: yuv420p, nv12, rgb32 \n");
     printf("%s", "    [--codecProfile codec_profile]           - specifies the codec profile. option: avc:main, avc:high, hevc:main \n");
     printf("%s", "    [--maxBFrames max_b_frames]              - specifies the maximum number of B frames. \n");
-    printf("%s", "    [--encodeType encode_type]               - specifies the encode type. option: ffmpeg, oneVPL \n");
+    printf("%s", "    [--encodeType encode_type]               - specifies the encode type. option: ffmpeg, oneVPL, null \n");
     printf("%s", "Examples: ./MRDASampleEncodeApp.exe --hostSessionAddr 127.0.0.1:50051 -i input.rgba -o output.hevc --memDevSize 1000000000 --bufferNum 100 --bufferSize 10000000 --inDevPath /dev/shm/shm1IN --outDevPath /dev/shm/shm1OUT --inDevSlotNumber 11 --outDevSlotNumber 12 --frameNum 3000 --codecId h265 --gopSize 30 --asyncDepth 4 --targetUsage balanced --rcMode 1 --bitrate 15000 --fps 30 --width 1920 --height 1080 --colorFormat rgb32 --codecProfile hevc:main --maxBFrames 0 --encodeType oneVPL \n");
 }
 
@@ -413,6 +436,10 @@ TASKTYPE StringToEncodeType(const char *encode_type_str)
     {
         encode_type = TASKTYPE::taskOneVPLEncode;
     }
+    else if (0 == strcmp(encode_type_str, "null"))
+    {
+        encode_type = TASKTYPE::taskNullEncode;
+    }
     return encode_type;
 }
 
@@ -566,10 +593,23 @@ int main(int argc, char **argv)
     }
     // 4. open source and sink file
     FILE *source = nullptr;
-    source = fopen(inputConfig.sourceFile.c_str(), "rb");
+    VDI::MRDALib::SyntheticFrameGenerator generator;
+    bool synthetic = inputConfig.sourceFile == "synthetic";
+    if (synthetic)
+    {
+        if (MRDA_STATUS_SUCCESS != generator.Initialize(inputConfig.frame_width, inputConfig.frame_height, inputConfig.color_format))
+        {
+            MRDA_LOG(LOG_ERROR, "init synthetic source failed!");
+            return MRDA_STATUS_OPERATION_FAIL;
+        }
+    }
+    else
+    {
+        source = fopen(inputConfig.sourceFile.c_str(), "rb");
+    }
     FILE *sink = nullptr;
     sink = fopen(inputConfig.sinkFile.c_str(), "wb");
-    if (source == nullptr || sink == nullptr)
+    if ((!synthetic && source == nullptr) || sink == nullptr)
     {
         MRDA_LOG(LOG_ERROR, "open file failed!");
         return MRDA_STATUS_OPERATION_FAIL;
@@ -600,7 +640,9 @@ int main(int argc, char **argv)
             continue;
         }
         // 5.2 fill input buffer
-        if (MRDA_STATUS_SUCCESS != ReadRawFrame(source, inBuffer.get(), inputConfig.color_format))
+        MRDAStatus readStatus = synthetic ? GenerateRawFrame(&generator, inBuffer.get(), inputConfig.color_format)
+                                          : ReadRawFrame(source, inBuffer.get(), inputConfig.color_format);
+        if (MRDA_STATUS_SUCCESS != readStatus)
         {
             MRDA_LOG(LOG_WARNING, "read raw frame invalid!");
             break;
@@ -662,7 +704,7 @@ int main(int argc, char **argv)
     MRDA_LOG(LOG_INFO, "MRDA trace log: total encode frame num: %d, fps: %f", curFrameNum, total_fps);
 
     fclose(sink);
-    fclose(source);
+    if (source != nullptr) fclose(source);
     // 7. stop mrda
     if (MRDA_STATUS_SUCCESS != MediaResourceDirectAccess_Stop(mrda_handle))
     {
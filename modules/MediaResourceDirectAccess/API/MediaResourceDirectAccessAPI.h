@@ -72,7 +72,8 @@ enum class TASKTYPE
     taskEncode,
     taskFFmpegDecode,
     taskOneVPLDecode,
-    taskDecode
+    taskDecode,
+    taskNullEncode    //!< synthetic encode for benchmarking, no codec or device involved
 };
 
 //!
@@ -100,6 +101,7 @@ typedef struct TASKINFO
     uint32_t taskID;
     HWDevice taskDevice;
     std::string ipAddr;
+    std::string sessionToken;   //!< secret of the session, sent with every data call
     //XXX
 } TaskInfo;
 
@@ -161,6 +163,26 @@ enum class TargetUsage {
     BestSpeed = 7
 };
 
+//!
+//! \brief container of the host bitstream recording
+//!
+//!
+enum class RecordFormat {
+    RECORD_NONE = 0,    //!< recording off
+    RECORD_ANNEXB,      //!< elementary stream as produced by the encoder, Annex-B for AVC and HEVC
+    RECORD_IVF          //!< IVF container with per-frame size and pts
+};
+
+//!
+//! \brief threading of the software decoder
+//!
+//!
+enum class DecodeThreadMode {
+    DECODE_THREAD_AUTO = 0, //!< frame threads if the decoder has them, else slice threads
+    DECODE_THREAD_FRAME,    //!< frame threads, one frame of delay per thread
+    DECODE_THREAD_SLICE     //!< slice threads only, no added delay
+};
+
 //!
 //! \brief encode parameters for encoding
 //!
@@ -182,6 +204,9 @@ typedef struct ENCODEPARAMS {
     CodecProfile codec_profile;         //!< the profile to create bitstream
     uint32_t max_b_frames;              //!< maximum number of B-frames between non-B-frames
     uint32_t     frame_num;             //!< total frame number
+    RecordFormat record_format = RecordFormat::RECORD_NONE; //!< bitstream recording on the host, off by default
+    std::string  record_path;           //!< file name of the recording, in the host directory set by MRDA_RECORD_DIR
+    uint32_t     record_buffer_size = 0; //!< bytes buffered for the recording before packets are dropped, 0 for default
 } EncodeParams;
 
 //!
@@ -196,6 +221,8 @@ typedef struct DECODEPARAMS {
     uint32_t frame_height;              //!< height of frame
     ColorFormat color_format;           //!< output pixel color format
     uint32_t    frame_num;              //!< total frame number
+    DecodeThreadMode thread_mode = DecodeThreadMode::DECODE_THREAD_AUTO; //!< threading when the session runs on CPU
+    uint32_t    thread_num = 0;         //!< decode threads when the session runs on CPU, 0 picks by resolution
 } DecodeParams;
 
 //!
@@ -210,6 +237,26 @@ typedef struct DECODEPARAMS {
 //     uint32_t            frameNum;           //!< frame number
 // }StreamInfo;
 
+//!
+//! \brief host mapping options of share memory, can be combined
+//!
+//!
+enum class ShmMapOption : uint32_t {
+    SHM_MAP_DEFAULT  = 0,       //!< plain shared mapping, pages fault on first touch
+    SHM_MAP_POPULATE = 1 << 0,  //!< pre-fault the whole region at session setup
+    SHM_MAP_HUGEPAGE = 1 << 1,  //!< advise transparent huge pages for the mapping
+    SHM_MAP_LOCK     = 1 << 2   //!< lock the mapping in memory
+};
+
+//!
+//! \brief Path of per frame buffer descriptors between guest and host
+//!
+//!
+enum class DataPlane : uint32_t {
+    DATA_PLANE_GRPC = 0,        //!< one gRPC stream message per frame
+    DATA_PLANE_SHM              //!< descriptor rings in the share memory control area, gRPC for control only
+};
+
 //!
 //! \brief Share memory info
 //!
@@ -223,6 +270,15 @@ typedef struct SHAREMEMORYINFO
     std::string  out_mem_dev_path;   //!< output memory dev path
     uint32_t     in_mem_dev_slot_number;     //!< input memory device slot number
     uint32_t     out_mem_dev_slot_number;    //!< output memory device slot number
+    uint64_t     bufferAlignment = 0;        //!< buffer payload alignment, power of two, 0 for default 4 KiB
+    uint32_t     outBufferNum = 0;           //!< output buffer number of encode bitstream ring, 0 for bufferNum
+    uint64_t     outSlotSize = 0;            //!< output slot size of encode tasks, 0 for a bitstream byte ring, larger packets are chained over slots
+    std::string  in_mem_guest_dev_path;      //!< input memory path on linux guests, empty to use the slot number
+    std::string  out_mem_guest_dev_path;     //!< output memory path on linux guests, empty to use the slot number
+    uint32_t     hostMapOptions = 0;         //!< bitmask of ShmMapOption for the host mapping
+    int32_t      hostNumaNode = -1;          //!< NUMA node the host binds the share memory to, -1 for none
+    uint32_t     hostStripes = 0;            //!< stripes of host frame conversions and copies, 0 auto by resolution, 1 single thread
+    DataPlane    dataPlane = DataPlane::DATA_PLANE_GRPC; //!< path of per frame buffer descriptors
 }ShareMemoryInfo;
 
 //!
@@ -257,13 +313,15 @@ typedef struct MEMBUFFERITEM
     uint64_t size;
     uint64_t occupied_size; // occupied buf size
     BufferState state;
+    uint32_t pitch; // row pitch in bytes of raw frame, 0 for bitstream
     void assign(uint32_t buf_id,
         uint64_t mem_offset,
         uint64_t state_offset,
         uint8_t* buf_ptr,
         uint64_t size,
         uint64_t occupied_size,
-        BufferState state) {
+        BufferState state,
+        uint32_t pitch = 0) {
         this->buf_id = buf_id;
         this->mem_offset = mem_offset;
         this->state_offset = state_offset;
@@ -271,6 +329,7 @@ typedef struct MEMBUFFERITEM
         this->size = size;
         this->occupied_size = occupied_size;
         this->state = state;
+        this->pitch = pitch;
     }
 } MemBufferItem;
 
@@ -298,6 +357,7 @@ typedef struct FRAMEBUFFERITEM {
         this->bufferItem->size = bufferItem->size;
         this->bufferItem->state = bufferItem->state;
         this->bufferItem->state_offset = bufferItem->state_offset;
+        this->bufferItem->pitch = bufferItem->pitch;
         this->width = width;
         this->height = height;
         this->streamType = streamType;
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file BitstreamRecorder.cpp
+//! \brief Implement the asynchronous bitstream recording tap
+//! \date 2026-10-17
+//!
+
+#include "BitstreamRecorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t RECORD_BUFFER_SIZE_MIN = 64 * 1024; //<! smallest ring
+constexpr uint32_t IVF_FILE_HEADER_SIZE = 32;          //<! size of the IVF file header
+constexpr uint32_t IVF_FRAME_HEADER_SIZE = 12;         //<! size of each IVF frame header
+constexpr uint32_t IVF_FRAME_COUNT_OFFSET = 24;        //<! offset of the frame count in the IVF header
+
+//!
+//! \brief Store little endian integers of the IVF headers
+//!
+static inline void PutLe16(uint8_t *p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+static inline void PutLe32(uint8_t *p, uint32_t v)
+{
+    PutLe16(p, static_cast<uint16_t>(v));
+    PutLe16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+
+static inline void PutLe64(uint8_t *p, uint64_t v)
+{
+    PutLe32(p, static_cast<uint32_t>(v));
+    PutLe32(p + 4, static_cast<uint32_t>(v >> 32));
+}
+
+BitstreamRecorder::BitstreamRecorder()
+    : m_fd(-1),
+      m_format(RecordFormat::RECORD_NONE),
+      m_ring(nullptr),
+      m_ringSize(0),
+      m_wakeSize(0),
+      m_writePos(0),
+      m_readPos(0),
+      m_skipToKey(false),
+      m_droppedNum(0),
+      m_staging(nullptr),
+      m_stagedSize(0),
+      m_frameNum(0),
+      m_writeFailed(false),
+      m_stop(false)
+{
+}
+
+BitstreamRecorder::~BitstreamRecorder()
+{
+    Stop();
+    free(m_ring);
+    free(m_staging);
+}
+
+MRDAStatus BitstreamRecorder::Start(const std::string &path, RecordFormat format, const EncodeParams &params, uint32_t bufferSize)
+{
+    if (m_fd >= 0 || format == RecordFormat::RECORD_NONE || path.empty())
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid bitstream recording settings!");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    // memory of the tap is bounded by the ring, allocated once
+    uint64_t ringSize = RECORD_BUFFER_SIZE_MIN;
+    uint64_t wanted = bufferSize > 0 ? bufferSize : RECORD_BUFFER_SIZE_DEFAULT;
+    while (ringSize < wanted) ringSize <<= 1;
+    void *ring = nullptr;
+    void *staging = nullptr;
+    if (posix_memalign(&ring, RECORD_WRITE_ALIGN, ringSize) != 0
+        || posix_memalign(&staging, RECORD_WRITE_ALIGN, RECORD_WRITE_CHUNK) != 0)
+    {
+        free(ring);
+        MRDA_LOG(LOG_ERROR, "Failed to allocate bitstream recording buffers!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    m_ring = static_cast<uint8_t*>(ring);
+    m_ringSize = ringSize;
+    m_wakeSize = std::min<uint64_t>(RECORD_WRITE_CHUNK, ringSize / 2);
+    m_staging = static_cast<uint8_t*>(staging);
+
+    m_fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to open bitstream recording %s, errno %d", path.c_str(), errno);
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    m_format = format;
+
+    if (m_format == RecordFormat::RECORD_IVF)
+    {
+        uint8_t header[IVF_FILE_HEADER_SIZE] = {};
+        const char *fourcc = params.codec_id == StreamCodecID::CodecID_AVC ? "H264"
+                           : params.codec_id == StreamCodecID::CodecID_AV1 ? "AV01" : "H265";
+        // pts counts frames, so the time base is one frame
+        bool hasRate = params.framerate_num > 0 && params.framerate_den > 0;
+        memcpy(header, "DKIF", 4);
+        PutLe16(header + 4, 0);
+        PutLe16(header + 6, IVF_FILE_HEADER_SIZE);
+        memcpy(header + 8, fourcc, 4);
+        PutLe16(header + 12, static_cast<uint16_t>(params.frame_width));
+        PutLe16(header + 14, static_cast<uint16_t>(params.frame_height));
+        PutLe32(header + 16, hasRate ? params.framerate_num : 30);
+        PutLe32(header + 20, hasRate ? params.framerate_den : 1);
+        // frame count is patched when the file is closed
+        Stage(header, sizeof(header));
+    }
+
+    m_stop = false;
+    m_writerThread = std::thread(&BitstreamRecorder::WriterThread, this);
+    MRDA_LOG(LOG_INFO, "Bitstream recording to %s, %lu bytes buffered", path.c_str(), m_ringSize);
+    return MRDA_STATUS_SUCCESS;
+}
+
+void BitstreamRecorder::Write(const uint8_t *data, uint32_t size, uint64_t pts, bool keyFrame)
+{
+    if (!m_writerThread.joinable() || data == nullptr || size == 0) return;
+
+    // after a drop the stream resumes at a key frame to stay decodable
+    if (m_skipToKey && !keyFrame)
+    {
+        m_droppedNum++;
+        return;
+    }
+    uint64_t need = sizeof(RecordHeader) + ((static_cast<uint64_t>(size) + 7) & ~7ULL);
+    uint64_t writePos = m_writePos.load(std::memory_order_relaxed);
+    uint64_t readPos = m_readPos.load(std::memory_order_acquire);
+    if (need > m_ringSize - (writePos - readPos))
+    {
+        m_skipToKey = true;
+        m_droppedNum++;
+        return;
+    }
+    m_skipToKey = false;
+
+    RecordHeader header = {size, 0, pts};
+    RingWrite(writePos, &header, sizeof(header));
+    RingWrite(writePos + sizeof(header), data, size);
+    m_writePos.store(writePos + need, std::memory_order_release);
+
+    // the writer also wakes on its own timer, so a lost wake up only delays it
+    if (writePos + need - readPos >= m_wakeSize)
+    {
+        m_wakeCond.notify_one();
+    }
+}
+
+void BitstreamRecorder::Stop()
+{
+    if (!m_writerThread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = true;
+    }
+    m_wakeCond.notify_one();
+    m_writerThread.join();
+    MRDA_LOG(LOG_INFO, "Bitstream recording closed, %u frames written, %lu packets dropped", m_frameNum, m_droppedNum);
+}
+
+void BitstreamRecorder::WriterThread()
+{
+    bool stop = false;
+    while (!stop)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCond.wait_for(lock, std::chrono::milliseconds(RECORD_WAKE_MS), [this] {
+                return m_stop.load() || m_writePos.load() - m_readPos.load() >= m_wakeSize;
+            });
+        }
+        // drain once more after stop so nothing published is lost
+        stop = m_stop.load();
+        Drain();
+    }
+    Flush();
+
+    if (m_format == RecordFormat::RECORD_IVF && !m_writeFailed)
+    {
+        uint8_t count[4];
+        PutLe32(count, m_frameNum);
+        if (pwrite(m_fd, count, sizeof(count), IVF_FRAME_COUNT_OFFSET) != sizeof(count))
+        {
+            MRDA_LOG(LOG_WARNING, "Failed to update IVF frame count, errno %d", errno);
+        }
+    }
+    close(m_fd);
+    m_fd = -1;
+}
+
+void BitstreamRecorder::Drain()
+{
+    uint64_t readPos = m_readPos.load(std::memory_order_relaxed);
+    uint64_t writePos = m_writePos.load(std::memory_order_acquire);
+    while (readPos < writePos)
+    {
+        RecordHeader header;
+        RingRead(readPos, &header, sizeof(header));
+        if (m_format == RecordFormat::RECORD_IVF)
+        {
+            uint8_t frameHeader[IVF_FRAME_HEADER_SIZE];
+            PutLe32(frameHeader, header.size);
+            PutLe64(frameHeader + 4, header.pts);
+            Stage(frameHeader, sizeof(frameHeader));
+        }
+        StageFromRing(readPos + sizeof(header), header.size);
+        m_frameNum++;
+        // the record is in the staging buffer, hand its space back
+        readPos += sizeof(header) + ((static_cast<uint64_t>(header.size) + 7) & ~7ULL);
+        m_readPos.store(readPos, std::memory_order_release);
+    }
+}
+
+void BitstreamRecorder::RingWrite(uint64_t pos, const void *src, uint64_t size)
+{
+    uint64_t offset = pos & (m_ringSize - 1);
+    uint64_t first = std::min(size, m_ringSize - offset);
+    memcpy(m_ring + offset, src, first);
+    memcpy(m_ring, static_cast<const uint8_t*>(src) + first, size - first);
+}
+
+void BitstreamRecorder::RingRead(uint64_t pos, void *dst, uint64_t size)
+{
+    uint64_t offset = pos & (m_ringSize - 1);
+    uint64_t first = std::min(size, m_ringSize - offset);
+    memcpy(dst, m_ring + offset, first);
+    memcpy(static_cast<uint8_t*>(dst) + first, m_ring, size - first);
+}
+
+void BitstreamRecorder::StageFromRing(uint64_t pos, uint64_t size)
+{
+    while (size > 0)
+    {
+        uint64_t offset = pos & (m_ringSize - 1);
+        uint64_t bytes = std::min(size, m_ringSize - offset);
+        Stage(m_ring + offset, bytes);
+        pos += bytes;
+        size -= bytes;
+    }
+}
+
+void BitstreamRecorder::Stage(const uint8_t *src, uint64_t size)
+{
+    while (size > 0)
+    {
+        uint64_t bytes = std::min<uint64_t>(size, RECORD_WRITE_CHUNK - m_stagedSize);
+        memcpy(m_staging + m_stagedSize, src, bytes);
+        m_stagedSize += static_cast<uint32_t>(bytes);
+        src += bytes;
+        size -= bytes;
+        // only whole chunks are written while recording
+        if (m_stagedSize == RECORD_WRITE_CHUNK) Flush();
+    }
+}
+
+void BitstreamRecorder::Flush()
+{
+    uint32_t written = 0;
+    while (!m_writeFailed && written < m_stagedSize)
+    {
+        ssize_t ret = write(m_fd, m_staging + written, m_stagedSize - written);
+        if (ret < 0 && errno == EINTR) continue;
+        if (ret <= 0)
+        {
+            // keep draining so the encode side never stalls, the rest is lost
+            MRDA_LOG(LOG_ERROR, "Bitstream recording write failed, errno %d", errno);
+            m_writeFailed = true;
+            break;
+        }
+        written += static_cast<uint32_t>(ret);
+    }
+    m_stagedSize = 0;
+}
+
+VDI_NS_END
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file BitstreamRecorder.h
+//! \brief Optional recording tap of encoded bitstreams, packets are copied
+//!        into a lock-free ring and written to a file by a background thread.
+//! \date 2026-10-17
+//!
+
+#ifndef _BITSTREAM_RECORDER_H_
+#define _BITSTREAM_RECORDER_H_
+
+#include "../utils/common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+VDI_NS_BEGIN
+
+constexpr const char *RECORD_DIR_ENV = "MRDA_RECORD_DIR";       //<! host directory recordings are confined to, unset disables recording
+constexpr uint32_t RECORD_BUFFER_SIZE_DEFAULT = 8 * 1024 * 1024; //<! default bytes buffered before packets are dropped
+constexpr uint32_t RECORD_WRITE_CHUNK = 1024 * 1024;             //<! size of each file write
+constexpr uint32_t RECORD_WRITE_ALIGN = 4096;                    //<! alignment of the write staging buffer
+constexpr uint32_t RECORD_WAKE_MS = 20;                          //<! max time packets wait in the ring
+
+class BitstreamRecorder
+{
+public:
+    //!
+    //! \brief Construct a new Bitstream Recorder object
+    //!
+    BitstreamRecorder();
+
+    //!
+    //! \brief Destroy the Bitstream Recorder object, writes out what is
+    //!        buffered and closes the file
+    //!
+    virtual ~BitstreamRecorder();
+
+    //!
+    //! \brief Open the file and start the writer thread
+    //!
+    //! \param [in] path
+    //!             output file
+    //! \param [in] format
+    //!             RECORD_ANNEXB or RECORD_IVF
+    //! \param [in] params
+    //!             encode parameters for the IVF header
+    //! \param [in] bufferSize
+    //!             bytes the ring holds, rounded up to a power of two
+    //! \return MRDAStatus
+    //!
+    MRDAStatus Start(const std::string &path, RecordFormat format, const EncodeParams &params, uint32_t bufferSize);
+
+    //!
+    //! \brief Copy one packet into the ring, never blocks. When the ring is
+    //!        full the packet is dropped and so is everything up to the next
+    //!        key frame, so the recording stays decodable
+    //!
+    //! \param [in] data
+    //! \param [in] size
+    //! \param [in] pts
+    //! \param [in] keyFrame
+    //!
+    void Write(const uint8_t *data, uint32_t size, uint64_t pts, bool keyFrame);
+
+    //!
+    //! \brief Write out what is buffered, stop the writer thread and close
+    //!        the file
+    //!
+    void Stop();
+
+private:
+    //!
+    //! \brief Packet record in the ring, followed by the payload padded to 8 bytes
+    //!
+    struct RecordHeader
+    {
+        uint32_t size;     //!< payload size
+        uint32_t reserved; //!< padding
+        uint64_t pts;      //!< presentation time stamp
+    };
+
+    //!
+    //! \brief Writer thread loop
+    //!
+    void WriterThread();
+
+    //!
+    //! \brief Move all published records from the ring to the file
+    //!
+    void Drain();
+
+    //!
+    //! \brief Copy bytes into the ring at a stream position, with wrap around
+    //!
+    //! \param [in] pos
+    //! \param [in] src
+    //! \param [in] size
+    //!
+    void RingWrite(uint64_t pos, const void *src, uint64_t size);
+
+    //!
+    //! \brief Copy bytes out of the ring at a stream position, with wrap around
+    //!
+    //! \param [in] pos
+    //! \param [out] dst
+    //! \param [in] size
+    //!
+    void RingRead(uint64_t pos, void *dst, uint64_t size);
+
+    //!
+    //! \brief Append bytes of the ring at a stream position to the staging buffer
+    //!
+    //! \param [in] pos
+    //! \param [in] size
+    //!
+    void StageFromRing(uint64_t pos, uint64_t size);
+
+    //!
+    //! \brief Append bytes to the staging buffer, full chunks go to the file
+    //!
+    //! \param [in] src
+    //! \param [in] size
+    //!
+    void Stage(const uint8_t *src, uint64_t size);
+
+    //!
+    //! \brief Write the staged bytes to the file
+    //!
+    void Flush();
+
+private:
+    int m_fd;                                //<! output file
+    RecordFormat m_format;                   //<! output container
+    uint8_t *m_ring;                         //<! packet ring shared by the encode thread and the writer
+    uint64_t m_ringSize;                     //<! ring size, power of two
+    uint64_t m_wakeSize;                     //<! pending bytes that wake the writer before its timer
+    std::atomic<uint64_t> m_writePos;        //<! ring bytes published by the encode thread
+    std::atomic<uint64_t> m_readPos;         //<! ring bytes consumed by the writer
+    bool m_skipToKey;                        //<! dropping until the next key frame, encode thread only
+    uint64_t m_droppedNum;                   //<! dropped packets, encode thread only
+    uint8_t *m_staging;                      //<! aligned buffer of the next file write
+    uint32_t m_stagedSize;                   //<! bytes in the staging buffer
+    uint32_t m_frameNum;                     //<! frames written, for the IVF header
+    bool m_writeFailed;                      //<! file write error seen, data is discarded
+    std::atomic<bool> m_stop;                //<! stop flag of the writer
+    std::mutex m_wakeMutex;                  //<! guard of the writer wake up
+    std::condition_variable m_wakeCond;      //<! signaled when the ring fills up or on stop
+    std::thread m_writerThread;              //<! background writer
+};
+
+VDI_NS_END
+#endif // _BITSTREAM_RECORDER_H_
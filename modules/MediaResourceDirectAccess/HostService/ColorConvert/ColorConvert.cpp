@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvert.cpp
+//! \brief Colour space converter, walks row pairs and dispatches the row
+//!        kernels picked for the CPU.
+//! \date 2026-10-17
+//!
+
+#include "ColorConvert.h"
+#include "ColorConvertKernels.h"
+
+#include <cstring>
+
+VDI_NS_BEGIN
+
+//!
+//! \brief Get the best instruction set supported by the CPU
+//!
+static CscIsa CscCpuIsa()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return CscIsa::CSC_ISA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return CscIsa::CSC_ISA_AVX2;
+    }
+#endif
+    return CscIsa::CSC_ISA_SCALAR;
+}
+
+ColorConvert::ColorConvert(CscIsa isa)
+{
+    CscIsa cpuIsa = CscCpuIsa();
+    // never use more than the CPU supports
+    if (isa == CscIsa::CSC_ISA_AUTO || static_cast<uint32_t>(isa) > static_cast<uint32_t>(cpuIsa))
+    {
+        isa = cpuIsa;
+    }
+    m_isa = isa;
+    switch (m_isa)
+    {
+        case CscIsa::CSC_ISA_AVX512:
+            m_kernels = &g_cscKernelsAVX512;
+            break;
+        case CscIsa::CSC_ISA_AVX2:
+            m_kernels = &g_cscKernelsAVX2;
+            break;
+        default:
+            m_kernels = &g_cscKernelsScalar;
+            break;
+    }
+}
+
+bool ColorConvert::IsSupported(CscFormat in, CscFormat out)
+{
+    // every pair of the handled formats, same formats are plain copies
+    return in != CscFormat::CSC_FORMAT_NONE && out != CscFormat::CSC_FORMAT_NONE;
+}
+
+MRDAStatus ColorConvert::Convert(const CscImage &src, const CscImage &dst)
+{
+    return ConvertRows(src, dst, 0, src.height);
+}
+
+//!
+//! \brief Copy rows of one plane
+//!
+static void CscCopyRows(const uint8_t *src, int srcLinesize, uint8_t *dst, int dstLinesize,
+                        int bytes, int rowBegin, int rowEnd)
+{
+    for (int row = rowBegin; row < rowEnd; row++)
+    {
+        memcpy(dst + static_cast<size_t>(row) * dstLinesize, src + static_cast<size_t>(row) * srcLinesize, bytes);
+    }
+}
+
+MRDAStatus ColorConvert::ConvertRows(const CscImage &src, const CscImage &dst, int rowBegin, int rowEnd)
+{
+    if (!IsSupported(src.format, dst.format))
+    {
+        MRDA_LOG(LOG_ERROR, "Unsupported color conversion!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    if (src.width != dst.width || src.height != dst.height || src.width <= 0 || src.height <= 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid color conversion size!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    if (rowBegin < 0 || (rowBegin & 1) != 0 || rowEnd > src.height || rowBegin >= rowEnd)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid color conversion rows [%d, %d)!", rowBegin, rowEnd);
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    int width = src.width;
+    int chromaWidth = (width + 1) / 2;
+    bool srcRgb = src.format == CscFormat::CSC_FORMAT_BGRA;
+    bool dstRgb = dst.format == CscFormat::CSC_FORMAT_BGRA;
+
+    // same format, copy planes
+    if (src.format == dst.format)
+    {
+        if (srcRgb)
+        {
+            CscCopyRows(src.data[0], src.linesize[0], dst.data[0], dst.linesize[0], width * 4, rowBegin, rowEnd);
+            return MRDA_STATUS_SUCCESS;
+        }
+        CscCopyRows(src.data[0], src.linesize[0], dst.data[0], dst.linesize[0], width, rowBegin, rowEnd);
+        int chromaBegin = rowBegin / 2;
+        int chromaEnd = (rowEnd + 1) / 2;
+        if (src.format == CscFormat::CSC_FORMAT_NV12)
+        {
+            CscCopyRows(src.data[1], src.linesize[1], dst.data[1], dst.linesize[1], chromaWidth * 2, chromaBegin, chromaEnd);
+        }
+        else
+        {
+            CscCopyRows(src.data[1], src.linesize[1], dst.data[1], dst.linesize[1], chromaWidth, chromaBegin, chromaEnd);
+            CscCopyRows(src.data[2], src.linesize[2], dst.data[2], dst.linesize[2], chromaWidth, chromaBegin, chromaEnd);
+        }
+        return MRDA_STATUS_SUCCESS;
+    }
+
+    for (int row = rowBegin; row < rowEnd; row += 2)
+    {
+        // odd height, the last row pairs with itself
+        int row1 = (row + 1 < src.height) ? row + 1 : row;
+        int chromaRow = row / 2;
+        if (srcRgb)
+        {
+            const uint8_t *bgra0 = src.data[0] + static_cast<size_t>(row) * src.linesize[0];
+            const uint8_t *bgra1 = src.data[0] + static_cast<size_t>(row1) * src.linesize[0];
+            uint8_t *y0 = dst.data[0] + static_cast<size_t>(row) * dst.linesize[0];
+            uint8_t *y1 = dst.data[0] + static_cast<size_t>(row1) * dst.linesize[0];
+            if (dst.format == CscFormat::CSC_FORMAT_NV12)
+            {
+                uint8_t *uv = dst.data[1] + static_cast<size_t>(chromaRow) * dst.linesize[1];
+                m_kernels->bgraToYuv(bgra0, bgra1, y0, y1, uv, uv + 1, 2, width);
+            }
+            else
+            {
+                uint8_t *u = dst.data[1] + static_cast<size_t>(chromaRow) * dst.linesize[1];
+                uint8_t *v = dst.data[2] + static_cast<size_t>(chromaRow) * dst.linesize[2];
+                m_kernels->bgraToYuv(bgra0, bgra1, y0, y1, u, v, 1, width);
+            }
+            continue;
+        }
+
+        const uint8_t *y0 = src.data[0] + static_cast<size_t>(row) * src.linesize[0];
+        const uint8_t *y1 = src.data[0] + static_cast<size_t>(row1) * src.linesize[0];
+        const uint8_t *u = src.data[1] + static_cast<size_t>(chromaRow) * src.linesize[1];
+        const uint8_t *v = nullptr;
+        int uvStep = 2;
+        if (src.format == CscFormat::CSC_FORMAT_NV12)
+        {
+            v = u + 1;
+        }
+        else
+        {
+            v = src.data[2] + static_cast<size_t>(chromaRow) * src.linesize[2];
+            uvStep = 1;
+        }
+
+        if (dstRgb)
+        {
+            uint8_t *bgra0 = dst.data[0] + static_cast<size_t>(row) * dst.linesize[0];
+            uint8_t *bgra1 = dst.data[0] + static_cast<size_t>(row1) * dst.linesize[0];
+            m_kernels->yuvToBgra(y0, y1, u, v, uvStep, bgra0, bgra1, width);
+            continue;
+        }
+
+        // NV12 <-> I420, luma is copied and chroma is split or merged
+        int rowEnd1 = (row1 != row) ? row + 2 : row + 1;
+        CscCopyRows(src.data[0], src.linesize[0], dst.data[0], dst.linesize[0], width, row, rowEnd1);
+        if (src.format == CscFormat::CSC_FORMAT_NV12)
+        {
+            m_kernels->splitUV(u, dst.data[1] + static_cast<size_t>(chromaRow) * dst.linesize[1],
+                               dst.data[2] + static_cast<size_t>(chromaRow) * dst.linesize[2], chromaWidth);
+        }
+        else
+        {
+            m_kernels->mergeUV(u, v, dst.data[1] + static_cast<size_t>(chromaRow) * dst.linesize[1], chromaWidth);
+        }
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvert.h
+//! \brief Colour space conversion between the raw formats exchanged with
+//!        the guest, with row kernels selected by the CPU at runtime.
+//! \date 2026-10-17
+//!
+
+#ifndef _COLOR_CONVERT_H_
+#define _COLOR_CONVERT_H_
+
+#include "../../utils/common.h"
+
+VDI_NS_BEGIN
+
+//!
+//! \brief raw formats handled by the converter
+//!
+enum class CscFormat : uint32_t
+{
+    CSC_FORMAT_NONE = 0,
+    CSC_FORMAT_NV12,    //!< Y plane, interleaved UV plane
+    CSC_FORMAT_I420,    //!< Y, U, V planes
+    CSC_FORMAT_BGRA,    //!< packed B, G, R, A bytes
+};
+
+//!
+//! \brief instruction set of the row kernels
+//!
+enum class CscIsa : uint32_t
+{
+    CSC_ISA_AUTO = 0,   //!< best one supported by the CPU
+    CSC_ISA_SCALAR,
+    CSC_ISA_AVX2,
+    CSC_ISA_AVX512,
+};
+
+//!
+//! \brief planes of one image, chroma planes are subsampled 2x2
+//!
+struct CscImage
+{
+    uint8_t *data[3] = {nullptr, nullptr, nullptr}; //!< plane pointers
+    int linesize[3] = {0, 0, 0};                    //!< plane strides in bytes
+    CscFormat format = CscFormat::CSC_FORMAT_NONE;  //!< pixel format
+    int width = 0;                                  //!< width in pixels
+    int height = 0;                                 //!< height in pixels
+};
+
+struct CscRowKernels;
+
+class ColorConvert
+{
+public:
+    //!
+    //! \brief Construct a new Color Convert object
+    //!
+    //! \param [in] isa
+    //!             requested kernels, lowered to what the CPU supports
+    //!
+    explicit ColorConvert(CscIsa isa = CscIsa::CSC_ISA_AUTO);
+    //!
+    //! \brief Destroy the Color Convert object
+    //!
+    virtual ~ColorConvert() = default;
+
+    //!
+    //! \brief Check whether a conversion is handled
+    //!
+    //! \param [in] in
+    //! \param [in] out
+    //! \return bool
+    //!
+    static bool IsSupported(CscFormat in, CscFormat out);
+
+    //!
+    //! \brief Convert a whole image, same formats are copied
+    //!
+    //! \param [in] src
+    //! \param [in] dst
+    //!             planes to write, same size as src
+    //! \return MRDAStatus
+    //!
+    MRDAStatus Convert(const CscImage &src, const CscImage &dst);
+
+    //!
+    //! \brief Convert rows [rowBegin, rowEnd) of an image, rowBegin is even
+    //!        and rowEnd is even or the image height, so ranges can be
+    //!        converted independently
+    //!
+    //! \param [in] src
+    //! \param [in] dst
+    //! \param [in] rowBegin
+    //! \param [in] rowEnd
+    //! \return MRDAStatus
+    //!
+    MRDAStatus ConvertRows(const CscImage &src, const CscImage &dst, int rowBegin, int rowEnd);
+
+    //!
+    //! \brief Get the instruction set of the selected kernels
+    //!
+    //! \return CscIsa
+    //!
+    inline CscIsa Isa() const { return m_isa; }
+
+private:
+    const CscRowKernels *m_kernels; //!< selected row kernels
+    CscIsa m_isa;                   //!< instruction set of the kernels
+};
+
+VDI_NS_END
+#endif // _COLOR_CONVERT_H_
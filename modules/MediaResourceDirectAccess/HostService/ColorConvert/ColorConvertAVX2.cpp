@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvertAVX2.cpp
+//! \brief AVX2 row kernels of the colour space converter, 8 pixels per
+//!        32 bit lane vector so the integer math matches the scalar path
+//! \date 2026-10-17
+//!
+
+#include "ColorConvertKernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CSC_AVX2 __attribute__((target("avx2")))
+#endif
+
+VDI_NS_BEGIN
+
+#if defined(__x86_64__) || defined(__i386__)
+
+//!
+//! \brief Pack eight 32 bit values in [0, 255] to the low 8 bytes
+//!
+static inline CSC_AVX2 __m128i CscPack8(__m256i value)
+{
+    __m256i packed = _mm256_packus_epi32(value, value);
+    packed = _mm256_packus_epi16(packed, packed);
+    // dword 0 holds pixels 0-3 and dword 4 holds pixels 4-7
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+    return _mm256_castsi256_si128(packed);
+}
+
+//!
+//! \brief Compute luma of eight BGRA pixels, returns 32 bit lanes
+//!
+static inline CSC_AVX2 __m256i CscLuma8(__m256i b, __m256i g, __m256i r)
+{
+    __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(r, _mm256_set1_epi32(66)),
+                                   _mm256_mullo_epi32(g, _mm256_set1_epi32(129)));
+    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(b, _mm256_set1_epi32(25)));
+    sum = _mm256_add_epi32(sum, _mm256_set1_epi32(128));
+    return _mm256_add_epi32(_mm256_srai_epi32(sum, 8), _mm256_set1_epi32(16));
+}
+
+//!
+//! \brief Compute a chroma component from averaged B, G, R
+//!
+static inline CSC_AVX2 __m256i CscChroma8(__m256i b, __m256i g, __m256i r, int cr, int cg, int cb)
+{
+    __m256i sum = _mm256_add_epi32(_mm256_mullo_epi32(r, _mm256_set1_epi32(cr)),
+                                   _mm256_mullo_epi32(g, _mm256_set1_epi32(cg)));
+    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(b, _mm256_set1_epi32(cb)));
+    sum = _mm256_add_epi32(sum, _mm256_set1_epi32(128));
+    return _mm256_add_epi32(_mm256_srai_epi32(sum, 8), _mm256_set1_epi32(128));
+}
+
+//!
+//! \brief Add horizontally adjacent lanes of a and b, in pixel order
+//!
+static inline CSC_AVX2 __m256i CscPairSum8(__m256i a, __m256i b)
+{
+    // hadd works per 128 bit lane, reorder the 64 bit halves after it
+    return _mm256_permute4x64_epi64(_mm256_hadd_epi32(a, b), 0xD8);
+}
+
+static CSC_AVX2 void CscBgraToYuvRowAVX2(const uint8_t *bgra0, const uint8_t *bgra1, uint8_t *y0, uint8_t *y1,
+                                         uint8_t *u, uint8_t *v, int uvStep, int width)
+{
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        __m256i sumB[2], sumG[2], sumR[2];
+        for (int half = 0; half < 2; half++)
+        {
+            __m256i p0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bgra0 + (x + half * 8) * 4));
+            __m256i p1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bgra1 + (x + half * 8) * 4));
+            __m256i b0 = _mm256_and_si256(p0, mask);
+            __m256i g0 = _mm256_and_si256(_mm256_srli_epi32(p0, 8), mask);
+            __m256i r0 = _mm256_and_si256(_mm256_srli_epi32(p0, 16), mask);
+            __m256i b1 = _mm256_and_si256(p1, mask);
+            __m256i g1 = _mm256_and_si256(_mm256_srli_epi32(p1, 8), mask);
+            __m256i r1 = _mm256_and_si256(_mm256_srli_epi32(p1, 16), mask);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(y0 + x + half * 8), CscPack8(CscLuma8(b0, g0, r0)));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(y1 + x + half * 8), CscPack8(CscLuma8(b1, g1, r1)));
+            sumB[half] = _mm256_add_epi32(b0, b1);
+            sumG[half] = _mm256_add_epi32(g0, g1);
+            sumR[half] = _mm256_add_epi32(r0, r1);
+        }
+        const __m256i round = _mm256_set1_epi32(2);
+        __m256i b = _mm256_srli_epi32(_mm256_add_epi32(CscPairSum8(sumB[0], sumB[1]), round), 2);
+        __m256i g = _mm256_srli_epi32(_mm256_add_epi32(CscPairSum8(sumG[0], sumG[1]), round), 2);
+        __m256i r = _mm256_srli_epi32(_mm256_add_epi32(CscPairSum8(sumR[0], sumR[1]), round), 2);
+        __m128i cu = CscPack8(CscChroma8(b, g, r, -38, -74, 112));
+        __m128i cv = CscPack8(CscChroma8(b, g, r, 112, -94, -18));
+        if (uvStep == 2)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x), _mm_unpacklo_epi8(cu, cv));
+        }
+        else
+        {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(u + x / 2), cu);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(v + x / 2), cv);
+        }
+    }
+    if (x < width)
+    {
+        CscBgraToYuvRowScalar(bgra0 + x * 4, bgra1 + x * 4, y0 + x, y1 + x,
+                              u + (x / 2) * uvStep, v + (x / 2) * uvStep, uvStep, width - x);
+    }
+}
+
+static CSC_AVX2 void CscYuvToBgraRowAVX2(const uint8_t *y0, const uint8_t *y1, const uint8_t *u, const uint8_t *v,
+                                         int uvStep, uint8_t *bgra0, uint8_t *bgra1, int width)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(255);
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    int x = 0;
+    for (; x + 8 <= width; x += 8)
+    {
+        // duplicate 4 chroma samples to the 8 pixels they cover
+        __m128i cu, cv;
+        if (uvStep == 2)
+        {
+            __m128i uv = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x));
+            cu = _mm_shuffle_epi8(uv, _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, -1, -1, -1, -1, -1, -1, -1, -1));
+            cv = _mm_shuffle_epi8(uv, _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, -1, -1, -1, -1, -1, -1, -1, -1));
+        }
+        else
+        {
+            int32_t u4 = 0, v4 = 0;
+            memcpy(&u4, u + x / 2, sizeof(u4));
+            memcpy(&v4, v + x / 2, sizeof(v4));
+            const __m128i dup = _mm_setr_epi8(0, 0, 1, 1, 2, 2, 3, 3, -1, -1, -1, -1, -1, -1, -1, -1);
+            cu = _mm_shuffle_epi8(_mm_cvtsi32_si128(u4), dup);
+            cv = _mm_shuffle_epi8(_mm_cvtsi32_si128(v4), dup);
+        }
+        __m256i d = _mm256_sub_epi32(_mm256_cvtepu8_epi32(cu), _mm256_set1_epi32(128));
+        __m256i e = _mm256_sub_epi32(_mm256_cvtepu8_epi32(cv), _mm256_set1_epi32(128));
+        __m256i rv = _mm256_add_epi32(_mm256_mullo_epi32(e, _mm256_set1_epi32(409)), _mm256_set1_epi32(128));
+        __m256i gv = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(d, _mm256_set1_epi32(-100)),
+                                                       _mm256_mullo_epi32(e, _mm256_set1_epi32(-208))),
+                                      _mm256_set1_epi32(128));
+        __m256i bv = _mm256_add_epi32(_mm256_mullo_epi32(d, _mm256_set1_epi32(516)), _mm256_set1_epi32(128));
+
+        const uint8_t *yRow[2] = {y0, y1};
+        uint8_t *bgraRow[2] = {bgra0, bgra1};
+        for (int row = 0; row < 2; row++)
+        {
+            __m256i luma = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(yRow[row] + x)));
+            __m256i c = _mm256_mullo_epi32(_mm256_sub_epi32(luma, _mm256_set1_epi32(16)), _mm256_set1_epi32(298));
+            __m256i r = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(c, rv), 8), zero), max);
+            __m256i g = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(c, gv), 8), zero), max);
+            __m256i b = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(_mm256_add_epi32(c, bv), 8), zero), max);
+            __m256i pixel = _mm256_or_si256(_mm256_or_si256(b, _mm256_slli_epi32(g, 8)),
+                                            _mm256_or_si256(_mm256_slli_epi32(r, 16), alpha));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(bgraRow[row] + x * 4), pixel);
+        }
+    }
+    if (x < width)
+    {
+        CscYuvToBgraRowScalar(y0 + x, y1 + x, u + (x / 2) * uvStep, v + (x / 2) * uvStep,
+                              uvStep, bgra0 + x * 4, bgra1 + x * 4, width - x);
+    }
+}
+
+static CSC_AVX2 void CscSplitUVRowAVX2(const uint8_t *uv, uint8_t *u, uint8_t *v, int chromaWidth)
+{
+    const __m256i shuffle = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+                                             0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    int x = 0;
+    for (; x + 16 <= chromaWidth; x += 16)
+    {
+        __m256i pairs = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(uv + 2 * x));
+        // per lane U then V, then gather U halves and V halves
+        __m256i split = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(pairs, shuffle), 0xD8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x), _mm256_castsi256_si128(split));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(v + x), _mm256_extracti128_si256(split, 1));
+    }
+    if (x < chromaWidth)
+    {
+        CscSplitUVRowScalar(uv + 2 * x, u + x, v + x, chromaWidth - x);
+    }
+}
+
+static CSC_AVX2 void CscMergeUVRowAVX2(const uint8_t *u, const uint8_t *v, uint8_t *uv, int chromaWidth)
+{
+    int x = 0;
+    for (; x + 16 <= chromaWidth; x += 16)
+    {
+        __m128i cu = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x));
+        __m128i cv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uv + 2 * x), _mm_unpacklo_epi8(cu, cv));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(uv + 2 * x + 16), _mm_unpackhi_epi8(cu, cv));
+    }
+    if (x < chromaWidth)
+    {
+        CscMergeUVRowScalar(u + x, v + x, uv + 2 * x, chromaWidth - x);
+    }
+}
+
+const CscRowKernels g_cscKernelsAVX2 =
+{
+    CscBgraToYuvRowAVX2,
+    CscYuvToBgraRowAVX2,
+    CscSplitUVRowAVX2,
+    CscMergeUVRowAVX2,
+};
+
+#else
+
+const CscRowKernels g_cscKernelsAVX2 =
+{
+    CscBgraToYuvRowScalar,
+    CscYuvToBgraRowScalar,
+    CscSplitUVRowScalar,
+    CscMergeUVRowScalar,
+};
+
+#endif
+
+VDI_NS_END
@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvertAVX512.cpp
+//! \brief AVX-512 row kernels of the colour space converter, 16 pixels
+//!        per 32 bit lane vector so the integer math matches the scalar
+//!        path. UV split and merge are memory bound and reuse AVX2.
+//! \date 2026-10-17
+//!
+
+#include "ColorConvertKernels.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CSC_AVX512 __attribute__((target("avx512f")))
+// avx512fintrin.h fills unused results with _mm512_undefined_epi32, which
+// some GCC versions report as maybe uninitialized once inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+VDI_NS_BEGIN
+
+#if defined(__x86_64__) || defined(__i386__)
+
+static inline CSC_AVX512 __m512i CscLuma16(__m512i b, __m512i g, __m512i r)
+{
+    __m512i sum = _mm512_add_epi32(_mm512_mullo_epi32(r, _mm512_set1_epi32(66)),
+                                   _mm512_mullo_epi32(g, _mm512_set1_epi32(129)));
+    sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(b, _mm512_set1_epi32(25)));
+    sum = _mm512_add_epi32(sum, _mm512_set1_epi32(128));
+    return _mm512_add_epi32(_mm512_srai_epi32(sum, 8), _mm512_set1_epi32(16));
+}
+
+static inline CSC_AVX512 __m512i CscChroma16(__m512i b, __m512i g, __m512i r, int cr, int cg, int cb)
+{
+    __m512i sum = _mm512_add_epi32(_mm512_mullo_epi32(r, _mm512_set1_epi32(cr)),
+                                   _mm512_mullo_epi32(g, _mm512_set1_epi32(cg)));
+    sum = _mm512_add_epi32(sum, _mm512_mullo_epi32(b, _mm512_set1_epi32(cb)));
+    sum = _mm512_add_epi32(sum, _mm512_set1_epi32(128));
+    return _mm512_add_epi32(_mm512_srai_epi32(sum, 8), _mm512_set1_epi32(128));
+}
+
+//!
+//! \brief Add horizontally adjacent lanes of a and b, in pixel order
+//!
+static inline CSC_AVX512 __m512i CscPairSum16(__m512i a, __m512i b)
+{
+    const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+    return _mm512_add_epi32(_mm512_permutex2var_epi32(a, even, b), _mm512_permutex2var_epi32(a, odd, b));
+}
+
+static CSC_AVX512 void CscBgraToYuvRowAVX512(const uint8_t *bgra0, const uint8_t *bgra1, uint8_t *y0, uint8_t *y1,
+                                             uint8_t *u, uint8_t *v, int uvStep, int width)
+{
+    const __m512i mask = _mm512_set1_epi32(0xFF);
+    int x = 0;
+    for (; x + 32 <= width; x += 32)
+    {
+        __m512i sumB[2], sumG[2], sumR[2];
+        for (int half = 0; half < 2; half++)
+        {
+            __m512i p0 = _mm512_loadu_si512(bgra0 + (x + half * 16) * 4);
+            __m512i p1 = _mm512_loadu_si512(bgra1 + (x + half * 16) * 4);
+            __m512i b0 = _mm512_and_si512(p0, mask);
+            __m512i g0 = _mm512_and_si512(_mm512_srli_epi32(p0, 8), mask);
+            __m512i r0 = _mm512_and_si512(_mm512_srli_epi32(p0, 16), mask);
+            __m512i b1 = _mm512_and_si512(p1, mask);
+            __m512i g1 = _mm512_and_si512(_mm512_srli_epi32(p1, 8), mask);
+            __m512i r1 = _mm512_and_si512(_mm512_srli_epi32(p1, 16), mask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y0 + x + half * 16), _mm512_cvtepi32_epi8(CscLuma16(b0, g0, r0)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(y1 + x + half * 16), _mm512_cvtepi32_epi8(CscLuma16(b1, g1, r1)));
+            sumB[half] = _mm512_add_epi32(b0, b1);
+            sumG[half] = _mm512_add_epi32(g0, g1);
+            sumR[half] = _mm512_add_epi32(r0, r1);
+        }
+        const __m512i round = _mm512_set1_epi32(2);
+        __m512i b = _mm512_srli_epi32(_mm512_add_epi32(CscPairSum16(sumB[0], sumB[1]), round), 2);
+        __m512i g = _mm512_srli_epi32(_mm512_add_epi32(CscPairSum16(sumG[0], sumG[1]), round), 2);
+        __m512i r = _mm512_srli_epi32(_mm512_add_epi32(CscPairSum16(sumR[0], sumR[1]), round), 2);
+        // values are in [16, 240], truncation is exact
+        __m128i cu = _mm512_cvtepi32_epi8(CscChroma16(b, g, r, -38, -74, 112));
+        __m128i cv = _mm512_cvtepi32_epi8(CscChroma16(b, g, r, 112, -94, -18));
+        if (uvStep == 2)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x), _mm_unpacklo_epi8(cu, cv));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x + 16), _mm_unpackhi_epi8(cu, cv));
+        }
+        else
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(u + x / 2), cu);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(v + x / 2), cv);
+        }
+    }
+    if (x < width)
+    {
+        g_cscKernelsAVX2.bgraToYuv(bgra0 + x * 4, bgra1 + x * 4, y0 + x, y1 + x,
+                                   u + (x / 2) * uvStep, v + (x / 2) * uvStep, uvStep, width - x);
+    }
+}
+
+static CSC_AVX512 void CscYuvToBgraRowAVX512(const uint8_t *y0, const uint8_t *y1, const uint8_t *u, const uint8_t *v,
+                                             int uvStep, uint8_t *bgra0, uint8_t *bgra1, int width)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i max = _mm512_set1_epi32(255);
+    const __m512i alpha = _mm512_set1_epi32(static_cast<int>(0xFF000000));
+    int x = 0;
+    for (; x + 16 <= width; x += 16)
+    {
+        // duplicate 8 chroma samples to the 16 pixels they cover
+        __m128i cu, cv;
+        if (uvStep == 2)
+        {
+            __m128i uv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x));
+            cu = _mm_shuffle_epi8(uv, _mm_setr_epi8(0, 0, 2, 2, 4, 4, 6, 6, 8, 8, 10, 10, 12, 12, 14, 14));
+            cv = _mm_shuffle_epi8(uv, _mm_setr_epi8(1, 1, 3, 3, 5, 5, 7, 7, 9, 9, 11, 11, 13, 13, 15, 15));
+        }
+        else
+        {
+            const __m128i dup = _mm_setr_epi8(0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+            cu = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(u + x / 2)), dup);
+            cv = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v + x / 2)), dup);
+        }
+        __m512i d = _mm512_sub_epi32(_mm512_cvtepu8_epi32(cu), _mm512_set1_epi32(128));
+        __m512i e = _mm512_sub_epi32(_mm512_cvtepu8_epi32(cv), _mm512_set1_epi32(128));
+        __m512i rv = _mm512_add_epi32(_mm512_mullo_epi32(e, _mm512_set1_epi32(409)), _mm512_set1_epi32(128));
+        __m512i gv = _mm512_add_epi32(_mm512_add_epi32(_mm512_mullo_epi32(d, _mm512_set1_epi32(-100)),
+                                                       _mm512_mullo_epi32(e, _mm512_set1_epi32(-208))),
+                                      _mm512_set1_epi32(128));
+        __m512i bv = _mm512_add_epi32(_mm512_mullo_epi32(d, _mm512_set1_epi32(516)), _mm512_set1_epi32(128));
+
+        const uint8_t *yRow[2] = {y0, y1};
+        uint8_t *bgraRow[2] = {bgra0, bgra1};
+        for (int row = 0; row < 2; row++)
+        {
+            __m512i luma = _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(yRow[row] + x)));
+            __m512i c = _mm512_mullo_epi32(_mm512_sub_epi32(luma, _mm512_set1_epi32(16)), _mm512_set1_epi32(298));
+            __m512i r = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(_mm512_add_epi32(c, rv), 8), zero), max);
+            __m512i g = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(_mm512_add_epi32(c, gv), 8), zero), max);
+            __m512i b = _mm512_min_epi32(_mm512_max_epi32(_mm512_srai_epi32(_mm512_add_epi32(c, bv), 8), zero), max);
+            __m512i pixel = _mm512_or_si512(_mm512_or_si512(b, _mm512_slli_epi32(g, 8)),
+                                            _mm512_or_si512(_mm512_slli_epi32(r, 16), alpha));
+            _mm512_storeu_si512(bgraRow[row] + x * 4, pixel);
+        }
+    }
+    if (x < width)
+    {
+        g_cscKernelsAVX2.yuvToBgra(y0 + x, y1 + x, u + (x / 2) * uvStep, v + (x / 2) * uvStep,
+                                   uvStep, bgra0 + x * 4, bgra1 + x * 4, width - x);
+    }
+}
+
+static void CscSplitUVRowAVX512(const uint8_t *uv, uint8_t *u, uint8_t *v, int chromaWidth)
+{
+    g_cscKernelsAVX2.splitUV(uv, u, v, chromaWidth);
+}
+
+static void CscMergeUVRowAVX512(const uint8_t *u, const uint8_t *v, uint8_t *uv, int chromaWidth)
+{
+    g_cscKernelsAVX2.mergeUV(u, v, uv, chromaWidth);
+}
+
+const CscRowKernels g_cscKernelsAVX512 =
+{
+    CscBgraToYuvRowAVX512,
+    CscYuvToBgraRowAVX512,
+    CscSplitUVRowAVX512,
+    CscMergeUVRowAVX512,
+};
+
+#pragma GCC diagnostic pop
+
+#else
+
+const CscRowKernels g_cscKernelsAVX512 =
+{
+    CscBgraToYuvRowScalar,
+    CscYuvToBgraRowScalar,
+    CscSplitUVRowScalar,
+    CscMergeUVRowScalar,
+};
+
+#endif
+
+VDI_NS_END
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvertKernels.h
+//! \brief Row kernels of the colour space converter. Every instruction set
+//!        computes the same integer BT.601 limited range formulas, so all
+//!        kernels give identical output.
+//! \date 2026-10-17
+//!
+
+#ifndef _COLOR_CONVERT_KERNELS_H_
+#define _COLOR_CONVERT_KERNELS_H_
+
+#include "ColorConvert.h"
+
+VDI_NS_BEGIN
+
+//!
+//! \brief kernels converting two luma rows and the chroma row they share,
+//!        uvStep is 2 for interleaved UV and 1 for planar U and V
+//!
+struct CscRowKernels
+{
+    void (*bgraToYuv)(const uint8_t *bgra0, const uint8_t *bgra1, uint8_t *y0, uint8_t *y1,
+                      uint8_t *u, uint8_t *v, int uvStep, int width);
+    void (*yuvToBgra)(const uint8_t *y0, const uint8_t *y1, const uint8_t *u, const uint8_t *v,
+                      int uvStep, uint8_t *bgra0, uint8_t *bgra1, int width);
+    void (*splitUV)(const uint8_t *uv, uint8_t *u, uint8_t *v, int chromaWidth);
+    void (*mergeUV)(const uint8_t *u, const uint8_t *v, uint8_t *uv, int chromaWidth);
+};
+
+extern const CscRowKernels g_cscKernelsScalar;
+extern const CscRowKernels g_cscKernelsAVX2;
+extern const CscRowKernels g_cscKernelsAVX512;
+
+// BT.601 limited range in 8 bit fixed point
+inline uint8_t CscRgbToY(int r, int g, int b)
+{
+    return static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+inline uint8_t CscRgbToU(int r, int g, int b)
+{
+    return static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+inline uint8_t CscRgbToV(int r, int g, int b)
+{
+    return static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+inline uint8_t CscClamp(int value)
+{
+    return static_cast<uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+inline void CscYuvToBgra(int y, int u, int v, uint8_t *bgra)
+{
+    int c = 298 * (y - 16);
+    int d = u - 128;
+    int e = v - 128;
+    bgra[0] = CscClamp((c + 516 * d + 128) >> 8);
+    bgra[1] = CscClamp((c - 100 * d - 208 * e + 128) >> 8);
+    bgra[2] = CscClamp((c + 409 * e + 128) >> 8);
+    bgra[3] = 255;
+}
+
+//!
+//! \brief Scalar row kernels, also used by the vector kernels for the
+//!        columns left after the last full vector, x offsets are even
+//!
+void CscBgraToYuvRowScalar(const uint8_t *bgra0, const uint8_t *bgra1, uint8_t *y0, uint8_t *y1,
+                           uint8_t *u, uint8_t *v, int uvStep, int width);
+void CscYuvToBgraRowScalar(const uint8_t *y0, const uint8_t *y1, const uint8_t *u, const uint8_t *v,
+                           int uvStep, uint8_t *bgra0, uint8_t *bgra1, int width);
+void CscSplitUVRowScalar(const uint8_t *uv, uint8_t *u, uint8_t *v, int chromaWidth);
+void CscMergeUVRowScalar(const uint8_t *u, const uint8_t *v, uint8_t *uv, int chromaWidth);
+
+VDI_NS_END
+#endif // _COLOR_CONVERT_KERNELS_H_
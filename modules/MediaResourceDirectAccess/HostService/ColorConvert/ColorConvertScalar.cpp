@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvertScalar.cpp
+//! \brief Portable row kernels of the colour space converter
+//! \date 2026-10-17
+//!
+
+#include "ColorConvertKernels.h"
+
+VDI_NS_BEGIN
+
+void CscBgraToYuvRowScalar(const uint8_t *bgra0, const uint8_t *bgra1, uint8_t *y0, uint8_t *y1,
+                           uint8_t *u, uint8_t *v, int uvStep, int width)
+{
+    for (int x = 0; x < width; x += 2)
+    {
+        // odd width, the last chroma sample covers a single column
+        int x1 = (x + 1 < width) ? x + 1 : x;
+        const uint8_t *p00 = bgra0 + x * 4;
+        const uint8_t *p01 = bgra0 + x1 * 4;
+        const uint8_t *p10 = bgra1 + x * 4;
+        const uint8_t *p11 = bgra1 + x1 * 4;
+        y0[x] = CscRgbToY(p00[2], p00[1], p00[0]);
+        y0[x1] = CscRgbToY(p01[2], p01[1], p01[0]);
+        y1[x] = CscRgbToY(p10[2], p10[1], p10[0]);
+        y1[x1] = CscRgbToY(p11[2], p11[1], p11[0]);
+
+        int b = (p00[0] + p01[0] + p10[0] + p11[0] + 2) >> 2;
+        int g = (p00[1] + p01[1] + p10[1] + p11[1] + 2) >> 2;
+        int r = (p00[2] + p01[2] + p10[2] + p11[2] + 2) >> 2;
+        u[(x / 2) * uvStep] = CscRgbToU(r, g, b);
+        v[(x / 2) * uvStep] = CscRgbToV(r, g, b);
+    }
+}
+
+void CscYuvToBgraRowScalar(const uint8_t *y0, const uint8_t *y1, const uint8_t *u, const uint8_t *v,
+                           int uvStep, uint8_t *bgra0, uint8_t *bgra1, int width)
+{
+    for (int x = 0; x < width; x++)
+    {
+        int cu = u[(x / 2) * uvStep];
+        int cv = v[(x / 2) * uvStep];
+        CscYuvToBgra(y0[x], cu, cv, bgra0 + x * 4);
+        CscYuvToBgra(y1[x], cu, cv, bgra1 + x * 4);
+    }
+}
+
+void CscSplitUVRowScalar(const uint8_t *uv, uint8_t *u, uint8_t *v, int chromaWidth)
+{
+    for (int x = 0; x < chromaWidth; x++)
+    {
+        u[x] = uv[2 * x];
+        v[x] = uv[2 * x + 1];
+    }
+}
+
+void CscMergeUVRowScalar(const uint8_t *u, const uint8_t *v, uint8_t *uv, int chromaWidth)
+{
+    for (int x = 0; x < chromaWidth; x++)
+    {
+        uv[2 * x] = u[x];
+        uv[2 * x + 1] = v[x];
+    }
+}
+
+const CscRowKernels g_cscKernelsScalar =
+{
+    CscBgraToYuvRowScalar,
+    CscYuvToBgraRowScalar,
+    CscSplitUVRowScalar,
+    CscMergeUVRowScalar,
+};
+
+VDI_NS_END
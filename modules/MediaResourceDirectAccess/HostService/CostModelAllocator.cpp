@@ -0,0 +1,279 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file CostModelAllocator.cpp
+//! \brief implement the cost model placement engine
+//! \date 2026-10-17
+//!
+
+#include "CostModelAllocator.h"
+#include "HostServiceSelect.h"
+
+#include <algorithm>
+#include <limits>
+
+VDI_NS_BEGIN
+
+constexpr float DECODE_COST_FACTOR = 0.25f; //!< decode cost against an encode of the same stream
+
+//!
+//! \brief Get the cost factor of a codec
+//!
+static float CodecFactor(StreamCodecID codec)
+{
+    switch (codec)
+    {
+    case StreamCodecID::CodecID_HEVC:
+        return 1.5f;
+    case StreamCodecID::CodecID_AV1:
+        return 2.0f;
+    default:
+        return 1.0f;
+    }
+}
+
+//!
+//! \brief Get the cost factor of an encode preset
+//!
+static float TargetUsageFactor(TargetUsage targetUsage)
+{
+    switch (targetUsage)
+    {
+    case TargetUsage::BestQuality:
+        return 1.5f;
+    case TargetUsage::BestSpeed:
+        return 0.7f;
+    default:
+        return 1.0f;
+    }
+}
+
+//!
+//! \brief Get the params a session is assumed to have before it sends them
+//!
+static MediaParams DefaultParams()
+{
+    MediaParams params = {};
+    params.encodeParams.codec_id = StreamCodecID::CodecID_AVC;
+    params.encodeParams.target_usage = TargetUsage::Balanced;
+    params.encodeParams.frame_width = 1920;
+    params.encodeParams.frame_height = 1080;
+    params.encodeParams.framerate_num = 30;
+    params.encodeParams.framerate_den = 1;
+    params.decodeParams.codec_id = StreamCodecID::CodecID_AVC;
+    params.decodeParams.frame_width = 1920;
+    params.decodeParams.frame_height = 1080;
+    params.decodeParams.framerate_num = 30;
+    params.decodeParams.framerate_den = 1;
+    return params;
+}
+
+CostModelAllocatorStrategy::CostModelAllocatorStrategy(const PlacementConfig &config)
+    : m_config(config),
+      m_fixedInventory(false)
+{
+}
+
+void CostModelAllocatorStrategy::SetInventory(const std::vector<DeviceLoad> &devices)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_devices = devices;
+    for (auto &device : m_devices)
+    {
+        device.committed = 0.0f;
+        device.sessionNum = 0;
+    }
+    m_placements.clear();
+    m_fixedInventory = true;
+}
+
+std::vector<DeviceLoad> CostModelAllocatorStrategy::GetInventory()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_devices;
+}
+
+float CostModelAllocatorStrategy::EstimateCost(TASKTYPE taskType, const MediaParams &params)
+{
+    // synthetic sessions load no device, they only exercise the data path
+    if (taskType == TASKTYPE::taskNullEncode) return 0.0f;
+    bool isDecode = IsDecodeTask(taskType);
+    uint32_t width = isDecode ? params.decodeParams.frame_width : params.encodeParams.frame_width;
+    uint32_t height = isDecode ? params.decodeParams.frame_height : params.encodeParams.frame_height;
+    int32_t fpsNum = isDecode ? params.decodeParams.framerate_num : params.encodeParams.framerate_num;
+    int32_t fpsDen = isDecode ? params.decodeParams.framerate_den : params.encodeParams.framerate_den;
+    StreamCodecID codec = isDecode ? params.decodeParams.codec_id : params.encodeParams.codec_id;
+    if (width == 0 || height == 0)
+    {
+        width = 1920;
+        height = 1080;
+    }
+    float fps = (fpsNum > 0 && fpsDen > 0) ? static_cast<float>(fpsNum) / fpsDen : DEFAULT_FRAME_RATE;
+
+    float cost = static_cast<float>(width) * height * fps / COST_UNIT_PIXEL_RATE * CodecFactor(codec);
+    return isDecode ? cost * DECODE_COST_FACTOR : cost * TargetUsageFactor(params.encodeParams.target_usage);
+}
+
+void CostModelAllocatorStrategy::SyncInventory()
+{
+    if (m_fixedInventory) return;
+    // devices stay listed once seen so placements keep their index, a
+    // device gone from telemetry takes no more sessions
+    for (auto &device : m_devices)
+    {
+        if (device.device.deviceType == DeviceType::GPU) device.capacity = 0.0f;
+    }
+    for (auto &gpu : m_gpuUsage)
+    {
+        auto it = std::find_if(m_devices.begin(), m_devices.end(), [&gpu](const DeviceLoad &element) {
+            return element.device.deviceType == DeviceType::GPU && element.device.deviceID == gpu.first; });
+        if (it == m_devices.end())
+        {
+            DeviceLoad device;
+            device.device = {DeviceType::GPU, gpu.first};
+            it = m_devices.insert(m_devices.end(), device);
+        }
+        it->capacity = m_config.gpuCapacity;
+        it->usage = gpu.second;
+    }
+    auto cpu = std::find_if(m_devices.begin(), m_devices.end(), [](const DeviceLoad &element) {
+        return element.device.deviceType == DeviceType::CPU; });
+    if (cpu == m_devices.end())
+    {
+        DeviceLoad device;
+        device.device = {DeviceType::CPU, 0};
+        cpu = m_devices.insert(m_devices.end(), device);
+    }
+    cpu->capacity = m_cpuCores * m_config.cpuCoreCapacity;
+    cpu->usage = m_cpuUsage;
+}
+
+float CostModelAllocatorStrategy::LoadWith(const DeviceLoad &device, float extraCost) const
+{
+    if (device.capacity <= 0.0f) return std::numeric_limits<float>::max();
+    // sessions not ramped up yet only show in the committed load, load of
+    // other tenants only in the measured usage
+    return std::max((device.committed + extraCost) / device.capacity, device.usage / 100.0f);
+}
+
+MRDAStatus CostModelAllocatorStrategy::FindDevice(float cost, size_t &deviceIndex)
+{
+    // GPUs first, the CPU takes what no GPU fits
+    for (int pass = 0; pass < 2; pass++)
+    {
+        bool found = false;
+        float bestLoad = 0.0f;
+        for (size_t i = 0; i < m_devices.size(); i++)
+        {
+            bool isGPU = m_devices[i].device.deviceType == DeviceType::GPU;
+            if (m_config.preferGPU && isGPU != (pass == 0)) continue;
+            float load = LoadWith(m_devices[i], cost);
+            if (load > m_config.maxLoad) continue;
+            bool better = m_config.policy == PlacementPolicy::BEST_FIT ? load > bestLoad : load < bestLoad;
+            if (!found || better)
+            {
+                found = true;
+                bestLoad = load;
+                deviceIndex = i;
+            }
+        }
+        if (found) return MRDA_STATUS_SUCCESS;
+        if (!m_config.preferGPU) break;
+    }
+    return MRDA_STATUS_NOT_READY;
+}
+
+MRDAStatus CostModelAllocatorStrategy::AllocateResource(TaskInfo *taskInfo)
+{
+    if (taskInfo == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid task info");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    SyncInventory();
+    if (m_placements.count(taskInfo->taskID) != 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Task %u is placed already", taskInfo->taskID);
+        return MRDA_STATUS_INVALID_STATE;
+    }
+    float cost = EstimateCost(taskInfo->taskType, DefaultParams());
+    size_t deviceIndex = 0;
+    if (MRDA_STATUS_SUCCESS != FindDevice(cost, deviceIndex))
+    {
+        MRDA_LOG(LOG_ERROR, "No device has room for task %u, cost %.2f", taskInfo->taskID, cost);
+        return MRDA_STATUS_NOT_READY;
+    }
+    DeviceLoad &device = m_devices[deviceIndex];
+    device.committed += cost;
+    device.sessionNum++;
+    m_placements[taskInfo->taskID] = {deviceIndex, taskInfo->taskType, cost};
+    taskInfo->taskDevice = device.device;
+    MRDA_LOG(LOG_INFO, "Place task %u on %s %u, cost %.2f, committed %.2f of %.2f", taskInfo->taskID,
+             device.device.deviceType == DeviceType::GPU ? "gpu" : "cpu", device.device.deviceID,
+             cost, device.committed, device.capacity);
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus CostModelAllocatorStrategy::CommitResource(uint32_t taskId, const MediaParams &params)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_placements.find(taskId);
+    if (it == m_placements.end())
+    {
+        MRDA_LOG(LOG_ERROR, "Task %u is not placed", taskId);
+        return MRDA_STATUS_NOT_FOUND;
+    }
+    Placement &placement = it->second;
+    DeviceLoad &device = m_devices[placement.deviceIndex];
+    float cost = EstimateCost(placement.taskType, params);
+    float extraCost = cost - placement.cost;
+    if (extraCost > 0.0f && LoadWith(device, extraCost) > m_config.maxLoad)
+    {
+        MRDA_LOG(LOG_ERROR, "Task %u does not fit its device, cost %.2f, committed %.2f of %.2f",
+                 taskId, cost, device.committed, device.capacity);
+        return MRDA_STATUS_NOT_READY;
+    }
+    device.committed = std::max(0.0f, device.committed + extraCost);
+    placement.cost = cost;
+    MRDA_LOG(LOG_INFO, "Commit task %u, cost %.2f, committed %.2f of %.2f", taskId, cost, device.committed, device.capacity);
+    return MRDA_STATUS_SUCCESS;
+}
+
+void CostModelAllocatorStrategy::ReleaseResource(uint32_t taskId)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_placements.find(taskId);
+    if (it == m_placements.end()) return;
+    DeviceLoad &device = m_devices[it->second.deviceIndex];
+    device.committed = std::max(0.0f, device.committed - it->second.cost);
+    if (device.sessionNum > 0) device.sessionNum--;
+    m_placements.erase(it);
+}
+
+VDI_NS_END
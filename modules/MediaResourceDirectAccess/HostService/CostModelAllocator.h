@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file CostModelAllocator.h
+//! \brief place sessions by their estimated cost against the load already
+//!        committed to each device, and refuse sessions that do not fit
+//! \date 2026-10-17
+//!
+
+#ifndef _COST_MODEL_ALLOCATOR_H_
+#define _COST_MODEL_ALLOCATOR_H_
+
+#include "ResourceManager.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+VDI_NS_BEGIN
+
+constexpr float COST_UNIT_PIXEL_RATE = 1920.0f * 1080.0f * 30.0f; //!< pixel rate of one cost unit, 1080p30 AVC balanced encode
+constexpr float GPU_CAPACITY_UNITS = 16.0f;      //!< default cost units one GPU takes
+constexpr float CPU_CORE_CAPACITY_UNITS = 0.25f; //!< default cost units per CPU core
+constexpr float DEFAULT_FRAME_RATE = 30.0f;      //!< frame rate of params without one
+
+//!
+//! \brief how a device is chosen among the ones a session fits on
+//!
+enum class PlacementPolicy
+{
+    LEAST_LOADED = 0, //!< spread, the device with the lowest load after placement
+    BEST_FIT          //!< pack, the device with the highest load after placement
+};
+
+//!
+//! \brief placement engine configuration
+//!
+struct PlacementConfig
+{
+    PlacementPolicy policy = PlacementPolicy::LEAST_LOADED; //!< device choice
+    float gpuCapacity = GPU_CAPACITY_UNITS;                 //!< cost units per GPU
+    float cpuCoreCapacity = CPU_CORE_CAPACITY_UNITS;        //!< cost units per CPU core
+    float maxLoad = 1.0f;                                   //!< admitted share of a device capacity
+    bool preferGPU = true;                                  //!< CPU only takes sessions no GPU fits
+};
+
+//!
+//! \brief load of one device
+//!
+struct DeviceLoad
+{
+    HWDevice device = {DeviceType::NONE, 0}; //!< the device
+    float capacity = 0.0f;                   //!< cost units the device takes
+    float committed = 0.0f;                  //!< cost units of the sessions placed on it
+    float usage = 0.0f;                      //!< measured usage in percent
+    uint32_t sessionNum = 0;                 //!< sessions placed on it
+};
+
+class CostModelAllocatorStrategy : public ResourceAllocatorStrategy
+{
+public:
+    //!
+    //! \brief Construct a new Cost Model Allocator Strategy object
+    //!
+    //! \param [in] config
+    //!
+    explicit CostModelAllocatorStrategy(const PlacementConfig &config = PlacementConfig());
+    //!
+    //! \brief Destroy the Cost Model Allocator Strategy object
+    //!
+    virtual ~CostModelAllocatorStrategy() = default;
+
+    //!
+    //! \brief Use a fixed device inventory instead of the telemetry one,
+    //!        for simulated hosts
+    //!
+    //! \param [in] devices
+    //!             capacity and measured usage of each device
+    //!
+    void SetInventory(const std::vector<DeviceLoad> &devices);
+
+    //!
+    //! \brief Get the load of all devices
+    //!
+    //! \return std::vector<DeviceLoad>
+    //!
+    std::vector<DeviceLoad> GetInventory();
+
+    //!
+    //! \brief Estimate the cost of a session in cost units:
+    //!        pixel rate x codec x target usage, decode a quarter of encode
+    //!
+    //! \param [in] taskType
+    //! \param [in] params
+    //! \return float
+    //!
+    static float EstimateCost(TASKTYPE taskType, const MediaParams &params);
+
+    //!
+    //! \brief Place a session with the default cost of its task type, the
+    //!        real cost is committed once its params are known
+    //!
+    //! \param [in/out] taskInfo
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_READY if no device has room
+    //!
+    virtual MRDAStatus AllocateResource(TaskInfo *taskInfo) override;
+
+    //!
+    //! \brief Replace the reserved cost of a session with the one of its params
+    //!
+    //! \param [in] taskId
+    //! \param [in] params
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_READY if the device has no room for it
+    //!
+    virtual MRDAStatus CommitResource(uint32_t taskId, const MediaParams &params) override;
+
+    //!
+    //! \brief Give back the cost of a session
+    //!
+    //! \param [in] taskId
+    //!
+    virtual void ReleaseResource(uint32_t taskId) override;
+
+private:
+    //!
+    //! \brief Session placed on a device
+    //!
+    struct Placement
+    {
+        size_t deviceIndex; //!< index in m_devices
+        TASKTYPE taskType;  //!< task type of the session
+        float cost;         //!< cost units committed
+    };
+
+    //!
+    //! \brief Add the devices of the latest telemetry, lock held
+    //!
+    void SyncInventory();
+
+    //!
+    //! \brief Get the load of a device with extra cost units on it
+    //!
+    //! \param [in] device
+    //! \param [in] extraCost
+    //! \return float
+    //!         share of the capacity, the measured usage if higher
+    //!
+    float LoadWith(const DeviceLoad &device, float extraCost) const;
+
+    //!
+    //! \brief Find the device for a cost with the placement policy, lock held
+    //!
+    //! \param [in] cost
+    //! \param [out] deviceIndex
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_READY if no device has room
+    //!
+    MRDAStatus FindDevice(float cost, size_t &deviceIndex);
+
+private:
+    PlacementConfig m_config; //!< placement engine configuration
+    std::mutex m_mutex; //!< guards the devices and placements
+    bool m_fixedInventory; //!< devices are set by SetInventory
+    std::vector<DeviceLoad> m_devices; //!< load of each device
+    std::map<uint32_t, Placement> m_placements; //!< placed sessions by task id
+};
+
+VDI_NS_END
+#endif // _COST_MODEL_ALLOCATOR_H_
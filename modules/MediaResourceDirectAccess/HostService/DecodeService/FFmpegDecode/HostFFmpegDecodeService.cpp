@@ -42,12 +42,18 @@
 #include <iostream>
 #include <assert.h>
 #include <cstring>
+#include <atomic>
 
 VDI_NS_BEGIN
 
 HostFFmpegDecodeService::HostFFmpegDecodeService(TaskInfo taskInfo)
     :m_avctx(nullptr),
-     m_hwDeviceCtx(nullptr)
+     m_hwDeviceCtx(nullptr),
+     m_outFrame(nullptr),
+     m_downloadFrame(nullptr),
+     m_decFrame(nullptr),
+     m_packet(nullptr),
+     m_swsCtx(nullptr)
 {
     debug_file = fopen("out_host.nv12", "wb");
     m_taskInfo = taskInfo;
@@ -55,10 +61,19 @@ HostFFmpegDecodeService::HostFFmpegDecodeService(TaskInfo taskInfo)
 
 HostFFmpegDecodeService::~HostFFmpegDecodeService()
 {
+    // wake the media thread at once and stop it before its codec goes away
+    m_isStop = true;
+    m_inQueue.Close();
+    if (m_decodeThread.joinable()) m_decodeThread.join();
+
     avcodec_free_context(&m_avctx);
     av_buffer_unref(&m_hwDeviceCtx);
 
-    m_decodeThread.join();
+    av_frame_free(&m_outFrame);
+    av_frame_free(&m_downloadFrame);
+    av_frame_free(&m_decFrame);
+    av_packet_free(&m_packet);
+    sws_freeContext(m_swsCtx);
 
     fclose(debug_file);
 }
@@ -77,6 +92,17 @@ MRDAStatus HostFFmpegDecodeService::Initialize()
         MRDA_LOG(LOG_ERROR, "Failed to init share memory!");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // frames and packet reused by every frame of the session, the decoded
+    // frame, the slot wrapper and the download target
+    m_outFrame = av_frame_alloc();
+    m_downloadFrame = av_frame_alloc();
+    m_decFrame = av_frame_alloc();
+    m_packet = av_packet_alloc();
+    if (m_outFrame == nullptr || m_downloadFrame == nullptr || m_decFrame == nullptr || m_packet == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to allocate output frames!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
     // start decode thread
     m_decodeThread = std::thread(&HostFFmpegDecodeService::DecodeThread, this);
     return MRDA_STATUS_SUCCESS;
@@ -211,6 +237,8 @@ MRDAStatus HostFFmpegDecodeService::InitCodec()
 
 void* HostFFmpegDecodeService::DecodeThread()
 {
+    BindThreadAffinity();
+    ShmFaultCount faultBegin = GetThreadFaults();
     while (!m_isStop)
     {
         // get one packet
@@ -219,14 +247,19 @@ void* HostFFmpegDecodeService::DecodeThread()
         if (m_isEOS == false)
         {
             {
-                if (m_inFrameBufferDataList.empty())
+                // woken by SendInputData, the timeout rechecks the stop flag
+                MRDAStatus st = m_inQueue.Pop(packet, HOST_INPUT_WAIT_MS * 1000);
+                if (MRDA_STATUS_NOT_READY == st)
                 {
-                    usleep(5 * 1000);//5ms
                     continue;
                 }
-                std::unique_lock<std::mutex> lock(m_inMutex);
-                packet = m_inFrameBufferDataList.front();
-                m_inFrameBufferDataList.pop_front();
+                if (MRDA_STATUS_SUCCESS != st)
+                {
+                    // closed without EOS, drain what is in flight
+                    MRDA_LOG(LOG_INFO, "Input queue closed, drain the pipeline");
+                    m_isEOS = true;
+                    continue;
+                }
 #ifdef _ENABLE_TRACE_
                 if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: pop front frame in host decoding service input queue, pts: %lu, in dev path: %s", packet->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
@@ -245,6 +278,7 @@ void* HostFFmpegDecodeService::DecodeThread()
         {
             MRDA_LOG(LOG_ERROR, "DecodeOneFrame failed!");
             m_isStop = true;
+            AccountThreadFaults(faultBegin, m_streamFaults);
             return nullptr;
         }
         else
@@ -253,6 +287,7 @@ void* HostFFmpegDecodeService::DecodeThread()
             UnRefInputFrame(packet);
         }
     }
+    AccountThreadFaults(faultBegin, m_streamFaults);
     return nullptr;
 }
 
@@ -265,40 +300,77 @@ AVPacket* HostFFmpegDecodeService::GetPacketForDecode(std::shared_ptr<FrameBuffe
         return nullptr;
     }
 
-    AVPacket *av_packet = av_packet_alloc();
-    if (packet == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to allocate AVPacket.");
-        return nullptr;
-    }
+    AVPacket *av_packet = m_packet;
+    av_packet_unref(av_packet);
     // packet -> av_packet
     av_packet->stream_index = 0;
     av_packet->pts = packet->Pts();
     av_packet->dts = packet->Pts();
     if (packet->MemBuffer() == nullptr) return nullptr;
     av_packet->size = packet->MemBuffer()->OccupiedSize();
-    size_t base_offset = packet->MemBuffer()->MemOffset();
-    av_packet->data = reinterpret_cast<uint8_t*>(m_inShmMem) + packet->MemBuffer()->MemOffset();
+    size_t base_offset = m_inLayout.MemOffset(packet->MemBuffer()->BufId());
+    av_packet->data = reinterpret_cast<uint8_t*>(m_inShmMem) + base_offset;
 
     return av_packet;
 }
 
+CscFormat HostFFmpegDecodeService::GetCscFormat(AVPixelFormat format)
+{
+    switch (format)
+    {
+        case AVPixelFormat::AV_PIX_FMT_NV12:
+            return CscFormat::CSC_FORMAT_NV12;
+        case AVPixelFormat::AV_PIX_FMT_YUV420P:
+            return CscFormat::CSC_FORMAT_I420;
+        case AVPixelFormat::AV_PIX_FMT_BGRA:
+            return CscFormat::CSC_FORMAT_BGRA;
+        default:
+            return CscFormat::CSC_FORMAT_NONE;
+    }
+}
+
 MRDAStatus HostFFmpegDecodeService::ColorSpaceConvert(AVPixelFormat in_pix_fmt, AVPixelFormat out_pix_fmt, AVFrame *in_frame, AVFrame* out_frame)
 {
-    if (in_frame == nullptr) return MRDA_STATUS_INVALID_DATA;
+    if (in_frame == nullptr || out_frame == nullptr) return MRDA_STATUS_INVALID_DATA;
 
     int width = in_frame->width;
     int height = in_frame->height;
-    struct SwsContext *sws_ctx = sws_getContext(width, height, in_pix_fmt,
-                                                width, height, out_pix_fmt,
-                                                SWS_FAST_BILINEAR, NULL, NULL, NULL);
-    if (!sws_ctx) {
+    CscFormat in_csc = GetCscFormat(in_pix_fmt);
+    CscFormat out_csc = GetCscFormat(out_pix_fmt);
+    if (ColorConvert::IsSupported(in_csc, out_csc))
+    {
+        CscImage src, dst;
+        src.format = in_csc;
+        dst.format = out_csc;
+        src.width = dst.width = width;
+        src.height = dst.height = height;
+        for (int i = 0; i < 3; i++)
+        {
+            src.data[i] = in_frame->data[i];
+            src.linesize[i] = in_frame->linesize[i];
+            dst.data[i] = out_frame->data[i];
+            dst.linesize[i] = out_frame->linesize[i];
+        }
+        // stripes start on even rows so each one owns its chroma rows
+        std::atomic<MRDAStatus> failed{MRDA_STATUS_SUCCESS};
+        HostWorkerPool::Instance().RunStripes(height, GetStripeNum(width, height), 2,
+            [&](uint32_t rowBegin, uint32_t rowEnd) {
+                MRDAStatus status = m_colorConvert.ConvertRows(src, dst, rowBegin, rowEnd);
+                if (MRDA_STATUS_SUCCESS != status) failed = status;
+            });
+        return failed.load();
+    }
+
+    // formats without a kernel, the context is kept for the whole session
+    m_swsCtx = sws_getCachedContext(m_swsCtx, width, height, in_pix_fmt,
+                                    width, height, out_pix_fmt,
+                                    SWS_FAST_BILINEAR, NULL, NULL, NULL);
+    if (!m_swsCtx) {
         MRDA_LOG(LOG_ERROR, "Could not initialize sws context");
         return MRDA_STATUS_OPERATION_FAIL;
     }
 
-    sws_scale(sws_ctx, in_frame->data, in_frame->linesize, 0, height, out_frame->data, out_frame->linesize);
-    sws_freeContext(sws_ctx);
+    sws_scale(m_swsCtx, in_frame->data, in_frame->linesize, 0, height, out_frame->data, out_frame->linesize);
 
     return MRDA_STATUS_SUCCESS;
 }
@@ -317,22 +389,16 @@ MRDAStatus HostFFmpegDecodeService::DecodeOneFrame(AVPacket* packet)
     if (avcodec_send_packet(m_avctx, packet) < 0)
     {
         MRDA_LOG(LOG_ERROR, "avcodec_send_packet failed");
-        av_packet_free(&packet);
+        if (packet != nullptr) av_packet_unref(packet);
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    av_packet_free(&packet);
+    if (packet != nullptr) av_packet_unref(packet);
 
     int ret = 0;
     while (ret >= 0)
     {
-        AVFrame *hw_frame = av_frame_alloc();
-        AVFrame *sw_frame = av_frame_alloc();
-        if (hw_frame == nullptr || sw_frame == nullptr)
-        {
-            MRDA_LOG(LOG_ERROR, "av frame is nullptr");
-            return MRDA_STATUS_INVALID_DATA;
-        }
+        AVFrame *hw_frame = m_decFrame;
         ret = avcodec_receive_frame(m_avctx, hw_frame);
         if (ret == AVERROR(EAGAIN))
         {
@@ -347,15 +413,13 @@ MRDAStatus HostFFmpegDecodeService::DecodeOneFrame(AVPacket* packet)
                 MRDA_LOG(LOG_INFO, "Stop decode thread!!!");
             }
             // MRDA_LOG(LOG_INFO, "avcodec_receive_packet EOF");
-            av_frame_free(&hw_frame);
-            av_frame_free(&sw_frame);
+            av_frame_unref(hw_frame);
             break;
         }
         else if (ret < 0)
         {
             MRDA_LOG(LOG_ERROR, "avcodec_receive_frame failed");
-            av_frame_free(&hw_frame);
-            av_frame_free(&sw_frame);
+            av_frame_unref(hw_frame);
             m_isStop = true;
             return MRDA_STATUS_INVALID_DATA;
         }
@@ -364,15 +428,14 @@ MRDAStatus HostFFmpegDecodeService::DecodeOneFrame(AVPacket* packet)
 #ifdef _ENABLE_TRACE_
             if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: complete avcodec receive frame in FFmpeg decode service, pts: %lu, in dev path: %s", hw_frame->pts, m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-            if ((ret = av_hwframe_transfer_data(sw_frame, hw_frame, 0)) < 0) {
-                MRDA_LOG(LOG_ERROR, "Error transferring the data to system memory");
-                av_frame_free(&hw_frame);
-                av_frame_free(&sw_frame);
+            // the frame is downloaded or converted straight into the output slot
+            if (MRDA_STATUS_SUCCESS != WriteToOutputShareMemoryBuffer(hw_frame))
+            {
+                MRDA_LOG(LOG_ERROR, "Error writing the frame to output share memory");
+                av_frame_unref(hw_frame);
                 return MRDA_STATUS_INVALID_DATA;
             }
-            WriteToOutputShareMemoryBuffer(sw_frame);
-            av_frame_free(&hw_frame);
-            av_frame_free(&sw_frame);
+            av_frame_unref(hw_frame);
             // MRDA_LOG(LOG_INFO, "decode one frame, frameNum = %d", m_frameNum);
             m_frameNum++;
         }
@@ -381,40 +444,111 @@ MRDAStatus HostFFmpegDecodeService::DecodeOneFrame(AVPacket* packet)
     return MRDA_STATUS_SUCCESS;
 }
 
-MRDAStatus HostFFmpegDecodeService::CopyFrameToMemory(AVFrame* frame, std::shared_ptr<FrameBufferData> data)
+static void NoopFreeShmBuffer(void *opaque, uint8_t *data)
+{
+    // slot lifetime follows the buffer state protocol, not the AVBuffer
+}
+
+MRDAStatus HostFFmpegDecodeService::WrapOutputBuffer(std::shared_ptr<FrameBufferData> data, AVPixelFormat format,
+                                                     int width, int height, AVFrame* out_frame)
 {
-    if (frame == nullptr || data == nullptr)
+    if (data == nullptr || data->MemBuffer() == nullptr || out_frame == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "frame memory copy input is empty");
+        MRDA_LOG(LOG_ERROR, "frame memory wrap input is empty");
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    if (data->MemBuffer() == nullptr)
+    int out_frame_size = av_image_get_buffer_size(format, width, height, 1);
+    if (out_frame_size < 0 || static_cast<uint64_t>(out_frame_size) > data->MemBuffer()->Size())
     {
-        MRDA_LOG(LOG_ERROR, "data->MemBuffer() is nullptr");
+        MRDA_LOG(LOG_ERROR, "frame size %d exceeds output buffer size", out_frame_size);
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    size_t mem_offset = data->MemBuffer()->MemOffset();
+    uint8_t *slot = reinterpret_cast<uint8_t*>(m_outShmMem) + data->MemBuffer()->MemOffset();
+    // the guest reads planes tightly packed, so lay them out with alignment 1
+    if (av_image_fill_arrays(out_frame->data, out_frame->linesize, slot, format, width, height, 1) < 0)
+    {
+        MRDA_LOG(LOG_ERROR, "av_image_fill_arrays failed");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    // a non null buf[0] makes av_hwframe_transfer_data write into the slot
+    // instead of allocating a frame of its own
+    out_frame->buf[0] = av_buffer_create(slot, out_frame_size, NoopFreeShmBuffer, nullptr, 0);
+    if (out_frame->buf[0] == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to wrap output buffer");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    out_frame->format = format;
+    out_frame->width = width;
+    out_frame->height = height;
 
-    int width = frame->width;
-    int height = frame->height;
-    size_t out_frame_size = av_image_get_buffer_size((AVPixelFormat)frame->format, frame->width,
-                                        frame->height, 1);
+    data->MemBuffer()->SetOccupiedSize(out_frame_size);
+    data->MemBuffer()->SetPitch(out_frame->linesize[0]);
+    return MRDA_STATUS_SUCCESS;
+}
 
-    int ret = av_image_copy_to_buffer((uint8_t*)m_outShmMem + mem_offset, out_frame_size,
-                                      (const uint8_t * const *)frame->data,
-                                      (const int *)frame->linesize, (AVPixelFormat)frame->format,
-                                      frame->width, frame->height, 1);
-    if (ret < 0)
+MRDAStatus HostFFmpegDecodeService::DownloadFrame(AVFrame* hw_frame, AVPixelFormat sw_format)
+{
+    // keep the download target across frames, only reallocate on a new geometry
+    if (m_downloadFrame->buf[0] == nullptr || m_downloadFrame->format != sw_format
+        || m_downloadFrame->width != hw_frame->width || m_downloadFrame->height != hw_frame->height)
+    {
+        av_frame_unref(m_downloadFrame);
+        m_downloadFrame->format = sw_format;
+        m_downloadFrame->width = hw_frame->width;
+        m_downloadFrame->height = hw_frame->height;
+        if (av_frame_get_buffer(m_downloadFrame, 0) < 0)
+        {
+            MRDA_LOG(LOG_ERROR, "Failed to allocate download frame.");
+            av_frame_unref(m_downloadFrame);
+            return MRDA_STATUS_INVALID_DATA;
+        }
+    }
+    if (av_hwframe_transfer_data(m_downloadFrame, hw_frame, 0) < 0)
     {
-        MRDA_LOG(LOG_ERROR, "av_image_copy_to_buffer failed");
+        MRDA_LOG(LOG_ERROR, "Error transferring the data to system memory");
         return MRDA_STATUS_INVALID_DATA;
     }
+    return MRDA_STATUS_SUCCESS;
+}
 
-    data->MemBuffer()->SetOccupiedSize(out_frame_size);
-    // debug
-    fwrite(m_outShmMem + mem_offset, 1, out_frame_size, debug_file);
+MRDAStatus HostFFmpegDecodeService::FillOutputFrame(AVFrame* frame, AVPixelFormat out_pix_fmt)
+{
+    bool is_hw_frame = frame->hw_frames_ctx != nullptr;
+    AVPixelFormat src_fmt = is_hw_frame
+        ? reinterpret_cast<AVHWFramesContext*>(frame->hw_frames_ctx->data)->sw_format
+        : static_cast<AVPixelFormat>(frame->format);
+
+    // hardware frame in the output format, download once straight into the slot
+    if (is_hw_frame && src_fmt == out_pix_fmt)
+    {
+        if (av_hwframe_transfer_data(m_outFrame, frame, 0) < 0)
+        {
+            MRDA_LOG(LOG_ERROR, "Error transferring the data to share memory");
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        return MRDA_STATUS_SUCCESS;
+    }
+
+    AVFrame *src_frame = frame;
+    if (is_hw_frame)
+    {
+        if (MRDA_STATUS_SUCCESS != DownloadFrame(frame, src_fmt))
+        {
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        src_frame = m_downloadFrame;
+    }
+
+    // convert or copy with the slot as the destination, every output format
+    // has a converter kernel, so same format frames are striped copies
+    if (MRDA_STATUS_SUCCESS != ColorSpaceConvert(src_fmt, out_pix_fmt, src_frame, m_outFrame))
+    {
+        MRDA_LOG(LOG_ERROR, "ColorSpaceConvert failed");
+        return MRDA_STATUS_INVALID_DATA;
+    }
     return MRDA_STATUS_SUCCESS;
 }
 
@@ -426,13 +560,20 @@ MRDAStatus HostFFmpegDecodeService::WriteToOutputShareMemoryBuffer(AVFrame* fram
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    if (m_outShmMem == nullptr)
+    if (m_outShmMem == nullptr || m_outFrame == nullptr || m_mediaParams == nullptr)
     {
         MRDA_LOG(LOG_ERROR, "m_outShmMem is nullptr");
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    // Get one available buffer frame from output memory pool
+    AVPixelFormat out_pix_fmt = GetColorFormat(m_mediaParams->decodeParams.color_format);
+    if (out_pix_fmt == AV_PIX_FMT_NONE)
+    {
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    // Get one available buffer frame from output memory pool first, so the
+    // frame lands in guest visible memory without an intermediate copy
     std::shared_ptr<FrameBufferData> data = nullptr;
     if (MRDA_STATUS_SUCCESS != GetAvailableOutputBufferFrame(data))
     {
@@ -444,59 +585,28 @@ MRDAStatus HostFFmpegDecodeService::WriteToOutputShareMemoryBuffer(AVFrame* fram
         MRDA_LOG(LOG_ERROR, "data is null\n");
         return MRDA_STATUS_INVALID_DATA;
     }
-    // write to out share memory
-    if (m_mediaParams == nullptr) return MRDA_STATUS_INVALID_DATA;
-
-    AVPixelFormat out_pix_fmt = GetColorFormat(m_mediaParams->decodeParams.color_format);
-
-    AVFrame *out_frame = nullptr;
-    bool out_frame_alloc = false;
-    // No need to CSC
-    if (out_pix_fmt == (AVPixelFormat)frame->format)
-    {
-        out_frame = frame;
-    }
-    // Do CSC
-    else {
-        out_frame = av_frame_alloc();
-        if (out_frame == nullptr) return MRDA_STATUS_INVALID_DATA;
-        out_frame_alloc = true;
-        out_frame->format = out_pix_fmt;
-        out_frame->width = frame->width;
-        out_frame->height = frame->height;
-        size_t out_frame_size = av_image_get_buffer_size(out_pix_fmt, frame->width, frame->height, 1);
-        // allocate new buffer for video
-        if (av_frame_get_buffer(out_frame, 0) < 0)
-        {
-            MRDA_LOG(LOG_ERROR, "Failed to allocate frame data.");
-            av_frame_free(&out_frame);
-            return MRDA_STATUS_INVALID_DATA;
-        }
 
-        if (MRDA_STATUS_SUCCESS != ColorSpaceConvert((AVPixelFormat)frame->format, out_pix_fmt, frame, out_frame))
-        {
-            MRDA_LOG(LOG_ERROR, "ColorSpaceConvert failed");
-            av_frame_free(&out_frame);
-            return MRDA_STATUS_INVALID_DATA;
-        }
+    MRDAStatus status = WrapOutputBuffer(data, out_pix_fmt, frame->width, frame->height, m_outFrame);
+    if (MRDA_STATUS_SUCCESS == status)
+    {
+        status = FillOutputFrame(frame, out_pix_fmt);
     }
-    RefOutputFrame(data);
-
-    // Copy output frame -> data (m_outShmMem)
-    if (MRDA_STATUS_SUCCESS != CopyFrameToMemory(out_frame, data))
+    av_frame_unref(m_outFrame);
+    if (MRDA_STATUS_SUCCESS != status)
     {
-        MRDA_LOG(LOG_ERROR, "CopyFrameToMemory failed");
-        if (out_frame_alloc) av_frame_free(&out_frame);
-        return MRDA_STATUS_INVALID_DATA;
+        DropOutputFrame(data);
+        return status;
     }
 
-    if (out_frame_alloc) av_frame_free(&out_frame);
+    RefOutputFrame(data);
+    // debug
+    fwrite(m_outShmMem + data->MemBuffer()->MemOffset(), 1, data->MemBuffer()->OccupiedSize(), debug_file);
+
     // update output buffer list
 #ifdef _ENABLE_TRACE_
     if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: push back frame in host decoding service output queue, pts: %lu, in dev path: %s", data->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-    std::unique_lock<std::mutex> lock(m_outMutex);
-    m_outFrameBufferDataList.push_back(data);
+    m_outQueue.Push(data);
     // MRDA_LOG(LOG_INFO, "Push back output buffer at pts %llu", data->Pts());
 
     return MRDA_STATUS_SUCCESS;
@@ -38,6 +38,7 @@
 
 #include "../HostDecodeService.h"
 #include "UtilFFmpeg.h"
+#include "../../ColorConvert/ColorConvert.h"
 
 VDI_NS_BEGIN
 
@@ -60,21 +61,21 @@ public:
     //!
     virtual MRDAStatus Initialize();
 
-private:
+protected:
 
     //!
     //! \brief initialize ffmpeg encoding context
     //!
     //! \return MRDAStatus
     //!
-    MRDAStatus InitCodec();
+    virtual MRDAStatus InitCodec();
 
     //!
     //! \brief Set ffmpeg encoding parameters
     //!
     //! \return MRDAStatus
     //!
-    MRDAStatus SetDecParams();
+    virtual MRDAStatus SetDecParams();
 
     //!
     //! \brief Get codec id for ffmpeg Decode
@@ -113,7 +114,17 @@ private:
     AVPacket* GetPacketForDecode(std::shared_ptr<FrameBufferData> packet);
 
     //!
-    //! \brief Color space convert from AVFrame -> AVFrame
+    //! \brief Get the converter format of a pixel format
+    //!
+    //! \param [in] format
+    //! \return CscFormat
+    //!         CSC_FORMAT_NONE if the converter has no kernel for it
+    //!
+    CscFormat GetCscFormat(AVPixelFormat format);
+
+    //!
+    //! \brief Color space convert from AVFrame -> AVFrame, with the SIMD
+    //!        converter when it handles the formats, else with swscale
     //!
     //! \param [in] in_pix_fmt
     //! \param [in] out_pix_fmt
@@ -140,17 +151,50 @@ private:
     MRDAStatus WriteToOutputShareMemoryBuffer(AVFrame* frame);
 
     //!
-    //! \brief Copy frame to memory
+    //! \brief Wrap an output share memory buffer as the planes of an AVFrame
     //!
-    //! \param [in] AVFrame
-    //! \param [in] FrameBufferData
+    //! \param [in] data
+    //!             acquired output buffer
+    //! \param [in] format
+    //! \param [in] width
+    //! \param [in] height
+    //! \param [out] out_frame
+    //!             frame whose planes point into the buffer
+    //! \return MRDAStatus
+    //!
+    MRDAStatus WrapOutputBuffer(std::shared_ptr<FrameBufferData> data, AVPixelFormat format,
+                                int width, int height, AVFrame* out_frame);
+
+    //!
+    //! \brief Download a hardware frame into the reused download frame
+    //!
+    //! \param [in] hw_frame
+    //! \param [in] sw_format
+    //!             software format of the hardware frames
+    //! \return MRDAStatus
+    //!
+    MRDAStatus DownloadFrame(AVFrame* hw_frame, AVPixelFormat sw_format);
+
+    //!
+    //! \brief Fill the wrapped output frame from a decoded frame, with a
+    //!        direct download, a single copy or a conversion into the slot
+    //!
+    //! \param [in] frame
+    //!             decoded hardware or software frame
+    //! \param [in] out_pix_fmt
     //! \return MRDAStatus
     //!
-    MRDAStatus CopyFrameToMemory(AVFrame* frame, std::shared_ptr<FrameBufferData> data);
+    MRDAStatus FillOutputFrame(AVFrame* frame, AVPixelFormat out_pix_fmt);
 
-private: //AV related
+protected: //AV related
     AVCodecContext       *m_avctx;     //!< AV codec context
     AVBufferRef    *m_hwDeviceCtx;     //!< hardware device context
+    AVFrame           *m_outFrame;     //!< wrapper of the current output slot
+    AVFrame      *m_downloadFrame;     //!< reused download target when a conversion follows
+    AVFrame           *m_decFrame;     //!< reused frame received from the decoder
+    AVPacket            *m_packet;     //!< reused packet sent to the decoder
+    struct SwsContext   *m_swsCtx;     //!< cached swscale context of the session
+    ColorConvert  m_colorConvert;      //!< colour space converter of the session
     TaskInfo           m_taskInfo;     //!< task info
 };
 
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostFFmpegSWDecodeService.cpp
+//! \brief implement host FFmpeg software decode service
+//! \date 2026-10-17
+//!
+
+#ifdef _FFMPEG_SUPPORT_
+
+#include "HostFFmpegSWDecodeService.h"
+
+#include <string>
+#include <thread>
+
+VDI_NS_BEGIN
+
+HostFFmpegSWDecodeService::HostFFmpegSWDecodeService(TaskInfo taskInfo)
+    :HostFFmpegDecodeService(taskInfo)
+{
+}
+
+const AVCodec* HostFFmpegSWDecodeService::FindDecoder(AVCodecID codecId)
+{
+    if (codecId == AV_CODEC_ID_AV1)
+    {
+        const AVCodec *dav1d = avcodec_find_decoder_by_name("libdav1d");
+        if (dav1d != nullptr) return dav1d;
+    }
+    return avcodec_find_decoder(codecId);
+}
+
+MRDAStatus HostFFmpegSWDecodeService::SetDecParams()
+{
+    MRDAStatus status = HostFFmpegDecodeService::SetDecParams();
+    if (MRDA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+    // the decoder picks its own software format
+    m_avctx->pix_fmt = AV_PIX_FMT_NONE;
+
+    SWDecodeThreading threading;
+    if (MRDA_STATUS_SUCCESS != GetSWDecodeThreading(m_mediaParams->decodeParams, std::thread::hardware_concurrency(), threading))
+    {
+        MRDA_LOG(LOG_ERROR, "Unknown decode thread mode!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    m_avctx->thread_count = threading.threadNum;
+    m_avctx->thread_type = (threading.frameThreads ? FF_THREAD_FRAME : 0) | (threading.sliceThreads ? FF_THREAD_SLICE : 0);
+    if (threading.lowDelay)
+    {
+        m_avctx->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus HostFFmpegSWDecodeService::InitCodec()
+{
+    if (m_mediaParams == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Media params empty!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    AVCodecID codecId = GetCodecId(m_mediaParams->decodeParams.codec_id);
+    const AVCodec *decoder = codecId != AV_CODEC_ID_NONE ? FindDecoder(codecId) : nullptr;
+    if (decoder == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to find software decoder for codec ID %d", codecId);
+        return MRDA_STATUS_NOT_SUPPORTED;
+    }
+
+    // allocated for the decoder so its private options can be set
+    m_avctx = avcodec_alloc_context3(decoder);
+    if (m_avctx == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to allocate memory for codec context");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    if (MRDA_STATUS_SUCCESS != SetDecParams())
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to set codec params");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    if (std::string(decoder->name) == "libdav1d" && (m_avctx->flags & AV_CODEC_FLAG_LOW_DELAY))
+    {
+        // dav1d threads over tiles and frames by itself, bound its frame delay
+        int ret = av_opt_set(m_avctx->priv_data, "max_frame_delay", "1", 0);
+        if (ret < 0)
+        {
+            char err[AV_ERROR_MAX_STRING_SIZE] = {0};
+            av_strerror(ret, err, sizeof(err));
+            MRDA_LOG(LOG_ERROR, "Failed to set decoder option max_frame_delay: %s", err);
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+    }
+
+    if (avcodec_open2(m_avctx, decoder, NULL) < 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to open codec for decoder");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+
+    MRDA_LOG(LOG_INFO, "Software decoder %s, %d threads, thread mode %d", decoder->name,
+        m_avctx->thread_count, static_cast<int32_t>(m_mediaParams->decodeParams.thread_mode));
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
+
+#endif // _FFMPEG_SUPPORT_
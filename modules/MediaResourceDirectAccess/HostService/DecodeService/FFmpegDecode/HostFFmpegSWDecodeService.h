@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostFFmpegSWDecodeService.h
+//! \brief host decode service on the FFmpeg software decoders, serves
+//!        sessions placed on the CPU
+//! \date 2026-10-17
+//!
+
+#ifdef _FFMPEG_SUPPORT_
+
+#ifndef _HOSTFFMPEGSWDECODESERVICE_H_
+#define _HOSTFFMPEGSWDECODESERVICE_H_
+
+#include "HostFFmpegDecodeService.h"
+#include "SWDecodeThreading.h"
+
+VDI_NS_BEGIN
+
+class HostFFmpegSWDecodeService : public HostFFmpegDecodeService
+{
+public:
+    //!
+    //! \brief Construct a new Host FFmpeg SW Decode Service object
+    //!
+    HostFFmpegSWDecodeService(TaskInfo taskInfo);
+    //!
+    //! \brief Destroy the Host FFmpeg SW Decode Service object
+    //!
+    virtual ~HostFFmpegSWDecodeService() = default;
+
+protected:
+    //!
+    //! \brief initialize the software decoder, no device is opened
+    //!
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus InitCodec() override;
+
+    //!
+    //! \brief Set decoding parameters and the threading of the session
+    //!
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus SetDecParams() override;
+
+private:
+    //!
+    //! \brief Find the software decoder of a codec, AV1 needs libdav1d as
+    //!        the native decoder only runs on hardware
+    //!
+    //! \param [in] codecId
+    //! \return const AVCodec*
+    //!
+    const AVCodec* FindDecoder(AVCodecID codecId);
+};
+
+VDI_NS_END
+#endif // _HOSTFFMPEGSWDECODESERVICE_H_
+
+#endif // _FFMPEG_SUPPORT_
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file SWDecodeThreading.h
+//! \brief map the decode parameters of a session to the threading of an
+//!        FFmpeg software decoder, without FFmpeg itself
+//! \date 2026-10-17
+//!
+
+#ifndef _SWDECODETHREADING_H_
+#define _SWDECODETHREADING_H_
+
+#include "../../../utils/common.h"
+
+#include <algorithm>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t SW_DECODE_PIXELS_PER_THREAD = 1920 * 1088 / 4; //!< pixels per decode thread when picked by resolution
+
+//!
+//! \brief threading of a software decoder
+//!
+struct SWDecodeThreading
+{
+    int threadNum = 1;          //!< decode threads
+    bool frameThreads = false;  //!< frame threads allowed, one frame of delay each
+    bool sliceThreads = false;  //!< slice threads allowed
+    bool lowDelay = false;      //!< no frames held back for reordering
+};
+
+//!
+//! \brief Get the threading of a session's software decoder
+//!
+//! \param [in] decodeParams
+//! \param [in] cores
+//!             cpus of the host, the thread number never exceeds it
+//! \param [out] threading
+//! \return MRDAStatus
+//!         MRDA_STATUS_INVALID_DATA for an unknown thread mode
+//!
+inline MRDAStatus GetSWDecodeThreading(const DecodeParams &decodeParams, uint32_t cores, SWDecodeThreading &threading)
+{
+    threading = SWDecodeThreading();
+    cores = std::max(cores, 1u);
+    if (decodeParams.thread_num > 0)
+    {
+        threading.threadNum = static_cast<int>(std::min(decodeParams.thread_num, cores));
+    }
+    else
+    {
+        uint64_t pixels = static_cast<uint64_t>(decodeParams.frame_width) * decodeParams.frame_height;
+        uint64_t threadNum = (pixels + SW_DECODE_PIXELS_PER_THREAD - 1) / SW_DECODE_PIXELS_PER_THREAD;
+        threading.threadNum = static_cast<int>(std::min<uint64_t>(std::max<uint64_t>(threadNum, 1), cores));
+    }
+    switch (decodeParams.thread_mode)
+    {
+    case DecodeThreadMode::DECODE_THREAD_AUTO:
+        threading.frameThreads = true;
+        threading.sliceThreads = true;
+        break;
+    case DecodeThreadMode::DECODE_THREAD_FRAME:
+        threading.frameThreads = true;
+        break;
+    case DecodeThreadMode::DECODE_THREAD_SLICE:
+        // low delay also keeps the decoder from holding frames for reordering
+        threading.sliceThreads = true;
+        threading.lowDelay = true;
+        break;
+    default:
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
+#endif // _SWDECODETHREADING_H_
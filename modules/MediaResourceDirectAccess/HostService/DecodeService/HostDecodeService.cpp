@@ -40,18 +40,18 @@ HostDecodeService::HostDecodeService()
     m_isStop = false;
     m_isEOS = false;
     m_frameNum = 0;
-    m_inFrameBufferDataList.clear();
-    m_outFrameBufferDataList.clear();
 }
 
 HostDecodeService::~HostDecodeService()
 {
+    ReportShmFaults();
+    ReportHotAllocs(m_frameNum);
     if (m_inShmMem != MAP_FAILED) munmap(m_inShmMem, m_inShmSize);
     if (m_outShmMem != MAP_FAILED) munmap(m_outShmMem, m_outShmSize);
     if (m_inShmFile >= 0) close(m_inShmFile);
     if (m_outShmFile >= 0) close(m_outShmFile);
-    m_inFrameBufferDataList.clear();
-    m_outFrameBufferDataList.clear();
+    m_inQueue.Reset();
+    m_outQueue.Reset();
 }
 
 MRDAStatus HostDecodeService::SetInitParams(MediaParams *params)
@@ -64,6 +64,8 @@ MRDAStatus HostDecodeService::SetInitParams(MediaParams *params)
     m_mediaParams = std::make_unique<MediaParams>();
     m_mediaParams->decodeParams = params->decodeParams;
     m_mediaParams->shareMemoryInfo = params->shareMemoryInfo;
+    // the guest never has more input buffers in flight, plus the EOS frame
+    m_inQueue.SetCapacity(params->shareMemoryInfo.bufferNum + 1);
 
     return MRDA_STATUS_SUCCESS;
 }
@@ -89,44 +91,77 @@ MRDAStatus HostDecodeService::InitShm()
         MRDA_LOG(LOG_ERROR, "Failed to get out shm file ptr!");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // the media thread starts after this and binds to the chosen node
+    ResolveAffinity();
+    if (m_outLayout.IsByteRing())
+    {
+        MRDA_LOG(LOG_ERROR, "Decoded frames need fixed size output buffers!");
+        return MRDA_STATUS_NOT_SUPPORTED;
+    }
 
     return MRDA_STATUS_SUCCESS;
 }
 
 MRDAStatus HostDecodeService::SendInputData(std::shared_ptr<FrameBufferData> data)
 {
-    std::unique_lock<std::mutex> lock(m_inMutex);
-    if (data == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Input data is null!");
-        return MRDA_STATUS_INVALID_DATA;
-    }
+    // offsets and size come from the input layout, never from the guest
+    MRDAStatus st = CheckInputFrame(data);
+    if (MRDA_STATUS_SUCCESS != st) return st;
 #ifdef _ENABLE_TRACE_
     if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: push back frame in host decoding service input queue, pts: %lu, in dev path: %s", data->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-    m_inFrameBufferDataList.push_back(data);
-    // MRDA_LOG(LOG_INFO, "Input frame data size is %d", m_inFrameBufferDataList.size());
+    // only blocks when the guest exceeds its input buffers
+    if (MRDA_STATUS_SUCCESS != m_inQueue.Push(data))
+    {
+        MRDA_LOG(LOG_ERROR, "Input queue is closed!");
+        return MRDA_STATUS_INVALID_STATE;
+    }
     return MRDA_STATUS_SUCCESS;
 }
 
+MRDAStatus HostDecodeService::TrySendInputData(std::shared_ptr<FrameBufferData> data)
+{
+    MRDAStatus st = CheckInputFrame(data);
+    if (MRDA_STATUS_SUCCESS != st) return st;
+    st = m_inQueue.Push(data, 0);
+    if (MRDA_STATUS_INVALID_STATE == st)
+    {
+        MRDA_LOG(LOG_ERROR, "Input queue is closed!");
+    }
+    return st;
+}
+
+void HostDecodeService::SetInputListener(std::function<void()> listener)
+{
+    m_inQueue.SetPopListener(std::move(listener));
+}
+
 MRDAStatus HostDecodeService::ReceiveOutputData(std::shared_ptr<FrameBufferData> &data)
 {
-    std::unique_lock<std::mutex> lock(m_outMutex);
-    if (m_outFrameBufferDataList.empty())
+    if (MRDA_STATUS_SUCCESS != m_outQueue.Pop(data, HOST_OUTPUT_WAIT_MS * 1000))
     {
         // MRDA_LOG(LOG_INFO, "Output data list is empty!");
         return MRDA_STATUS_NOT_ENOUGH_DATA;
     }
-    data = m_outFrameBufferDataList.front();
-    m_outFrameBufferDataList.pop_front();
 #ifdef _ENABLE_TRACE_
     if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: pop front frame in host decoding service output queue, pts: %lu, in dev path: %s", data->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-    // MRDA_LOG(LOG_INFO, "Output frame data size is %d, pts %llu", m_outFrameBufferDataList.size(), data->Pts());
     return MRDA_STATUS_SUCCESS;
 }
 
+MRDAStatus HostDecodeService::TryReceiveOutputData(std::shared_ptr<FrameBufferData> &data)
+{
+    if (MRDA_STATUS_SUCCESS != m_outQueue.Pop(data, 0))
+    {
+        return MRDA_STATUS_NOT_ENOUGH_DATA;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
 
+void HostDecodeService::SetOutputListener(std::function<void()> listener)
+{
+    m_outQueue.SetPushListener(std::move(listener));
+}
 
 MRDAStatus HostDecodeService::GetAvailableOutputBufferFrame(std::shared_ptr<FrameBufferData>& pFrame)
 {
@@ -134,10 +169,23 @@ MRDAStatus HostDecodeService::GetAvailableOutputBufferFrame(std::shared_ptr<Fram
     bool isBufferAvailable = false;
     while (!isBufferAvailable)
     {
-        if (MRDA_STATUS_SUCCESS != GetAvailBuffer(pFrame))
+        // a guest that stopped releasing buffers must not hold the media thread
+        if (m_isStop)
+        {
+            MRDA_LOG(LOG_ERROR, "Service stopped while waiting for an output buffer!");
+            return MRDA_STATUS_INVALID_STATE;
+        }
+        // read the sequence first so a release right after the check still wakes us
+        uint32_t releaseSeq = m_outBufIndex.ReleaseSequence();
+        MRDAStatus status = GetAvailBuffer(pFrame);
+        if (MRDA_STATUS_NOT_READY != status && MRDA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+        if (MRDA_STATUS_SUCCESS != status)
         {
             // MRDA_LOG(LOG_INFO, "GetAvailBuffer failed\n");
-            usleep(5 * 1000);
+            m_outBufIndex.WaitRelease(releaseSeq, SHM_DOORBELL_WAIT_US);
             continue;
         }
         isBufferAvailable = true;
@@ -152,35 +200,29 @@ MRDAStatus HostDecodeService::GetAvailBuffer(std::shared_ptr<FrameBufferData>& p
         MRDA_LOG(LOG_ERROR, "Media params or out shm mem invalid!");
         return MRDA_STATUS_INVALID_DATA;
     }
-    uint32_t bufferNum = m_mediaParams->shareMemoryInfo.bufferNum;
-    uint64_t bufferSize = m_mediaParams->shareMemoryInfo.bufferSize;
-    for (uint32_t i = 1; i <= bufferNum; i++)
+    // take one idle buffer from the shared index
+    uint32_t bufId = 0;
+    if (MRDA_STATUS_SUCCESS != m_outBufIndex.Acquire(bufId))
     {
-        size_t state_offset = (i - 1) * bufferSize;
-        BufferState state = BufferState::BUFFER_STATE_NONE;
-        memcpy(&state, m_outShmMem + state_offset, sizeof(uint32_t));
-        // find an available frame
-        if (state == BufferState::BUFFER_STATE_IDLE)
-        {
-            std::shared_ptr<MemoryBuffer> memBuffer = std::make_shared<MemoryBuffer>();
-            memBuffer->SetBufId(i);
-            memBuffer->SetMemOffset(state_offset + sizeof(uint32_t));
-            memBuffer->SetStateOffset(state_offset);
-            memBuffer->SetBufPtr(nullptr);
-            memBuffer->SetSize(bufferSize);
-            memBuffer->SetOccupiedSize(0);
-            memBuffer->SetState(state);
-            pFrame = std::make_shared<FrameBufferData>();
-            pFrame->SetWidth(m_mediaParams->decodeParams.frame_width);
-            pFrame->SetHeight(m_mediaParams->decodeParams.frame_height);
-            pFrame->SetStreamType(InputStreamType::ENCODED);
-            pFrame->SetPts(m_frameNum);
-            pFrame->SetEOS(m_isEOS);
-            pFrame->SetMemBuffer(memBuffer);
-            return MRDA_STATUS_SUCCESS;
-        }
+        return MRDA_STATUS_NOT_READY;
     }
-    return MRDA_STATUS_INVALID_DATA;
+    // frame and memory buffer are recycled from the session pool
+    pFrame = GetOutputFrameData();
+    std::shared_ptr<MemoryBuffer> memBuffer = pFrame->MemBuffer();
+    memBuffer->SetBufId(bufId);
+    memBuffer->SetMemOffset(m_outLayout.MemOffset(bufId));
+    memBuffer->SetStateOffset(m_outLayout.StateOffset(bufId));
+    memBuffer->SetBufPtr(nullptr);
+    memBuffer->SetSize(m_outLayout.slotSize);
+    memBuffer->SetOccupiedSize(0);
+    memBuffer->SetState(BufferState::BUFFER_STATE_IDLE);
+    memBuffer->SetPitch(0);
+    pFrame->SetWidth(m_mediaParams->decodeParams.frame_width);
+    pFrame->SetHeight(m_mediaParams->decodeParams.frame_height);
+    pFrame->SetStreamType(InputStreamType::ENCODED);
+    pFrame->SetPts(m_frameNum);
+    pFrame->SetEOS(m_isEOS);
+    return MRDA_STATUS_SUCCESS;
 }
 
 VDI_NS_END
@@ -35,9 +35,9 @@
 #define _HOSTDECODESERVICE_H_
 
 #include "../HostService.h"
+#include "../../utils/BlockingQueue.h"
 #include <thread>
 #include <mutex>
-#include <list>
 #include <map>
 #include <unistd.h>
 
@@ -75,12 +75,38 @@ public:
     //!
     virtual MRDAStatus SendInputData(std::shared_ptr<FrameBufferData> data) override;
     //!
+    //! \brief Send input data without waiting
+    //!
+    //! \param [in] data
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus TrySendInputData(std::shared_ptr<FrameBufferData> data) override;
+    //!
+    //! \brief Set the listener of input data leaving the input queue
+    //!
+    //! \param [in] listener
+    //!
+    virtual void SetInputListener(std::function<void()> listener) override;
+    //!
     //! \brief Receive output data
     //!
     //! \param [out] data
     //! \return MRDAStatus
     //!
     virtual MRDAStatus ReceiveOutputData(std::shared_ptr<FrameBufferData> &data) override;
+    //!
+    //! \brief Receive output data without waiting
+    //!
+    //! \param [out] data
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus TryReceiveOutputData(std::shared_ptr<FrameBufferData> &data) override;
+    //!
+    //! \brief Set the listener of queued output data
+    //!
+    //! \param [in] listener
+    //!
+    virtual void SetOutputListener(std::function<void()> listener) override;
 
 protected:
     //!
@@ -110,10 +136,8 @@ protected:
     bool m_isStop; //<! stop flag
     bool m_isEOS; //<! EOS flag
     uint32_t m_frameNum; //<! frame number
-    std::mutex m_inMutex; //<! input list mutex
-    std::mutex m_outMutex; //<! output list mutex
-    std::list<std::shared_ptr<FrameBufferData>> m_inFrameBufferDataList; //<! frame buffer data list
-    std::list<std::shared_ptr<FrameBufferData>> m_outFrameBufferDataList; //<! frame buffer data list
+    BlockingQueue<std::shared_ptr<FrameBufferData>> m_inQueue; //<! input frames, bounded by the input buffers plus EOS
+    BlockingQueue<std::shared_ptr<FrameBufferData>> m_outQueue; //<! output frames, bounded by the output buffers
     std::thread m_decodeThread; //<! decode thread
     FILE *debug_file = nullptr;
 };
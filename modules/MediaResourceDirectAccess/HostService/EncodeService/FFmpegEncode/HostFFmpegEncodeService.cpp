@@ -49,20 +49,27 @@ VDI_NS_BEGIN
 
 HostFFmpegEncodeService::HostFFmpegEncodeService(TaskInfo taskInfo)
     :m_avctx(nullptr),
-     m_hwDeviceCtx(nullptr)
+     m_hwDeviceCtx(nullptr),
+     m_swFrame(nullptr),
+     m_hwFrame(nullptr),
+     m_packet(nullptr)
 {
-    debug_file = fopen("out_host.hevc", "wb");
     m_taskInfo = taskInfo;
 }
 
 HostFFmpegEncodeService::~HostFFmpegEncodeService()
 {
+    // wake the media thread at once and stop it before its codec goes away
+    m_isStop = true;
+    m_inQueue.Close();
+    if (m_encodeThread.joinable()) m_encodeThread.join();
+
     avcodec_free_context(&m_avctx);
     av_buffer_unref(&m_hwDeviceCtx);
 
-    m_encodeThread.join();
-
-    fclose(debug_file);
+    av_frame_free(&m_swFrame);
+    av_frame_free(&m_hwFrame);
+    av_packet_free(&m_packet);
 }
 
 MRDAStatus HostFFmpegEncodeService::Initialize()
@@ -79,6 +86,18 @@ MRDAStatus HostFFmpegEncodeService::Initialize()
         MRDA_LOG(LOG_ERROR, "Failed to init share memory!");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // optional recording tap, never fails the session
+    InitRecorder();
+    // surfaces and packet reused by every frame of the session
+    m_swFrame = av_frame_alloc();
+    m_hwFrame = av_frame_alloc();
+    m_packet = av_packet_alloc();
+    if (m_swFrame == nullptr || m_hwFrame == nullptr || m_packet == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to allocate encode surfaces!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    m_inputRefs.resize(m_inLayout.bufferNum);
     // start encode thread
     m_encodeThread = std::thread(&HostFFmpegEncodeService::EncodeThread, this);
     return MRDA_STATUS_SUCCESS;
@@ -369,6 +388,8 @@ MRDAStatus HostFFmpegEncodeService::InitCodec()
 
 void* HostFFmpegEncodeService::EncodeThread()
 {
+    BindThreadAffinity();
+    ShmFaultCount faultBegin = GetThreadFaults();
     while (!m_isStop)
     {
         // get one frame
@@ -377,14 +398,19 @@ void* HostFFmpegEncodeService::EncodeThread()
         if (m_isEOS == false)
         {
             {
-                if (m_inFrameBufferDataList.empty())
+                // woken by SendInputData, the timeout rechecks the stop flag
+                MRDAStatus st = m_inQueue.Pop(frame, HOST_INPUT_WAIT_MS * 1000);
+                if (MRDA_STATUS_NOT_READY == st)
                 {
-                    usleep(5 * 1000);//5ms
                     continue;
                 }
-                std::unique_lock<std::mutex> lock(m_inMutex);
-                frame = m_inFrameBufferDataList.front();
-                m_inFrameBufferDataList.pop_front();
+                if (MRDA_STATUS_SUCCESS != st)
+                {
+                    // closed without EOS, drain what is in flight
+                    MRDA_LOG(LOG_INFO, "Input queue closed, drain the pipeline");
+                    m_isEOS = true;
+                    continue;
+                }
 #ifdef _ENABLE_TRACE_
                 if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: pop front frame in host encoding service input queue, pts: %lu, in dev path: %s", frame->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
@@ -398,180 +424,168 @@ void* HostFFmpegEncodeService::EncodeThread()
             // get surface for encode
             av_frame = GetSurfaceForEncode(frame);
         }
-        // encode one frame
+        // encode one frame, the input buffer is released with the last
+        // reference to the surface wrapping it
         if (MRDA_STATUS_SUCCESS != EncodeOneFrame(av_frame))
         {
             MRDA_LOG(LOG_ERROR, "EncodeOneFrame failed!");
             m_isStop = true;
+            AccountThreadFaults(faultBegin, m_streamFaults);
             return nullptr;
         }
-        else
-        {
-            // unref frame
-            UnRefInputFrame(frame);
-        }
     }
+    AccountThreadFaults(faultBegin, m_streamFaults);
     return nullptr;
 }
 
 
-AVFrame* HostFFmpegEncodeService::GetSurfaceForEncode(std::shared_ptr<FrameBufferData> frame)
+void HostFFmpegEncodeService::ReleaseInputBuffer(void *opaque, uint8_t *data)
 {
-    if (frame == nullptr)
+    InputBufferRef *ref = static_cast<InputBufferRef*>(opaque);
+    if (ref == nullptr || ref->service == nullptr) return;
+    // clear the entry before the slot goes back: the guest may resubmit it
+    // and the encode thread wrap it into this same entry right away
+    std::shared_ptr<FrameBufferData> frame = std::move(ref->frame);
+    ref->frame = nullptr;
+    ref->service->UnRefInputFrame(frame);
+}
+
+AVBufferRef* HostFFmpegEncodeService::WrapInputBuffer(std::shared_ptr<FrameBufferData> frame)
+{
+    if (frame == nullptr || frame->MemBuffer() == nullptr || m_inShmMem == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "Input data is null!");
+        MRDA_LOG(LOG_ERROR, "Input buffer is invalid!");
+        return nullptr;
+    }
+
+    // one reference per slot, a slot is wrapped at most once at a time
+    uint32_t bufId = frame->MemBuffer()->BufId();
+    if (bufId == 0 || bufId > m_inputRefs.size())
+    {
+        MRDA_LOG(LOG_ERROR, "Input buffer id %u out of range!", bufId);
+        return nullptr;
+    }
+    InputBufferRef *ref = &m_inputRefs[bufId - 1];
+    ref->service = this;
+    ref->frame = frame;
+
+    uint8_t *base_ptr = reinterpret_cast<uint8_t*>(m_inShmMem) + m_inLayout.MemOffset(bufId);
+    AVBufferRef *buf = av_buffer_create(base_ptr, m_inLayout.slotSize, ReleaseInputBuffer,
+                                        ref, AV_BUFFER_FLAG_READONLY);
+    if (buf == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to wrap input buffer.");
+        ref->frame = nullptr;
         return nullptr;
     }
+    // AVBuffer and AVBufferRef of the wrapper
+    CountHotAllocs(2);
+    return buf;
+}
 
-    AVFrame *sw_frame = av_frame_alloc();
-    if (sw_frame == nullptr)
+AVFrame* HostFFmpegEncodeService::GetSurfaceForEncode(std::shared_ptr<FrameBufferData> frame)
+{
+    if (frame == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "Failed to allocate AVFrame.");
+        MRDA_LOG(LOG_ERROR, "Input data is null!");
         return nullptr;
     }
 
+    // surfaces are reused for every frame, only their references change
+    AVFrame *sw_frame = m_swFrame;
+    av_frame_unref(sw_frame);
+
     EncodeParams encodeParams = m_mediaParams->encodeParams;
     //sw_frame->format = AV_PIX_FMT_NV12; // uniformed color format
     sw_frame->format = GetColorFormat(encodeParams.color_format);
     sw_frame->width = frame->Width();
     sw_frame->height = frame->Height();
     sw_frame->pts = frame->Pts();
-    // allocate new buffer for video
-    if (av_frame_get_buffer(sw_frame, 0) < 0)
+    // the surface owns the input buffer from here, unref releases the slot
+    sw_frame->buf[0] = WrapInputBuffer(frame);
+    if (sw_frame->buf[0] == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "Failed to allocate frame data.");
-        av_frame_free(&sw_frame);
+        av_frame_unref(sw_frame);
+        UnRefInputFrame(frame);
         return nullptr;
     }
 
     if (MRDA_STATUS_SUCCESS != FillFrameToSurface(frame, sw_frame))
     {
         MRDA_LOG(LOG_ERROR, "FillFrameToSurface failed!");
-        av_frame_free(&sw_frame);
+        av_frame_unref(sw_frame);
         return nullptr;
     }
 
-    AVFrame *hw_frame = av_frame_alloc();
-    if (hw_frame == nullptr)
+    // software encoders take the shared memory surface as is
+    if (m_avctx->hw_frames_ctx == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "Failed to allocate AVFrame.");
-        av_frame_free(&sw_frame);
-        return nullptr;
+        return sw_frame;
     }
 
+    AVFrame *hw_frame = m_hwFrame;
+    av_frame_unref(hw_frame);
     if (av_hwframe_get_buffer(m_avctx->hw_frames_ctx, hw_frame, 0) < 0)
     {
         MRDA_LOG(LOG_ERROR, "Failed to allocate hw frame buffer.");
-        av_frame_free(&sw_frame);
-        av_frame_free(&hw_frame);
+        av_frame_unref(sw_frame);
         return nullptr;
     }
 
+    // upload reads the guest payload in place
     if (av_hwframe_transfer_data(hw_frame, sw_frame, 0) < 0)
     {
         MRDA_LOG(LOG_ERROR, "Failed to transfer data from sw to hw frame.");
-        av_frame_free(&sw_frame);
-        av_frame_free(&hw_frame);
+        av_frame_unref(sw_frame);
+        av_frame_unref(hw_frame);
         return nullptr;
     }
     hw_frame->pts = sw_frame->pts; // copy pts to hw frame
 
-    av_frame_free(&sw_frame);
+    // upload is complete, the input slot goes back to the guest here
+    av_frame_unref(sw_frame);
 
     return hw_frame;
 }
 
-MRDAStatus HostFFmpegEncodeService::ColorSpaceConvert(AVPixelFormat in_pix_fmt, AVPixelFormat out_pix_fmt, std::shared_ptr<FrameBufferData> frame, AVFrame* pSurface)
+MRDAStatus HostFFmpegEncodeService::FillFrameToSurface(std::shared_ptr<FrameBufferData> frame, AVFrame* pSurface)
 {
-    if (pSurface == nullptr) return MRDA_STATUS_INVALID_DATA;
+    if (pSurface == nullptr || pSurface->buf[0] == nullptr) return MRDA_STATUS_INVALID_DATA;
 
+    // planes point into the wrapped input buffer, no pixel is copied
+    uint8_t* base_ptr = pSurface->buf[0]->data;
     int width = pSurface->width;
     int height = pSurface->height;
-    struct SwsContext *sws_ctx = sws_getContext(width, height, in_pix_fmt,
-                                                width, height, out_pix_fmt,
-                                                SWS_FAST_BILINEAR, NULL, NULL, NULL);
-    if (!sws_ctx) {
-        MRDA_LOG(LOG_ERROR, "Could not initialize sws context");
-        return MRDA_STATUS_OPERATION_FAIL;
-    }
-    // construct source data and linesize
-    if (frame->MemBuffer() == nullptr) return MRDA_STATUS_INVALID_DATA;
-    size_t base_offset = frame->MemBuffer()->MemOffset();
-    uint8_t *src_data[4];
-    int src_linesize[4];
-    uint8_t* base_ptr = reinterpret_cast<uint8_t*>(m_inShmMem) + base_offset;
-    switch (in_pix_fmt)
+    // row pitch from guest, 0 means tightly packed rows
+    uint64_t pitch = frame->MemBuffer()->Pitch();
+    switch (static_cast<AVPixelFormat>(pSurface->format))
     {
         case AVPixelFormat::AV_PIX_FMT_YUV420P:
-            // Do CSC
-            //src_data[0] = base_ptr;
-            //src_data[1] = base_ptr + width * height;
-            //src_data[2] = base_ptr + width * height + width * height / 4;
-            //src_data[3] = nullptr;
-            //src_linesize[0] = width;
-            //src_linesize[1] = width / 2;
-            //src_linesize[2] = width / 2;
-            //src_linesize[3] = 0;
+            if (MRDA_STATUS_SUCCESS != CheckInputPitch(pitch, width, static_cast<uint64_t>(height) * 3 / 2)) return MRDA_STATUS_INVALID_DATA;
             pSurface->data[0] = base_ptr;
-            pSurface->data[1] = base_ptr + width * height;
-            pSurface->data[2] = base_ptr + width * height + width * height / 4;
-            pSurface->linesize[0] = width;
-            pSurface->linesize[1] = width / 2;
-            pSurface->linesize[2] = width / 2;
-            return MRDA_STATUS_SUCCESS;
-	        break;
+            pSurface->data[1] = base_ptr + pitch * height;
+            pSurface->data[2] = base_ptr + pitch * height + pitch * height / 4;
+            pSurface->linesize[0] = static_cast<int>(pitch);
+            pSurface->linesize[1] = static_cast<int>(pitch / 2);
+            pSurface->linesize[2] = static_cast<int>(pitch / 2);
+            break;
         case AVPixelFormat::AV_PIX_FMT_BGR0:
-            // Do CSC
-            //src_data[0] = base_ptr;
-            //src_data[1] = nullptr;
-            //src_data[2] = nullptr;
-            //src_data[3] = nullptr;
-            //src_linesize[0] = width * 4;
-            //src_linesize[1] = 0;
-            //src_linesize[2] = 0;
-            //src_linesize[3] = 0;
+            if (MRDA_STATUS_SUCCESS != CheckInputPitch(pitch, static_cast<uint64_t>(width) * 4, height)) return MRDA_STATUS_INVALID_DATA;
             pSurface->data[0] = base_ptr;
-            pSurface->linesize[0] = width * 4;
-            return MRDA_STATUS_SUCCESS;
+            pSurface->linesize[0] = static_cast<int>(pitch);
             break;
         case AVPixelFormat::AV_PIX_FMT_NV12:
+            if (MRDA_STATUS_SUCCESS != CheckInputPitch(pitch, width, static_cast<uint64_t>(height) * 3 / 2)) return MRDA_STATUS_INVALID_DATA;
             pSurface->data[0] = base_ptr;
-            pSurface->data[1] = base_ptr + width * height;
-            pSurface->linesize[0] = width;
-            pSurface->linesize[1] = width;
-            return MRDA_STATUS_SUCCESS;
+            pSurface->data[1] = base_ptr + pitch * height;
+            pSurface->linesize[0] = static_cast<int>(pitch);
+            pSurface->linesize[1] = static_cast<int>(pitch);
+            break;
         default:
+            MRDA_LOG(LOG_ERROR, "Unsupported input color format!");
             return MRDA_STATUS_INVALID_DATA;
     }
 
-    sws_scale(sws_ctx, src_data, src_linesize, 0, height, pSurface->data, pSurface->linesize);
-    sws_freeContext(sws_ctx);
-
-    return MRDA_STATUS_SUCCESS;
-}
-
-MRDAStatus HostFFmpegEncodeService::FillFrameToSurface(std::shared_ptr<FrameBufferData> frame, AVFrame* pSurface)
-{
-    // offset = memory offset + state offset (sizeof(uint32))
-    if (frame->MemBuffer() == nullptr) return MRDA_STATUS_INVALID_DATA;
-    size_t base_offset = frame->MemBuffer()->MemOffset();
-
-    EncodeParams encodeParams = m_mediaParams->encodeParams;
-    int w = frame->Width();
-    int h = frame->Height();
-    int i;
-    int pitch = 0;
-    uint8_t* ptr = nullptr;
-
-    AVPixelFormat in_pix_fmt = GetColorFormat(encodeParams.color_format);
-    AVPixelFormat out_pix_fmt = static_cast<AVPixelFormat>(pSurface->format); // output pixel format
-
-    if (MRDA_STATUS_SUCCESS != ColorSpaceConvert(in_pix_fmt, out_pix_fmt, frame, pSurface))
-    {
-        MRDA_LOG(LOG_ERROR, "ColorSpaceConvert failed");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-
     return MRDA_STATUS_SUCCESS;
 }
 
@@ -583,22 +597,18 @@ MRDAStatus HostFFmpegEncodeService::EncodeOneFrame(AVFrame* pSurface)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    AVPacket *av_pkt = av_packet_alloc();
-    if (av_pkt == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "av_pkt is nullptr");
-        return MRDA_STATUS_INVALID_DATA;
-    }
+    AVPacket *av_pkt = m_packet;
 #ifdef _ENABLE_TRACE_
     if (m_mediaParams != nullptr && pSurface != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: begin avcodec send frame in FFmpeg encode service, pts: %lu, in dev path: %s", pSurface->pts, m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
     if (avcodec_send_frame(m_avctx, pSurface) < 0)
     {
         MRDA_LOG(LOG_ERROR, "avcodec_send_frame failed");
-        av_packet_free(&av_pkt);
+        if (pSurface != nullptr) av_frame_unref(pSurface);
         return MRDA_STATUS_INVALID_DATA;
     }
-    av_frame_free(&pSurface);
+    // the encoder holds its own reference now
+    if (pSurface != nullptr) av_frame_unref(pSurface);
     int ret = 0;
     while (ret >= 0)
     {
@@ -621,7 +631,7 @@ MRDAStatus HostFFmpegEncodeService::EncodeOneFrame(AVFrame* pSurface)
         else if (ret < 0)
         {
             MRDA_LOG(LOG_ERROR, "avcodec_receive_packet failed");
-            av_packet_free(&av_pkt);
+            av_packet_unref(av_pkt);
             m_isStop = true;
             return MRDA_STATUS_INVALID_DATA;
         }
@@ -636,7 +646,6 @@ MRDAStatus HostFFmpegEncodeService::EncodeOneFrame(AVFrame* pSurface)
             m_frameNum++;
         }
     }
-    av_packet_free(&av_pkt);
     return MRDA_STATUS_SUCCESS;
 }
 
@@ -654,35 +663,12 @@ MRDAStatus HostFFmpegEncodeService::WriteToOutputShareMemoryBuffer(AVPacket* pBS
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    // Get one available buffer frame from output memory pool
-    std::shared_ptr<FrameBufferData> data = nullptr;
-    if (MRDA_STATUS_SUCCESS != GetAvailableOutputBufferFrame(data))
-    {
-        MRDA_LOG(LOG_ERROR, "GetAvailableOutputBufferFrame failed\n");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-    if (data == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "data is null\n");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-    // write to out share memory
-    RefOutputFrame(data);
-    if (data->MemBuffer() == nullptr) return MRDA_STATUS_INVALID_DATA;
-    size_t mem_offset = data->MemBuffer()->MemOffset();
-    memcpy(m_outShmMem + mem_offset, pBS->data, pBS->size);
-    data->MemBuffer()->SetOccupiedSize(pBS->size);
-
-    fwrite(pBS->data, 1, pBS->size, debug_file);
-    // update output buffer list
+    RecordPacket(pBS->data, pBS->size, (pBS->flags & AV_PKT_FLAG_KEY) != 0);
+    // write to out share memory and update output buffer list
 #ifdef _ENABLE_TRACE_
-    if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: push back frame in host encoding service output queue, pts: %lu, in dev path: %s", data->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
+    if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: push back frame in host encoding service output queue, pts: %u, in dev path: %s", m_frameNum, m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-    std::unique_lock<std::mutex> lock(m_outMutex);
-    m_outFrameBufferDataList.push_back(data);
-    // MRDA_LOG(LOG_INFO, "Push back output buffer at pts %llu", data->Pts());
-
-    return MRDA_STATUS_SUCCESS;
+    return WriteOutputPacket(pBS->data, pBS->size);
 }
 
 VDI_NS_END
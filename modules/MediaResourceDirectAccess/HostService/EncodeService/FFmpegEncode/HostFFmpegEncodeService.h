@@ -60,21 +60,21 @@ public:
     //!
     virtual MRDAStatus Initialize();
 
-private:
+protected:
 
     //!
     //! \brief initialize ffmpeg encoding context
     //!
     //! \return MRDAStatus
     //!
-    MRDAStatus InitCodec();
+    virtual MRDAStatus InitCodec();
 
     //!
     //! \brief Set ffmpeg encoding parameters
     //!
     //! \return MRDAStatus
     //!
-    MRDAStatus SetEncParams();
+    virtual MRDAStatus SetEncParams();
 
     //!
     //! \brief Set hardware frame context
@@ -111,7 +111,7 @@ private:
     //! \return std::string
     //!         avcodec encoder name
     //!
-    std::string GetEncoderName(StreamCodecID codec_id);
+    virtual std::string GetEncoderName(StreamCodecID codec_id);
 
     //!
     //! \brief Get encoder profile for ffmpeg Encode
@@ -137,10 +137,10 @@ private:
     //! \param [out] pSurface
     //! \return MRDAStatus
     //!
-    AVFrame* GetSurfaceForEncode(std::shared_ptr<FrameBufferData> frame);
+    virtual AVFrame* GetSurfaceForEncode(std::shared_ptr<FrameBufferData> frame);
 
     //!
-    //! \brief Fill the input frame data to ffmpeg surface
+    //! \brief Point the ffmpeg surface planes to the input frame data
     //!
     //! \param [in] frame
     //! \param [out] pSurface
@@ -149,15 +149,24 @@ private:
     MRDAStatus FillFrameToSurface(std::shared_ptr<FrameBufferData> frame, AVFrame* pSurface);
 
     //!
-    //! \brief Color space convert
+    //! \brief Wrap an input share memory buffer as an AVBufferRef, the
+    //!        buffer is released to the guest when the last reference goes
     //!
-    //! \param [in] in_pix_fmt
-    //! \param [in] out_pix_fmt
     //! \param [in] frame
-    //! \param [in out] pSurface
-    //! \return MRDAStatus
+    //!             input frame in share memory
+    //! \return AVBufferRef*
+    //!         buffer reference, nullptr if failed
+    //!
+    AVBufferRef* WrapInputBuffer(std::shared_ptr<FrameBufferData> frame);
+
+    //!
+    //! \brief Free callback of the wrapped input buffer
     //!
-    MRDAStatus ColorSpaceConvert(AVPixelFormat in_pix_fmt, AVPixelFormat out_pix_fmt, std::shared_ptr<FrameBufferData> frame, AVFrame* pSurface);
+    //! \param [in] opaque
+    //!             InputBufferRef of the wrapped buffer
+    //! \param [in] data
+    //!
+    static void ReleaseInputBuffer(void *opaque, uint8_t *data);
 
     //!
     //! \brief Encode one frame
@@ -175,9 +184,23 @@ private:
     //!
     MRDAStatus WriteToOutputShareMemoryBuffer(AVPacket* pBS);
 
-private: //AV related
+private:
+    //!
+    //! \brief Opaque of a wrapped input buffer
+    //!
+    struct InputBufferRef
+    {
+        HostFFmpegEncodeService *service = nullptr; //!< service owning the input share memory
+        std::shared_ptr<FrameBufferData> frame;     //!< input frame to release
+    };
+
+protected: //AV related
     AVCodecContext       *m_avctx;     //!< AV codec context
     AVBufferRef    *m_hwDeviceCtx;     //!< hardware device context
+    AVFrame           *m_swFrame;      //!< reused surface wrapping the input buffer
+    AVFrame           *m_hwFrame;      //!< reused hardware surface
+    AVPacket          *m_packet;       //!< reused output packet
+    std::vector<InputBufferRef> m_inputRefs; //!< wrapper opaque per input buffer
     TaskInfo           m_taskInfo;     //!< task info
 };
 
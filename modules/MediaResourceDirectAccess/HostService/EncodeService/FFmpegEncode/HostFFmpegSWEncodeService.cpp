@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostFFmpegSWEncodeService.cpp
+//! \brief implement host FFmpeg software encode service
+//! \date 2026-10-17
+//!
+
+#ifdef _FFMPEG_SUPPORT_
+
+#include "HostFFmpegSWEncodeService.h"
+
+#include <atomic>
+
+VDI_NS_BEGIN
+
+constexpr int SW_SURFACE_ALIGN = 64; //!< row alignment of converted surfaces
+
+HostFFmpegSWEncodeService::HostFFmpegSWEncodeService(TaskInfo taskInfo)
+    :HostFFmpegEncodeService(taskInfo),
+     m_convPool(nullptr),
+     m_convFrame(nullptr)
+{
+}
+
+HostFFmpegSWEncodeService::~HostFFmpegSWEncodeService()
+{
+    // the media thread converts into our surfaces, stop it before they go
+    m_isStop = true;
+    m_inQueue.Close();
+    if (m_encodeThread.joinable()) m_encodeThread.join();
+
+    av_frame_free(&m_convFrame);
+    // buffers still held by the encoder free the pool with their last reference
+    av_buffer_pool_uninit(&m_convPool);
+}
+
+std::string HostFFmpegSWEncodeService::GetEncoderName(StreamCodecID codec_id)
+{
+    std::string name = GetSWEncoderName(codec_id);
+    if (name.empty())
+    {
+        MRDA_LOG(LOG_ERROR, "Unknown codec id!");
+    }
+    return name;
+}
+
+MRDAStatus HostFFmpegSWEncodeService::InitCodec()
+{
+    if (m_mediaParams == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Media params empty!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    EncodeParams encodeParams = m_mediaParams->encodeParams;
+    std::string encNameStr = GetEncoderName(encodeParams.codec_id);
+
+    const AVCodec *codec = avcodec_find_encoder_by_name(encNameStr.c_str());
+    if (codec == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Could not find encoder %s, ffmpeg is built without it.", encNameStr.c_str());
+        return MRDA_STATUS_NOT_SUPPORTED;
+    }
+
+    m_avctx = avcodec_alloc_context3(codec);
+    if (m_avctx == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to allocate codec context!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+
+    if (MRDA_STATUS_SUCCESS != SetEncParams())
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to set encoder params");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+
+    if (avcodec_open2(m_avctx, codec, nullptr) < 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Cannot open video encoder codec.");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+
+    m_convFrame = av_frame_alloc();
+    if (m_convFrame == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to allocate convert surface!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    MRDA_LOG(LOG_INFO, "Software encoder %s, %s input, %u frame threads", encNameStr.c_str(),
+        av_get_pix_fmt_name(m_avctx->pix_fmt), encodeParams.async_depth);
+    return MRDA_STATUS_SUCCESS;
+}
+
+bool HostFFmpegSWEncodeService::IsEncoderFormat(AVPixelFormat format)
+{
+    if (m_avctx == nullptr || m_avctx->codec == nullptr || m_avctx->codec->pix_fmts == nullptr)
+    {
+        return false;
+    }
+    for (const AVPixelFormat *fmt = m_avctx->codec->pix_fmts; *fmt != AV_PIX_FMT_NONE; fmt++)
+    {
+        if (*fmt == format) return true;
+    }
+    return false;
+}
+
+MRDAStatus HostFFmpegSWEncodeService::SetEncParams()
+{
+    if (m_mediaParams == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Media params empty!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    EncodeParams encodeParams = m_mediaParams->encodeParams;
+    m_avctx->width = encodeParams.frame_width;
+    m_avctx->height = encodeParams.frame_height;
+    if (encodeParams.framerate_den == 0) return MRDA_STATUS_INVALID_DATA;
+    m_avctx->time_base = (AVRational){encodeParams.framerate_den, encodeParams.framerate_num};
+    m_avctx->framerate = (AVRational){encodeParams.framerate_num, encodeParams.framerate_den};
+    m_avctx->sample_aspect_ratio = (AVRational){1, 1};
+    m_avctx->codec_id = GetCodecId(encodeParams.codec_id);
+    if (AV_CODEC_ID_NONE == m_avctx->codec_id) return MRDA_STATUS_INVALID_DATA;
+    m_avctx->codec_type = AVMEDIA_TYPE_VIDEO;
+
+    // the shared memory surface is encoded in place if the encoder takes it
+    AVPixelFormat inFormat = GetColorFormat(encodeParams.color_format);
+    if (AV_PIX_FMT_NONE == inFormat) return MRDA_STATUS_INVALID_DATA;
+    m_avctx->pix_fmt = IsEncoderFormat(inFormat) ? inFormat : AV_PIX_FMT_YUV420P;
+
+    m_avctx->gop_size = encodeParams.gop_size;
+    m_avctx->max_b_frames = encodeParams.max_b_frames;
+    if (m_avctx->codec_id != AV_CODEC_ID_HEVC)
+    {
+        // libx265 takes its profile by name, main is the only 8 bit one
+        m_avctx->profile = GetCodecProfile(encodeParams.codec_profile);
+    }
+    else if (encodeParams.codec_profile == CodecProfile::PROFILE_HEVC_MAIN10)
+    {
+        MRDA_LOG(LOG_WARNING, "8 bit input, encode HEVC main instead of main10");
+    }
+
+    // async depth is the number of frames in flight, one per frame thread
+    m_avctx->thread_count = static_cast<int>(encodeParams.async_depth);
+    m_avctx->thread_type = FF_THREAD_FRAME;
+
+    if (encodeParams.rc_mode == 1)
+    {
+        m_avctx->bit_rate = encodeParams.bit_rate * 1000; // input paramter (kbps) - ffmpeg (bps)
+        m_avctx->rc_min_rate = m_avctx->bit_rate;
+        m_avctx->rc_max_rate = m_avctx->bit_rate;
+        m_avctx->rc_buffer_size = m_avctx->bit_rate * 2;
+        m_avctx->rc_initial_buffer_occupancy = m_avctx->rc_buffer_size * 3 / 4;
+    }
+    else if (encodeParams.rc_mode != 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Unknown rc mode!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    return SetTuneOptions(encodeParams);
+}
+
+MRDAStatus HostFFmpegSWEncodeService::SetTuneOptions(const EncodeParams &encodeParams)
+{
+    SWEncodeOptionList options;
+    if (MRDA_STATUS_SUCCESS != GetSWEncodeOptions(encodeParams, options))
+    {
+        MRDA_LOG(LOG_ERROR, "Unknown target usage!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    // a wrapper that lacks an option must not silently encode with defaults
+    for (auto &option : options)
+    {
+        MRDAStatus st = SetPrivOption(option.first.c_str(), option.second);
+        if (MRDA_STATUS_SUCCESS != st) return st;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus HostFFmpegSWEncodeService::SetPrivOption(const char *name, const std::string &value)
+{
+    int ret = av_opt_set(m_avctx->priv_data, name, value.c_str(), 0);
+    if (ret < 0)
+    {
+        char err[AV_ERROR_MAX_STRING_SIZE] = {0};
+        av_strerror(ret, err, sizeof(err));
+        MRDA_LOG(LOG_ERROR, "Failed to set encoder option %s=%s: %s", name, value.c_str(), err);
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+CscFormat HostFFmpegSWEncodeService::GetCscFormat(AVPixelFormat format)
+{
+    switch (format)
+    {
+        case AVPixelFormat::AV_PIX_FMT_NV12:
+            return CscFormat::CSC_FORMAT_NV12;
+        case AVPixelFormat::AV_PIX_FMT_YUV420P:
+            return CscFormat::CSC_FORMAT_I420;
+        case AVPixelFormat::AV_PIX_FMT_BGR0:
+            // alpha byte of the screen capture is ignored
+            return CscFormat::CSC_FORMAT_BGRA;
+        default:
+            return CscFormat::CSC_FORMAT_NONE;
+    }
+}
+
+AVFrame* HostFFmpegSWEncodeService::GetSurfaceForEncode(std::shared_ptr<FrameBufferData> frame)
+{
+    // no hw frames context, the base returns the wrapped input surface
+    AVFrame *surface = HostFFmpegEncodeService::GetSurfaceForEncode(frame);
+    if (surface == nullptr || surface->format == m_avctx->pix_fmt)
+    {
+        return surface;
+    }
+    return ConvertSurface(surface);
+}
+
+AVFrame* HostFFmpegSWEncodeService::ConvertSurface(AVFrame *surface)
+{
+    int width = m_avctx->width;
+    int height = m_avctx->height;
+    CscFormat inCsc = GetCscFormat(static_cast<AVPixelFormat>(surface->format));
+    if (surface->width != width || surface->height != height || !ColorConvert::IsSupported(inCsc, CscFormat::CSC_FORMAT_I420))
+    {
+        MRDA_LOG(LOG_ERROR, "Cannot convert input surface for the encoder!");
+        av_frame_unref(surface);
+        return nullptr;
+    }
+
+    int lumaPitch = (width + SW_SURFACE_ALIGN - 1) / SW_SURFACE_ALIGN * SW_SURFACE_ALIGN;
+    int chromaPitch = lumaPitch / 2;
+    size_t lumaSize = static_cast<size_t>(lumaPitch) * height;
+    size_t chromaSize = static_cast<size_t>(chromaPitch) * ((height + 1) / 2);
+    if (m_convPool == nullptr)
+    {
+        m_convPool = av_buffer_pool_init(lumaSize + chromaSize * 2, nullptr);
+        if (m_convPool == nullptr)
+        {
+            MRDA_LOG(LOG_ERROR, "Failed to create convert surface pool!");
+            av_frame_unref(surface);
+            return nullptr;
+        }
+    }
+
+    // pooled buffers are recycled once the encoder drops them
+    AVFrame *conv = m_convFrame;
+    av_frame_unref(conv);
+    conv->buf[0] = av_buffer_pool_get(m_convPool);
+    if (conv->buf[0] == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to get convert surface!");
+        av_frame_unref(surface);
+        return nullptr;
+    }
+    conv->format = m_avctx->pix_fmt;
+    conv->width = width;
+    conv->height = height;
+    conv->pts = surface->pts;
+    conv->data[0] = conv->buf[0]->data;
+    conv->data[1] = conv->data[0] + lumaSize;
+    conv->data[2] = conv->data[1] + chromaSize;
+    conv->linesize[0] = lumaPitch;
+    conv->linesize[1] = chromaPitch;
+    conv->linesize[2] = chromaPitch;
+
+    CscImage src, dst;
+    src.format = inCsc;
+    dst.format = CscFormat::CSC_FORMAT_I420;
+    src.width = dst.width = width;
+    src.height = dst.height = height;
+    for (int i = 0; i < 3; i++)
+    {
+        src.data[i] = surface->data[i];
+        src.linesize[i] = surface->linesize[i];
+        dst.data[i] = conv->data[i];
+        dst.linesize[i] = conv->linesize[i];
+    }
+    // stripes start on even rows so each one owns its chroma rows
+    std::atomic<MRDAStatus> failed{MRDA_STATUS_SUCCESS};
+    HostWorkerPool::Instance().RunStripes(height, GetStripeNum(width, height), 2,
+        [&](uint32_t rowBegin, uint32_t rowEnd) {
+            MRDAStatus status = m_colorConvert.ConvertRows(src, dst, rowBegin, rowEnd);
+            if (MRDA_STATUS_SUCCESS != status) failed = status;
+        });
+
+    // converted, the input slot goes back to the guest here
+    av_frame_unref(surface);
+    if (MRDA_STATUS_SUCCESS != failed.load())
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to convert input surface!");
+        av_frame_unref(conv);
+        return nullptr;
+    }
+    return conv;
+}
+
+VDI_NS_END
+
+#endif // _FFMPEG_SUPPORT_
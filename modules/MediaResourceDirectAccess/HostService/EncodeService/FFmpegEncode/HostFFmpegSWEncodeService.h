@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostFFmpegSWEncodeService.h
+//! \brief host encode service on the FFmpeg software encoders, serves
+//!        sessions placed on the CPU
+//! \date 2026-10-17
+//!
+
+#ifdef _FFMPEG_SUPPORT_
+
+#ifndef _HOSTFFMPEGSWENCODESERVICE_H_
+#define _HOSTFFMPEGSWENCODESERVICE_H_
+
+#include "HostFFmpegEncodeService.h"
+#include "SWEncodeOptions.h"
+#include "../../ColorConvert/ColorConvert.h"
+
+#include <string>
+
+VDI_NS_BEGIN
+
+class HostFFmpegSWEncodeService : public HostFFmpegEncodeService
+{
+public:
+    //!
+    //! \brief Construct a new Host FFmpeg SW Encode Service object
+    //!
+    HostFFmpegSWEncodeService(TaskInfo taskInfo);
+    //!
+    //! \brief Destroy the Host FFmpeg SW Encode Service object
+    //!
+    virtual ~HostFFmpegSWEncodeService();
+
+protected:
+    //!
+    //! \brief initialize the software encoder, no device is opened
+    //!
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus InitCodec() override;
+
+    //!
+    //! \brief Set encoding parameters with low latency tuning of the
+    //!        software encoder
+    //!
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus SetEncParams() override;
+
+    //!
+    //! \brief Get software encoder name for ffmpeg Encode
+    //!
+    //! \param [in] codec_id
+    //!             input codec id
+    //! \return std::string
+    //!         avcodec encoder name
+    //!
+    virtual std::string GetEncoderName(StreamCodecID codec_id) override;
+
+    //!
+    //! \brief Get the surface for encode, input the encoder takes is wrapped
+    //!        in place, other input is converted
+    //!
+    //! \param [in] frame
+    //! \return AVFrame*
+    //!
+    virtual AVFrame* GetSurfaceForEncode(std::shared_ptr<FrameBufferData> frame) override;
+
+private:
+    //!
+    //! \brief Set the preset, lookahead and rate control options of the encoder
+    //!
+    //! \param [in] encodeParams
+    //! \return MRDAStatus
+    //!
+    MRDAStatus SetTuneOptions(const EncodeParams &encodeParams);
+
+    //!
+    //! \brief Set one private option of the encoder
+    //!
+    //! \param [in] name
+    //! \param [in] value
+    //! \return MRDAStatus
+    //!
+    MRDAStatus SetPrivOption(const char *name, const std::string &value);
+
+    //!
+    //! \brief Check whether the encoder takes a pixel format
+    //!
+    //! \param [in] format
+    //! \return bool
+    //!
+    bool IsEncoderFormat(AVPixelFormat format);
+
+    //!
+    //! \brief Convert a wrapped input surface to the encoder format, the
+    //!        input buffer is released once converted
+    //!
+    //! \param [in] surface
+    //! \return AVFrame*
+    //!
+    AVFrame* ConvertSurface(AVFrame *surface);
+
+    //!
+    //! \brief Get csc format of a pixel format
+    //!
+    //! \param [in] format
+    //! \return CscFormat
+    //!
+    CscFormat GetCscFormat(AVPixelFormat format);
+
+private:
+    ColorConvert       m_colorConvert; //!< converts input the encoder does not take
+    AVBufferPool      *m_convPool;     //!< buffers of converted surfaces, the encoder may hold several
+    AVFrame           *m_convFrame;    //!< reused converted surface
+};
+
+VDI_NS_END
+#endif // _HOSTFFMPEGSWENCODESERVICE_H_
+
+#endif // _FFMPEG_SUPPORT_
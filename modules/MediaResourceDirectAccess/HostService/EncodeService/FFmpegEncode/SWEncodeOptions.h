@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file SWEncodeOptions.h
+//! \brief map the encode parameters of a session to the FFmpeg software
+//!        encoder and its private options, without FFmpeg itself
+//! \date 2026-10-17
+//!
+
+#ifndef _SWENCODEOPTIONS_H_
+#define _SWENCODEOPTIONS_H_
+
+#include "../../../utils/common.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+VDI_NS_BEGIN
+
+//!
+//! \brief private options of an encoder in the order they are set
+//!
+typedef std::vector<std::pair<std::string, std::string>> SWEncodeOptionList;
+
+//!
+//! \brief Get the software encoder of a codec
+//!
+//! \param [in] codecId
+//! \return std::string
+//!         avcodec encoder name, empty for an unknown codec
+//!
+inline std::string GetSWEncoderName(StreamCodecID codecId)
+{
+    switch (codecId)
+    {
+    case StreamCodecID::CodecID_AVC:
+        return "libx264";
+    case StreamCodecID::CodecID_HEVC:
+        return "libx265";
+    case StreamCodecID::CodecID_AV1:
+        return "libsvtav1";
+    default:
+        return "";
+    }
+}
+
+//!
+//! \brief Get the preset, lookahead and rate control options of the
+//!        software encoder of a session
+//!
+//! \param [in] encodeParams
+//! \param [out] options
+//! \return MRDAStatus
+//!         MRDA_STATUS_INVALID_DATA for an unknown codec or target usage
+//!
+inline MRDAStatus GetSWEncodeOptions(const EncodeParams &encodeParams, SWEncodeOptionList &options)
+{
+    options.clear();
+    // desktop content at interactive latency: fast presets, no lookahead,
+    // the frame threads are the only frames the encoder holds
+    const char *x26xPreset = nullptr;
+    const char *svtPreset = nullptr;
+    switch (encodeParams.target_usage)
+    {
+    case TargetUsage::BestQuality:
+        x26xPreset = "medium";
+        svtPreset = "8";
+        break;
+    case TargetUsage::Balanced:
+        x26xPreset = "veryfast";
+        svtPreset = "10";
+        break;
+    case TargetUsage::BestSpeed:
+        x26xPreset = "ultrafast";
+        svtPreset = "12";
+        break;
+    default:
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    // values inside the *-params strings are parsed by avcodec_open2
+    std::string qp = std::to_string(encodeParams.qp);
+    std::string params;
+    if (encodeParams.codec_id == StreamCodecID::CodecID_AVC)
+    {
+        options.emplace_back("preset", x26xPreset);
+        if (encodeParams.rc_mode == 0) options.emplace_back("qp", qp);
+        else options.emplace_back("nal-hrd", "cbr");
+        // frame threads instead of the sliced threads of the zerolatency tune
+        options.emplace_back("x264-params", "rc-lookahead=0:sync-lookahead=0:sliced-threads=0");
+    }
+    else if (encodeParams.codec_id == StreamCodecID::CodecID_HEVC)
+    {
+        options.emplace_back("preset", x26xPreset);
+        options.emplace_back("profile", "main");
+        if (encodeParams.rc_mode == 0) options.emplace_back("qp", qp);
+        params = "rc-lookahead=0:bframes=" + std::to_string(encodeParams.max_b_frames);
+        if (encodeParams.async_depth > 0) params += ":frame-threads=" + std::to_string(encodeParams.async_depth);
+        options.emplace_back("x265-params", params);
+    }
+    else if (encodeParams.codec_id == StreamCodecID::CodecID_AV1)
+    {
+        options.emplace_back("preset", svtPreset);
+        // low delay prediction structure, required by svt cbr
+        params = "pred-struct=1";
+        if (encodeParams.rc_mode == 0)
+        {
+            params += ":rc=0";
+            options.emplace_back("qp", qp);
+        }
+        else
+        {
+            params += ":rc=2";
+        }
+        if (encodeParams.async_depth > 0) params += ":lp=" + std::to_string(encodeParams.async_depth);
+        options.emplace_back("svtav1-params", params);
+    }
+    else
+    {
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
+#endif // _SWENCODEOPTIONS_H_
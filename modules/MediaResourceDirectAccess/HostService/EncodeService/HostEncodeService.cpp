@@ -33,6 +33,9 @@
 
 #include "HostEncodeService.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 VDI_NS_BEGIN
 
 HostEncodeService::HostEncodeService()
@@ -40,18 +43,18 @@ HostEncodeService::HostEncodeService()
     m_isStop = false;
     m_isEOS = false;
     m_frameNum = 0;
-    m_inFrameBufferDataList.clear();
-    m_outFrameBufferDataList.clear();
 }
 
 HostEncodeService::~HostEncodeService()
 {
+    ReportShmFaults();
+    ReportHotAllocs(m_frameNum);
     if (m_inShmMem != MAP_FAILED) munmap(m_inShmMem, m_inShmSize);
     if (m_outShmMem != MAP_FAILED) munmap(m_outShmMem, m_outShmSize);
     if (m_inShmFile >= 0) close(m_inShmFile);
     if (m_outShmFile >= 0) close(m_outShmFile);
-    m_inFrameBufferDataList.clear();
-    m_outFrameBufferDataList.clear();
+    m_inQueue.Reset();
+    m_outQueue.Reset();
 }
 
 MRDAStatus HostEncodeService::SetInitParams(MediaParams *params)
@@ -64,6 +67,8 @@ MRDAStatus HostEncodeService::SetInitParams(MediaParams *params)
     m_mediaParams = std::make_unique<MediaParams>();
     m_mediaParams->encodeParams = params->encodeParams;
     m_mediaParams->shareMemoryInfo = params->shareMemoryInfo;
+    // the guest never has more input buffers in flight, plus the EOS frame
+    m_inQueue.SetCapacity(params->shareMemoryInfo.bufferNum + 1);
 
     return MRDA_STATUS_SUCCESS;
 }
@@ -89,55 +94,101 @@ MRDAStatus HostEncodeService::InitShm()
         MRDA_LOG(LOG_ERROR, "Failed to get out shm file ptr!");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // the media thread starts after this and binds to the chosen node
+    ResolveAffinity();
+    if (m_outLayout.IsByteRing() && MRDA_STATUS_SUCCESS != m_outRing.Init(m_outShmMem, m_outLayout))
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to init out shm byte ring!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
 
     return MRDA_STATUS_SUCCESS;
 }
 
 MRDAStatus HostEncodeService::SendInputData(std::shared_ptr<FrameBufferData> data)
 {
-    std::unique_lock<std::mutex> lock(m_inMutex);
-    if (data == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Input data is null!");
-        return MRDA_STATUS_INVALID_DATA;
-    }
+    // offsets and size come from the input layout, never from the guest
+    MRDAStatus st = CheckInputFrame(data);
+    if (MRDA_STATUS_SUCCESS != st) return st;
 #ifdef _ENABLE_TRACE_
     if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: push back frame in host encoding service input queue, pts: %lu, in dev path: %s", data->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-    m_inFrameBufferDataList.push_back(data);
-    // MRDA_LOG(LOG_INFO, "Input frame data size is %d", m_inFrameBufferDataList.size());
+    // only blocks when the guest exceeds its input buffers
+    if (MRDA_STATUS_SUCCESS != m_inQueue.Push(data))
+    {
+        MRDA_LOG(LOG_ERROR, "Input queue is closed!");
+        return MRDA_STATUS_INVALID_STATE;
+    }
     return MRDA_STATUS_SUCCESS;
 }
 
+MRDAStatus HostEncodeService::TrySendInputData(std::shared_ptr<FrameBufferData> data)
+{
+    MRDAStatus st = CheckInputFrame(data);
+    if (MRDA_STATUS_SUCCESS != st) return st;
+    st = m_inQueue.Push(data, 0);
+    if (MRDA_STATUS_INVALID_STATE == st)
+    {
+        MRDA_LOG(LOG_ERROR, "Input queue is closed!");
+    }
+    return st;
+}
+
+void HostEncodeService::SetInputListener(std::function<void()> listener)
+{
+    m_inQueue.SetPopListener(std::move(listener));
+}
+
 MRDAStatus HostEncodeService::ReceiveOutputData(std::shared_ptr<FrameBufferData> &data)
 {
-    std::unique_lock<std::mutex> lock(m_outMutex);
-    if (m_outFrameBufferDataList.empty())
+    if (MRDA_STATUS_SUCCESS != m_outQueue.Pop(data, HOST_OUTPUT_WAIT_MS * 1000))
     {
         // MRDA_LOG(LOG_INFO, "Output data list is empty!");
         return MRDA_STATUS_NOT_ENOUGH_DATA;
     }
-    data = m_outFrameBufferDataList.front();
-    m_outFrameBufferDataList.pop_front();
 #ifdef _ENABLE_TRACE_
     if (m_mediaParams != nullptr) MRDA_LOG(LOG_INFO, "MRDA trace log: pop front frame in host encoding service output queue, pts: %lu, in dev path: %s", data->Pts(), m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str());
 #endif
-    // MRDA_LOG(LOG_INFO, "Output frame data size is %d, pts %llu", m_outFrameBufferDataList.size(), data->Pts());
     return MRDA_STATUS_SUCCESS;
 }
 
+MRDAStatus HostEncodeService::TryReceiveOutputData(std::shared_ptr<FrameBufferData> &data)
+{
+    if (MRDA_STATUS_SUCCESS != m_outQueue.Pop(data, 0))
+    {
+        return MRDA_STATUS_NOT_ENOUGH_DATA;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
 
+void HostEncodeService::SetOutputListener(std::function<void()> listener)
+{
+    m_outQueue.SetPushListener(std::move(listener));
+}
 
-MRDAStatus HostEncodeService::GetAvailableOutputBufferFrame(std::shared_ptr<FrameBufferData>& pFrame)
+MRDAStatus HostEncodeService::GetAvailableOutputBufferFrame(std::shared_ptr<FrameBufferData>& pFrame, uint64_t size)
 {
     // check an available buffer
     bool isBufferAvailable = false;
     while (!isBufferAvailable)
     {
-        if (MRDA_STATUS_SUCCESS != GetAvailBuffer(pFrame))
+        // a guest that stopped releasing buffers must not hold the media thread
+        if (m_isStop)
+        {
+            MRDA_LOG(LOG_ERROR, "Service stopped while waiting for an output buffer!");
+            return MRDA_STATUS_INVALID_STATE;
+        }
+        // read the sequence first so a release right after the check still wakes us
+        uint32_t releaseSeq = m_outBufIndex.ReleaseSequence();
+        MRDAStatus status = GetAvailBuffer(pFrame, size);
+        if (MRDA_STATUS_NOT_READY != status && MRDA_STATUS_SUCCESS != status)
+        {
+            return status;
+        }
+        if (MRDA_STATUS_SUCCESS != status)
         {
             // MRDA_LOG(LOG_INFO, "GetAvailBuffer failed\n");
-            usleep(5 * 1000);
+            m_outBufIndex.WaitRelease(releaseSeq, SHM_DOORBELL_WAIT_US);
             continue;
         }
         isBufferAvailable = true;
@@ -145,42 +196,143 @@ MRDAStatus HostEncodeService::GetAvailableOutputBufferFrame(std::shared_ptr<Fram
     return MRDA_STATUS_SUCCESS;
 }
 
-MRDAStatus HostEncodeService::GetAvailBuffer(std::shared_ptr<FrameBufferData>& pFrame)
+MRDAStatus HostEncodeService::GetAvailBuffer(std::shared_ptr<FrameBufferData>& pFrame, uint64_t size)
 {
     if (m_mediaParams == nullptr || m_outShmMem == nullptr)
     {
         MRDA_LOG(LOG_ERROR, "Media params or out shm mem invalid!");
         return MRDA_STATUS_INVALID_DATA;
     }
-    uint32_t bufferNum = m_mediaParams->shareMemoryInfo.bufferNum;
-    uint64_t bufferSize = m_mediaParams->shareMemoryInfo.bufferSize;
-    for (uint32_t i = 1; i <= bufferNum; i++)
+    // take one idle buffer from the shared index
+    uint32_t bufId = 0;
+    if (!m_outLayout.IsByteRing() && size > m_outLayout.slotSize)
+    {
+        MRDA_LOG(LOG_ERROR, "Output size %lu exceeds buffer size %lu!", size, m_outLayout.slotSize);
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    if (MRDA_STATUS_SUCCESS != m_outBufIndex.Acquire(bufId))
+    {
+        return MRDA_STATUS_NOT_READY;
+    }
+    uint64_t memOffset = m_outLayout.MemOffset(bufId);
+    uint64_t bufSize = m_outLayout.slotSize;
+    if (m_outLayout.IsByteRing())
     {
-        size_t state_offset = (i - 1) * bufferSize;
-        BufferState state = BufferState::BUFFER_STATE_NONE;
-        memcpy(&state, m_outShmMem + state_offset, sizeof(uint32_t));
-        // find an available frame
-        if (state == BufferState::BUFFER_STATE_IDLE)
+        // reserve exactly the bytes needed in the bitstream ring
+        MRDAStatus status = m_outRing.Allocate(bufId, size, memOffset, bufSize);
+        if (MRDA_STATUS_SUCCESS != status)
         {
-            std::shared_ptr<MemoryBuffer> memBuffer = std::make_shared<MemoryBuffer>();
-            memBuffer->SetBufId(i);
-            memBuffer->SetMemOffset(state_offset + sizeof(uint32_t));
-            memBuffer->SetStateOffset(state_offset);
-            memBuffer->SetBufPtr(nullptr);
-            memBuffer->SetSize(bufferSize);
-            memBuffer->SetOccupiedSize(0);
-            memBuffer->SetState(state);
-            pFrame = std::make_shared<FrameBufferData>();
-            pFrame->SetWidth(m_mediaParams->encodeParams.frame_width);
-            pFrame->SetHeight(m_mediaParams->encodeParams.frame_height);
-            pFrame->SetStreamType(InputStreamType::RAW);
-            pFrame->SetPts(m_frameNum);
-            pFrame->SetEOS(m_isEOS);
-            pFrame->SetMemBuffer(memBuffer);
-            return MRDA_STATUS_SUCCESS;
+            // the ring frees room only when the guest releases a buffer,
+            // so the caller waits for that release, not for this give back
+            m_outBufIndex.Restore(bufId);
+            return status;
         }
     }
-    return MRDA_STATUS_INVALID_DATA;
+    // frame and memory buffer are recycled from the session pool
+    pFrame = GetOutputFrameData();
+    std::shared_ptr<MemoryBuffer> memBuffer = pFrame->MemBuffer();
+    memBuffer->SetBufId(bufId);
+    memBuffer->SetMemOffset(memOffset);
+    memBuffer->SetStateOffset(m_outLayout.StateOffset(bufId));
+    memBuffer->SetBufPtr(nullptr);
+    memBuffer->SetSize(bufSize);
+    memBuffer->SetOccupiedSize(0);
+    memBuffer->SetState(BufferState::BUFFER_STATE_IDLE);
+    memBuffer->SetPitch(0);
+    memBuffer->SetChainNum(1);
+    memBuffer->SetChainIndex(0);
+    pFrame->SetWidth(m_mediaParams->encodeParams.frame_width);
+    pFrame->SetHeight(m_mediaParams->encodeParams.frame_height);
+    pFrame->SetStreamType(InputStreamType::RAW);
+    pFrame->SetPts(m_frameNum);
+    pFrame->SetEOS(m_isEOS);
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus HostEncodeService::InitRecorder()
+{
+    if (m_mediaParams == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Media params invalid!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    const EncodeParams &encodeParams = m_mediaParams->encodeParams;
+    if (encodeParams.record_format == RecordFormat::RECORD_NONE)
+    {
+        return MRDA_STATUS_SUCCESS;
+    }
+    // guests only name the file, the host decides where recordings may go
+    const char *recordDir = getenv(RECORD_DIR_ENV);
+    const std::string &name = encodeParams.record_path;
+    if (recordDir == nullptr || *recordDir == '\0')
+    {
+        MRDA_LOG(LOG_WARNING, "Bitstream recording requested but %s is not set, recording off", RECORD_DIR_ENV);
+        return MRDA_STATUS_SUCCESS;
+    }
+    if (name.empty() || name.find('/') != std::string::npos || name == "." || name == "..")
+    {
+        MRDA_LOG(LOG_WARNING, "Invalid bitstream recording name %s, recording off", name.c_str());
+        return MRDA_STATUS_SUCCESS;
+    }
+    m_recorder = std::make_unique<BitstreamRecorder>();
+    if (MRDA_STATUS_SUCCESS != m_recorder->Start(std::string(recordDir) + "/" + name, encodeParams.record_format,
+                                                 encodeParams, encodeParams.record_buffer_size))
+    {
+        MRDA_LOG(LOG_WARNING, "Failed to start bitstream recording, recording off");
+        m_recorder.reset();
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus HostEncodeService::WriteOutputPacket(const uint8_t *bitstream, uint64_t size)
+{
+    if (bitstream == nullptr || m_outShmMem == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Bitstream or out shm mem invalid!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    // fixed slots are sized for typical packets, larger ones span several
+    uint64_t segSize = size;
+    uint32_t chainNum = 1;
+    if (!m_outLayout.IsByteRing() && size > m_outLayout.slotSize)
+    {
+        segSize = m_outLayout.slotSize;
+        chainNum = static_cast<uint32_t>((size + segSize - 1) / segSize);
+        if (chainNum > m_outLayout.bufferNum)
+        {
+            MRDA_LOG(LOG_ERROR, "Output size %lu exceeds all %u output buffers!", size, m_outLayout.bufferNum);
+            return MRDA_STATUS_INVALID_DATA;
+        }
+    }
+
+    m_outChain.clear();
+    uint64_t offset = 0;
+    for (uint32_t i = 0; i < chainNum; i++)
+    {
+        uint64_t bytes = std::min(segSize, size - offset);
+        std::shared_ptr<FrameBufferData> data = nullptr;
+        MRDAStatus status = GetAvailableOutputBufferFrame(data, bytes);
+        if (MRDA_STATUS_SUCCESS != status || data == nullptr || data->MemBuffer() == nullptr)
+        {
+            MRDA_LOG(LOG_ERROR, "GetAvailableOutputBufferFrame failed\n");
+            // give back the slots taken for this packet
+            for (auto &taken : m_outChain) DropOutputFrame(taken);
+            m_outChain.clear();
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        memcpy(m_outShmMem + data->MemBuffer()->MemOffset(), bitstream + offset, bytes);
+        data->MemBuffer()->SetOccupiedSize(bytes);
+        data->MemBuffer()->SetChainNum(chainNum);
+        data->MemBuffer()->SetChainIndex(i);
+        m_outChain.push_back(data);
+        offset += bytes;
+    }
+
+    // publish the whole chain at once so the guest receives it in order
+    for (auto &data : m_outChain) RefOutputFrame(data);
+    m_outQueue.PushRange(m_outChain.begin(), m_outChain.end());
+    m_outChain.clear();
+    return MRDA_STATUS_SUCCESS;
 }
 
 VDI_NS_END
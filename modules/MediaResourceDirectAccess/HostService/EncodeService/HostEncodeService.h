@@ -35,10 +35,13 @@
 #define _HOSTENCODESERVICE_H_
 
 #include "../HostService.h"
+#include "../../utils/BlockingQueue.h"
+#include "../ShmByteRing.h"
+#include "../BitstreamRecorder.h"
 #include <thread>
 #include <mutex>
-#include <list>
 #include <map>
+#include <vector>
 #include <unistd.h>
 
 VDI_NS_BEGIN
@@ -75,12 +78,38 @@ public:
     //!
     virtual MRDAStatus SendInputData(std::shared_ptr<FrameBufferData> data) override;
     //!
+    //! \brief Send input data without waiting
+    //!
+    //! \param [in] data
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus TrySendInputData(std::shared_ptr<FrameBufferData> data) override;
+    //!
+    //! \brief Set the listener of input data leaving the input queue
+    //!
+    //! \param [in] listener
+    //!
+    virtual void SetInputListener(std::function<void()> listener) override;
+    //!
     //! \brief Receive output data
     //!
     //! \param [out] data
     //! \return MRDAStatus
     //!
     virtual MRDAStatus ReceiveOutputData(std::shared_ptr<FrameBufferData> &data) override;
+    //!
+    //! \brief Receive output data without waiting
+    //!
+    //! \param [out] data
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus TryReceiveOutputData(std::shared_ptr<FrameBufferData> &data) override;
+    //!
+    //! \brief Set the listener of queued output data
+    //!
+    //! \param [in] listener
+    //!
+    virtual void SetOutputListener(std::function<void()> listener) override;
 
 protected:
     //!
@@ -92,30 +121,61 @@ protected:
     //!
     //! \brief Get the Avail Buffer object
     //!
-    //! \param [out]
+    //! \param [out] pFrame
+    //! \param [in] size
+    //!             bytes needed in the output buffer
     //! \return MRDAStatus
     //!
-    MRDAStatus GetAvailBuffer(std::shared_ptr<FrameBufferData>& pFrame);
+    MRDAStatus GetAvailBuffer(std::shared_ptr<FrameBufferData>& pFrame, uint64_t size);
     // FIXME: May put output memory pool in host
     //!
     //! \brief Get the Available Output Buffer Frame object
     //!
-    //! \param [in] pFrame
+    //! \param [out] pFrame
+    //! \param [in] size
+    //!             bytes needed in the output buffer
     //! \return MRDAStatus
     //!
-    MRDAStatus GetAvailableOutputBufferFrame(std::shared_ptr<FrameBufferData>& pFrame);
+    MRDAStatus GetAvailableOutputBufferFrame(std::shared_ptr<FrameBufferData>& pFrame, uint64_t size);
+    //!
+    //! \brief Write one bitstream packet to output share memory and queue it,
+    //!        a packet larger than a fixed slot is chained over several slots
+    //!
+    //! \param [in] bitstream
+    //! \param [in] size
+    //! \return MRDAStatus
+    //!
+    MRDAStatus WriteOutputPacket(const uint8_t *bitstream, uint64_t size);
+    //!
+    //! \brief Start the bitstream recording tap if the session asks for it,
+    //!        a recording that cannot start leaves the session running
+    //!
+    //! \return MRDAStatus
+    //!
+    MRDAStatus InitRecorder();
+    //!
+    //! \brief Hand one packet to the recording tap, no-op when recording is off
+    //!
+    //! \param [in] bitstream
+    //! \param [in] size
+    //! \param [in] keyFrame
+    //!
+    inline void RecordPacket(const uint8_t *bitstream, uint64_t size, bool keyFrame)
+    {
+        if (m_recorder != nullptr) m_recorder->Write(bitstream, static_cast<uint32_t>(size), m_frameNum, keyFrame);
+    }
 
 protected:
     // Encode thread related
     bool m_isStop; //<! stop flag
     bool m_isEOS; //<! EOS flag
     uint32_t m_frameNum; //<! frame number
-    std::mutex m_inMutex; //<! input list mutex
-    std::mutex m_outMutex; //<! output list mutex
-    std::list<std::shared_ptr<FrameBufferData>> m_inFrameBufferDataList; //<! frame buffer data list
-    std::list<std::shared_ptr<FrameBufferData>> m_outFrameBufferDataList; //<! frame buffer data list
+    BlockingQueue<std::shared_ptr<FrameBufferData>> m_inQueue; //<! input frames, bounded by the input buffers plus EOS
+    BlockingQueue<std::shared_ptr<FrameBufferData>> m_outQueue; //<! output frames, bounded by the output buffers
     std::thread m_encodeThread; //<! encode thread
-    FILE *debug_file = nullptr;
+    ShmByteRing m_outRing; //<! bitstream byte ring of output shared memory
+    std::vector<std::shared_ptr<FrameBufferData>> m_outChain; //<! slots of the packet being written
+    std::unique_ptr<BitstreamRecorder> m_recorder; //<! optional bitstream recording tap
 };
 
 VDI_NS_END
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostNullEncodeService.cpp
+//! \brief implement host null encode service
+//! \date 2026-10-17
+//!
+
+#include "HostNullEncodeService.h"
+
+#include <chrono>
+#include <cstring>
+
+VDI_NS_BEGIN
+
+HostNullEncodeService::HostNullEncodeService(TaskInfo taskInfo)
+    :m_config({NULL_DEFAULT_SERVICE_US, NULL_DEFAULT_PACKET_BYTES, NULL_DEFAULT_KEY_RATIO, NULL_DEFAULT_PACKET_SPREAD, true}),
+     m_packetModel(taskInfo.taskID),
+     m_totalBytes(0),
+     m_readSink(0)
+{
+    m_taskInfo = taskInfo;
+}
+
+HostNullEncodeService::~HostNullEncodeService()
+{
+    m_isStop = true;
+    m_inQueue.Close();
+    if (m_encodeThread.joinable()) m_encodeThread.join();
+}
+
+MRDAStatus HostNullEncodeService::Initialize()
+{
+    if (MRDA_STATUS_SUCCESS != LoadConfig())
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to load null encode config!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    // init share memory
+    if (MRDA_STATUS_SUCCESS != InitShm())
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to init share memory!");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    // optional recording tap, never fails the session
+    InitRecorder();
+    // start encode thread
+    m_encodeThread = std::thread(&HostNullEncodeService::EncodeThread, this);
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus HostNullEncodeService::LoadConfig()
+{
+    if (m_mediaParams == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Media params invalid!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    const EncodeParams &encodeParams = m_mediaParams->encodeParams;
+    m_config = GetNullEncodeConfig(encodeParams);
+    ApplyNullEncodeEnv(m_config);
+    m_packetModel.Initialize(m_config, encodeParams.gop_size);
+
+    MRDA_LOG(LOG_INFO, "Null encode service time %u us, packet %u bytes, gop %u, key ratio %.2f, spread %.2f, read input %d",
+             m_config.serviceTimeUs, m_config.packetBytes, m_packetModel.GopSize(), m_config.keyRatio, m_config.spread, m_config.readInput);
+    return MRDA_STATUS_SUCCESS;
+}
+
+void HostNullEncodeService::ReadInputFrame(std::shared_ptr<FrameBufferData> frame)
+{
+    if (frame == nullptr || frame->MemBuffer() == nullptr || m_inShmMem == nullptr) return;
+
+    const uint8_t *base_ptr = reinterpret_cast<const uint8_t*>(m_inShmMem) + m_inLayout.MemOffset(frame->MemBuffer()->BufId());
+    uint64_t size = frame->MemBuffer()->OccupiedSize();
+    if (size == 0 || size > m_inLayout.slotSize) size = m_inLayout.slotSize;
+    // one byte per cache line pulls the whole frame in
+    uint8_t sum = 0;
+    for (uint64_t i = 0; i < size; i += 64) sum += base_ptr[i];
+    m_readSink = sum;
+}
+
+void* HostNullEncodeService::EncodeThread()
+{
+    BindThreadAffinity();
+    ShmFaultCount faultBegin = GetThreadFaults();
+    while (!m_isStop)
+    {
+        // woken by SendInputData, the timeout rechecks the stop flag
+        std::shared_ptr<FrameBufferData> frame = nullptr;
+        MRDAStatus st = m_inQueue.Pop(frame, HOST_INPUT_WAIT_MS * 1000);
+        if (MRDA_STATUS_NOT_READY == st)
+        {
+            continue;
+        }
+        if (MRDA_STATUS_SUCCESS != st || frame->IsEOS())
+        {
+            // nothing is buffered, so EOS stops the thread at once
+            MRDA_LOG(LOG_INFO, "Stop null encode thread, %u packets, %lu bytes", m_frameNum, m_totalBytes);
+            m_isStop = true;
+            break;
+        }
+        // one frame at a time, like a single encode engine
+        auto done = std::chrono::steady_clock::now() + std::chrono::microseconds(m_config.serviceTimeUs);
+        if (m_config.readInput) ReadInputFrame(frame);
+        std::this_thread::sleep_until(done);
+        UnRefInputFrame(frame);
+
+        bool keyFrame = m_packetModel.IsKeyFrame(m_frameNum);
+        uint64_t size = m_packetModel.NextPacketSize(keyFrame);
+        if (m_packet.size() < size) m_packet.resize(size);
+        // stamp the frame number so receivers can check order and loss
+        memcpy(m_packet.data(), &m_frameNum, sizeof(m_frameNum));
+        RecordPacket(m_packet.data(), size, keyFrame);
+        if (MRDA_STATUS_SUCCESS != WriteOutputPacket(m_packet.data(), size))
+        {
+            MRDA_LOG(LOG_ERROR, "Failed to write null packet %u!", m_frameNum);
+            m_isStop = true;
+            break;
+        }
+        m_totalBytes += size;
+        m_frameNum++;
+    }
+    AccountThreadFaults(faultBegin, m_streamFaults);
+    return nullptr;
+}
+
+VDI_NS_END
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostNullEncodeService.h
+//! \brief synthetic encode service emitting fake packets at a configured
+//!        pace, to benchmark the data path end to end without a codec
+//! \date 2026-10-17
+//!
+
+#ifndef _HOSTNULLENCODESERVICE_H_
+#define _HOSTNULLENCODESERVICE_H_
+
+#include "../HostEncodeService.h"
+#include "NullPacketModel.h"
+
+VDI_NS_BEGIN
+
+//!
+//! \brief Encode service without a codec: each input slot is held for the
+//!        service time, optionally read, released, and answered with a
+//!        packet of random size drawn around the stream's packet size.
+//!        Runs on any host and loads no device, so a single host can
+//!        benchmark hundreds of sessions of shared memory and transport.
+//!
+class HostNullEncodeService : public HostEncodeService
+{
+public:
+    //!
+    //! \brief Construct a new Host Null Encode Service object
+    //!
+    HostNullEncodeService(TaskInfo taskInfo);
+    //!
+    //! \brief Destroy the Host Null Encode Service object
+    //!
+    virtual ~HostNullEncodeService();
+    //!
+    //! \brief Initialize null encode service
+    //!
+    //! \return MRDAStatus
+    //!
+    virtual MRDAStatus Initialize() override;
+
+private:
+    //!
+    //! \brief Load the configuration from the environment of the host
+    //!
+    //! \return MRDAStatus
+    //!
+    MRDAStatus LoadConfig();
+    //!
+    //! \brief Read an input frame the way an encoder would, to bring the
+    //!        cost of fetching shared memory into the benchmark
+    //!
+    //! \param [in] frame
+    //!
+    void ReadInputFrame(std::shared_ptr<FrameBufferData> frame);
+    //!
+    //! \brief Encode thread
+    //!
+    //! \return void*
+    //!
+    void* EncodeThread();
+
+private:
+    TaskInfo m_taskInfo; //<! Task information
+    NullEncodeConfig m_config; //<! synthetic encoder configuration
+    NullPacketModel m_packetModel; //<! packet sizes, seeded per task
+    std::vector<uint8_t> m_packet; //<! scratch of the packet being written
+    uint64_t m_totalBytes; //<! bytes emitted over the session
+    volatile uint8_t m_readSink; //<! keeps input reads from being optimized out
+};
+
+VDI_NS_END
+#endif // _HOSTNULLENCODESERVICE_H_
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file NullPacketModel.h
+//! \brief configuration and packet sizes of the synthetic encoder, kept
+//!        apart from the service so they build without the transport
+//! \date 2026-10-17
+//!
+
+#ifndef _NULLPACKETMODEL_H_
+#define _NULLPACKETMODEL_H_
+
+#include "../../../utils/common.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+VDI_NS_BEGIN
+
+constexpr const char *NULL_SERVICE_US_ENV = "MRDA_NULL_SERVICE_US";         //<! service time of one frame in microseconds
+constexpr const char *NULL_PACKET_BYTES_ENV = "MRDA_NULL_PACKET_BYTES";     //<! mean packet size over a GOP, default from the bit rate
+constexpr const char *NULL_KEY_RATIO_ENV = "MRDA_NULL_KEY_RATIO";           //<! key packet size against an inter packet
+constexpr const char *NULL_PACKET_SPREAD_ENV = "MRDA_NULL_PACKET_SPREAD";   //<! standard deviation of packet sizes against their mean
+constexpr const char *NULL_READ_INPUT_ENV = "MRDA_NULL_READ_INPUT";         //<! 0 to release input slots without reading them
+
+constexpr uint32_t NULL_DEFAULT_SERVICE_US = 2000;      //<! in the range of a hardware 1080p encode
+constexpr uint32_t NULL_DEFAULT_PACKET_BYTES = 20000;   //<! used when the session carries no bit rate
+constexpr float NULL_DEFAULT_KEY_RATIO = 8.0f;
+constexpr float NULL_DEFAULT_PACKET_SPREAD = 0.3f;
+constexpr uint32_t NULL_MIN_PACKET_BYTES = 16;
+
+//!
+//! \brief Configuration of the synthetic encoder
+//!
+typedef struct NULLENCODECONFIG
+{
+    uint32_t serviceTimeUs;     //!< time one frame occupies the encoder
+    uint32_t packetBytes;       //!< mean packet size over a GOP
+    float    keyRatio;          //!< key packet size against an inter packet
+    float    spread;            //!< standard deviation against the mean size
+    bool     readInput;         //!< read every input frame as an encoder would
+} NullEncodeConfig;
+
+//!
+//! \brief Get the configuration of a session before the host overrides,
+//!        the stream's own bit rate sets the packet size
+//!
+//! \param [in] encodeParams
+//! \return NullEncodeConfig
+//!
+inline NullEncodeConfig GetNullEncodeConfig(const EncodeParams &encodeParams)
+{
+    NullEncodeConfig config = {NULL_DEFAULT_SERVICE_US, NULL_DEFAULT_PACKET_BYTES, NULL_DEFAULT_KEY_RATIO, NULL_DEFAULT_PACKET_SPREAD, true};
+    if (encodeParams.rc_mode == 1 && encodeParams.bit_rate > 0
+        && encodeParams.framerate_num > 0 && encodeParams.framerate_den > 0)
+    {
+        config.packetBytes = static_cast<uint32_t>(static_cast<uint64_t>(encodeParams.bit_rate) * 1000 / 8
+            * encodeParams.framerate_den / encodeParams.framerate_num);
+    }
+    return config;
+}
+
+//!
+//! \brief Apply the overrides set in the environment of the host, then
+//!        put back the defaults of values a packet size cannot use
+//!
+//! \param [in, out] config
+//!
+inline void ApplyNullEncodeEnv(NullEncodeConfig &config)
+{
+    const char *value = getenv(NULL_SERVICE_US_ENV);
+    if (value != nullptr && *value != '\0') config.serviceTimeUs = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+    value = getenv(NULL_PACKET_BYTES_ENV);
+    if (value != nullptr && *value != '\0') config.packetBytes = static_cast<uint32_t>(strtoul(value, nullptr, 10));
+    value = getenv(NULL_KEY_RATIO_ENV);
+    if (value != nullptr && *value != '\0') config.keyRatio = strtof(value, nullptr);
+    value = getenv(NULL_PACKET_SPREAD_ENV);
+    if (value != nullptr && *value != '\0') config.spread = strtof(value, nullptr);
+    value = getenv(NULL_READ_INPUT_ENV);
+    if (value != nullptr && *value != '\0') config.readInput = strcmp(value, "0") != 0;
+
+    if (config.packetBytes < NULL_MIN_PACKET_BYTES)
+    {
+        MRDA_LOG(LOG_WARNING, "Null encode packet size %u too small, use %u", config.packetBytes, NULL_DEFAULT_PACKET_BYTES);
+        config.packetBytes = NULL_DEFAULT_PACKET_BYTES;
+    }
+    if (!(config.keyRatio >= 1.0f))
+    {
+        MRDA_LOG(LOG_WARNING, "Null encode key ratio %.2f invalid, use %.2f", config.keyRatio, NULL_DEFAULT_KEY_RATIO);
+        config.keyRatio = NULL_DEFAULT_KEY_RATIO;
+    }
+    if (!(config.spread >= 0.0f))
+    {
+        MRDA_LOG(LOG_WARNING, "Null encode packet spread %.2f invalid, use %.2f", config.spread, NULL_DEFAULT_PACKET_SPREAD);
+        config.spread = NULL_DEFAULT_PACKET_SPREAD;
+    }
+}
+
+//!
+//! \brief Draws packet sizes around the mean of the stream: the GOP
+//!        budget is split so one key packet and the inter packets
+//!        average the configured size, a given seed repeats its sizes
+//!
+class NullPacketModel
+{
+public:
+    //!
+    //! \brief Construct a new Null Packet Model object
+    //!
+    //! \param [in] seed
+    //!
+    NullPacketModel(uint32_t seed):
+    m_gopSize(1),
+    m_keyRatio(NULL_DEFAULT_KEY_RATIO),
+    m_spread(NULL_DEFAULT_PACKET_SPREAD),
+    m_interMean(static_cast<float>(NULL_DEFAULT_PACKET_BYTES)),
+    m_rng(seed)
+    {
+    }
+    //!
+    //! \brief Set the sizes of the stream
+    //!
+    //! \param [in] config
+    //! \param [in] gopSize
+    //!             0 is taken as all key packets
+    //!
+    void Initialize(const NullEncodeConfig &config, uint32_t gopSize)
+    {
+        m_gopSize = std::max(gopSize, 1u);
+        m_keyRatio = config.keyRatio;
+        m_spread = config.spread;
+        m_interMean = static_cast<float>(config.packetBytes) * m_gopSize / (m_gopSize - 1 + m_keyRatio);
+    }
+    //!
+    //! \brief Get the distance between two key packets
+    //!
+    //! \return uint32_t
+    //!
+    uint32_t GopSize() const { return m_gopSize; }
+    //!
+    //! \brief Check if a frame starts a GOP
+    //!
+    //! \param [in] frameNum
+    //! \return bool
+    //!
+    bool IsKeyFrame(uint32_t frameNum) const { return (frameNum % m_gopSize) == 0; }
+    //!
+    //! \brief Get the mean size of a key or an inter packet
+    //!
+    //! \param [in] keyFrame
+    //! \return float
+    //!
+    float MeanSize(bool keyFrame) const { return keyFrame ? m_interMean * m_keyRatio : m_interMean; }
+    //!
+    //! \brief Draw the size of the next packet
+    //!
+    //! \param [in] keyFrame
+    //! \return uint64_t
+    //!
+    uint64_t NextPacketSize(bool keyFrame)
+    {
+        float mean = MeanSize(keyFrame);
+        // a normal distribution needs a positive deviation
+        if (m_spread <= 0.0f) return static_cast<uint64_t>(std::max(mean, static_cast<float>(NULL_MIN_PACKET_BYTES)));
+        std::normal_distribution<float> dist(mean, mean * m_spread);
+        // the tail is cut so a rare draw does not overrun the output memory
+        float size = std::min(std::max(dist(m_rng), static_cast<float>(NULL_MIN_PACKET_BYTES)), mean * 4);
+        return static_cast<uint64_t>(size);
+    }
+
+private:
+    uint32_t m_gopSize;     //<! distance between two key packets
+    float m_keyRatio;       //<! key packet size against an inter packet
+    float m_spread;         //<! standard deviation against the mean size
+    float m_interMean;      //<! mean size of an inter packet
+    std::mt19937 m_rng;     //<! packet size generator, seeded per task
+};
+
+VDI_NS_END
+#endif // _NULLPACKETMODEL_H_
@@ -47,12 +47,16 @@ VDI_NS_BEGIN
 
 HostVPLEncodeService::HostVPLEncodeService(TaskInfo taskInfo)
 {
-    debug_file = fopen("out_host.hevc", "wb");
     m_taskInfo = taskInfo;
 }
 
 HostVPLEncodeService::~HostVPLEncodeService()
 {
+    // wake the media thread at once and stop it before its session goes away
+    m_isStop = true;
+    m_inQueue.Close();
+    if (m_encodeThread.joinable()) m_encodeThread.join();
+
     if (m_session)
     {
         MFXVideoENCODE_Close(m_session);
@@ -62,10 +66,6 @@ HostVPLEncodeService::~HostVPLEncodeService()
     {
         MFXUnload(m_loader);
     }
-
-    m_encodeThread.join();
-
-    fclose(debug_file);
 }
 
 MRDAStatus HostVPLEncodeService::Initialize()
@@ -94,6 +94,8 @@ MRDAStatus HostVPLEncodeService::Initialize()
         MRDA_LOG(LOG_ERROR, "Failed to init share memory!");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // optional recording tap, never fails the session
+    InitRecorder();
     // start encode thread
     m_encodeThread = std::thread(&HostVPLEncodeService::EncodeThread, this);
     return MRDA_STATUS_SUCCESS;
@@ -147,65 +149,65 @@ MRDAStatus HostVPLEncodeService::FillFrameToSurface(std::shared_ptr<FrameBufferD
 
     mfxU16 w = info->CropW;
     mfxU16 h = info->CropH;
-    mfxU16 pitch = 0, i = 0;
+    mfxU16 pitch = 0;
     size_t bytes_read = 0;
     mfxU8 *ptr = nullptr;
-    // offset = memory offset + state offset (sizeof(uint32))
+    // payload starts at memory offset, state lives in the state table
     if (frame->MemBuffer() == nullptr) return MRDA_STATUS_INVALID_DATA;
-    size_t base_offset = frame->MemBuffer()->MemOffset();
+    size_t base_offset = m_inLayout.MemOffset(frame->MemBuffer()->BufId());
+    // row pitch from guest, 0 means tightly packed rows
+    uint64_t src_pitch = frame->MemBuffer()->Pitch();
+    // planes are copied in stripes on the host worker pool for large frames
+    uint32_t stripes = GetStripeNum(w, h);
+    MRDAStatus st = MRDA_STATUS_SUCCESS;
 
     switch (info->FourCC) {
         case MFX_FOURCC_I420: {
             // read luminance plane (Y)
+            st = CheckInputPitch(src_pitch, w, h * 3 / 2);
+            if (MRDA_STATUS_SUCCESS != st) break;
             pitch = data->Pitch;
             ptr   = data->Y;
             char* in_shm_offset_y = m_inShmMem + base_offset;
-            for (i = 0; i < h; i++) {
-                memcpy(ptr + i * pitch, in_shm_offset_y + i * w, w);
-            }
+            CopyPlane(ptr, pitch, reinterpret_cast<uint8_t*>(in_shm_offset_y), src_pitch, w, h, stripes);
 
             // read chrominance (U, V)
+            char* in_shm_offset_u = in_shm_offset_y + src_pitch * h;
+            char* in_shm_offset_v = in_shm_offset_u + src_pitch * h / 4;
             pitch /= 2;
+            src_pitch /= 2;
             h /= 2;
             w /= 2;
             ptr = data->U;
-            char* in_shm_offset_u = m_inShmMem + base_offset + w * h;
-            for (i = 0; i < h; i++) {
-                memcpy(ptr + i * pitch, in_shm_offset_u + i * w, w);
-            }
+            CopyPlane(ptr, pitch, reinterpret_cast<uint8_t*>(in_shm_offset_u), src_pitch, w, h, stripes);
 
             ptr = data->V;
-            char* in_shm_offset_v = m_inShmMem + base_offset + w * h * 5 / 4;
-            for (i = 0; i < h; i++) {
-                memcpy(ptr + i * pitch, in_shm_offset_v + i * w, w);
-            }
+            CopyPlane(ptr, pitch, reinterpret_cast<uint8_t*>(in_shm_offset_v), src_pitch, w, h, stripes);
             break;
         }
         case MFX_FOURCC_NV12: {
             // Y
+            st = CheckInputPitch(src_pitch, w, h * 3 / 2);
+            if (MRDA_STATUS_SUCCESS != st) break;
             pitch = data->Pitch;
             ptr   = data->Y;
             char* in_shm_offset_y = m_inShmMem + base_offset;
-            for (i = 0; i < h; i++) {
-                memcpy(ptr + i * pitch, in_shm_offset_y + i * w, w);
-            }
+            CopyPlane(ptr, pitch, reinterpret_cast<uint8_t*>(in_shm_offset_y), src_pitch, w, h, stripes);
             // UV
             ptr = data->UV;
-            char* in_shm_offset_uv = m_inShmMem + base_offset + w * h;
+            char* in_shm_offset_uv = in_shm_offset_y + src_pitch * h;
             h /= 2;
-            for (i = 0; i < h; i++) {
-                memcpy(ptr + i * pitch, in_shm_offset_uv + i * w, w);
-            }
+            CopyPlane(ptr, pitch, reinterpret_cast<uint8_t*>(in_shm_offset_uv), src_pitch, w, h, stripes);
             break;
         }
         case MFX_FOURCC_RGB4: {
             // Y
+            st = CheckInputPitch(src_pitch, w * 4, h);
+            if (MRDA_STATUS_SUCCESS != st) break;
             ptr   = data->B;
             char* in_shm_offset = m_inShmMem + base_offset;
             pitch = data->Pitch;
-            for (i = 0; i < h; i++) {
-                memcpy(ptr + i * pitch, in_shm_offset + i * pitch, pitch);
-            }
+            CopyPlane(ptr, pitch, reinterpret_cast<uint8_t*>(in_shm_offset), src_pitch, w * 4, h, stripes);
             break;
         }
         default:
@@ -220,7 +222,7 @@ MRDAStatus HostVPLEncodeService::FillFrameToSurface(std::shared_ptr<FrameBufferD
         return sts;
     }
 
-    return MRDA_STATUS_SUCCESS;
+    return st;
 }
 
 MRDAStatus HostVPLEncodeService::WriteToOutputShareMemoryBuffer(mfxBitstream* pBS)
@@ -236,32 +238,9 @@ MRDAStatus HostVPLEncodeService::WriteToOutputShareMemoryBuffer(mfxBitstream* pB
         MRDA_LOG(LOG_ERROR, "m_outShmMem is null\n");
         return MRDA_STATUS_INVALID_DATA;
     }
-    // Get one available buffer frame from output memory pool
-    std::shared_ptr<FrameBufferData> data = nullptr;
-    if (MRDA_STATUS_SUCCESS != GetAvailableOutputBufferFrame(data))
-    {
-        MRDA_LOG(LOG_ERROR, "GetAvailableOutputBufferFrame failed\n");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-    if (data == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "data is null\n");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-    // write to out share memory
-    RefOutputFrame(data);
-    if (data->MemBuffer() == nullptr) return MRDA_STATUS_INVALID_DATA;
-    size_t mem_offset = data->MemBuffer()->MemOffset();
-    memcpy(m_outShmMem + mem_offset, pBS->Data + pBS->DataOffset, pBS->DataLength);
-    data->MemBuffer()->SetOccupiedSize(pBS->DataLength);
-
-    fwrite(pBS->Data + pBS->DataOffset, 1, pBS->DataLength, debug_file);
-    // update output buffer list
-    std::unique_lock<std::mutex> lock(m_outMutex);
-    m_outFrameBufferDataList.push_back(data);
-    // MRDA_LOG(LOG_INFO, "Push back output buffer at pts %llu", data->Pts());
-
-    return MRDA_STATUS_SUCCESS;
+    RecordPacket(pBS->Data + pBS->DataOffset, pBS->DataLength, (pBS->FrameType & (MFX_FRAMETYPE_IDR | MFX_FRAMETYPE_I)) != 0);
+    // write to out share memory and update output buffer list
+    return WriteOutputPacket(pBS->Data + pBS->DataOffset, pBS->DataLength);
 }
 
 MRDAStatus HostVPLEncodeService::EncodeOneFrame(mfxFrameSurface1* pSurface)
@@ -341,6 +320,8 @@ MRDAStatus HostVPLEncodeService::EncodeOneFrame(mfxFrameSurface1* pSurface)
 
 void* HostVPLEncodeService::EncodeThread()
 {
+    BindThreadAffinity();
+    ShmFaultCount faultBegin = GetThreadFaults();
     while (!m_isStop)
     {
         // get one frame
@@ -349,14 +330,19 @@ void* HostVPLEncodeService::EncodeThread()
         if (m_isEOS == false)
         {
             {
-                if (m_inFrameBufferDataList.empty())
+                // woken by SendInputData, the timeout rechecks the stop flag
+                MRDAStatus st = m_inQueue.Pop(frame, HOST_INPUT_WAIT_MS * 1000);
+                if (MRDA_STATUS_NOT_READY == st)
                 {
-                    usleep(5 * 1000);//5ms
                     continue;
                 }
-                std::unique_lock<std::mutex> lock(m_inMutex);
-                frame = m_inFrameBufferDataList.front();
-                m_inFrameBufferDataList.pop_front();
+                if (MRDA_STATUS_SUCCESS != st)
+                {
+                    // closed without EOS, drain what is in flight
+                    MRDA_LOG(LOG_INFO, "Input queue closed, drain the pipeline");
+                    m_isEOS = true;
+                    continue;
+                }
                 if (frame->IsEOS())
                 {
                     MRDA_LOG(LOG_INFO, "Get EOS frame!!!!!!!!\n");
@@ -372,6 +358,7 @@ void* HostVPLEncodeService::EncodeThread()
         {
             MRDA_LOG(LOG_ERROR, "EncodeOneFrame failed!");
             m_isStop = true;
+            AccountThreadFaults(faultBegin, m_streamFaults);
             return nullptr;
         }
         else
@@ -380,6 +367,7 @@ void* HostVPLEncodeService::EncodeThread()
             UnRefInputFrame(frame);
         }
     }
+    AccountThreadFaults(faultBegin, m_streamFaults);
     return nullptr;
 }
 
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostObjectPool.h
+//! \brief Bounded per-session pool of reference counted objects used on
+//!        the host frame path, objects are recycled once no one else
+//!        holds them.
+//! \date 2026-10-17
+//!
+
+#ifndef _HOST_OBJECT_POOL_H_
+#define _HOST_OBJECT_POOL_H_
+
+#include "../utils/common.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t HOST_OBJECT_POOL_SIZE = 64; //<! default bound of pooled objects per session
+constexpr size_t HOST_POOL_BLOCK_SIZE = 64;    //<! storage of the shared pointer control block of one object
+
+template <typename T>
+class HostObjectPool
+{
+public:
+    //!
+    //! \brief Construct a new Host Object Pool object
+    //!
+    //! \param [in] capacity
+    //!             max number of pooled objects
+    //!
+    explicit HostObjectPool(uint32_t capacity = HOST_OBJECT_POOL_SIZE)
+        : m_capacity(capacity),
+          m_cursor(0),
+          m_allocCount(0)
+    {
+        m_entries.reserve(capacity);
+    }
+    //!
+    //! \brief Destroy the Host Object Pool object, objects still held
+    //!        stay alive until their last holder is done
+    //!
+    virtual ~HostObjectPool() = default;
+
+    //!
+    //! \brief Get one object no one else holds, allocate when all pooled
+    //!        objects are in use, the caller resets every field it uses
+    //!
+    //! \return std::shared_ptr<T>
+    //!
+    std::shared_ptr<T> Get()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t num = m_entries.size();
+        for (size_t i = 0; i < num; i++)
+        {
+            size_t idx = (m_cursor + i) % num;
+            std::shared_ptr<Entry> &entry = m_entries[idx];
+            // pairs with the release store of the last holder, so all its
+            // writes to the object are visible before the object is reused
+            if (!entry->inUse.load(std::memory_order_acquire))
+            {
+                m_cursor = (idx + 1) % num;
+                return Lend(entry);
+            }
+        }
+        m_allocCount++;
+        // grow up to the bound, beyond it objects are not recycled
+        if (m_entries.size() < m_capacity)
+        {
+            m_entries.push_back(std::make_shared<Entry>());
+            return Lend(m_entries.back());
+        }
+        return std::make_shared<T>();
+    }
+
+    //!
+    //! \brief Get the number of heap allocations made by the pool
+    //!
+    //! \return uint64_t
+    //!
+    inline uint64_t AllocCount() const { return m_allocCount.load(std::memory_order_relaxed); }
+
+private:
+    //!
+    //! \brief Pooled object with its use flag and the storage of the
+    //!        control block of the pointer lent out, so lending allocates
+    //!        nothing
+    //!
+    struct Entry
+    {
+        T object;                                //!< the pooled object
+        std::atomic<bool> inUse{false};          //!< lent out, cleared once the last holder is done
+        alignas(std::max_align_t) unsigned char block[HOST_POOL_BLOCK_SIZE]; //!< control block storage
+    };
+
+    //!
+    //! \brief Deleter of a lent pointer, the entry owns the object
+    //!
+    struct KeepObject
+    {
+        void operator()(T *) const {}
+    };
+
+    //!
+    //! \brief Allocator placing the control block of a lent pointer in its
+    //!        entry. The control block is freed after the last holder and
+    //!        the deleter are done with it, so the entry is marked free
+    //!        there. It holds the entry so a pool destroyed first does not
+    //!        free an object still in use.
+    //!
+    template <typename U>
+    struct BlockAllocator
+    {
+        using value_type = U;
+
+        explicit BlockAllocator(std::shared_ptr<Entry> entry) : entry(std::move(entry)) {}
+        template <typename V>
+        BlockAllocator(const BlockAllocator<V> &other) : entry(other.entry) {}
+
+        U *allocate(size_t)
+        {
+            // a shared pointer allocates exactly one control block
+            static_assert(sizeof(U) <= HOST_POOL_BLOCK_SIZE && alignof(U) <= alignof(std::max_align_t),
+                          "control block does not fit the pool entry");
+            return reinterpret_cast<U*>(entry->block);
+        }
+        void deallocate(U *, size_t)
+        {
+            entry->inUse.store(false, std::memory_order_release);
+        }
+        template <typename V>
+        bool operator==(const BlockAllocator<V> &other) const { return entry == other.entry; }
+        template <typename V>
+        bool operator!=(const BlockAllocator<V> &other) const { return entry != other.entry; }
+
+        std::shared_ptr<Entry> entry; //!< entry owning the block
+    };
+
+    //!
+    //! \brief Lend the object of a free entry, mutex held
+    //!
+    //! \param [in] entry
+    //! \return std::shared_ptr<T>
+    //!
+    std::shared_ptr<T> Lend(const std::shared_ptr<Entry> &entry)
+    {
+        entry->inUse.store(true, std::memory_order_relaxed);
+        return std::shared_ptr<T>(&entry->object, KeepObject(), BlockAllocator<T>(entry));
+    }
+
+private:
+    std::vector<std::shared_ptr<Entry>> m_entries; //<! pooled objects
+    uint32_t m_capacity; //<! max number of pooled objects
+    size_t m_cursor; //<! next position to probe
+    std::atomic<uint64_t> m_allocCount; //<! number of objects allocated
+    std::mutex m_mutex; //<! guard of the pooled objects
+};
+
+VDI_NS_END
+#endif // _HOST_OBJECT_POOL_H_
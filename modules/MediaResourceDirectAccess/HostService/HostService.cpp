@@ -33,10 +33,41 @@
 
 #include "HostService.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <linux/magic.h>
+#include <linux/mempolicy.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/vfs.h>
+#include <unistd.h>
+
 
 VDI_NS_BEGIN
 
 MRDAStatus HostService::GetInShmFilePtr(std::string filePath)
+{
+    MRDAStatus status = MapShmFile(filePath, m_inShmFile, m_inShmMem, m_inShmSize);
+    if (MRDA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    return AttachShmRegion(m_inShmMem, m_inShmSize, m_inLayout, m_inBufIndex, m_inDescRing);
+}
+
+MRDAStatus HostService::GetOutShmFilePtr(std::string filePath)
+{
+    MRDAStatus status = MapShmFile(filePath, m_outShmFile, m_outShmMem, m_outShmSize);
+    if (MRDA_STATUS_SUCCESS != status)
+    {
+        return status;
+    }
+
+    return AttachShmRegion(m_outShmMem, m_outShmSize, m_outLayout, m_outBufIndex, m_outDescRing);
+}
+
+MRDAStatus HostService::MapShmFile(const std::string &filePath, int &shmFile, char *&shmMem, size_t &shmSize)
 {
     if (filePath.empty())
     {
@@ -44,79 +75,277 @@ MRDAStatus HostService::GetInShmFilePtr(std::string filePath)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    std::ifstream file(filePath, std::ios::binary);
+    uint32_t options = 0;
+    int32_t numaNode = -1;
+    if (m_mediaParams != nullptr)
+    {
+        options = m_mediaParams->shareMemoryInfo.hostMapOptions;
+        numaNode = m_mediaParams->shareMemoryInfo.hostNumaNode;
+    }
+    // the node comes from the guest and is a bit of the mbind node mask
+    if (numaNode < -1 || numaNode >= static_cast<int32_t>(sizeof(unsigned long) * 8))
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid NUMA node %d for %s!", numaNode, filePath.c_str());
+        return MRDA_STATUS_INVALID_PARAM;
+    }
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    m_inShmSize = fileSize;
-    file.seekg(0, std::ios::beg);
+    shmFile = open(filePath.c_str(), O_RDWR);
+    if (shmFile < 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to open %s: %s", filePath.c_str(), strerror(errno));
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
 
-    file.close();
+    struct stat st;
+    if (fstat(shmFile, &st) != 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to stat %s: %s", filePath.c_str(), strerror(errno));
+        CloseShmFile(shmFile);
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    shmSize = static_cast<size_t>(st.st_size);
 
-    if (m_mediaParams != nullptr && m_mediaParams->shareMemoryInfo.totalMemorySize > m_inShmSize)
+    if (m_mediaParams != nullptr && m_mediaParams->shareMemoryInfo.totalMemorySize > shmSize)
     {
         MRDA_LOG(LOG_ERROR, "shm size invalid!");
+        CloseShmFile(shmFile);
         return MRDA_STATUS_INVALID_DATA;
     }
+    bool populate = options & static_cast<uint32_t>(ShmMapOption::SHM_MAP_POPULATE);
+    bool hugePage = options & static_cast<uint32_t>(ShmMapOption::SHM_MAP_HUGEPAGE);
+    bool lock = options & static_cast<uint32_t>(ShmMapOption::SHM_MAP_LOCK);
+
+    ShmFaultCount begin = GetThreadFaults();
 
-    m_inShmFile = open(filePath.c_str(), O_RDWR);
+    // MAP_POPULATE faults pages in before mbind and madvise could apply,
+    // so the region is populated after them if either one is requested
+    int flags = MAP_SHARED;
+    bool populateAtMap = populate && !hugePage && numaNode < 0;
+    if (populateAtMap)
+    {
+        flags |= MAP_POPULATE;
+    }
 
-    void* mapped_memory = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_inShmFile, 0);
+    void* mapped_memory = mmap(NULL, shmSize, PROT_READ | PROT_WRITE, flags, shmFile, 0);
 
     if (mapped_memory == MAP_FAILED) {
         MRDA_LOG(LOG_ERROR, "Failed to map the file into memory!");
+        CloseShmFile(shmFile);
         return MRDA_STATUS_OPERATION_FAIL;
     }
 
-    m_inShmMem = (char*)mapped_memory;
+    shmMem = (char*)mapped_memory;
+
+    struct statfs fs;
+    if (fstatfs(shmFile, &fs) == 0 && fs.f_type == HUGETLBFS_MAGIC)
+    {
+        MRDA_LOG(LOG_INFO, "%s is hugetlbfs backed, huge page size %ld", filePath.c_str(), (long)fs.f_bsize);
+    }
+    else if (hugePage && madvise(shmMem, shmSize, MADV_HUGEPAGE) != 0)
+    {
+        // tmpfs only honors it if shmem_enabled is advise or within_size
+        MRDA_LOG(LOG_WARNING, "madvise huge page failed on %s: %s", filePath.c_str(), strerror(errno));
+    }
+
+    if (numaNode >= 0)
+    {
+        unsigned long nodeMask = 1UL << numaNode;
+        if (syscall(SYS_mbind, shmMem, shmSize, MPOL_BIND, &nodeMask, sizeof(nodeMask) * 8, MPOL_MF_MOVE) != 0)
+        {
+            MRDA_LOG(LOG_WARNING, "Failed to bind %s to NUMA node %d: %s", filePath.c_str(), numaNode, strerror(errno));
+        }
+    }
+
+    if (populate && !populateAtMap)
+    {
+        PopulateShmMem(shmMem, shmSize);
+    }
+
+    if (lock && mlock(shmMem, shmSize) != 0)
+    {
+        // limited by RLIMIT_MEMLOCK without CAP_IPC_LOCK
+        MRDA_LOG(LOG_WARNING, "Failed to lock %s: %s", filePath.c_str(), strerror(errno));
+    }
+
+    AccountThreadFaults(begin, m_setupFaults);
 
     return MRDA_STATUS_SUCCESS;
 }
 
-MRDAStatus HostService::GetOutShmFilePtr(std::string filePath)
+void HostService::CloseShmFile(int &shmFile)
 {
-    if (filePath.empty())
+    close(shmFile);
+    shmFile = -1;
+}
+
+void HostService::PopulateShmMem(char *shmMem, size_t shmSize)
+{
+#ifdef MADV_POPULATE_WRITE
+    if (madvise(shmMem, shmSize, MADV_POPULATE_WRITE) == 0)
     {
-        MRDA_LOG(LOG_ERROR, "File path invalid!");
-        return MRDA_STATUS_INVALID_DATA;
+        return;
     }
+#endif
+    // older kernels, fault every page in by reading it, the guest owns the content
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    for (size_t offset = 0; offset < shmSize; offset += pageSize)
+    {
+        (void)*(volatile char*)(shmMem + offset);
+    }
+}
+
+ShmFaultCount HostService::GetThreadFaults()
+{
+    ShmFaultCount count;
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0)
+    {
+        count.minor = static_cast<uint64_t>(usage.ru_minflt);
+        count.major = static_cast<uint64_t>(usage.ru_majflt);
+    }
+    return count;
+}
+
+void HostService::AccountThreadFaults(const ShmFaultCount &begin, ShmFaultCount &total)
+{
+    ShmFaultCount now = GetThreadFaults();
+    total.minor += now.minor - begin.minor;
+    total.major += now.major - begin.major;
+}
 
-    std::ifstream file(filePath, std::ios::binary);
+void HostService::ReportShmFaults()
+{
+    const char *inPath = m_mediaParams != nullptr ? m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str() : "";
+    MRDA_LOG(LOG_INFO, "Session page faults, in dev path: %s, setup minor %lu major %lu, streaming minor %lu major %lu",
+        inPath, m_setupFaults.minor, m_setupFaults.major, m_streamFaults.minor, m_streamFaults.major);
+}
 
-    file.seekg(0, std::ios::end);
-    size_t fileSize = file.tellg();
-    m_outShmSize = fileSize;
-    file.seekg(0, std::ios::beg);
+void HostService::SetAffinity(AffinityPolicy policy, std::shared_ptr<const HostTopology> topology, int32_t deviceNode)
+{
+    m_affinityPolicy = policy;
+    m_topology = std::move(topology);
+    m_deviceNode = deviceNode;
+}
 
-    file.close();
+void HostService::ResolveAffinity()
+{
+    // the larger region carries the frames, the other one the bitstream
+    m_memoryNode = m_inShmSize >= m_outShmSize ? HostTopology::GetMemoryNode(m_inShmMem, m_inShmSize)
+                                               : HostTopology::GetMemoryNode(m_outShmMem, m_outShmSize);
+    m_affinityNode = m_topology != nullptr ? m_topology->ChooseNode(m_affinityPolicy, m_deviceNode, m_memoryNode) : -1;
+    const NumaNodeInfo *node = m_topology != nullptr ? m_topology->GetNode(m_affinityNode) : nullptr;
+    const char *inPath = m_mediaParams != nullptr ? m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str() : "";
+    MRDA_LOG(LOG_INFO, "Session placement, in dev path: %s, policy %d, device node %d, memory node %d, bound node %d, cpus %s",
+        inPath, static_cast<int32_t>(m_affinityPolicy), m_deviceNode, m_memoryNode, m_affinityNode,
+        m_affinityNode >= 0 ? HostTopology::FormatCpuList(node->cpus).c_str() : "any");
+}
 
-    if (m_mediaParams != nullptr && m_mediaParams->shareMemoryInfo.totalMemorySize > m_outShmSize)
+void HostService::BindThreadAffinity()
+{
+    if (m_affinityNode < 0 || m_topology == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "shm size invalid!");
-        return MRDA_STATUS_INVALID_DATA;
+        return;
+    }
+    if (MRDA_STATUS_SUCCESS != m_topology->BindThread(m_affinityNode))
+    {
+        MRDA_LOG(LOG_WARNING, "Session thread stays unbound");
     }
+}
 
-    m_outShmFile = open(filePath.c_str(), O_RDWR);
+std::shared_ptr<FrameBufferData> HostService::GetInputFrameData()
+{
+    return GetPooledFrameData(m_inDataPool);
+}
 
-    void* mapped_memory = mmap(NULL, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_outShmFile, 0);
+std::shared_ptr<FrameBufferData> HostService::GetOutputFrameData()
+{
+    return GetPooledFrameData(m_outDataPool);
+}
 
-    if (mapped_memory == MAP_FAILED) {
-        MRDA_LOG(LOG_ERROR, "Failed to map the file into memory!");
-        return MRDA_STATUS_OPERATION_FAIL;
+std::shared_ptr<FrameBufferData> HostService::GetPooledFrameData(HostObjectPool<FrameBufferData> &pool)
+{
+    std::shared_ptr<FrameBufferData> frame = pool.Get();
+    // the memory buffer stays attached to its frame across reuse
+    if (frame->MemBuffer() == nullptr)
+    {
+        frame->SetMemBuffer(std::make_shared<MemoryBuffer>());
+        CountHotAllocs(1);
     }
+    return frame;
+}
 
-    m_outShmMem = (char*)mapped_memory;
+uint32_t HostService::GetStripeNum(uint32_t width, uint32_t height)
+{
+    uint32_t stripes = m_mediaParams != nullptr ? m_mediaParams->shareMemoryInfo.hostStripes : 0;
+    if (stripes == 0)
+    {
+        // small frames stay on the media thread, fan out costs more than it saves
+        uint64_t pixels = static_cast<uint64_t>(width) * height;
+        stripes = static_cast<uint32_t>((pixels + HOST_STRIPE_AUTO_PIXELS - 1) / HOST_STRIPE_AUTO_PIXELS);
+    }
+    uint32_t maxStripes = HostWorkerPool::Instance().WorkerNum() + 1;
+    return std::max(1u, std::min(stripes, maxStripes));
+}
 
-    return MRDA_STATUS_SUCCESS;
+void HostService::CopyPlane(uint8_t *dst, size_t dstPitch, const uint8_t *src, size_t srcPitch,
+                            size_t rowBytes, uint32_t rows, uint32_t stripes)
+{
+    HostWorkerPool::Instance().RunStripes(rows, stripes, 1, [&](uint32_t rowBegin, uint32_t rowEnd) {
+        for (uint32_t row = rowBegin; row < rowEnd; row++)
+        {
+            memcpy(dst + row * dstPitch, src + row * srcPitch, rowBytes);
+        }
+    });
+}
+
+void HostService::ReportHotAllocs(uint64_t frameNum)
+{
+    const char *inPath = m_mediaParams != nullptr ? m_mediaParams->shareMemoryInfo.in_mem_dev_path.c_str() : "";
+    uint64_t allocs = m_hotAllocs.load(std::memory_order_relaxed)
+        + m_inDataPool.AllocCount() + m_outDataPool.AllocCount();
+    MRDA_LOG(LOG_INFO, "Session heap allocations, in dev path: %s, %lu allocations in %lu frames, %.3f per frame",
+        inPath, allocs, frameNum, frameNum > 0 ? static_cast<double>(allocs) / frameNum : 0.0);
+}
+
+MRDAStatus HostService::AttachShmRegion(char *shmMem, size_t shmSize, ShmRegionLayout &layout, ShmBufferIndex &index, ShmDescRing &descRing)
+{
+    // layout comes from the region header written by the guest pool owner
+    MRDAStatus status = ShmReadRegionHeader(shmMem, shmSize, layout);
+    if (MRDA_STATUS_SUCCESS != status)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to validate shm region header!");
+        return status;
+    }
+    if (m_mediaParams != nullptr
+        && (m_mediaParams->shareMemoryInfo.bufferNum != layout.bufferNum
+        || m_mediaParams->shareMemoryInfo.bufferSize > layout.slotSize))
+    {
+        MRDA_LOG(LOG_WARNING, "Shm params mismatch region header, use header: buffer num %u, slot size %lu",
+            layout.bufferNum, layout.slotSize);
+    }
+    if (!(layout.featureFlags & SHM_FEATURE_FREE_INDEX))
+    {
+        MRDA_LOG(LOG_ERROR, "Shm region has no idle buffer index!");
+        return MRDA_STATUS_NOT_SUPPORTED;
+    }
+    if (m_mediaParams != nullptr && m_mediaParams->shareMemoryInfo.dataPlane == DataPlane::DATA_PLANE_SHM
+        && MRDA_STATUS_SUCCESS != descRing.Attach(shmMem, layout))
+    {
+        MRDA_LOG(LOG_ERROR, "Shm region has no descriptor ring!");
+        return MRDA_STATUS_NOT_SUPPORTED;
+    }
+    return index.Attach(shmMem, layout.bufferNum);
 }
 
 void HostService::RefOutputFrame(std::shared_ptr<FrameBufferData> pFrame)
 {
+    // buffer has been taken from the idle index, just publish its state
     if (pFrame != nullptr && pFrame->MemBuffer() != nullptr)
     {
+        uint32_t bufId = pFrame->MemBuffer()->BufId();
+        if (bufId == 0 || bufId > m_outLayout.bufferNum) return;
         pFrame->MemBuffer()->SetState(BufferState::BUFFER_STATE_BUSY);
-        uint32_t state = static_cast<uint32_t>(pFrame->MemBuffer()->State());
-        memcpy(m_outShmMem + pFrame->MemBuffer()->StateOffset(), &state, sizeof(uint32_t));
+        ShmStoreState(m_outShmMem + m_outLayout.StateOffset(bufId), pFrame->MemBuffer()->State());
         // MRDA_LOG(LOG_INFO, "Ref output buffer at pts %llu, buffer id %d", pFrame->Pts(), pFrame->MemBuffer()->BufId());
     }
 }
@@ -125,11 +354,70 @@ void HostService::UnRefInputFrame(std::shared_ptr<FrameBufferData> pFrame)
 {
     if (pFrame != nullptr && pFrame->MemBuffer() != nullptr)
     {
+        uint32_t bufId = pFrame->MemBuffer()->BufId();
+        if (bufId == 0 || bufId > m_inLayout.bufferNum) return;
         pFrame->MemBuffer()->SetState(BufferState::BUFFER_STATE_IDLE);
-        uint32_t state = static_cast<uint32_t>(pFrame->MemBuffer()->State());
-        memcpy(m_inShmMem + pFrame->MemBuffer()->StateOffset(), &state, sizeof(uint32_t));
+        ShmStoreState(m_inShmMem + m_inLayout.StateOffset(bufId), pFrame->MemBuffer()->State());
+        m_inBufIndex.Release(bufId);
         // MRDA_LOG(LOG_INFO, "UnRef input buffer at pts %llu, buffer id %d", pFrame->Pts(), pFrame->MemBuffer()->BufId());
     }
 }
 
+void HostService::DropOutputFrame(std::shared_ptr<FrameBufferData> pFrame)
+{
+    if (pFrame != nullptr && pFrame->MemBuffer() != nullptr)
+    {
+        // never seen by the guest, so no release is counted or signaled
+        m_outBufIndex.Restore(pFrame->MemBuffer()->BufId());
+    }
+}
+
+MRDAStatus HostService::CheckInputFrame(std::shared_ptr<FrameBufferData> pFrame)
+{
+    if (pFrame == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Input data is null!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    std::shared_ptr<MemoryBuffer> memBuffer = pFrame->MemBuffer();
+    // EOS payload is never read, a frame may end the stream without a buffer
+    if (pFrame->IsEOS() && (memBuffer == nullptr || memBuffer->BufId() == 0))
+    {
+        return MRDA_STATUS_SUCCESS;
+    }
+    if (memBuffer == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Input frame has no buffer!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    uint32_t bufId = memBuffer->BufId();
+    if (bufId == 0 || bufId > m_inLayout.bufferNum)
+    {
+        MRDA_LOG(LOG_ERROR, "Input buffer id %u out of range [1, %u]!", bufId, m_inLayout.bufferNum);
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    if (memBuffer->OccupiedSize() > m_inLayout.slotSize)
+    {
+        MRDA_LOG(LOG_ERROR, "Input size %lu exceeds buffer size %lu!", memBuffer->OccupiedSize(), m_inLayout.slotSize);
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    // the guest only names the slot, where it lives is up to the layout
+    memBuffer->SetMemOffset(m_inLayout.MemOffset(bufId));
+    memBuffer->SetStateOffset(m_inLayout.StateOffset(bufId));
+    memBuffer->SetSize(m_inLayout.slotSize);
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus HostService::CheckInputPitch(uint64_t &pitch, uint64_t rowBytes, uint64_t rows)
+{
+    if (pitch == 0) pitch = rowBytes;
+    // divide instead of multiply, a guest pitch must not overflow the check
+    if (pitch < rowBytes || (rows > 0 && pitch > m_inLayout.slotSize / rows))
+    {
+        MRDA_LOG(LOG_ERROR, "Input pitch %lu with %lu rows does not fit buffer size %lu!", pitch, rows, m_inLayout.slotSize);
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
 VDI_NS_END
\ No newline at end of file
@@ -36,16 +36,36 @@
 
 #include "../utils/common.h"
 #include "../SHMemory/FrameBufferData.h"
+#include "../SHMemory/ShmBufferIndex.h"
+#include "../SHMemory/ShmDescRing.h"
+#include "HostObjectPool.h"
+#include "HostWorkerPool.h"
+#include "HostTopology.h"
 
 #include <fstream>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <cstring>
+#include <functional>
+#include <memory>
 #include <string>
 
 VDI_NS_BEGIN
 
+constexpr uint32_t HOST_INPUT_WAIT_MS = 100; //<! max wait on an empty input list before rechecking the stop flag
+constexpr uint32_t HOST_OUTPUT_WAIT_MS = 10; //<! max wait on an empty output list in ReceiveOutputData
+constexpr uint32_t HOST_STRIPE_AUTO_PIXELS = 1920 * 1088; //<! pixels per stripe when stripes are chosen by resolution
+
+//!
+//! \brief page fault counters of a session
+//!
+struct ShmFaultCount
+{
+    uint64_t minor = 0; //<! minor faults, page was resident
+    uint64_t major = 0; //<! major faults, page needed I/O
+};
+
 class HostService
 {
 public:
@@ -89,6 +109,24 @@ public:
     //!
     virtual MRDAStatus SendInputData(std::shared_ptr<FrameBufferData> data) = 0;
 
+    //!
+    //! \brief Send input data without waiting
+    //!
+    //! \param [in] data
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_READY if the input queue is full
+    //!
+    virtual MRDAStatus TrySendInputData(std::shared_ptr<FrameBufferData> data) = 0;
+
+    //!
+    //! \brief Set a listener called each time input data leaves the input
+    //!        queue, set before Initialize
+    //!
+    //! \param [in] listener
+    //!             must not block, runs on the media thread
+    //!
+    virtual void SetInputListener(std::function<void()> listener) = 0;
+
     //!
     //! \brief
     //!
@@ -107,7 +145,128 @@ public:
     //!
     virtual MRDAStatus ReceiveOutputData(std::shared_ptr<FrameBufferData> &data) = 0;
 
+    //!
+    //! \brief Receive output data without waiting
+    //!
+    //! \param [out] data
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_ENOUGH_DATA if no output is queued
+    //!
+    virtual MRDAStatus TryReceiveOutputData(std::shared_ptr<FrameBufferData> &data) = 0;
+
+    //!
+    //! \brief Set a listener called each time output data is queued, set
+    //!        before Initialize
+    //!
+    //! \param [in] listener
+    //!             must not block, runs on the media thread
+    //!
+    virtual void SetOutputListener(std::function<void()> listener) = 0;
+
+    //!
+    //! \brief Get a pooled frame for an input buffer sent by the guest
+    //!
+    //! \return std::shared_ptr<FrameBufferData>
+    //!         frame with a memory buffer attached
+    //!
+    std::shared_ptr<FrameBufferData> GetInputFrameData();
+
+    //!
+    //! \brief Get the descriptor ring of the input shared memory
+    //!
+    //! \return ShmDescRing*
+    //!         nullptr if the region has no descriptor ring
+    //!
+    inline ShmDescRing* InDescRing() { return m_inDescRing.IsAttached() ? &m_inDescRing : nullptr; }
+
+    //!
+    //! \brief Get the descriptor ring of the output shared memory
+    //!
+    //! \return ShmDescRing*
+    //!         nullptr if the region has no descriptor ring
+    //!
+    inline ShmDescRing* OutDescRing() { return m_outDescRing.IsAttached() ? &m_outDescRing : nullptr; }
+
+    //!
+    //! \brief Set how the session threads are placed, set before
+    //!        SetInitParams maps the shared memory
+    //!
+    //! \param [in] policy
+    //! \param [in] topology
+    //!             host topology, nullptr leaves the threads floating
+    //! \param [in] deviceNode
+    //!             node of the assigned device, -1 if unknown
+    //!
+    void SetAffinity(AffinityPolicy policy, std::shared_ptr<const HostTopology> topology, int32_t deviceNode);
+
+    //!
+    //! \brief Bind the calling session thread to the chosen node, no-op if
+    //!        none is chosen
+    //!
+    void BindThreadAffinity();
+
 protected:
+    //!
+    //! \brief Choose the node of the session once the shared memory is
+    //!        mapped and log the placement
+    //!
+    void ResolveAffinity();
+
+    //!
+    //! \brief Get a pooled frame for an output buffer
+    //!
+    //! \return std::shared_ptr<FrameBufferData>
+    //!         frame with a memory buffer attached
+    //!
+    std::shared_ptr<FrameBufferData> GetOutputFrameData();
+
+    //!
+    //! \brief Get one frame from a pool, with its memory buffer
+    //!
+    //! \param [in] pool
+    //! \return std::shared_ptr<FrameBufferData>
+    //!
+    std::shared_ptr<FrameBufferData> GetPooledFrameData(HostObjectPool<FrameBufferData> &pool);
+
+    //!
+    //! \brief Count heap allocations made on the frame path
+    //!
+    //! \param [in] num
+    //!
+    inline void CountHotAllocs(uint64_t num) { m_hotAllocs.fetch_add(num, std::memory_order_relaxed); }
+
+    //!
+    //! \brief Get the number of stripes for a frame with the session policy
+    //!
+    //! \param [in] width
+    //! \param [in] height
+    //! \return uint32_t
+    //!         1 to stay on the media thread
+    //!
+    uint32_t GetStripeNum(uint32_t width, uint32_t height);
+
+    //!
+    //! \brief Copy rows of a plane, split in stripes on the worker pool
+    //!
+    //! \param [out] dst
+    //! \param [in] dstPitch
+    //! \param [in] src
+    //! \param [in] srcPitch
+    //! \param [in] rowBytes
+    //! \param [in] rows
+    //! \param [in] stripes
+    //!
+    void CopyPlane(uint8_t *dst, size_t dstPitch, const uint8_t *src, size_t srcPitch,
+                   size_t rowBytes, uint32_t rows, uint32_t stripes);
+
+    //!
+    //! \brief Log heap allocations per frame taken by this session
+    //!
+    //! \param [in] frameNum
+    //!             frames processed by the session
+    //!
+    void ReportHotAllocs(uint64_t frameNum);
+
     //!
     //! \brief Get the In Shm File Ptr object
     //!
@@ -137,6 +296,93 @@ protected:
     //!
     void UnRefInputFrame(std::shared_ptr<FrameBufferData> frame);
 
+    //!
+    //! \brief give an acquired but unused output frame back
+    //!
+    //! \param [in] frame
+    //!
+    void DropOutputFrame(std::shared_ptr<FrameBufferData> frame);
+
+    //!
+    //! \brief Check the buffer id of a guest input frame against the input
+    //!        layout and take offsets and size from the layout, not the guest
+    //!
+    //! \param [in] frame
+    //! \return MRDAStatus
+    //!
+    MRDAStatus CheckInputFrame(std::shared_ptr<FrameBufferData> frame);
+
+    //!
+    //! \brief Check a guest row pitch against the row bytes and the input
+    //!        slot size, 0 pitch is replaced with tightly packed rows
+    //!
+    //! \param [in,out] pitch
+    //! \param [in] rowBytes
+    //! \param [in] rows
+    //! \return MRDAStatus
+    //!
+    MRDAStatus CheckInputPitch(uint64_t &pitch, uint64_t rowBytes, uint64_t rows);
+
+    //!
+    //! \brief Validate the region header and attach idle buffer index and
+    //!        descriptor ring
+    //!
+    //! \param [in] shmMem
+    //! \param [in] shmSize
+    //! \param [out] layout
+    //! \param [out] index
+    //! \param [out] descRing
+    //! \return MRDAStatus
+    //!
+    MRDAStatus AttachShmRegion(char *shmMem, size_t shmSize, ShmRegionLayout &layout, ShmBufferIndex &index, ShmDescRing &descRing);
+
+    //!
+    //! \brief Open and map a shm backing file with the session map options
+    //!
+    //! \param [in] filePath
+    //! \param [out] shmFile
+    //! \param [out] shmMem
+    //! \param [out] shmSize
+    //! \return MRDAStatus
+    //!
+    MRDAStatus MapShmFile(const std::string &filePath, int &shmFile, char *&shmMem, size_t &shmSize);
+
+    //!
+    //! \brief Close a share memory file that failed to map
+    //!
+    //! \param [in/out] shmFile
+    //!                 set to -1 once closed
+    //!
+    void CloseShmFile(int &shmFile);
+
+    //!
+    //! \brief Fault in all pages of a mapping without changing its content
+    //!
+    //! \param [in] shmMem
+    //! \param [in] shmSize
+    //!
+    void PopulateShmMem(char *shmMem, size_t shmSize);
+
+    //!
+    //! \brief Get page fault counters of the calling thread
+    //!
+    //! \return ShmFaultCount
+    //!
+    static ShmFaultCount GetThreadFaults();
+
+    //!
+    //! \brief Add faults taken by the calling thread since begin to total
+    //!
+    //! \param [in] begin
+    //! \param [in, out] total
+    //!
+    void AccountThreadFaults(const ShmFaultCount &begin, ShmFaultCount &total);
+
+    //!
+    //! \brief Log page faults taken by this session
+    //!
+    void ReportShmFaults();
+
 protected:
     std::unique_ptr<MediaParams> m_mediaParams = nullptr; //<! media parameters
 
@@ -147,6 +393,24 @@ protected:
     int m_outShmFile = -1; //<! output shared memory file path
     char *m_outShmMem = nullptr; //<! output shared memory buffer
     size_t m_outShmSize = 0; //<! output shared memory buffer size
+    ShmBufferIndex m_inBufIndex; //<! idle buffer index of input shared memory
+    ShmBufferIndex m_outBufIndex; //<! idle buffer index of output shared memory
+    ShmRegionLayout m_inLayout; //<! layout of input shared memory
+    ShmRegionLayout m_outLayout; //<! layout of output shared memory
+    ShmDescRing m_inDescRing; //<! descriptor ring of input shared memory, popped by the host
+    ShmDescRing m_outDescRing; //<! descriptor ring of output shared memory, pushed by the host
+    ShmFaultCount m_setupFaults; //<! page faults taken while mapping shared memory
+    ShmFaultCount m_streamFaults; //<! page faults taken by the media thread
+    HostObjectPool<FrameBufferData> m_inDataPool; //<! pooled frames of input buffers
+    HostObjectPool<FrameBufferData> m_outDataPool; //<! pooled frames of output buffers
+    std::atomic<uint64_t> m_hotAllocs{0}; //<! heap allocations on the frame path, pools excluded
+
+    // NUMA placement
+    std::shared_ptr<const HostTopology> m_topology = nullptr; //<! host topology, nullptr if threads float
+    AffinityPolicy m_affinityPolicy = AffinityPolicy::NONE; //<! placement policy of the session threads
+    int32_t m_deviceNode = -1; //<! node of the assigned device, -1 if unknown
+    int32_t m_memoryNode = -1; //<! node holding most shared memory pages, -1 if unknown
+    int32_t m_affinityNode = -1; //<! node the session threads are bound to, -1 if none
 };
 
 VDI_NS_END
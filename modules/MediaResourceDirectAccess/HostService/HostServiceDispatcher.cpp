@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostServiceDispatcher.cpp
+//! \brief Route the data calls of all sessions by task id
+//! \date 2026-10-17
+//!
+
+#include "HostServiceDispatcher.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+VDI_NS_BEGIN
+
+HostServiceDispatcher::HostServiceDispatcher()
+{
+    for (uint32_t i = 0; i < DISPATCHER_INIT_WORKER_NUM; i++)
+    {
+        m_initWorkers.emplace_back(&HostServiceDispatcher::InitThread, this);
+    }
+}
+
+HostServiceDispatcher::~HostServiceDispatcher()
+{
+    // inits queued before the close still run and finish their calls
+    m_initJobs.Close();
+    for (auto &worker : m_initWorkers)
+    {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void HostServiceDispatcher::InitThread()
+{
+    std::function<void()> job;
+    while (MRDA_STATUS_SUCCESS == m_initJobs.Pop(job))
+    {
+        job();
+        job = nullptr;
+    }
+}
+
+//!
+//! \brief Compare a token in time independent of where it differs, so a
+//!        caller cannot guess it byte by byte
+//!
+static bool SameToken(const std::string &expected, const std::string &token)
+{
+    if (expected.empty() || expected.size() != token.size()) return false;
+    unsigned char diff = 0;
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+        diff |= static_cast<unsigned char>(expected[i] ^ token[i]);
+    }
+    return diff == 0;
+}
+
+MRDAStatus HostServiceDispatcher::AddSession(uint32_t taskId, const std::string &token, std::shared_ptr<HostServiceSession> session)
+{
+    if (session == nullptr || token.empty())
+    {
+        MRDA_LOG(LOG_ERROR, "invalid session");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    std::unique_lock<std::shared_mutex> lock(m_sessionsMutex);
+    if (!m_sessions.emplace(taskId, SessionEntry{token, session}).second)
+    {
+        MRDA_LOG(LOG_ERROR, "task id %u is in use", taskId);
+        return MRDA_STATUS_INVALID_STATE;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+std::shared_ptr<HostServiceSession> HostServiceDispatcher::RemoveSession(uint32_t taskId, const std::string &token)
+{
+    std::unique_lock<std::shared_mutex> lock(m_sessionsMutex);
+    auto it = m_sessions.find(taskId);
+    if (it == m_sessions.end())
+    {
+        return nullptr;
+    }
+    if (!SameToken(it->second.token, token))
+    {
+        MRDA_LOG(LOG_ERROR, "wrong session token for task id %u", taskId);
+        return nullptr;
+    }
+    std::shared_ptr<HostServiceSession> session = it->second.session;
+    m_sessions.erase(it);
+    return session;
+}
+
+size_t HostServiceDispatcher::SessionNum()
+{
+    std::shared_lock<std::shared_mutex> lock(m_sessionsMutex);
+    return m_sessions.size();
+}
+
+std::shared_ptr<HostServiceSession> HostServiceDispatcher::FindSession(CallbackServerContext* context)
+{
+    if (context == nullptr) return nullptr;
+    const auto &metadata = context->client_metadata();
+    auto entry = metadata.find(MRDA_TASK_ID_KEY);
+    if (entry == metadata.end())
+    {
+        MRDA_LOG(LOG_ERROR, "call has no task id");
+        return nullptr;
+    }
+    std::string value(entry->second.data(), entry->second.size());
+    char *end = nullptr;
+    unsigned long taskId = strtoul(value.c_str(), &end, 10);
+    if (value.empty() || end == nullptr || *end != '\0')
+    {
+        MRDA_LOG(LOG_ERROR, "invalid task id %s", value.c_str());
+        return nullptr;
+    }
+    auto tokenEntry = metadata.find(MRDA_SESSION_TOKEN_KEY);
+    std::string token;
+    if (tokenEntry != metadata.end())
+    {
+        token.assign(tokenEntry->second.data(), tokenEntry->second.size());
+    }
+    std::shared_lock<std::shared_mutex> lock(m_sessionsMutex);
+    auto it = m_sessions.find(static_cast<uint32_t>(taskId));
+    if (it == m_sessions.end())
+    {
+        MRDA_LOG(LOG_ERROR, "no session of task id %lu", taskId);
+        return nullptr;
+    }
+    // task ids are sequential, only the token proves the caller owns the session
+    if (!SameToken(it->second.token, token))
+    {
+        MRDA_LOG(LOG_ERROR, "wrong session token for task id %lu", taskId);
+        return nullptr;
+    }
+    return it->second.session;
+}
+
+grpc::ServerUnaryReactor* HostServiceDispatcher::SetInitParams(CallbackServerContext* context, const MRDA::MediaParams* mediaParams, MRDA::TaskStatus* status)
+{
+    grpc::ServerUnaryReactor *reactor = context->DefaultReactor();
+    std::shared_ptr<HostServiceSession> session = FindSession(context);
+    if (session == nullptr)
+    {
+        reactor->Finish(Status(grpc::StatusCode::NOT_FOUND, "unknown session"));
+        return reactor;
+    }
+    // the codec setup takes long, one session must not stall the calls of
+    // the others, the request and response stay valid until Finish
+    MRDAStatus st = m_initJobs.Push([session, reactor, mediaParams, status]() {
+        reactor->Finish(session->SetInitParams(mediaParams, status));
+    });
+    if (MRDA_STATUS_SUCCESS != st)
+    {
+        reactor->Finish(Status(grpc::StatusCode::UNAVAILABLE, "dispatcher is stopping"));
+    }
+    return reactor;
+}
+
+ServerReadReactor<MRDA::BufferInfo>* HostServiceDispatcher::SendInputData(CallbackServerContext* context, MRDA::TaskStatus* status)
+{
+    std::shared_ptr<HostServiceSession> session = FindSession(context);
+    if (session == nullptr)
+    {
+        return new FailedReactor<ServerReadReactor<MRDA::BufferInfo>>(Status(grpc::StatusCode::NOT_FOUND, "unknown session"));
+    }
+    return session->SendInputData(context, status);
+}
+
+ServerWriteReactor<MRDA::BufferInfo>* HostServiceDispatcher::ReceiveOutputData(CallbackServerContext* context, const MRDA::Pts* pts)
+{
+    std::shared_ptr<HostServiceSession> session = FindSession(context);
+    if (session == nullptr)
+    {
+        return new FailedReactor<ServerWriteReactor<MRDA::BufferInfo>>(Status(grpc::StatusCode::NOT_FOUND, "unknown session"));
+    }
+    return session->ReceiveOutputData(context, pts);
+}
+
+VDI_NS_END
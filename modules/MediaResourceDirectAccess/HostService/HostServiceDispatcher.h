@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostServiceDispatcher.h
+//! \brief Serve the data calls of all host service sessions on the session
+//!        manager server, routed by the task id in the call metadata
+//! \date 2026-10-17
+//!
+
+#ifndef _HOST_SERVICE_DISPATCHER_H_
+#define _HOST_SERVICE_DISPATCHER_H_
+
+#include "HostServiceSession.h"
+#include "../utils/BlockingQueue.h"
+
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t DISPATCHER_INIT_WORKER_NUM = 4; //<! threads running session codec setup
+
+class HostServiceDispatcher : public MRDA::MRDAService::CallbackService
+{
+public:
+    //!
+    //! \brief Host service dispatcher Constructor, starts the init workers
+    //!
+    HostServiceDispatcher();
+    //!
+    //! \brief Host service dispatcher Destructor, runs the queued inits
+    //!        and joins the init workers
+    //!
+    virtual ~HostServiceDispatcher();
+
+    //!
+    //! \brief Add a session to the table
+    //!
+    //! \param [in] taskId
+    //! \param [in] token
+    //!             secret the calls of the session must carry
+    //! \param [in] session
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_INVALID_STATE if the task id is taken
+    //!
+    MRDAStatus AddSession(uint32_t taskId, const std::string &token, std::shared_ptr<HostServiceSession> session);
+
+    //!
+    //! \brief Remove a session from the table, calls in flight keep it alive
+    //!
+    //! \param [in] taskId
+    //! \param [in] token
+    //!             secret returned when the session started
+    //! \return std::shared_ptr<HostServiceSession>
+    //!         nullptr if not found or the token does not match
+    //!
+    std::shared_ptr<HostServiceSession> RemoveSession(uint32_t taskId, const std::string &token);
+
+    //!
+    //! \brief Get the number of sessions
+    //!
+    //! \return size_t
+    //!
+    size_t SessionNum();
+
+    //!
+    //! \brief Set the Init Params of the calling session, the codec setup
+    //!        runs on an init worker so the callback thread is not held
+    //!
+    //! \param [in] context
+    //! \param [in] mediaParams
+    //! \param [out] status
+    //! \return grpc::ServerUnaryReactor*
+    //!
+    virtual grpc::ServerUnaryReactor* SetInitParams(CallbackServerContext* context, const MRDA::MediaParams* mediaParams, MRDA::TaskStatus* status) override;
+
+    //!
+    //! \brief Send input data to the calling session
+    //!
+    //! \param [in] context
+    //! \param [out] status
+    //! \return ServerReadReactor<MRDA::BufferInfo>*
+    //!
+    virtual ServerReadReactor<MRDA::BufferInfo>* SendInputData(CallbackServerContext* context, MRDA::TaskStatus* status) override;
+
+    //!
+    //! \brief Receive output data of the calling session
+    //!
+    //! \param [in] context
+    //! \param [in] pts
+    //! \return ServerWriteReactor<MRDA::BufferInfo>*
+    //!
+    virtual ServerWriteReactor<MRDA::BufferInfo>* ReceiveOutputData(CallbackServerContext* context, const MRDA::Pts* pts) override;
+
+private:
+    //!
+    //! \brief Find the session named by the call metadata, the call must
+    //!        carry the token of the session
+    //!
+    //! \param [in] context
+    //! \return std::shared_ptr<HostServiceSession>
+    //!         nullptr if the metadata has no known task id or a wrong token
+    //!
+    std::shared_ptr<HostServiceSession> FindSession(CallbackServerContext* context);
+
+    //!
+    //! \brief Init worker loop, runs queued inits until the queue is closed
+    //!
+    void InitThread();
+
+private:
+    //!
+    //! \brief session with the token its calls must carry
+    //!
+    struct SessionEntry
+    {
+        std::string token;                           //<! secret of the session
+        std::shared_ptr<HostServiceSession> session; //<! the session
+    };
+
+    std::shared_mutex m_sessionsMutex; //<! guards the table, shared for lookups
+    std::unordered_map<uint32_t, SessionEntry> m_sessions; //<! sessions by task id
+    BlockingQueue<std::function<void()>> m_initJobs; //<! pending session inits
+    std::vector<std::thread> m_initWorkers; //<! threads running the session inits
+};
+
+VDI_NS_END
+#endif // _HOST_SERVICE_DISPATCHER_H_
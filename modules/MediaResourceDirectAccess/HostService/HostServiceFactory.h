@@ -35,12 +35,16 @@
 #define _HOSTSERVICEFACTORY_H_
 
 #include "HostService.h"
+#include "HostServiceSelect.h"
+#include "EncodeService/NullEncode/HostNullEncodeService.h"
 #ifdef _VPL_SUPPORT_
 #include "EncodeService/VPLEncode/HostVPLEncodeService.h"
 #endif
 #ifdef _FFMPEG_SUPPORT_
 #include "EncodeService/FFmpegEncode/HostFFmpegEncodeService.h"
+#include "EncodeService/FFmpegEncode/HostFFmpegSWEncodeService.h"
 #include "DecodeService/FFmpegDecode/HostFFmpegDecodeService.h"
+#include "DecodeService/FFmpegDecode/HostFFmpegSWDecodeService.h"
 #endif
 #include "../protos/MRDAServiceManager.grpc.pb.h"
 
@@ -69,38 +73,35 @@ public:
     {
         TaskInfo taskInfo = MakeTaskInfoBack(info);
 
-        if (info->devicetype() == static_cast<int32_t>(DeviceType::GPU)
-            && info->tasktype() == static_cast<int32_t>(TASKTYPE::taskFFmpegEncode))
+        switch (SelectHostService(taskInfo.taskType, taskInfo.taskDevice.deviceType))
         {
+        case HostServiceKind::NULL_ENCODE:
+            return std::make_shared<HostNullEncodeService>(taskInfo);
 #ifdef _FFMPEG_SUPPORT_
+        case HostServiceKind::FFMPEG_SW_ENCODE:
+            return std::make_shared<HostFFmpegSWEncodeService>(taskInfo);
+        case HostServiceKind::FFMPEG_SW_DECODE:
+            return std::make_shared<HostFFmpegSWDecodeService>(taskInfo);
+        case HostServiceKind::FFMPEG_ENCODE:
             return std::make_shared<HostFFmpegEncodeService>(taskInfo);
+        case HostServiceKind::FFMPEG_DECODE:
+            return std::make_shared<HostFFmpegDecodeService>(taskInfo);
 #else
+        case HostServiceKind::FFMPEG_SW_ENCODE:
+        case HostServiceKind::FFMPEG_SW_DECODE:
+        case HostServiceKind::FFMPEG_ENCODE:
+        case HostServiceKind::FFMPEG_DECODE:
             MRDA_LOG(LOG_ERROR, "FFmpeg is not supported");
             return nullptr;
 #endif
-        }
-        else if (info->devicetype() == static_cast<int32_t>(DeviceType::GPU)
-            && info->tasktype() == static_cast<int32_t>(TASKTYPE::taskOneVPLEncode))
-        {
+        case HostServiceKind::VPL_ENCODE:
 #ifdef _VPL_SUPPORT_
             return std::make_shared<HostVPLEncodeService>(taskInfo);
 #else
             MRDA_LOG(LOG_ERROR, "VPL is not supported");
             return nullptr;
 #endif
-        }
-        else if (info->devicetype() == static_cast<int32_t>(DeviceType::GPU)
-            && info->tasktype() == static_cast<int32_t>(TASKTYPE::taskFFmpegDecode))
-        {
-#ifdef _FFMPEG_SUPPORT_
-            return std::make_shared<HostFFmpegDecodeService>(taskInfo);
-#else
-            MRDA_LOG(LOG_ERROR, "FFmpeg is not supported");
-            return nullptr;
-#endif
-        }
-        else
-        {
+        default:
             MRDA_LOG(LOG_ERROR, "Unsupported task type or device type");
             return nullptr;
         }
@@ -118,6 +119,7 @@ private:
         taskInfo.taskDevice.deviceID = mrda_taskInfo->deviceid();
         taskInfo.taskDevice.deviceType = static_cast<DeviceType>(mrda_taskInfo->devicetype());
         taskInfo.ipAddr = mrda_taskInfo->ipaddr();
+        taskInfo.sessionToken = mrda_taskInfo->sessiontoken();
         return taskInfo;
     }
 
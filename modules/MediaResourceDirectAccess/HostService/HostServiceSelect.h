@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file HostServiceSelect.h
+//! \brief choose the host service implementation for a task type and the
+//!        device the task was placed on, kept apart from the factory so
+//!        it builds without gRPC or codec libraries
+//! \date 2026-10-17
+//!
+
+#ifndef _HOSTSERVICESELECT_H_
+#define _HOSTSERVICESELECT_H_
+
+#include "../utils/common.h"
+
+VDI_NS_BEGIN
+
+//!
+//! \brief host service implementations
+//!
+enum class HostServiceKind
+{
+    NONE = 0,           //!< no service for the task
+    NULL_ENCODE,        //!< synthetic encode, no codec or device
+    FFMPEG_ENCODE,      //!< FFmpeg VAAPI encode on the GPU
+    VPL_ENCODE,         //!< oneVPL encode on the GPU
+    FFMPEG_DECODE,      //!< FFmpeg VAAPI decode on the GPU
+    FFMPEG_SW_ENCODE,   //!< FFmpeg software encode on the CPU
+    FFMPEG_SW_DECODE,   //!< FFmpeg software decode on the CPU
+};
+
+//!
+//! \brief Check whether a task type is an encode task
+//!
+//! \param [in] taskType
+//! \return bool
+//!
+inline bool IsEncodeTask(TASKTYPE taskType)
+{
+    return taskType == TASKTYPE::taskFFmpegEncode
+        || taskType == TASKTYPE::taskOneVPLEncode
+        || taskType == TASKTYPE::taskEncode;
+}
+
+//!
+//! \brief Check whether a task type is a decode task
+//!
+//! \param [in] taskType
+//! \return bool
+//!
+inline bool IsDecodeTask(TASKTYPE taskType)
+{
+    return taskType == TASKTYPE::taskFFmpegDecode
+        || taskType == TASKTYPE::taskOneVPLDecode
+        || taskType == TASKTYPE::taskDecode;
+}
+
+//!
+//! \brief Choose the service for a task, whether the chosen one is built
+//!        in is up to the factory
+//!
+//! \param [in] taskType
+//! \param [in] deviceType
+//!             device the allocator placed the task on
+//! \return HostServiceKind
+//!
+inline HostServiceKind SelectHostService(TASKTYPE taskType, DeviceType deviceType)
+{
+    if (taskType == TASKTYPE::taskNullEncode)
+    {
+        // synthetic sessions need no codec, whatever device they landed on
+        return HostServiceKind::NULL_ENCODE;
+    }
+    if (deviceType == DeviceType::CPU)
+    {
+        // sessions spilled to the CPU run on the software codecs
+        if (IsEncodeTask(taskType)) return HostServiceKind::FFMPEG_SW_ENCODE;
+        if (IsDecodeTask(taskType)) return HostServiceKind::FFMPEG_SW_DECODE;
+    }
+    else if (deviceType == DeviceType::GPU)
+    {
+        if (taskType == TASKTYPE::taskFFmpegEncode) return HostServiceKind::FFMPEG_ENCODE;
+        if (taskType == TASKTYPE::taskOneVPLEncode) return HostServiceKind::VPL_ENCODE;
+        if (taskType == TASKTYPE::taskFFmpegDecode) return HostServiceKind::FFMPEG_DECODE;
+    }
+    return HostServiceKind::NONE;
+}
+
+VDI_NS_END
+#endif // _HOSTSERVICESELECT_H_
@@ -35,11 +35,249 @@
 
 VDI_NS_BEGIN
 
+//!
+//! \brief Reads the input stream, each frame goes to the host service from
+//!        the read callback. Callbacks must not block, so a frame the full
+//!        input queue cannot take is held and the next read only starts
+//!        once the session wakes the reactor up on a drained queue.
+//!
+class HostServiceSession::InputReactor : public ServerReadReactor<MRDA::BufferInfo>
+{
+public:
+    InputReactor(std::shared_ptr<HostServiceSession> session, MRDA::TaskStatus *status):
+    m_session(std::move(session)),
+    m_status(status),
+    m_pending(nullptr),
+    m_finished(false)
+    {
+    }
+
+    //!
+    //! \brief Start reading the stream
+    //!
+    void Start()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        StartRead(&m_bufferInfo);
+    }
+
+    //!
+    //! \brief Retry the held frame, called when the input queue drains
+    //!
+    void Wake()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        SendPending();
+    }
+
+    //!
+    //! \brief Finish at once, the session has an input stream already
+    //!
+    void Reject()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_status->set_status(static_cast<int32_t>(MRDA_STATUS_INVALID_STATE));
+        FinishOnce(Status(grpc::StatusCode::ALREADY_EXISTS, "input stream is open"));
+    }
+
+    void OnReadDone(bool ok) override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // the guest closed the stream
+        if (!ok)
+        {
+            m_status->set_status(static_cast<int32_t>(MRDA_STATUS_SUCCESS));
+            FinishOnce(Status::OK);
+            return;
+        }
+        // recycled from the session pool instead of a heap allocation per frame
+        m_pending = m_session->m_hostService->GetInputFrameData();
+        m_session->MakeBufferInfoBack(&m_bufferInfo, m_pending);
+        SendPending();
+    }
+
+    void OnCancel() override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // a read in flight completes with !ok and finishes there
+        if (m_pending != nullptr) FinishOnce(Status::CANCELLED);
+    }
+
+    void OnDone() override
+    {
+        m_session->DetachInputReactor(this);
+        delete this;
+    }
+
+private:
+    //!
+    //! \brief Hand the held frame to the host service and read the next
+    //!        one, keep holding it while the input queue is full, lock held
+    //!
+    void SendPending()
+    {
+        if (m_pending == nullptr || m_finished) return;
+        MRDAStatus st = m_session->m_hostService->TrySendInputData(m_pending);
+        if (MRDA_STATUS_NOT_READY == st)
+        {
+            // woken up again when the media thread takes a frame
+            return;
+        }
+        m_pending = nullptr;
+        if (MRDA_STATUS_SUCCESS != st)
+        {
+            MRDA_LOG(LOG_ERROR, "failed to send input data");
+            m_status->set_status(static_cast<int32_t>(MRDA_STATUS_INVALID_STATE));
+            FinishOnce(Status::CANCELLED);
+            return;
+        }
+        StartRead(&m_bufferInfo);
+    }
+
+    //!
+    //! \brief Finish the call if not finished yet, lock held
+    //!
+    void FinishOnce(const Status &status)
+    {
+        if (m_finished) return;
+        m_finished = true;
+        Finish(status);
+    }
+
+private:
+    std::shared_ptr<HostServiceSession> m_session; //<! keeps the session alive during the call
+    MRDA::TaskStatus *m_status; //<! call response
+    std::mutex m_mutex; //<! serializes wake ups and reactions
+    std::shared_ptr<FrameBufferData> m_pending; //<! frame read but not taken by the full input queue
+    bool m_finished; //<! Finish is called
+    MRDA::BufferInfo m_bufferInfo; //<! frame being read
+};
+
+//!
+//! \brief Writes the output stream. The session wakes it up when the host
+//!        service queues output, one write is in flight at a time.
+//!
+class HostServiceSession::OutputReactor : public ServerWriteReactor<MRDA::BufferInfo>
+{
+public:
+    OutputReactor(std::shared_ptr<HostServiceSession> session, uint64_t pts):
+    m_session(std::move(session)),
+    m_pts(pts),
+    m_writing(false),
+    m_lastWrite(false),
+    m_finished(false)
+    {
+    }
+
+    //!
+    //! \brief Write the next queued frame unless a write is in flight,
+    //!        finish if the session is stopped
+    //!
+    void Wake()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        WriteNext();
+    }
+
+    //!
+    //! \brief Finish at once, the session has an output stream already
+    //!
+    void Reject()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        FinishOnce(Status(grpc::StatusCode::ALREADY_EXISTS, "output stream is open"));
+    }
+
+    void OnWriteDone(bool ok) override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_writing = false;
+        if (!ok)
+        {
+            MRDA_LOG(LOG_ERROR, "failed to write output data");
+            FinishOnce(Status::CANCELLED);
+            return;
+        }
+        if (m_lastWrite)
+        {
+            FinishOnce(Status::OK);
+            return;
+        }
+        WriteNext();
+    }
+
+    void OnCancel() override
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // a write in flight completes with !ok and finishes there
+        if (!m_writing) FinishOnce(Status::CANCELLED);
+    }
+
+    void OnDone() override
+    {
+        m_session->DetachOutputReactor(this);
+        delete this;
+    }
+
+private:
+    //!
+    //! \brief Start writing the next queued frame, lock held
+    //!
+    void WriteNext()
+    {
+        if (m_writing || m_finished) return;
+        if (m_session->m_stopped)
+        {
+            FinishOnce(Status::OK);
+            return;
+        }
+        std::shared_ptr<FrameBufferData> buffer = nullptr;
+        if (MRDA_STATUS_SUCCESS != m_session->m_hostService->TryReceiveOutputData(buffer) || buffer == nullptr)
+        {
+            // woken up again by the next queued output
+            return;
+        }
+        m_bufferInfo.Clear();
+        m_session->MakeBufferInfo(buffer, &m_bufferInfo);
+        // segments of a chained packet share its pts, only the last one ends the stream
+        std::shared_ptr<MemoryBuffer> memBuffer = buffer->MemBuffer();
+        bool lastSegment = memBuffer == nullptr || memBuffer->ChainIndex() + 1 >= memBuffer->ChainNum();
+        m_lastWrite = buffer->Pts() >= m_pts - 1 && lastSegment;
+        m_writing = true;
+        StartWrite(&m_bufferInfo);
+    }
+
+    //!
+    //! \brief Finish the call if not finished yet, lock held
+    //!
+    void FinishOnce(const Status &status)
+    {
+        if (m_finished) return;
+        m_finished = true;
+        Finish(status);
+    }
+
+private:
+    std::shared_ptr<HostServiceSession> m_session; //<! keeps the session alive during the call
+    uint64_t m_pts; //<! the stream ends after the frame before this pts
+    std::mutex m_mutex; //<! serializes wake ups and reactions
+    bool m_writing; //<! a write is in flight
+    bool m_lastWrite; //<! the write in flight is the last one
+    bool m_finished; //<! Finish is called
+    MRDA::BufferInfo m_bufferInfo; //<! frame being written
+};
+
 HostServiceSession::HostServiceSession()
-    : m_server(nullptr),
+    : m_inputReactor(nullptr),
+      m_outputReactor(nullptr),
       m_hostService(nullptr),
       m_hostServiceFactory(nullptr) {}
 
+HostServiceSession::~HostServiceSession()
+{
+    StopShmDataPlane();
+}
+
 MRDAStatus HostServiceSession::Initialize(MRDA::TaskInfo* taskInfo)
 {
     if (taskInfo == nullptr)
@@ -59,10 +297,23 @@ MRDAStatus HostServiceSession::Initialize(MRDA::TaskInfo* taskInfo)
         MRDA_LOG(LOG_ERROR, "failed to create host service");
         return MRDA_STATUS_INVALID_DATA;
     }
+    // the media thread is joined before the session members go away
+    m_hostService->SetOutputListener([this]() { OnOutputReady(); });
+    m_hostService->SetInputListener([this]() { OnInputDrained(); });
     return MRDA_STATUS_SUCCESS;
 }
 
-Status HostServiceSession::SetInitParams(ServerContext* context, const MRDA::MediaParams* mrda_mediaParams, MRDA::TaskStatus* mrda_status)
+void HostServiceSession::SetAffinity(AffinityPolicy policy, std::shared_ptr<const HostTopology> topology, int32_t deviceNode)
+{
+    if (m_hostService == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "host service is not initialized");
+        return;
+    }
+    m_hostService->SetAffinity(policy, std::move(topology), deviceNode);
+}
+
+Status HostServiceSession::SetInitParams(const MRDA::MediaParams* mrda_mediaParams, MRDA::TaskStatus* mrda_status)
 {
     if (mrda_mediaParams == nullptr || mrda_status == nullptr)
     {
@@ -71,84 +322,107 @@ Status HostServiceSession::SetInitParams(ServerContext* context, const MRDA::Med
     }
     MediaParams mediaParams;
     MakeMediaParamsBack(mrda_mediaParams, &mediaParams);
-    MRDAStatus st = m_hostService->SetInitParams(&mediaParams);
+    MRDAStatus st = m_admission ? m_admission(mediaParams) : MRDA_STATUS_SUCCESS;
+    if (st != MRDA_STATUS_SUCCESS)
+    {
+        MRDA_LOG(LOG_ERROR, "session is refused by admission");
+        mrda_status->set_status(static_cast<int32_t>(st));
+        return Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "device has no room for the session");
+    }
+    st = m_hostService->SetInitParams(&mediaParams);
     if (st != MRDA_STATUS_SUCCESS)
     {
         mrda_status->set_status(static_cast<int32_t>(st));
         return Status::CANCELLED;
     }
     st = m_hostService->Initialize();
+    if (st == MRDA_STATUS_SUCCESS && mediaParams.shareMemoryInfo.dataPlane == DataPlane::DATA_PLANE_SHM)
+    {
+        st = StartShmDataPlane();
+    }
     mrda_status->set_status(static_cast<int32_t>(st));
     return Status::OK;
 }
 
-Status HostServiceSession::SendInputData(ServerContext* context, ServerReader<MRDA::BufferInfo>* reader, MRDA::TaskStatus* status)
+ServerReadReactor<MRDA::BufferInfo>* HostServiceSession::SendInputData(CallbackServerContext* context, MRDA::TaskStatus* status)
 {
-    MRDA::BufferInfo mrda_bufferInfo;
-    while (reader->Read(&mrda_bufferInfo))
+    if (m_hostService == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "host service is not initialized");
+        return new FailedReactor<ServerReadReactor<MRDA::BufferInfo>>(Status::CANCELLED);
+    }
+    InputReactor *reactor = new InputReactor(shared_from_this(), status);
     {
-        std::shared_ptr<FrameBufferData> buffer = std::make_shared<FrameBufferData>();
-        MakeBufferInfoBack(&mrda_bufferInfo, buffer);
-        if (m_hostService == nullptr)
+        std::unique_lock<std::mutex> lock(m_inputMutex);
+        if (m_inputReactor == nullptr)
         {
-            MRDA_LOG(LOG_ERROR, "host service is not initialized");
-            return Status::CANCELLED;
+            m_inputReactor = reactor;
+            reactor->Start();
+            return reactor;
         }
-        MRDAStatus st = m_hostService->SendInputData(buffer);
     }
-    status->set_status(static_cast<int32_t>(MRDA_STATUS_SUCCESS));
-
-    return Status::OK;
+    MRDA_LOG(LOG_ERROR, "input stream is open already");
+    reactor->Reject();
+    return reactor;
 }
 
-Status HostServiceSession::ReceiveOutputData(ServerContext* context, const MRDA::Pts* pts, ServerWriter<MRDA::BufferInfo>* writer)
+ServerWriteReactor<MRDA::BufferInfo>* HostServiceSession::ReceiveOutputData(CallbackServerContext* context, const MRDA::Pts* pts)
 {
-    bool stopFlag = false;
-    while (!stopFlag)
+    if (m_hostService == nullptr)
     {
-        std::shared_ptr<FrameBufferData> buffer = nullptr;
-
-        if (m_hostService == nullptr)
-        {
-            MRDA_LOG(LOG_ERROR, "host service is not initialized");
-            return Status::CANCELLED;
-        }
-        MRDA::BufferInfo mrda_bufferInfo;
-        MRDAStatus st = m_hostService->ReceiveOutputData(buffer);
-        // error
-        if (MRDA_STATUS_SUCCESS != st && MRDA_STATUS_NOT_ENOUGH_DATA != st)
-        {
-            MRDA_LOG(LOG_ERROR, "receive output data failed");
-        }
-        // not enough output data
-        else if (MRDA_STATUS_NOT_ENOUGH_DATA == st) {
-            // MRDA_LOG(LOG_INFO, "Receive data empty! please wait!");
-            usleep(1000);
-        }
-        else if (buffer != nullptr)
+        MRDA_LOG(LOG_ERROR, "host service is not initialized");
+        return new FailedReactor<ServerWriteReactor<MRDA::BufferInfo>>(Status::CANCELLED);
+    }
+    OutputReactor *reactor = new OutputReactor(shared_from_this(), static_cast<uint64_t>(pts->pts()));
+    {
+        std::unique_lock<std::mutex> lock(m_outputMutex);
+        if (m_outputReactor == nullptr)
         {
-            MakeBufferInfo(buffer, &mrda_bufferInfo);
-            if (!writer->Write(mrda_bufferInfo))
-            {
-                MRDA_LOG(LOG_ERROR, "failed to write output data");
-                return Status::CANCELLED;
-            }
-            if (buffer->Pts() >= pts->pts() - 1)
-            {
-                // MRDA_LOG(LOG_INFO, "Receive stopFlag true!");
-                stopFlag = true;
-            }
+            m_outputReactor = reactor;
+            // write what was queued before the stream opened
+            reactor->Wake();
+            return reactor;
         }
     }
+    MRDA_LOG(LOG_ERROR, "output stream is open already");
+    reactor->Reject();
+    return reactor;
+}
 
-    return Status::OK;
+void HostServiceSession::OnOutputReady()
+{
+    std::unique_lock<std::mutex> lock(m_outputMutex);
+    if (m_outputReactor != nullptr) m_outputReactor->Wake();
+}
+
+void HostServiceSession::OnInputDrained()
+{
+    std::unique_lock<std::mutex> lock(m_inputMutex);
+    if (m_inputReactor != nullptr) m_inputReactor->Wake();
+}
+
+void HostServiceSession::DetachInputReactor(InputReactor *reactor)
+{
+    std::unique_lock<std::mutex> lock(m_inputMutex);
+    if (m_inputReactor == reactor) m_inputReactor = nullptr;
+}
+
+void HostServiceSession::DetachOutputReactor(OutputReactor *reactor)
+{
+    std::unique_lock<std::mutex> lock(m_outputMutex);
+    if (m_outputReactor == reactor) m_outputReactor = nullptr;
 }
 
 MRDAStatus HostServiceSession::MakeBufferInfoBack(const MRDA::BufferInfo *mrda_bufferInfo, std::shared_ptr<FrameBufferData> &buffer)
 {
     if (mrda_bufferInfo == nullptr || buffer == nullptr) return MRDA_STATUS_INVALID_DATA;
     MRDA::MemBuffer *mrda_memBuffer = (const_cast<MRDA::BufferInfo*>(mrda_bufferInfo))->mutable_buffer();
-    std::shared_ptr<MemoryBuffer> memoryBuffer = std::make_shared<MemoryBuffer>();
+    std::shared_ptr<MemoryBuffer> memoryBuffer = buffer->MemBuffer();
+    if (memoryBuffer == nullptr)
+    {
+        memoryBuffer = std::make_shared<MemoryBuffer>();
+        buffer->SetMemBuffer(memoryBuffer);
+    }
     if (memoryBuffer == nullptr || mrda_memBuffer == nullptr) return MRDA_STATUS_INVALID_DATA;
 
     buffer->SetWidth(mrda_bufferInfo->width());
@@ -162,7 +436,7 @@ MRDAStatus HostServiceSession::MakeBufferInfoBack(const MRDA::BufferInfo *mrda_b
     memoryBuffer->SetStateOffset(mrda_memBuffer->state_offset());
     memoryBuffer->SetSize(mrda_memBuffer->buf_size());
     memoryBuffer->SetState(static_cast<BufferState>(mrda_memBuffer->state()));
-    buffer->SetMemBuffer(memoryBuffer);
+    memoryBuffer->SetPitch(mrda_memBuffer->pitch());
     return MRDA_STATUS_SUCCESS;
 }
 
@@ -186,6 +460,9 @@ MRDAStatus HostServiceSession::MakeBufferInfo(const std::shared_ptr<FrameBufferD
     mrda_memBuffer->set_buf_size(memoryBuffer->Size());
     mrda_memBuffer->set_state(static_cast<int32_t>(memoryBuffer->State()));
     mrda_memBuffer->set_occupied_buf_size(memoryBuffer->OccupiedSize());
+    mrda_memBuffer->set_pitch(memoryBuffer->Pitch());
+    mrda_memBuffer->set_chain_num(memoryBuffer->ChainNum());
+    mrda_memBuffer->set_chain_index(memoryBuffer->ChainIndex());
     mrda_bufferInfo->set_width(buffer->Width());
     mrda_bufferInfo->set_height(buffer->Height());
     mrda_bufferInfo->set_type(static_cast<int32_t>(buffer->StreamType()));
@@ -209,6 +486,10 @@ MRDAStatus HostServiceSession::MakeMediaParamsBack(const MRDA::MediaParams* mrda
     params->shareMemoryInfo.bufferSize = mrda_shmInfo->buffer_size();
     params->shareMemoryInfo.in_mem_dev_path = mrda_shmInfo->in_mem_dev_path();
     params->shareMemoryInfo.out_mem_dev_path = mrda_shmInfo->out_mem_dev_path();
+    params->shareMemoryInfo.hostMapOptions = mrda_shmInfo->host_map_options();
+    params->shareMemoryInfo.hostNumaNode = mrda_shmInfo->host_numa_node();
+    params->shareMemoryInfo.hostStripes = mrda_shmInfo->host_stripes();
+    params->shareMemoryInfo.dataPlane = static_cast<DataPlane>(mrda_shmInfo->data_plane());
 
     MRDA::EncodeParams *mrda_encParams = (const_cast<MRDA::MediaParams*>(mrda_mediaParams))->mutable_enc_params();
     params->encodeParams.codec_id = static_cast<StreamCodecID>(mrda_encParams->codec_id());
@@ -226,6 +507,9 @@ MRDAStatus HostServiceSession::MakeMediaParamsBack(const MRDA::MediaParams* mrda
     params->encodeParams.codec_profile = static_cast<CodecProfile>(mrda_encParams->codec_profile());
     params->encodeParams.max_b_frames = mrda_encParams->max_b_frames();
     params->encodeParams.frame_num = mrda_encParams->frame_num();
+    params->encodeParams.record_format = static_cast<RecordFormat>(mrda_encParams->record_format());
+    params->encodeParams.record_path = mrda_encParams->record_path();
+    params->encodeParams.record_buffer_size = mrda_encParams->record_buffer_size();
 
     MRDA::DecodeParams *mrda_decParams = (const_cast<MRDA::MediaParams*>(mrda_mediaParams))->mutable_dec_params();
     params->decodeParams.codec_id = static_cast<StreamCodecID>(mrda_decParams->codec_id());
@@ -235,26 +519,118 @@ MRDAStatus HostServiceSession::MakeMediaParamsBack(const MRDA::MediaParams* mrda
     params->decodeParams.frame_height = mrda_decParams->frame_height();
     params->decodeParams.color_format = static_cast<ColorFormat>(mrda_decParams->color_format());
     params->decodeParams.frame_num = mrda_decParams->frame_num();
+    params->decodeParams.thread_mode = static_cast<DecodeThreadMode>(mrda_decParams->thread_mode());
+    params->decodeParams.thread_num = mrda_decParams->thread_num();
 
     return MRDA_STATUS_SUCCESS;
 }
 
-void HostServiceSession::RunService(std::string server_address)
+MRDAStatus HostServiceSession::StartShmDataPlane()
 {
-    std::unique_ptr<ServerBuilder> serverBuilder = std::make_unique<ServerBuilder>();
-    serverBuilder->AddListeningPort(server_address, grpc::InsecureServerCredentials());
-    serverBuilder->RegisterService(this);
-    m_server = serverBuilder->BuildAndStart();
-    MRDA_LOG(LOG_INFO, "Service listening on %s", server_address.c_str());
-    m_server->Wait();
+    if (m_hostService->InDescRing() == nullptr || m_hostService->OutDescRing() == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "descriptor rings are not attached");
+        return MRDA_STATUS_INVALID_STATE;
+    }
+    if (m_submitThread.joinable() || m_completeThread.joinable())
+    {
+        MRDA_LOG(LOG_ERROR, "shm data plane is already running");
+        return MRDA_STATUS_INVALID_STATE;
+    }
+    m_shmStop = false;
+    m_submitThread = std::thread(&HostServiceSession::SubmitThread, this);
+    m_completeThread = std::thread(&HostServiceSession::CompleteThread, this);
+    return MRDA_STATUS_SUCCESS;
 }
 
-void HostServiceSession::StopService()
+void HostServiceSession::StopShmDataPlane()
+{
+    m_shmStop = true;
+    // the guest waits on the rings, closing them ends its stream at once
+    if (m_hostService != nullptr && m_hostService->InDescRing() != nullptr) m_hostService->InDescRing()->Close();
+    if (m_hostService != nullptr && m_hostService->OutDescRing() != nullptr) m_hostService->OutDescRing()->Close();
+    if (m_submitThread.joinable()) m_submitThread.join();
+    if (m_completeThread.joinable()) m_completeThread.join();
+}
+
+void HostServiceSession::SubmitThread()
+{
+    m_hostService->BindThreadAffinity();
+    ShmDescRing *ring = m_hostService->InDescRing();
+    while (!m_shmStop)
+    {
+        ShmDescriptor desc;
+        MRDAStatus st = ring->Pop(desc, SHM_DOORBELL_WAIT_US);
+        if (MRDA_STATUS_NOT_READY == st)
+        {
+            continue;
+        }
+        if (MRDA_STATUS_NOT_ENOUGH_DATA == st)
+        {
+            MRDA_LOG(LOG_INFO, "input descriptor ring is closed");
+            break;
+        }
+        if (MRDA_STATUS_SUCCESS != st)
+        {
+            MRDA_LOG(LOG_ERROR, "failed to pop input descriptor");
+            break;
+        }
+        // recycled from the session pool instead of a heap allocation per frame
+        std::shared_ptr<FrameBufferData> buffer = m_hostService->GetInputFrameData();
+        ShmMakeFrame(desc, buffer);
+        bool isEOS = buffer->IsEOS();
+        if (MRDA_STATUS_SUCCESS != m_hostService->SendInputData(buffer))
+        {
+            // like the gRPC stream, a rejected frame ends the input
+            MRDA_LOG(LOG_ERROR, "failed to send input data");
+            break;
+        }
+        if (isEOS)
+        {
+            break;
+        }
+    }
+}
+
+void HostServiceSession::CompleteThread()
 {
-    if (m_server != nullptr)
+    m_hostService->BindThreadAffinity();
+    ShmDescRing *ring = m_hostService->OutDescRing();
+    while (!m_shmStop)
     {
-        m_server->Shutdown();
+        std::shared_ptr<FrameBufferData> buffer = nullptr;
+        MRDAStatus st = m_hostService->ReceiveOutputData(buffer);
+        if (MRDA_STATUS_SUCCESS != st && MRDA_STATUS_NOT_ENOUGH_DATA != st)
+        {
+            MRDA_LOG(LOG_ERROR, "receive output data failed");
+            continue;
+        }
+        // ReceiveOutputData has already blocked on the output list
+        if (MRDA_STATUS_NOT_ENOUGH_DATA == st || buffer == nullptr)
+        {
+            continue;
+        }
+        ShmDescriptor desc;
+        ShmMakeDescriptor(buffer, desc);
+        st = MRDA_STATUS_NOT_READY;
+        while (MRDA_STATUS_NOT_READY == st && !m_shmStop)
+        {
+            st = ring->Push(desc, SHM_DOORBELL_WAIT_US);
+        }
+        if (MRDA_STATUS_SUCCESS != st && !m_shmStop)
+        {
+            MRDA_LOG(LOG_ERROR, "failed to push output descriptor");
+            break;
+        }
     }
 }
 
+void HostServiceSession::StopService()
+{
+    m_stopped = true;
+    StopShmDataPlane();
+    // the output stream may be idle, waiting for output that never comes
+    OnOutputReady();
+}
+
 VDI_NS_END
\ No newline at end of file
@@ -45,23 +45,42 @@
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/server_callback.h>
 
-using grpc::Server;
-using grpc::ServerBuilder;
-using grpc::ServerContext;
-using grpc::ServerReader;
-// using grpc::ServerReaderWriter;
-using grpc::ServerWriter;
+using grpc::CallbackServerContext;
+using grpc::ServerReadReactor;
+using grpc::ServerWriteReactor;
 using grpc::Status;
 
 #include "../protos/MRDAService.grpc.pb.h"
 #include "../protos/MRDAService.pb.h"
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 VDI_NS_BEGIN
 
-class HostServiceSession : public MRDA::MRDAService::Service
+//!
+//! \brief Reactor of a stream call that fails before it starts
+//!
+template<typename Reactor>
+class FailedReactor : public Reactor
+{
+public:
+    explicit FailedReactor(const Status &status) { this->Finish(status); }
+    void OnDone() override { delete this; }
+};
+
+//!
+//! \brief One session of a host service. Its data calls run as gRPC
+//!        callback reactors, so a stream holds no thread while it waits
+//!        for the guest or the media thread.
+//!
+class HostServiceSession : public std::enable_shared_from_this<HostServiceSession>
 {
 public:
     //!
@@ -71,7 +90,7 @@ public:
     //!
     //! \brief Host service session Destructor
     //!
-    virtual ~HostServiceSession() = default;
+    virtual ~HostServiceSession();
 
     //!
     //! \brief Initialize with task info
@@ -82,56 +101,49 @@ public:
     MRDAStatus Initialize(MRDA::TaskInfo* taskInfo);
 
     //!
-    //! \brief Set the Init Params object
+    //! \brief Set the admission check of the media params, the session is
+    //!        refused at SetInitParams if it fails
     //!
-    //! \param [in] context
-    //! \param [in] mediaParams
-    //! \param [in] status
-    //! \return Status
+    //! \param [in] admission
     //!
-    virtual Status SetInitParams(ServerContext* context, const MRDA::MediaParams* mediaParams, MRDA::TaskStatus* status) override;
+    inline void SetAdmission(std::function<MRDAStatus(const MediaParams&)> admission) { m_admission = std::move(admission); }
+
     //!
-    //! \brief Send input data
+    //! \brief Set how the session threads are placed, after Initialize
     //!
-    //! \param [in] context
-    //! \param [in] reader
-    //! \param [out] status
-    //! \return Status
-    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //! \param [in] policy
+    //! \param [in] topology
+    //! \param [in] deviceNode
+    //!             node of the assigned device, -1 if unknown
     //!
-    virtual Status SendInputData(ServerContext* context, ServerReader<MRDA::BufferInfo>* reader, MRDA::TaskStatus* status) override;
+    void SetAffinity(AffinityPolicy policy, std::shared_ptr<const HostTopology> topology, int32_t deviceNode);
 
-    /// FIXME: use unary API as the first step, then use stream as optimization
     //!
-    //! \brief Send input data using gRPC
+    //! \brief Set the Init Params object
     //!
-    //! \param [in] context
-    //! \param [in] bufferInfo
-    //! \param [out] taskStatus
+    //! \param [in] mediaParams
+    //! \param [out] status
     //! \return Status
     //!
-    // virtual Status SendInputData(ServerContext* context, const MRDA::BufferInfo* bufferInfo, MRDA::TaskStatus* taskStatus) override;
-
+    Status SetInitParams(const MRDA::MediaParams* mediaParams, MRDA::TaskStatus* status);
     //!
-    //! \brief
+    //! \brief Start the input stream, each frame read is sent to the host service
     //!
     //! \param [in] context
-    //! \param [in] pts
-    //! \param [in] writer
-    //! \return Status
-    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //! \param [out] status
+    //! \return ServerReadReactor<MRDA::BufferInfo>*
     //!
-    virtual Status ReceiveOutputData(ServerContext* context, const MRDA::Pts* pts, ServerWriter<MRDA::BufferInfo>* writer) override;
+    ServerReadReactor<MRDA::BufferInfo>* SendInputData(CallbackServerContext* context, MRDA::TaskStatus* status);
 
     //!
-    //! \brief Receive output data using gRPC
+    //! \brief Start the output stream, frames are written as soon as the
+    //!        host service queues them, until the frame before pts
     //!
     //! \param [in] context
     //! \param [in] pts
-    //! \param [in] bufferInfo
-    //! \return Status
+    //! \return ServerWriteReactor<MRDA::BufferInfo>*
     //!
-    // virtual Status ReceiveOutputData(ServerContext* context, const MRDA::Pts* pts, MRDA::BufferInfo* bufferInfo) override;
+    ServerWriteReactor<MRDA::BufferInfo>* ReceiveOutputData(CallbackServerContext* context, const MRDA::Pts* pts);
 
     //!
     //! \brief Get the Host Service Instance object
@@ -144,18 +156,39 @@ public:
     // }
 
     //!
-    //! \brief Start the service with server addr
+    //! \brief Stop the service and finish the output stream
+    //!
+    void StopService();
+
+private:
+    class InputReactor;
+    class OutputReactor;
+
+    //!
+    //! \brief Wake up the input stream, called when input data leaves the
+    //!        input queue
+    //!
+    void OnInputDrained();
+
+    //!
+    //! \brief Forget the input stream once it is done
     //!
-    //! \param [in] server_address
+    //! \param [in] reactor
     //!
-    void RunService(std::string server_address);
+    void DetachInputReactor(InputReactor *reactor);
 
     //!
-    //! \brief Stop the service
+    //! \brief Wake up the output stream, called when output data is queued
     //!
-    void StopService();
+    void OnOutputReady();
+
+    //!
+    //! \brief Forget the output stream once it is done
+    //!
+    //! \param [in] reactor
+    //!
+    void DetachOutputReactor(OutputReactor *reactor);
 
-private:
     //!
     //! \brief Convert mrda buffer info to buffer info
     //!
@@ -182,11 +215,41 @@ private:
     //!
     MRDAStatus MakeMediaParamsBack(const MRDA::MediaParams* mrda_mediaParams, MediaParams *params);
 
+    //!
+    //! \brief Start the descriptor ring threads of the shm data plane
+    //!
+    //! \return MRDAStatus
+    //!
+    MRDAStatus StartShmDataPlane();
+
+    //!
+    //! \brief Stop and join the descriptor ring threads
+    //!
+    void StopShmDataPlane();
+
+    //!
+    //! \brief Pop input descriptors and send the frames to the host service
+    //!
+    void SubmitThread();
+
+    //!
+    //! \brief Receive output frames of the host service and push their descriptors
+    //!
+    void CompleteThread();
+
 private:
 
-    std::unique_ptr<Server> m_server; //<! gRPC server handle
+    std::mutex m_inputMutex; //<! guards the input stream, outlives the host service
+    InputReactor *m_inputReactor; //<! input stream of the session, nullptr if none
+    std::mutex m_outputMutex; //<! guards the output stream, outlives the host service
+    OutputReactor *m_outputReactor; //<! output stream of the session, nullptr if none
     std::shared_ptr<HostService> m_hostService; //<! host service
     std::unique_ptr<HostServiceFactory> m_hostServiceFactory; //<! host service factory
+    std::thread m_submitThread; //<! input descriptor thread of the shm data plane
+    std::thread m_completeThread; //<! output descriptor thread of the shm data plane
+    std::atomic<bool> m_shmStop{false}; //<! stops the descriptor threads
+    std::atomic<bool> m_stopped{false}; //<! set by StopService, finishes the output stream
+    std::function<MRDAStatus(const MediaParams&)> m_admission; //<! admission check of the media params
 
 };
 
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostTopology.cpp
+//! \brief implement NUMA topology discovery and thread binding
+//! \date 2026-10-17
+//!
+
+#include "HostTopology.h"
+
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <linux/mempolicy.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+VDI_NS_BEGIN
+
+//!
+//! \brief Read the first line of a sysfs file
+//!
+//! \param [in] path
+//! \param [out] value
+//! \return bool
+//!
+static bool ReadLine(const std::string &path, std::string &value)
+{
+    FILE *fp = fopen(path.c_str(), "r");
+    if (fp == nullptr)
+    {
+        return false;
+    }
+    char line[1024];
+    bool ok = fgets(line, sizeof(line), fp) != nullptr;
+    fclose(fp);
+    if (!ok)
+    {
+        return false;
+    }
+    value = line;
+    while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) value.pop_back();
+    return true;
+}
+
+HostTopology::HostTopology(const std::string &rootPath)
+    : m_rootPath(rootPath)
+{
+}
+
+std::string HostTopology::RootPath(const std::string &path) const
+{
+    if (m_rootPath == "/") return path;
+    std::string root = m_rootPath;
+    if (root.back() == '/') root.pop_back();
+    return root + path;
+}
+
+MRDAStatus HostTopology::Discover()
+{
+    m_nodes.clear();
+    std::string nodePath = RootPath("/sys/devices/system/node");
+    DIR *dir = opendir(nodePath.c_str());
+    if (dir != nullptr)
+    {
+        struct dirent *entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            if (strncmp(entry->d_name, "node", 4) != 0) continue;
+            char *end = nullptr;
+            long id = strtol(entry->d_name + 4, &end, 10);
+            if (end == entry->d_name + 4 || *end != '\0') continue;
+            std::string cpuList;
+            NumaNodeInfo node;
+            node.id = static_cast<int32_t>(id);
+            // memory only nodes have an empty cpulist, they still take allocations
+            if (ReadLine(nodePath + "/" + entry->d_name + "/cpulist", cpuList)
+                && MRDA_STATUS_SUCCESS != ParseCpuList(cpuList, node.cpus))
+            {
+                MRDA_LOG(LOG_WARNING, "Invalid cpulist of node %ld: %s", id, cpuList.c_str());
+            }
+            m_nodes.push_back(node);
+        }
+        closedir(dir);
+    }
+    if (m_nodes.empty())
+    {
+        // no NUMA support in the kernel, one node holds every cpu
+        NumaNodeInfo node;
+        node.id = 0;
+        long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        for (long cpu = 0; cpu < cores; cpu++) node.cpus.push_back(static_cast<uint32_t>(cpu));
+        m_nodes.push_back(node);
+    }
+    std::sort(m_nodes.begin(), m_nodes.end(),
+              [](const NumaNodeInfo &a, const NumaNodeInfo &b) { return a.id < b.id; });
+    for (auto &node : m_nodes)
+    {
+        MRDA_LOG(LOG_INFO, "NUMA node %d, cpus %s", node.id, FormatCpuList(node.cpus).c_str());
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+const NumaNodeInfo* HostTopology::GetNode(int32_t node) const
+{
+    for (auto &info : m_nodes)
+    {
+        if (info.id == node) return &info;
+    }
+    return nullptr;
+}
+
+int32_t HostTopology::GetDeviceNode(const std::string &pciSlot) const
+{
+    if (pciSlot.empty())
+    {
+        return -1;
+    }
+    std::string value;
+    if (!ReadLine(RootPath("/sys/bus/pci/devices/" + pciSlot + "/numa_node"), value))
+    {
+        return -1;
+    }
+    // the kernel reports -1 when the firmware gives no locality
+    int32_t node = static_cast<int32_t>(atoi(value.c_str()));
+    return GetNode(node) != nullptr ? node : -1;
+}
+
+int32_t HostTopology::GetMemoryNode(const void *addr, size_t size)
+{
+    if (addr == nullptr || size == 0)
+    {
+        return -1;
+    }
+    size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t pageNum = (size + pageSize - 1) / pageSize;
+    size_t sampleNum = std::min<size_t>(pageNum, TOPOLOGY_PAGE_SAMPLES);
+    uintptr_t base = reinterpret_cast<uintptr_t>(addr) & ~(pageSize - 1);
+    std::vector<void*> pages(sampleNum);
+    std::vector<int> status(sampleNum, -1);
+    for (size_t i = 0; i < sampleNum; i++)
+    {
+        pages[i] = reinterpret_cast<void*>(base + (i * pageNum / sampleNum) * pageSize);
+        // pages the guest wrote are in the page cache but not yet in this mapping
+        (void)*static_cast<volatile char*>(pages[i]);
+    }
+    // no target nodes, move_pages only reports where each page is
+    if (syscall(SYS_move_pages, 0, sampleNum, pages.data(), nullptr, status.data(), 0) != 0)
+    {
+        MRDA_LOG(LOG_WARNING, "Failed to query page nodes: %s", strerror(errno));
+        return -1;
+    }
+    std::map<int, size_t> count;
+    for (int node : status)
+    {
+        if (node >= 0) count[node]++;
+    }
+    int32_t memoryNode = -1;
+    size_t maxCount = 0;
+    for (auto &item : count)
+    {
+        if (item.second > maxCount)
+        {
+            memoryNode = item.first;
+            maxCount = item.second;
+        }
+    }
+    return memoryNode;
+}
+
+MRDAStatus HostTopology::BindThread(int32_t node) const
+{
+    const NumaNodeInfo *info = GetNode(node);
+    if (info == nullptr || info->cpus.empty())
+    {
+        MRDA_LOG(LOG_ERROR, "NUMA node %d has no cpus", node);
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (uint32_t cpu : info->cpus)
+    {
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &cpuSet);
+    }
+    int ret = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    if (ret != 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to bind thread to node %d: %s", node, strerror(ret));
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    // preferred, not bound, so a full node spills over instead of failing
+    unsigned long nodeMask = 0;
+    if (node >= static_cast<int32_t>(sizeof(nodeMask) * 8))
+    {
+        MRDA_LOG(LOG_WARNING, "Failed to prefer memory of node %d: beyond the node mask", node);
+        return MRDA_STATUS_SUCCESS;
+    }
+    nodeMask = 1UL << node;
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED, &nodeMask, sizeof(nodeMask) * 8) != 0)
+    {
+        MRDA_LOG(LOG_WARNING, "Failed to prefer memory of node %d: %s", node, strerror(errno));
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+int32_t HostTopology::ChooseNode(AffinityPolicy policy, int32_t deviceNode, int32_t memoryNode) const
+{
+    if (m_nodes.size() <= 1)
+    {
+        return -1;
+    }
+    int32_t node = -1;
+    if (AffinityPolicy::DEVICE == policy)
+    {
+        node = deviceNode >= 0 ? deviceNode : memoryNode;
+    }
+    else if (AffinityPolicy::MEMORY == policy)
+    {
+        node = memoryNode >= 0 ? memoryNode : deviceNode;
+    }
+    const NumaNodeInfo *info = GetNode(node);
+    return (info != nullptr && !info->cpus.empty()) ? node : -1;
+}
+
+std::string HostTopology::FormatCpuList(const std::vector<uint32_t> &cpus)
+{
+    std::string cpuList;
+    size_t i = 0;
+    while (i < cpus.size())
+    {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) j++;
+        if (!cpuList.empty()) cpuList += ",";
+        cpuList += std::to_string(cpus[i]);
+        if (j > i) cpuList += "-" + std::to_string(cpus[j]);
+        i = j + 1;
+    }
+    return cpuList;
+}
+
+MRDAStatus HostTopology::ParseCpuList(const std::string &cpuList, std::vector<uint32_t> &cpus)
+{
+    cpus.clear();
+    const char *p = cpuList.c_str();
+    while (*p != '\0')
+    {
+        char *end = nullptr;
+        unsigned long first = strtoul(p, &end, 10);
+        if (end == p)
+        {
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        unsigned long last = first;
+        p = end;
+        if (*p == '-')
+        {
+            last = strtoul(p + 1, &end, 10);
+            if (end == p + 1 || last < first)
+            {
+                return MRDA_STATUS_INVALID_DATA;
+            }
+            p = end;
+        }
+        for (unsigned long cpu = first; cpu <= last; cpu++) cpus.push_back(static_cast<uint32_t>(cpu));
+        if (*p == ',') p++;
+        else if (*p != '\0') return MRDA_STATUS_INVALID_DATA;
+    }
+    std::sort(cpus.begin(), cpus.end());
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostTopology.h
+//! \brief NUMA topology of the host: nodes and their cpus, the node of
+//!        pci devices and of mapped memory, and thread binding to a node
+//! \date 2026-10-17
+//!
+
+#ifndef _HOST_TOPOLOGY_H_
+#define _HOST_TOPOLOGY_H_
+
+#include "../utils/common.h"
+
+#include <string>
+#include <vector>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t TOPOLOGY_PAGE_SAMPLES = 64; //!< pages sampled to find the node of a mapping
+
+//!
+//! \brief how the threads of a session are placed
+//!
+enum class AffinityPolicy
+{
+    NONE = 0, //!< threads float, nothing is bound
+    DEVICE,   //!< node of the assigned device, the memory node if it has none
+    MEMORY    //!< node of the shared memory pages, the device node if unknown
+};
+
+//!
+//! \brief one NUMA node
+//!
+struct NumaNodeInfo
+{
+    int32_t id = -1;            //!< node id
+    std::vector<uint32_t> cpus; //!< online cpus of the node
+};
+
+class HostTopology
+{
+public:
+    //!
+    //! \brief Construct a new Host Topology object
+    //!
+    //! \param [in] rootPath
+    //!             root of sys, a fixture tree in tests
+    //!
+    explicit HostTopology(const std::string &rootPath = "/");
+    //!
+    //! \brief Destroy the Host Topology object
+    //!
+    virtual ~HostTopology() = default;
+
+    //!
+    //! \brief Read the nodes and their cpus from sysfs, a host without
+    //!        node entries is one node holding all cpus
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //!
+    MRDAStatus Discover();
+
+    //!
+    //! \brief Get the number of nodes
+    //!
+    //! \return size_t
+    //!
+    inline size_t NodeNum() const { return m_nodes.size(); }
+
+    //!
+    //! \brief Get a node by id
+    //!
+    //! \param [in] node
+    //! \return const NumaNodeInfo*
+    //!         nullptr if the node does not exist
+    //!
+    const NumaNodeInfo* GetNode(int32_t node) const;
+
+    //!
+    //! \brief Get the node a pci device is attached to
+    //!
+    //! \param [in] pciSlot
+    //!             pci address, e.g. 0000:03:00.0
+    //! \return int32_t
+    //!         -1 if unknown
+    //!
+    int32_t GetDeviceNode(const std::string &pciSlot) const;
+
+    //!
+    //! \brief Get the node holding most of the sampled pages of a mapping,
+    //!        the sampled pages are read to fault them in
+    //!
+    //! \param [in] addr
+    //! \param [in] size
+    //! \return int32_t
+    //!         -1 if unknown
+    //!
+    static int32_t GetMemoryNode(const void *addr, size_t size);
+
+    //!
+    //! \brief Bind the calling thread to the cpus of a node and prefer the
+    //!        node for its allocations
+    //!
+    //! \param [in] node
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //!
+    MRDAStatus BindThread(int32_t node) const;
+
+    //!
+    //! \brief Choose the node to bind a session to, a single node host
+    //!        or a node without cpus binds nothing
+    //!
+    //! \param [in] policy
+    //! \param [in] deviceNode
+    //!             node of the assigned device, -1 if unknown
+    //! \param [in] memoryNode
+    //!             node of the shared memory pages, -1 if unknown
+    //! \return int32_t
+    //!         -1 if the session threads stay unbound
+    //!
+    int32_t ChooseNode(AffinityPolicy policy, int32_t deviceNode, int32_t memoryNode) const;
+
+    //!
+    //! \brief Format cpus as a sysfs cpulist, e.g. 0-3,8
+    //!
+    //! \param [in] cpus
+    //!             sorted cpus
+    //! \return std::string
+    //!
+    static std::string FormatCpuList(const std::vector<uint32_t> &cpus);
+
+    //!
+    //! \brief Parse a sysfs cpulist
+    //!
+    //! \param [in] cpuList
+    //! \param [out] cpus
+    //! \return MRDAStatus
+    //!
+    static MRDAStatus ParseCpuList(const std::string &cpuList, std::vector<uint32_t> &cpus);
+
+private:
+    //!
+    //! \brief Get the path of a sys entry under the root
+    //!
+    //! \param [in] path
+    //!             absolute path on a live host
+    //! \return std::string
+    //!
+    std::string RootPath(const std::string &path) const;
+
+    std::string m_rootPath;            //!< root of sys
+    std::vector<NumaNodeInfo> m_nodes; //!< nodes sorted by id
+};
+
+VDI_NS_END
+#endif // _HOST_TOPOLOGY_H_
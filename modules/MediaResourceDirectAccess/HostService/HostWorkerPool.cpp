@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostWorkerPool.cpp
+//! \brief Implement the host wide stripe worker pool
+//! \date 2026-10-17
+//!
+
+#include "HostWorkerPool.h"
+
+#include <algorithm>
+
+VDI_NS_BEGIN
+
+HostWorkerPool& HostWorkerPool::Instance()
+{
+    // the calling thread runs a share of every job, so keep one core for it
+    static HostWorkerPool pool([]() {
+        uint32_t cores = std::thread::hardware_concurrency();
+        uint32_t workerNum = cores > 1 ? cores - 1 : 1;
+        return std::min(workerNum, HOST_WORKER_MAX_NUM);
+    }());
+    return pool;
+}
+
+HostWorkerPool::HostWorkerPool(uint32_t workerNum)
+    : m_stop(false)
+{
+    for (uint32_t i = 0; i < workerNum; i++)
+    {
+        m_workers.emplace_back(&HostWorkerPool::WorkerThread, this);
+    }
+    MRDA_LOG(LOG_INFO, "Host worker pool started with %u workers", workerNum);
+}
+
+HostWorkerPool::~HostWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobCond.notify_all();
+    for (auto &worker : m_workers)
+    {
+        if (worker.joinable()) worker.join();
+    }
+}
+
+void HostWorkerPool::RunJob(StripeJob *job)
+{
+    uint32_t idx = job->next.fetch_add(1, std::memory_order_relaxed);
+    while (idx < job->num)
+    {
+        (*job->task)(idx);
+        job->done.fetch_add(1, std::memory_order_acq_rel);
+        idx = job->next.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void HostWorkerPool::WorkerThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        StripeJob *job = nullptr;
+        m_jobCond.wait(lock, [this, &job] {
+            if (m_stop) return true;
+            for (StripeJob *pending : m_jobs)
+            {
+                if (pending->next.load(std::memory_order_relaxed) < pending->num)
+                {
+                    job = pending;
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (m_stop) return;
+
+        // the owner waits for active to drop before the job goes away
+        job->active++;
+        lock.unlock();
+        RunJob(job);
+        lock.lock();
+        job->active--;
+        m_doneCond.notify_all();
+    }
+}
+
+void HostWorkerPool::Run(uint32_t num, const std::function<void(uint32_t)> &task)
+{
+    if (num == 0) return;
+    if (num == 1 || m_workers.empty())
+    {
+        for (uint32_t i = 0; i < num; i++) task(i);
+        return;
+    }
+
+    StripeJob job;
+    job.task = &task;
+    job.num = num;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.push_back(&job);
+    }
+    m_jobCond.notify_all();
+
+    // the calling thread works on its own job instead of sleeping
+    RunJob(&job);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobs.remove(&job);
+    m_doneCond.wait(lock, [&job] {
+        return job.done.load(std::memory_order_acquire) == job.num && job.active == 0;
+    });
+}
+
+void HostWorkerPool::RunStripes(uint32_t rows, uint32_t stripes, uint32_t align,
+                                const std::function<void(uint32_t, uint32_t)> &task)
+{
+    if (rows == 0) return;
+    if (align == 0) align = 1;
+    uint32_t units = (rows + align - 1) / align;
+    stripes = std::max(1u, std::min(stripes, units));
+    if (stripes == 1)
+    {
+        task(0, rows);
+        return;
+    }
+
+    // spread the aligned units evenly, the first stripes take the remainder
+    uint32_t base = units / stripes;
+    uint32_t extra = units % stripes;
+    Run(stripes, [&](uint32_t idx) {
+        uint32_t unitBegin = idx * base + std::min(idx, extra);
+        uint32_t unitEnd = unitBegin + base + (idx < extra ? 1 : 0);
+        uint32_t rowBegin = unitBegin * align;
+        uint32_t rowEnd = std::min(unitEnd * align, rows);
+        task(rowBegin, rowEnd);
+    });
+}
+
+VDI_NS_END
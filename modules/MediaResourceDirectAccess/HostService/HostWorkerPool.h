@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostWorkerPool.h
+//! \brief Host wide pool of worker threads running horizontal stripes of
+//!        colour conversions and plane copies for all sessions.
+//! \date 2026-10-17
+//!
+
+#ifndef _HOST_WORKER_POOL_H_
+#define _HOST_WORKER_POOL_H_
+
+#include "../utils/common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t HOST_WORKER_MAX_NUM = 16; //<! upper bound of pool worker threads
+
+class HostWorkerPool
+{
+public:
+    //!
+    //! \brief Get the host wide pool, workers start on first use
+    //!
+    //! \return HostWorkerPool&
+    //!
+    static HostWorkerPool& Instance();
+
+    //!
+    //! \brief Destroy the Host Worker Pool object
+    //!
+    virtual ~HostWorkerPool();
+
+    //!
+    //! \brief Get the number of worker threads
+    //!
+    //! \return uint32_t
+    //!
+    inline uint32_t WorkerNum() const { return static_cast<uint32_t>(m_workers.size()); }
+
+    //!
+    //! \brief Run task(0) .. task(num - 1) on the workers and the calling
+    //!        thread, returns when all of them are done
+    //!
+    //! \param [in] num
+    //! \param [in] task
+    //!
+    void Run(uint32_t num, const std::function<void(uint32_t)> &task);
+
+    //!
+    //! \brief Split rows into stripes and run them, stripe boundaries are
+    //!        multiples of align so 4:2:0 chroma rows are never shared
+    //!
+    //! \param [in] rows
+    //!             number of rows
+    //! \param [in] stripes
+    //!             requested number of stripes, 1 runs on the calling thread
+    //! \param [in] align
+    //!             row alignment of stripe boundaries
+    //! \param [in] task
+    //!             called with rowBegin and rowEnd of one stripe
+    //!
+    void RunStripes(uint32_t rows, uint32_t stripes, uint32_t align,
+                    const std::function<void(uint32_t, uint32_t)> &task);
+
+private:
+    //!
+    //! \brief one Run call shared by the workers
+    //!
+    struct StripeJob
+    {
+        const std::function<void(uint32_t)> *task = nullptr; //<! task of each index
+        uint32_t num = 0;                                     //<! number of indexes
+        std::atomic<uint32_t> next{0};                        //<! next index to claim
+        std::atomic<uint32_t> done{0};                        //<! finished indexes
+        uint32_t active = 0;                                  //<! workers inside the job, under m_mutex
+    };
+
+    //!
+    //! \brief Construct a new Host Worker Pool object
+    //!
+    //! \param [in] workerNum
+    //!
+    explicit HostWorkerPool(uint32_t workerNum);
+
+    //!
+    //! \brief Worker thread loop
+    //!
+    void WorkerThread();
+
+    //!
+    //! \brief Claim and run indexes of a job until none is left
+    //!
+    //! \param [in] job
+    //!
+    static void RunJob(StripeJob *job);
+
+    std::vector<std::thread> m_workers; //<! worker threads
+    std::list<StripeJob*> m_jobs;       //<! jobs with indexes left to claim
+    std::mutex m_mutex;                 //<! guard of m_jobs and job activity
+    std::condition_variable m_jobCond;  //<! signaled on new jobs and stop
+    std::condition_variable m_doneCond; //<! signaled when a worker leaves a job
+    bool m_stop;                        //<! stop flag of the workers
+};
+
+VDI_NS_END
+#endif // _HOST_WORKER_POOL_H_
@@ -33,8 +33,6 @@
 
 #include "ResourceManager.h"
 
-#include <stdio.h>
-#include <cstring>
 #include <algorithm>
 
 VDI_NS_BEGIN
@@ -42,166 +40,26 @@ VDI_NS_BEGIN
 constexpr float MAX_GPU_USAGE = 100.0f;
 constexpr float MAX_CPU_USAGE = 100.0f;
 
-enum class ACCResourceDriver
+MRDAStatus ResourceAllocatorStrategy::CheckGPU(const ResourceSnapshot &snapshot)
 {
-    I915DRIVER = 0,
-    QAT420XXDRIVER,
-    UNKNOWNDRIVER
-};
-
-MRDAStatus ResourceAllocatorStrategy::CheckGPU()
-{
-    // check i915 driver
-    char buffer[128];
-    memset(buffer, 0, sizeof(buffer));
-    ACCResourceDriver accDriver = ACCResourceDriver::UNKNOWNDRIVER;
-    const char *drivers[2] = {"i915", "420xx"};
-    int32_t gpuCount = 0;
-    for (uint32_t i = 0; i < sizeof(drivers) / sizeof(drivers[0]); i++)
-    {
-        char command[256];
-        snprintf(command, sizeof(command), "cat /sys/class/drm/renderD*/device/uevent | grep 'DRIVER=%s' | wc -l", drivers[i]);
-        FILE* fp = popen(command, "r");
-        if (fp == nullptr)
-        {
-            MRDA_LOG(LOG_ERROR, "Failed to check GPU device nodes info");
-            return MRDA_STATUS_INVALID_DATA;
-        }
-
-        if(fgets(buffer, sizeof(buffer), fp) == nullptr)
-        {
-            MRDA_LOG(LOG_ERROR, "Failed to get GPU device nodes info");
-            pclose(fp);
-            return MRDA_STATUS_INVALID_DATA;
-        }
-        pclose(fp);
-        gpuCount = atoi(buffer);
-        if (gpuCount > 0)
-        {
-            accDriver = static_cast<ACCResourceDriver>(i);
-            break;
-        }
-    }
-
-    if (gpuCount <= 0)
+    // strategies decide whether a host without GPU can take the task
+    m_gpuUsage.clear();
+    for (auto &gpu : snapshot.gpus)
     {
-        MRDA_LOG(LOG_ERROR, "No GPU device nodes found");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-
-    // i915 driver - get xpu-smi info: gpu usage
-    if (accDriver == ACCResourceDriver::I915DRIVER)
-    {
-        for (int32_t i = 0; i < gpuCount; i++)
-        {
-            char cmd[128];
-            sprintf(cmd, "xpu-smi dump -m 0 -d %d | head -n 2 | tail -n 1 | awk -F ',' '{print $NF}'", i);
-            FILE *fp = popen(cmd, "r");
-            if (fp == nullptr)
-            {
-                MRDA_LOG(LOG_ERROR, "Failed to get GPU device nodes info");
-                return MRDA_STATUS_INVALID_DATA;
-            }
-
-            memset(buffer, 0, sizeof(buffer));
-            if(fgets(buffer, sizeof(buffer), fp) == nullptr)
-            {
-                MRDA_LOG(LOG_ERROR, "Failed to get GPU device nodes info");
-                pclose(fp);
-                return MRDA_STATUS_INVALID_DATA;
-            }
-            pclose(fp);
-            float curGpuUsage = atof(buffer);
-            if (curGpuUsage < 0 || curGpuUsage > 100)
-            {
-                MRDA_LOG(LOG_ERROR, "Invalid GPU usage: %f, cpu id %d", curGpuUsage, i);
-                return MRDA_STATUS_INVALID_DATA;
-            }
-
-            MRDA_LOG(LOG_INFO, "curGpuUsage %f", curGpuUsage);
-            auto it = std::find_if(m_gpuUsage.begin(), m_gpuUsage.end(), [i](const std::pair<uint32_t, float>& element) {
-            return element.first == i;});
-            if (it != m_gpuUsage.end()) {
-                // MRDA_LOG(LOG_INFO, "In gpu vector UPDATE : %d, %f", it->first, curGpuUsage);
-                it->second = curGpuUsage;
-            } else {
-                // MRDA_LOG(LOG_INFO, "In gpu vector PUSH : %d, %f", i, curGpuUsage);
-                m_gpuUsage.push_back(std::make_pair(i, curGpuUsage));
-            }
-        }
-    }
-    else if (accDriver == ACCResourceDriver::QAT420XXDRIVER)
-    {
-        // TODO: add qat420xx information collection
-        if (m_gpuUsage.empty()) {
-            for (int32_t i = 0; i < gpuCount; i++)
-            {
-                m_gpuUsage.push_back(std::make_pair(i, 0.0));
-            }
-        }
+        m_gpuUsage.push_back(std::make_pair(gpu.id, gpu.usage));
     }
     return MRDA_STATUS_SUCCESS;
 }
 
-
-
-MRDAStatus ResourceAllocatorStrategy::CheckCPU()
+MRDAStatus ResourceAllocatorStrategy::CheckCPU(const ResourceSnapshot &snapshot)
 {
-    // get cpu cores number
-    char buffer[128];
-    memset(buffer, 0, sizeof(buffer));
-    FILE* fp = popen("cat /proc/cpuinfo | grep 'cpu cores' | uniq | cut -d ':' -f 2", "r");
-    if (fp == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to get cpu cores number");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-
-    if(fgets(buffer, sizeof(buffer), fp) == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to get cpu cores number");
-        pclose(fp);
-        return MRDA_STATUS_INVALID_DATA;
-    }
-    pclose(fp);
-
-    int cpuCores = atoi(buffer);
-
-    MRDA_LOG(LOG_INFO, "cpuCores %d", cpuCores);
-    if (cpuCores <= 0)
-    {
-        MRDA_LOG(LOG_ERROR, "Invalid cpu cores number: %d", cpuCores);
-        return MRDA_STATUS_INVALID_DATA;
-    }
-
-    // get cpu usage
-    fp = popen("top -b -n 1 | grep 'Cpu(s)' | uniq | cut -d ':' -f 2 | cut -d ',' -f 4 | awk '{print $1}'", "r");
-    if (fp == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to get cpu usage");
-        return MRDA_STATUS_INVALID_DATA;
-    }
-
-    if(fgets(buffer, sizeof(buffer), fp) == nullptr)
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to get cpu usage");
-        pclose(fp);
-        return MRDA_STATUS_INVALID_DATA;
-    }
-    pclose(fp);
-
-    float idle_cpuUsage = atof(buffer);
-    if (idle_cpuUsage < 0)
+    if (snapshot.cpuCores == 0)
     {
-        MRDA_LOG(LOG_ERROR, "Invalid cpu usage: %f", idle_cpuUsage);
+        MRDA_LOG(LOG_ERROR, "Invalid cpu cores number: %u", snapshot.cpuCores);
         return MRDA_STATUS_INVALID_DATA;
     }
-    // calculate cpu usage
-    float total_cpuUsage = 100 - idle_cpuUsage;
-    m_cpuUsage = total_cpuUsage;
-
-    MRDA_LOG(LOG_INFO, "m_cpuUsage %f", m_cpuUsage);
-
+    m_cpuUsage = snapshot.cpuUsage;
+    m_cpuCores = snapshot.cpuCores;
     return MRDA_STATUS_SUCCESS;
 }
 
@@ -209,7 +67,7 @@ MRDAStatus CPUResourceFirstAllocatorStrategy::AllocateResource(TaskInfo *taskInf
 {
     //CPU resource first
     // check gpu and cpu usage VALID
-    if (m_gpuUsage.empty() || m_cpuUsage <= 0.0f)
+    if (m_gpuUsage.empty() || m_cpuUsage < 0.0f)
     {
         MRDA_LOG(LOG_ERROR, "Invalid gpu or cpu usage");
         return MRDA_STATUS_INVALID_DATA;
@@ -240,7 +98,7 @@ MRDAStatus GPUResourceFirstAllocatorStrategy::AllocateResource(TaskInfo *taskInf
 {
     //GPU resource first
     // check gpu and cpu usage VALID
-    if (m_gpuUsage.empty() || m_cpuUsage <= 0.0f)
+    if (m_gpuUsage.empty() || m_cpuUsage < 0.0f)
     {
         MRDA_LOG(LOG_ERROR, "Invalid gpu or cpu usage");
         return MRDA_STATUS_INVALID_DATA;
@@ -277,20 +135,48 @@ MRDAStatus ResourceManager::SetResourceAllocatorStrategy(std::shared_ptr<Resourc
         MRDA_LOG(LOG_ERROR, "Invalid strategy");
         return MRDA_STATUS_INVALID_DATA;
     }
+    std::unique_lock<std::mutex> lock(m_mutex);
     m_allocatorStrategy = strategy;
     return MRDA_STATUS_SUCCESS;
 }
 
+MRDAStatus ResourceManager::StartTelemetry(const TelemetryConfig &config)
+{
+    if (m_telemetry != nullptr)
+    {
+        m_telemetry->Stop();
+    }
+    m_telemetry = std::make_unique<ResourceTelemetry>(config);
+    return m_telemetry->Start();
+}
+
+MRDAStatus ResourceManager::GetSnapshot(ResourceSnapshot &snapshot)
+{
+    if (m_telemetry == nullptr)
+    {
+        return MRDA_STATUS_NOT_READY;
+    }
+    return m_telemetry->GetSnapshot(snapshot);
+}
+
 MRDAStatus ResourceManager::AllocateResource(TaskInfo *taskInfo)
 {
-    if (taskInfo == nullptr)
+    if (taskInfo == nullptr || m_allocatorStrategy == nullptr)
     {
-        MRDA_LOG(LOG_ERROR, "Invalid task info");
+        MRDA_LOG(LOG_ERROR, "Invalid task info or strategy");
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    if (MRDA_STATUS_SUCCESS != m_allocatorStrategy->CheckCPU() ||
-        MRDA_STATUS_SUCCESS != m_allocatorStrategy->CheckGPU())
+    // the sampler keeps the usage fresh, allocation only reads it
+    ResourceSnapshot snapshot;
+    if (m_telemetry == nullptr || MRDA_STATUS_SUCCESS != m_telemetry->GetSnapshot(snapshot))
+    {
+        MRDA_LOG(LOG_ERROR, "No resource telemetry!");
+        return MRDA_STATUS_NOT_READY;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (MRDA_STATUS_SUCCESS != m_allocatorStrategy->CheckCPU(snapshot) ||
+        MRDA_STATUS_SUCCESS != m_allocatorStrategy->CheckGPU(snapshot))
     {
         MRDA_LOG(LOG_ERROR, "Failed to check GPU or CPU!");
         return MRDA_STATUS_OPERATION_FAIL;
@@ -299,4 +185,21 @@ MRDAStatus ResourceManager::AllocateResource(TaskInfo *taskInfo)
     return m_allocatorStrategy->AllocateResource(taskInfo);
 }
 
+MRDAStatus ResourceManager::CommitResource(uint32_t taskId, const MediaParams &params)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_allocatorStrategy == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid strategy");
+        return MRDA_STATUS_INVALID_STATE;
+    }
+    return m_allocatorStrategy->CommitResource(taskId, params);
+}
+
+void ResourceManager::ReleaseResource(uint32_t taskId)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_allocatorStrategy != nullptr) m_allocatorStrategy->ReleaseResource(taskId);
+}
+
 VDI_NS_END
\ No newline at end of file
@@ -36,7 +36,9 @@
 #define _RESOURCE_MANAGER_H_
 
 #include "../utils/common.h"
+#include "ResourceTelemetry.h"
 
+#include <mutex>
 #include <vector>
 
 VDI_NS_BEGIN
@@ -51,6 +53,7 @@ public:
     {
         m_gpuUsage.clear();
         m_cpuUsage = 0.0f;
+        m_cpuCores = 0;
     };
     //!
     //! \brief Destroy the Resource Allocator Strategy object
@@ -60,18 +63,22 @@ public:
     //!
     //! \brief Check GPU resources on host
     //!
+    //! \param [in] snapshot
+    //!             latest telemetry snapshot
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fails
     //!
-    MRDAStatus CheckGPU();
+    MRDAStatus CheckGPU(const ResourceSnapshot &snapshot);
 
     //!
     //! \brief Check CPU resources on host
     //!
+    //! \param [in] snapshot
+    //!             latest telemetry snapshot
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fails
     //!
-    MRDAStatus CheckCPU();
+    MRDAStatus CheckCPU(const ResourceSnapshot &snapshot);
 
     //!
     //! \brief allocate resource by task info
@@ -80,9 +87,27 @@ public:
     //! \return MRDAStatus
     //!
     virtual MRDAStatus AllocateResource(TaskInfo *taskInfo) = 0;
+
+    //!
+    //! \brief Check a placed task against its media params
+    //!
+    //! \param [in] taskId
+    //! \param [in] params
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if the task may run, else it is refused
+    //!
+    virtual MRDAStatus CommitResource(uint32_t taskId, const MediaParams &params) { return MRDA_STATUS_SUCCESS; }
+
+    //!
+    //! \brief Give back the resource of a stopped task
+    //!
+    //! \param [in] taskId
+    //!
+    virtual void ReleaseResource(uint32_t taskId) {}
 protected:
     std::vector<std::pair<uint32_t, float>> m_gpuUsage; //!< gpu usage
     float m_cpuUsage; //!< cpu usage
+    uint32_t m_cpuCores; //!< cpu cores
 };
 
 class CPUResourceFirstAllocatorStrategy : public ResourceAllocatorStrategy
@@ -147,6 +172,24 @@ public:
     //!
     MRDAStatus SetResourceAllocatorStrategy(std::shared_ptr<ResourceAllocatorStrategy> strategy);
 
+    //!
+    //! \brief Start sampling host resources in the background
+    //!
+    //! \param [in] config
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //!
+    MRDAStatus StartTelemetry(const TelemetryConfig &config);
+
+    //!
+    //! \brief Get the latest telemetry snapshot
+    //!
+    //! \param [out] snapshot
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_READY if telemetry is not started
+    //!
+    MRDAStatus GetSnapshot(ResourceSnapshot &snapshot);
+
     //!
     //! \brief allocate resource by task info
     //!
@@ -156,9 +199,28 @@ public:
     //!
     MRDAStatus AllocateResource(TaskInfo *taskInfo);
 
+    //!
+    //! \brief Check a placed task against its media params
+    //!
+    //! \param [in] taskId
+    //! \param [in] params
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if the task may run, else it is refused
+    //!
+    MRDAStatus CommitResource(uint32_t taskId, const MediaParams &params);
+
+    //!
+    //! \brief Give back the resource of a stopped task
+    //!
+    //! \param [in] taskId
+    //!
+    void ReleaseResource(uint32_t taskId);
+
 private:
     std::shared_ptr<ResourceAllocatorStrategy> m_allocatorStrategy; //!< resource allocator strategy
+    std::unique_ptr<ResourceTelemetry> m_telemetry; //!< background resource sampler
+    std::mutex m_mutex; //!< serializes allocations, StartService runs on several threads
 };
 
-#endif // _RESOURCE_MANAGER_H_
-VDI_NS_END
\ No newline at end of file
+VDI_NS_END
+#endif // _RESOURCE_MANAGER_H_
\ No newline at end of file
@@ -0,0 +1,460 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ResourceTelemetry.cpp
+//! \brief implement the host resource sampler
+//! \date 2026-10-17
+//!
+
+#include "ResourceTelemetry.h"
+
+#include <dirent.h>
+#include <stdio.h>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+VDI_NS_BEGIN
+
+constexpr float MAX_USAGE = 100.0f;
+constexpr const char *DRM_PDEV_KEY = "drm-pdev:";
+constexpr const char *DRM_CLIENT_KEY = "drm-client-id:";
+constexpr const char *DRM_ENGINE_KEY = "drm-engine-";
+constexpr const char *DRM_CAPACITY_KEY = "drm-engine-capacity-";
+
+//!
+//! \brief render node of an accelerator
+//!
+struct RenderNode
+{
+    uint32_t minor;      //!< number of renderD<minor>
+    std::string pciSlot; //!< PCI_SLOT_NAME of the device
+};
+
+//!
+//! \brief Check whether a name is all digits, as a pid directory is
+//!
+static bool IsNumber(const char *name)
+{
+    if (name == nullptr || *name == '\0') return false;
+    for (const char *c = name; *c != '\0'; c++)
+    {
+        if (*c < '0' || *c > '9') return false;
+    }
+    return true;
+}
+
+//!
+//! \brief Trim the spaces and the line break around a value
+//!
+static std::string TrimValue(const char *value)
+{
+    while (*value == ' ' || *value == '\t') value++;
+    std::string str(value);
+    while (!str.empty() && (str.back() == '\n' || str.back() == ' ' || str.back() == '\t'))
+    {
+        str.pop_back();
+    }
+    return str;
+}
+
+ResourceTelemetry::ResourceTelemetry(const TelemetryConfig &config)
+    : m_config(config),
+      m_stop(false),
+      m_prevCpuTotal(0),
+      m_prevCpuIdle(0)
+{
+    if (m_config.ewmaAlpha <= 0.0f || m_config.ewmaAlpha > 1.0f)
+    {
+        MRDA_LOG(LOG_WARNING, "Invalid ewma alpha %f, use %f", m_config.ewmaAlpha, TELEMETRY_EWMA_ALPHA);
+        m_config.ewmaAlpha = TELEMETRY_EWMA_ALPHA;
+    }
+    if (m_config.intervalMs == 0)
+    {
+        m_config.intervalMs = TELEMETRY_INTERVAL_MS;
+    }
+    if (m_config.rootPath.empty())
+    {
+        m_config.rootPath = "/";
+    }
+}
+
+ResourceTelemetry::~ResourceTelemetry()
+{
+    Stop();
+}
+
+MRDAStatus ResourceTelemetry::Start()
+{
+    if (m_thread.joinable())
+    {
+        MRDA_LOG(LOG_ERROR, "Telemetry sampler is already running");
+        return MRDA_STATUS_INVALID_STATE;
+    }
+    // allocation never waits for the first interval
+    MRDAStatus st = Sample();
+    if (MRDA_STATUS_SUCCESS != st)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to take the first telemetry sample");
+        return st;
+    }
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stop = false;
+        MRDA_LOG(LOG_INFO, "Telemetry sampler started: %u cpus, %zu gpus, every %u ms",
+                 m_snapshot.cpuCores, m_snapshot.gpus.size(), m_config.intervalMs);
+    }
+    m_thread = std::thread(&ResourceTelemetry::SampleThread, this);
+    return MRDA_STATUS_SUCCESS;
+}
+
+void ResourceTelemetry::Stop()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void ResourceTelemetry::SampleThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_cond.wait_for(lock, std::chrono::milliseconds(m_config.intervalMs), [this] { return m_stop; }))
+    {
+        lock.unlock();
+        if (MRDA_STATUS_SUCCESS != Sample())
+        {
+            MRDA_LOG(LOG_WARNING, "Failed to take telemetry sample, keep the last one");
+        }
+        lock.lock();
+    }
+}
+
+MRDAStatus ResourceTelemetry::GetSnapshot(ResourceSnapshot &snapshot)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_snapshot.sampleNum == 0)
+    {
+        return MRDA_STATUS_NOT_READY;
+    }
+    snapshot = m_snapshot;
+    return MRDA_STATUS_SUCCESS;
+}
+
+std::string ResourceTelemetry::RootPath(const std::string &path) const
+{
+    if (m_config.rootPath == "/") return path;
+    std::string root = m_config.rootPath;
+    if (root.back() == '/') root.pop_back();
+    return root + path;
+}
+
+MRDAStatus ResourceTelemetry::Sample()
+{
+    std::unique_lock<std::mutex> sampleLock(m_sampleMutex);
+    ResourceSnapshot snapshot;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        snapshot = m_snapshot;
+    }
+    auto now = std::chrono::steady_clock::now();
+    uint64_t elapsedNs = snapshot.sampleNum == 0 ? 0 :
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_prevSampleTime).count();
+
+    if (MRDA_STATUS_SUCCESS != SampleCPU(snapshot) || MRDA_STATUS_SUCCESS != SampleMemory(snapshot))
+    {
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
+    // a host without accelerators still reports cpu and memory
+    MRDAStatus st = SampleGPU(snapshot, elapsedNs);
+    if (MRDA_STATUS_SUCCESS != st && MRDA_STATUS_NOT_FOUND != st)
+    {
+        return st;
+    }
+    m_prevSampleTime = now;
+    snapshot.sampleNum++;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_snapshot = std::move(snapshot);
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus ResourceTelemetry::SampleCPU(ResourceSnapshot &snapshot)
+{
+    std::string path = RootPath("/proc/stat");
+    FILE *fp = fopen(path.c_str(), "r");
+    if (fp == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to open %s", path.c_str());
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    char line[512];
+    uint64_t total = 0, idle = 0;
+    uint32_t cores = 0;
+    bool found = false;
+    while (fgets(line, sizeof(line), fp) != nullptr)
+    {
+        if (strncmp(line, "cpu", 3) != 0) continue;
+        if (line[3] >= '0' && line[3] <= '9')
+        {
+            cores++;
+            continue;
+        }
+        // cpu user nice system idle iowait irq softirq steal, guest time is in user
+        unsigned long long fields[8] = {0};
+        if (sscanf(line + 3, "%llu %llu %llu %llu %llu %llu %llu %llu", &fields[0], &fields[1], &fields[2],
+                   &fields[3], &fields[4], &fields[5], &fields[6], &fields[7]) < 4)
+        {
+            continue;
+        }
+        for (auto field : fields) total += field;
+        idle = fields[3] + fields[4];
+        found = true;
+    }
+    fclose(fp);
+    if (!found || cores == 0 || total == 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid cpu times in %s", path.c_str());
+        return MRDA_STATUS_INVALID_DATA;
+    }
+
+    // the first sample averages since boot
+    uint64_t deltaTotal = total - m_prevCpuTotal;
+    uint64_t deltaIdle = idle - m_prevCpuIdle;
+    if (total < m_prevCpuTotal || idle < m_prevCpuIdle || deltaIdle > deltaTotal)
+    {
+        deltaTotal = total;
+        deltaIdle = idle;
+    }
+    m_prevCpuTotal = total;
+    m_prevCpuIdle = idle;
+    if (deltaTotal == 0)
+    {
+        // no tick since the last sample, keep the smoothed value
+        snapshot.cpuCores = cores;
+        return MRDA_STATUS_SUCCESS;
+    }
+    float usage = MAX_USAGE * static_cast<float>(deltaTotal - deltaIdle) / static_cast<float>(deltaTotal);
+    snapshot.cpuUsage = snapshot.sampleNum == 0 ? usage : Smooth(snapshot.cpuUsage, usage);
+    snapshot.cpuCores = cores;
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus ResourceTelemetry::SampleMemory(ResourceSnapshot &snapshot)
+{
+    std::string path = RootPath("/proc/meminfo");
+    FILE *fp = fopen(path.c_str(), "r");
+    if (fp == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to open %s", path.c_str());
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    char line[256];
+    unsigned long long value = 0;
+    bool hasTotal = false, hasAvailable = false;
+    while (fgets(line, sizeof(line), fp) != nullptr && !(hasTotal && hasAvailable))
+    {
+        if (sscanf(line, "MemTotal: %llu", &value) == 1)
+        {
+            snapshot.memTotalKB = value;
+            hasTotal = true;
+        }
+        else if (sscanf(line, "MemAvailable: %llu", &value) == 1)
+        {
+            snapshot.memAvailableKB = value;
+            hasAvailable = true;
+        }
+    }
+    fclose(fp);
+    if (!hasTotal || !hasAvailable)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid memory info in %s", path.c_str());
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus ResourceTelemetry::SampleGPU(ResourceSnapshot &snapshot, uint64_t elapsedNs)
+{
+    // render nodes of the first driver present, ordered as the device ids of xpu-smi
+    const char *drivers[2] = {"i915", "420xx"};
+    std::string drmPath = RootPath("/sys/class/drm");
+    std::vector<RenderNode> nodes;
+    ACCResourceDriver accDriver = ACCResourceDriver::UNKNOWNDRIVER;
+    for (uint32_t i = 0; i < sizeof(drivers) / sizeof(drivers[0]) && nodes.empty(); i++)
+    {
+        DIR *dir = opendir(drmPath.c_str());
+        if (dir == nullptr)
+        {
+            return MRDA_STATUS_NOT_FOUND;
+        }
+        std::string driverLine = std::string("DRIVER=") + drivers[i];
+        struct dirent *entry = nullptr;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            if (strncmp(entry->d_name, "renderD", 7) != 0 || !IsNumber(entry->d_name + 7)) continue;
+            std::string ueventPath = drmPath + "/" + entry->d_name + "/device/uevent";
+            FILE *fp = fopen(ueventPath.c_str(), "r");
+            if (fp == nullptr) continue;
+            char line[256];
+            bool match = false;
+            RenderNode node = {static_cast<uint32_t>(atoi(entry->d_name + 7)), ""};
+            while (fgets(line, sizeof(line), fp) != nullptr)
+            {
+                std::string value = TrimValue(line);
+                if (value == driverLine) match = true;
+                else if (value.compare(0, 14, "PCI_SLOT_NAME=") == 0) node.pciSlot = value.substr(14);
+            }
+            fclose(fp);
+            if (match) nodes.push_back(node);
+        }
+        closedir(dir);
+        if (!nodes.empty()) accDriver = static_cast<ACCResourceDriver>(i);
+    }
+    if (nodes.empty())
+    {
+        snapshot.gpus.clear();
+        return MRDA_STATUS_NOT_FOUND;
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const RenderNode &a, const RenderNode &b) { return a.minor < b.minor; });
+
+    std::map<std::string, std::map<std::string, uint64_t>> busyNs;
+    std::map<std::string, std::map<std::string, uint64_t>> capacity;
+    if (accDriver == ACCResourceDriver::I915DRIVER)
+    {
+        ReadDrmClients(busyNs, capacity);
+    }
+    // TODO: add qat420xx information collection
+
+    std::vector<GpuTelemetry> gpus;
+    for (uint32_t i = 0; i < nodes.size(); i++)
+    {
+        GpuTelemetry gpu;
+        gpu.id = i;
+        gpu.driver = accDriver;
+        gpu.pciSlot = nodes[i].pciSlot;
+        // the busiest engine class bounds the sessions a device takes
+        float usage = 0.0f;
+        if (elapsedNs > 0)
+        {
+            for (auto &engine : busyNs[gpu.pciSlot])
+            {
+                uint64_t engineNum = std::max<uint64_t>(1, capacity[gpu.pciSlot][engine.first]);
+                float engineUsage = MAX_USAGE * static_cast<float>(engine.second) / (static_cast<float>(elapsedNs) * engineNum);
+                usage = std::max(usage, std::min(engineUsage, MAX_USAGE));
+            }
+        }
+        auto prev = std::find_if(snapshot.gpus.begin(), snapshot.gpus.end(), [&gpu](const GpuTelemetry &element) {
+            return element.pciSlot == gpu.pciSlot; });
+        gpu.usage = prev == snapshot.gpus.end() ? usage : Smooth(prev->usage, usage);
+        gpus.push_back(gpu);
+    }
+    snapshot.gpus = std::move(gpus);
+    return MRDA_STATUS_SUCCESS;
+}
+
+void ResourceTelemetry::ReadDrmClients(std::map<std::string, std::map<std::string, uint64_t>> &busyNs,
+                                       std::map<std::string, std::map<std::string, uint64_t>> &capacity)
+{
+    std::string procPath = RootPath("/proc");
+    DIR *procDir = opendir(procPath.c_str());
+    if (procDir == nullptr) return;
+    std::map<std::string, std::map<std::string, uint64_t>> clientNs;
+    struct dirent *pidEntry = nullptr;
+    while ((pidEntry = readdir(procDir)) != nullptr)
+    {
+        if (!IsNumber(pidEntry->d_name)) continue;
+        std::string fdinfoPath = procPath + "/" + pidEntry->d_name + "/fdinfo";
+        DIR *fdDir = opendir(fdinfoPath.c_str());
+        if (fdDir == nullptr) continue;
+        struct dirent *fdEntry = nullptr;
+        while ((fdEntry = readdir(fdDir)) != nullptr)
+        {
+            if (!IsNumber(fdEntry->d_name)) continue;
+            std::string path = fdinfoPath + "/" + fdEntry->d_name;
+            FILE *fp = fopen(path.c_str(), "r");
+            if (fp == nullptr) continue;
+            char line[256];
+            std::string pdev, clientId;
+            std::map<std::string, uint64_t> engines;
+            std::map<std::string, uint64_t> engineNum;
+            while (fgets(line, sizeof(line), fp) != nullptr)
+            {
+                char *sep = strchr(line, ':');
+                if (sep == nullptr) continue;
+                if (strncmp(line, DRM_PDEV_KEY, strlen(DRM_PDEV_KEY)) == 0)
+                {
+                    pdev = TrimValue(sep + 1);
+                }
+                else if (strncmp(line, DRM_CLIENT_KEY, strlen(DRM_CLIENT_KEY)) == 0)
+                {
+                    clientId = TrimValue(sep + 1);
+                }
+                else if (strncmp(line, DRM_CAPACITY_KEY, strlen(DRM_CAPACITY_KEY)) == 0)
+                {
+                    std::string engine(line + strlen(DRM_CAPACITY_KEY), sep);
+                    engineNum[engine] = strtoull(sep + 1, nullptr, 10);
+                }
+                else if (strncmp(line, DRM_ENGINE_KEY, strlen(DRM_ENGINE_KEY)) == 0)
+                {
+                    std::string engine(line + strlen(DRM_ENGINE_KEY), sep);
+                    engines[engine] = strtoull(sep + 1, nullptr, 10);
+                }
+            }
+            fclose(fp);
+            // a client shows up once per fd it is opened with
+            std::string key = pdev + "/" + clientId;
+            if (pdev.empty() || clientId.empty() || clientNs.count(key) != 0) continue;
+            clientNs[key] = engines;
+            for (auto &engine : engineNum)
+            {
+                capacity[pdev][engine.first] = engine.second;
+            }
+            auto prev = m_prevClientNs.find(key);
+            for (auto &engine : engines)
+            {
+                // a client new since the last sample spent all its time in the interval
+                uint64_t prevNs = 0;
+                if (prev != m_prevClientNs.end())
+                {
+                    auto prevEngine = prev->second.find(engine.first);
+                    if (prevEngine != prev->second.end()) prevNs = prevEngine->second;
+                }
+                busyNs[pdev][engine.first] += engine.second >= prevNs ? engine.second - prevNs : 0;
+            }
+        }
+        closedir(fdDir);
+    }
+    closedir(procDir);
+    // clients gone since the last sample drop out
+    m_prevClientNs = std::move(clientNs);
+}
+
+VDI_NS_END
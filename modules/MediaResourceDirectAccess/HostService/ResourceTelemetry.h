@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ResourceTelemetry.h
+//! \brief sample host cpu, memory and gpu usage in the background and keep
+//!        smoothed snapshots for resource allocation
+//! \date 2026-10-17
+//!
+
+#ifndef _RESOURCE_TELEMETRY_H_
+#define _RESOURCE_TELEMETRY_H_
+
+#include "../utils/common.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t TELEMETRY_INTERVAL_MS = 1000; //!< default sample interval
+constexpr float TELEMETRY_EWMA_ALPHA = 0.3f;     //!< default weight of the newest sample
+
+enum class ACCResourceDriver
+{
+    I915DRIVER = 0,
+    QAT420XXDRIVER,
+    UNKNOWNDRIVER
+};
+
+//!
+//! \brief sampler configuration
+//!
+struct TelemetryConfig
+{
+    std::string rootPath = "/";                 //!< root of proc and sys, a fixture tree in tests
+    uint32_t intervalMs = TELEMETRY_INTERVAL_MS; //!< sample interval
+    float ewmaAlpha = TELEMETRY_EWMA_ALPHA;      //!< weight of the newest sample, (0, 1]
+};
+
+//!
+//! \brief usage of one accelerator
+//!
+struct GpuTelemetry
+{
+    uint32_t id = 0;                                         //!< index among the render nodes of the driver
+    ACCResourceDriver driver = ACCResourceDriver::UNKNOWNDRIVER; //!< kernel driver
+    std::string pciSlot;                                     //!< pci address, matches drm-pdev of fdinfo
+    float usage = 0.0f;                                      //!< busiest engine class in percent, smoothed
+};
+
+//!
+//! \brief one smoothed view of the host
+//!
+struct ResourceSnapshot
+{
+    uint32_t cpuCores = 0;         //!< online logical cpus
+    float cpuUsage = 0.0f;         //!< busy cpu time in percent, smoothed
+    uint64_t memTotalKB = 0;       //!< MemTotal
+    uint64_t memAvailableKB = 0;   //!< MemAvailable
+    std::vector<GpuTelemetry> gpus; //!< accelerators of the first driver found
+    uint64_t sampleNum = 0;        //!< samples taken, 0 if none yet
+};
+
+class ResourceTelemetry
+{
+public:
+    //!
+    //! \brief Construct a new Resource Telemetry object
+    //!
+    //! \param [in] config
+    //!
+    explicit ResourceTelemetry(const TelemetryConfig &config = TelemetryConfig());
+    //!
+    //! \brief Destroy the Resource Telemetry object, stop the sampler
+    //!
+    virtual ~ResourceTelemetry();
+
+    //!
+    //! \brief Take the first sample and start the sampler thread
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //!
+    MRDAStatus Start();
+
+    //!
+    //! \brief Stop and join the sampler thread
+    //!
+    void Stop();
+
+    //!
+    //! \brief Take one sample now and fold it into the snapshot
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fails
+    //!
+    MRDAStatus Sample();
+
+    //!
+    //! \brief Get the latest snapshot
+    //!
+    //! \param [out] snapshot
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_NOT_READY if no sample is taken yet
+    //!
+    MRDAStatus GetSnapshot(ResourceSnapshot &snapshot);
+
+private:
+    //!
+    //! \brief Read cpu times of /proc/stat
+    //!
+    //! \param [out] snapshot
+    //! \return MRDAStatus
+    //!
+    MRDAStatus SampleCPU(ResourceSnapshot &snapshot);
+
+    //!
+    //! \brief Read /proc/meminfo
+    //!
+    //! \param [out] snapshot
+    //! \return MRDAStatus
+    //!
+    MRDAStatus SampleMemory(ResourceSnapshot &snapshot);
+
+    //!
+    //! \brief Find the render nodes in sysfs and their engine time in the
+    //!        drm fdinfo of all processes
+    //!
+    //! \param [out] snapshot
+    //! \param [in] elapsedNs
+    //!             wall time since the last sample, 0 for the first one
+    //! \return MRDAStatus
+    //!
+    MRDAStatus SampleGPU(ResourceSnapshot &snapshot, uint64_t elapsedNs);
+
+    //!
+    //! \brief Sum the engine time of each drm client per device and engine class
+    //!
+    //! \param [out] busyNs
+    //!              busy time added since the last sample, by pci slot and engine class
+    //! \param [out] capacity
+    //!              engines per class, by pci slot and engine class
+    //!
+    void ReadDrmClients(std::map<std::string, std::map<std::string, uint64_t>> &busyNs,
+                        std::map<std::string, std::map<std::string, uint64_t>> &capacity);
+
+    //!
+    //! \brief Get the path of a proc or sys entry under the root
+    //!
+    //! \param [in] path
+    //!             absolute path on a live host
+    //! \return std::string
+    //!
+    std::string RootPath(const std::string &path) const;
+
+    //!
+    //! \brief Fold a new value into a smoothed one
+    //!
+    //! \param [in] prev
+    //! \param [in] cur
+    //! \return float
+    //!
+    inline float Smooth(float prev, float cur) const
+    {
+        return m_config.ewmaAlpha * cur + (1.0f - m_config.ewmaAlpha) * prev;
+    }
+
+    //!
+    //! \brief Sampler thread
+    //!
+    void SampleThread();
+
+private:
+    TelemetryConfig m_config; //!< sampler configuration
+    std::thread m_thread; //!< sampler thread
+    std::mutex m_mutex; //!< guards the snapshot and the stop flag
+    std::condition_variable m_cond; //!< wakes up the sampler to stop
+    bool m_stop; //!< stops the sampler
+    ResourceSnapshot m_snapshot; //!< latest smoothed snapshot
+    std::mutex m_sampleMutex; //!< serializes samples, guards the counters below
+    uint64_t m_prevCpuTotal; //!< cpu jiffies of the last sample
+    uint64_t m_prevCpuIdle; //!< idle cpu jiffies of the last sample
+    std::chrono::steady_clock::time_point m_prevSampleTime; //!< time of the last sample
+    std::map<std::string, std::map<std::string, uint64_t>> m_prevClientNs; //!< engine time of each drm client by class
+};
+
+VDI_NS_END
+#endif // _RESOURCE_TELEMETRY_H_
@@ -33,46 +33,62 @@
 
 #include "SessionManager.h"
 
-constexpr uint32_t PORT_BASE = 50000;
-constexpr uint32_t PORT_NUM = 50;
+// transports are picked by gRPC from the address scheme
+const std::string UNIX_SCHEME = "unix:";   // unix:<socket path>, host local clients
+const std::string VSOCK_SCHEME = "vsock:"; // vsock:<cid>:<port>, guests over AF_VSOCK
+const std::string VSOCK_CID_ANY = "4294967295"; // VMADDR_CID_ANY, listen on all cids
+const std::string VSOCK_CID_HOST = "2";         // VMADDR_CID_HOST, the host seen from guests
+constexpr size_t SESSION_TOKEN_BYTES = 16;      // random bytes of a session token
 
 VDI_USE_MRDALib;
 
-SessionManagerImpl::SessionManagerImpl(std::string server_addr)
+SessionManagerImpl::SessionManagerImpl(std::string server_addr, const TelemetryConfig &telemetryConfig, const PlacementConfig &placementConfig,
+                                       AffinityPolicy affinityPolicy)
 {
     m_server_addr = server_addr;
-    m_allocator = std::make_shared<GPUResourceFirstAllocatorStrategy>();
+    m_allocator = std::make_shared<CostModelAllocatorStrategy>(placementConfig);
     m_resourceManager = std::make_unique<ResourceManager>();
-    m_server = nullptr;
-    m_hostServices.clear();
-    std::string server_base_addr = GetServerBaseAddr(server_addr);
-    std::unique_lock<std::mutex> lock(m_addrMutex);
-    for (uint32_t i = 1; i <= PORT_NUM; i++)
+    // sample host usage off the StartService path
+    if (MRDA_STATUS_SUCCESS != m_resourceManager->StartTelemetry(telemetryConfig))
     {
-        m_reservedAddrs.push_back(std::make_pair(i, server_base_addr + ":" + std::to_string(PORT_BASE + i)));
+        MRDA_LOG(LOG_ERROR, "Failed to start resource telemetry.");
     }
+    m_topology = std::make_shared<HostTopology>(telemetryConfig.rootPath);
+    m_topology->Discover();
+    m_affinityPolicy = affinityPolicy;
+    m_server = nullptr;
+    m_dispatcher = std::make_unique<HostServiceDispatcher>();
+    m_nextTaskId = 1;
 }
 
-std::pair<uint32_t, std::string> SessionManagerImpl::GenerateServiceAddr()
+uint32_t SessionManagerImpl::GenerateTaskId()
 {
-    std::pair<uint32_t, std::string> addr;
-    std::unique_lock<std::mutex> lock(m_addrMutex);
-    if (m_reservedAddrs.empty())
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to generate service address.");
-        return std::make_pair(0, "");
-    }
-    else
+    uint32_t taskId = m_nextTaskId.fetch_add(1);
+    // 0 is never a valid task id
+    return taskId != 0 ? taskId : m_nextTaskId.fetch_add(1);
+}
+
+std::string SessionManagerImpl::GenerateSessionToken()
+{
+    // random_device reads the kernel entropy pool, not a seeded generator
+    static const char *HEX = "0123456789abcdef";
+    std::random_device random;
+    std::string token;
+    token.reserve(SESSION_TOKEN_BYTES * 2);
+    for (size_t i = 0; i < SESSION_TOKEN_BYTES; i += sizeof(uint32_t))
     {
-        addr = m_reservedAddrs.front();
-        m_reservedAddrs.pop_front();
-        return addr;
+        uint32_t value = random();
+        for (size_t n = 0; n < sizeof(uint32_t) * 2; n++)
+        {
+            token.push_back(HEX[(value >> (n * 4)) & 0xF]);
+        }
     }
+    return token;
 }
 
 MRDAStatus SessionManagerImpl::AssignResource(TaskInfo *taskInfo)
 {
-    // default strategy: GPU resource first
+    // default strategy: cost model placement
     if (m_allocator == nullptr)
     {
         MRDA_LOG(LOG_ERROR, "Failed to create resource allocator.");
@@ -87,15 +103,34 @@ MRDAStatus SessionManagerImpl::AssignResource(TaskInfo *taskInfo)
 
     m_resourceManager->SetResourceAllocatorStrategy(m_allocator);
 
-    if (m_resourceManager->AllocateResource(taskInfo) != MRDA_STATUS_SUCCESS)
+    MRDAStatus st = m_resourceManager->AllocateResource(taskInfo);
+    if (st != MRDA_STATUS_SUCCESS)
     {
         MRDA_LOG(LOG_ERROR, "Failed to allocate resource.");
-        return MRDA_STATUS_INVALID_DATA;
+        return st;
     }
 
     return MRDA_STATUS_SUCCESS;
 }
 
+int32_t SessionManagerImpl::GetDeviceNode(const HWDevice &device)
+{
+    if (device.deviceType != DeviceType::GPU)
+    {
+        return -1;
+    }
+    ResourceSnapshot snapshot;
+    if (MRDA_STATUS_SUCCESS != m_resourceManager->GetSnapshot(snapshot))
+    {
+        return -1;
+    }
+    for (auto &gpu : snapshot.gpus)
+    {
+        if (gpu.id == device.deviceID) return m_topology->GetDeviceNode(gpu.pciSlot);
+    }
+    return -1;
+}
+
 void SessionManagerImpl::CopyTaskInfo(const MRDA::TaskInfo *in, MRDA::TaskInfo *out)
 {
     if (in == nullptr || out == nullptr)
@@ -111,18 +146,20 @@ void SessionManagerImpl::CopyTaskInfo(const MRDA::TaskInfo *in, MRDA::TaskInfo *
     out->set_ipaddr(in->ipaddr());
 }
 
-std::string SessionManagerImpl::GetServerBaseAddr(std::string server_base_addr)
+std::string SessionManagerImpl::GetGuestAddr(const std::string &addr)
 {
-    // Find the position of the colon.
-    size_t colon_pos = server_base_addr.find(':');
-
-    // If there is no colon, return the entire input string.
-    if (colon_pos == std::string::npos) {
-        return server_base_addr;
+    // a server listening on any cid is reached through the host cid
+    std::string anyPrefix = VSOCK_SCHEME + VSOCK_CID_ANY + ":";
+    std::string anyPrefixSigned = VSOCK_SCHEME + "-1:";
+    if (addr.compare(0, anyPrefix.size(), anyPrefix) == 0)
+    {
+        return VSOCK_SCHEME + VSOCK_CID_HOST + ":" + addr.substr(anyPrefix.size());
     }
-
-    // Extract the string before the colon.
-    return server_base_addr.substr(0, colon_pos);
+    if (addr.compare(0, anyPrefixSigned.size(), anyPrefixSigned) == 0)
+    {
+        return VSOCK_SCHEME + VSOCK_CID_HOST + ":" + addr.substr(anyPrefixSigned.size());
+    }
+    return addr;
 }
 
 Status SessionManagerImpl::StartService(ServerContext* context, const MRDA::TaskInfo* in_mrdaInfo, MRDA::TaskInfo* out_mrdaInfo)
@@ -133,18 +170,21 @@ Status SessionManagerImpl::StartService(ServerContext* context, const MRDA::Task
         MRDA_LOG(LOG_ERROR, "Failed to get task info.");
         return Status::CANCELLED;
     }
+    auto startTime = std::chrono::steady_clock::now();
     CopyTaskInfo(in_mrdaInfo, out_mrdaInfo);
-    // get service address
-    std::pair<uint32_t, std::string> serviceAddr = GenerateServiceAddr();
-    if (serviceAddr.second.empty())
-    {
-        MRDA_LOG(LOG_ERROR, "Failed to generate service address.");
-        return Status::CANCELLED;
-    }
+    // sessions are told apart by task id, no address per session
+    uint32_t taskId = GenerateTaskId();
     // assign resource
     TaskInfo taskInfo;
-    taskInfo.taskID = serviceAddr.first;
-    if (MRDA_STATUS_SUCCESS != AssignResource(&taskInfo))
+    taskInfo.taskID = taskId;
+    taskInfo.taskType = static_cast<TASKTYPE>(in_mrdaInfo->tasktype());
+    MRDAStatus st = AssignResource(&taskInfo);
+    if (MRDA_STATUS_NOT_READY == st)
+    {
+        MRDA_LOG(LOG_ERROR, "No device has room for the task.");
+        return Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "no device has room for the task");
+    }
+    if (MRDA_STATUS_SUCCESS != st)
     {
         MRDA_LOG(LOG_ERROR, "Failed to assign resource.");
         return Status::CANCELLED;
@@ -163,24 +203,34 @@ Status SessionManagerImpl::StartService(ServerContext* context, const MRDA::Task
     if (MRDA_STATUS_SUCCESS != hostServiceSession->Initialize(out_mrdaInfo))
     {
         MRDA_LOG(LOG_ERROR, "Failed to initialize host service.");
+        m_resourceManager->ReleaseResource(taskId);
         return Status::CANCELLED;
     }
-
-    // start service start thread
-    std::thread hostServiceStartThread([=](){
-        hostServiceSession->RunService(serviceAddr.second);
+    // threads are bound once the shared memory is mapped and its node is known
+    hostServiceSession->SetAffinity(m_affinityPolicy, m_topology, GetDeviceNode(taskInfo.taskDevice));
+    // the real cost of the session is known once it sends its params
+    ResourceManager *resourceManager = m_resourceManager.get();
+    hostServiceSession->SetAdmission([resourceManager, taskId](const MediaParams &params) {
+        return resourceManager->CommitResource(taskId, params);
     });
-    // detach service start thread
-    hostServiceStartThread.detach();
 
-    // update host services
-    std::unique_lock<std::mutex> lock(m_servicesMutex);
-    m_hostServices.insert(std::make_pair(serviceAddr.first, std::make_pair(serviceAddr.second, hostServiceSession)));
+    // data calls reach the session through the dispatcher on this server,
+    // and only with the token handed out here
+    std::string token = GenerateSessionToken();
+    if (MRDA_STATUS_SUCCESS != m_dispatcher->AddSession(taskId, token, hostServiceSession))
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to add host service session.");
+        m_resourceManager->ReleaseResource(taskId);
+        return Status::CANCELLED;
+    }
 
-    out_mrdaInfo->set_taskid(serviceAddr.first);
-    out_mrdaInfo->set_ipaddr(serviceAddr.second);
+    out_mrdaInfo->set_taskid(taskId);
+    out_mrdaInfo->set_sessiontoken(token);
+    out_mrdaInfo->set_ipaddr(GetGuestAddr(m_server_addr));
     out_mrdaInfo->set_taskstatus(static_cast<int32_t>(TASKStatus::TASK_STATUS_INITIALIZED));
 
+    uint64_t startUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+    MRDA_LOG(LOG_INFO, "Start service! task id : %u, start time %lu us, %zu sessions", taskId, startUs, m_dispatcher->SessionNum());
     return Status::OK;
 }
 
@@ -192,29 +242,19 @@ Status SessionManagerImpl::StopService(ServerContext* context, const MRDA::TaskI
         MRDA_LOG(LOG_ERROR, "Failed to get task info.");
         return Status::CANCELLED;
     }
-    // get host service according to task id
-    std::unique_lock<std::mutex> lock(m_servicesMutex);
-    auto it = m_hostServices.find(taskInfo->taskid());
-    if (it == m_hostServices.end())
+    // calls in flight keep the session alive until they return
+    std::shared_ptr<HostServiceSession> hostService = m_dispatcher->RemoveSession(taskInfo->taskid(), taskInfo->sessiontoken());
+    if (hostService == nullptr)
     {
         MRDA_LOG(LOG_ERROR, "Failed to find host service.");
         status->set_status(static_cast<int32_t>(TASKStatus::TASK_STATUS_ERROR));
         return Status::CANCELLED;
     }
-    else
-    {
-        int32_t taskId = (*it).first;
-        std::string serviceAddr = (*it).second.first;
-        std::shared_ptr<HostServiceSession> hostService = (*it).second.second;
-        hostService->StopService();
-        status->set_status(static_cast<int32_t>(TASKStatus::TASK_STATUS_STOPPED));
-        // release service and address
-        m_hostServices.erase(it);
-        std::unique_lock<std::mutex> lock(m_addrMutex);
-        m_reservedAddrs.push_back(std::make_pair(taskId, serviceAddr));
-        MRDA_LOG(LOG_INFO, "Stop service! task id : %d", taskId);
-        return Status::OK;
-    }
+    hostService->StopService();
+    m_resourceManager->ReleaseResource(taskInfo->taskid());
+    status->set_status(static_cast<int32_t>(TASKStatus::TASK_STATUS_STOPPED));
+    MRDA_LOG(LOG_INFO, "Stop service! task id : %d", taskInfo->taskid());
+    return Status::OK;
 }
 
 Status SessionManagerImpl::ResetService(ServerContext* context, const MRDA::TaskInfo* taskInfo, MRDA::TASKStatus* status)
@@ -233,7 +273,13 @@ void SessionManagerImpl::RunService()
     std::unique_ptr<ServerBuilder> serverBuilder = std::make_unique<ServerBuilder>();
     serverBuilder->AddListeningPort(m_server_addr, grpc::InsecureServerCredentials());
     serverBuilder->RegisterService(this);
+    serverBuilder->RegisterService(m_dispatcher.get());
     m_server = serverBuilder->BuildAndStart();
+    if (m_server == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to listen on %s", m_server_addr.c_str());
+        return;
+    }
     MRDA_LOG(LOG_INFO, "HostService listening on %s", m_server_addr.c_str());
     m_server->Wait();
 }
@@ -255,13 +301,26 @@ void SessionManagerImpl::StopService()
 //!
 int main(int argc, char** argv)
 {
-    if (argc < 2)
+    std::string server_address;
+    TelemetryConfig telemetryConfig;
+    PlacementConfig placementConfig;
+    AffinityPolicy affinityPolicy = AffinityPolicy::DEVICE;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string option(argv[i]);
+        if (option == "-addr") server_address = argv[i + 1];
+        else if (option == "-telemetry_ms") telemetryConfig.intervalMs = static_cast<uint32_t>(atoi(argv[i + 1]));
+        else if (option == "-sys_root") telemetryConfig.rootPath = argv[i + 1];
+        else if (option == "-placement" && std::string(argv[i + 1]) == "best_fit") placementConfig.policy = PlacementPolicy::BEST_FIT;
+        else if (option == "-affinity" && std::string(argv[i + 1]) == "none") affinityPolicy = AffinityPolicy::NONE;
+        else if (option == "-affinity" && std::string(argv[i + 1]) == "memory") affinityPolicy = AffinityPolicy::MEMORY;
+    }
+    if (server_address.empty())
     {
-        MRDA_LOG(LOG_ERROR, "Usage: %s -addr <serviceIp:port>", argv[0]);
+        MRDA_LOG(LOG_ERROR, "Usage: %s -addr <serviceIp:port | unix:path | vsock:cid:port> [-telemetry_ms <interval>] [-sys_root <path>] [-placement <least_loaded | best_fit>] [-affinity <device | memory | none>]", argv[0]);
         return -1;
     }
-    std::string server_address(argv[2]);
-    SessionManagerImpl serviceManager(server_address);
+    SessionManagerImpl serviceManager(server_address, telemetryConfig, placementConfig, affinityPolicy);
     serviceManager.RunService();
     return 0;
 }
\ No newline at end of file
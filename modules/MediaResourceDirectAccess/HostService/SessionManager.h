@@ -56,10 +56,14 @@ using grpc::Status;
 #include "../protos/MRDAService.pb.h"
 
 #include "ResourceManager.h"
+#include "CostModelAllocator.h"
 #include "HostServiceSession.h"
+#include "HostServiceDispatcher.h"
 #include "HostService.h"
 
-#include <map>
+#include <atomic>
+#include <chrono>
+#include <random>
 #include <string>
 
 VDI_USE_MRDALib;
@@ -70,7 +74,17 @@ public:
     //!
     //! \brief Construct a new Service Manager Impl object
     //!
-    SessionManagerImpl(std::string server_addr);
+    //! \param [in] server_addr
+    //! \param [in] telemetryConfig
+    //!             host resource sampler configuration
+    //! \param [in] placementConfig
+    //!             device placement configuration
+    //! \param [in] affinityPolicy
+    //!             NUMA placement of the session threads
+    //!
+    SessionManagerImpl(std::string server_addr, const TelemetryConfig &telemetryConfig = TelemetryConfig(),
+                       const PlacementConfig &placementConfig = PlacementConfig(),
+                       AffinityPolicy affinityPolicy = AffinityPolicy::DEVICE);
 
     //!
     //! \brief Destroy the Service Manager Impl object
@@ -119,11 +133,20 @@ public:
 
 private:
     //!
-    //! \brief Generate service addr with task id
+    //! \brief Generate a task id, unique while the manager runs
+    //!
+    //! \return uint32_t
+    //!
+    uint32_t GenerateTaskId();
+
+    //!
+    //! \brief Generate a random session token, the guest sends it with
+    //!        every call on the session
     //!
-    //! \return std::pair<uint32_t, std::string>
+    //! \return std::string
+    //!         hex of SESSION_TOKEN_BYTES random bytes
     //!
-    std::pair<uint32_t, std::string> GenerateServiceAddr();
+    std::string GenerateSessionToken();
 
     //!
     //! \brief Assign hardware resource to a host service
@@ -133,6 +156,15 @@ private:
     //!
     MRDAStatus AssignResource(TaskInfo* taskInfo);
 
+    //!
+    //! \brief Get the NUMA node of an assigned device
+    //!
+    //! \param [in] device
+    //! \return int32_t
+    //!         -1 if unknown or not a GPU
+    //!
+    int32_t GetDeviceNode(const HWDevice &device);
+
     //!
     //! \brief Copy taskInfo in to out
     //!
@@ -142,22 +174,24 @@ private:
     void CopyTaskInfo(const MRDA::TaskInfo *in, MRDA::TaskInfo *out);
 
     //!
-    //! \brief Get the Server Base Addr object
+    //! \brief Get the address guests dial for a listening address:
+    //!         ip:port, unix:path or vsock:cid:port
     //!
-    //! \param [in] server_addr
+    //! \param [in] addr
+    //!             listening address of the server
     //! \return string
     //!
-    std::string GetServerBaseAddr(std::string server_addr);
+    std::string GetGuestAddr(const std::string &addr);
 
 private:
     std::string m_server_addr; //!< server address
     std::shared_ptr<ResourceAllocatorStrategy> m_allocator; //!< resource allocator strategy
     std::unique_ptr<ResourceManager> m_resourceManager; //!< resource manager
+    std::shared_ptr<HostTopology> m_topology; //!< NUMA topology, shared with the sessions
+    AffinityPolicy m_affinityPolicy; //!< NUMA placement of the session threads
+    std::unique_ptr<HostServiceDispatcher> m_dispatcher; //!< serves the data calls of all sessions on m_server, outlives it
     std::unique_ptr<Server> m_server; //<! gRPC server handle
-    std::map<int32_t, std::pair<std::string, std::shared_ptr<HostServiceSession>>> m_hostServices; //!< for each service addr, assign a host service.
-    std::list<std::pair<uint32_t, std::string>> m_reservedAddrs; //!< reservced service addrs
-    std::mutex m_addrMutex; //!< mutex for addr
-    std::mutex m_servicesMutex; //!< mutex for services
+    std::atomic<uint32_t> m_nextTaskId; //!< next task id to hand out
 };
 
 #endif //_SESSIONMANAGER_H_
\ No newline at end of file
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmByteRing.cpp
+//! \brief implement host side byte ring allocator
+//! \date 2026-10-17
+//!
+
+#include "ShmByteRing.h"
+
+VDI_NS_BEGIN
+
+ShmByteRing::ShmByteRing()
+    :m_shmMem(nullptr),
+     m_begin(0),
+     m_end(0),
+     m_head(0)
+{
+}
+
+ShmByteRing::~ShmByteRing()
+{
+    m_entries.clear();
+    m_seq.clear();
+    m_shmMem = nullptr;
+}
+
+MRDAStatus ShmByteRing::Init(char *shmMem, const ShmRegionLayout &layout)
+{
+    if (shmMem == nullptr || !layout.IsByteRing() || layout.dataSize == 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid byte ring region!");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    m_shmMem = shmMem;
+    m_layout = layout;
+    m_begin = layout.dataOffset;
+    m_end = layout.dataOffset + layout.dataSize;
+    m_head = m_begin;
+    m_entries.clear();
+    m_seq.assign(layout.bufferNum + 1, 0);
+    return MRDA_STATUS_SUCCESS;
+}
+
+void ShmByteRing::Reclaim()
+{
+    while (!m_entries.empty())
+    {
+        const RingEntry &entry = m_entries.front();
+        // the id was taken again from the idle index, so the old range is free
+        bool superseded = m_seq[entry.bufId] != entry.seq;
+        BufferState state = ShmLoadState(m_shmMem + m_layout.StateOffset(entry.bufId));
+        if (!superseded && state != BufferState::BUFFER_STATE_IDLE)
+        {
+            break;
+        }
+        m_entries.pop_front();
+    }
+    if (m_entries.empty())
+    {
+        m_head = m_begin;
+    }
+}
+
+MRDAStatus ShmByteRing::Allocate(uint32_t bufId, uint64_t size, uint64_t &offset, uint64_t &reserved)
+{
+    if (m_shmMem == nullptr || bufId == 0 || bufId > m_layout.bufferNum)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid byte ring allocation!");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    reserved = ShmAlignUp(size > 0 ? size : 1, m_layout.slotSize);
+    if (reserved > Capacity())
+    {
+        MRDA_LOG(LOG_ERROR, "Allocation size %lu exceeds byte ring capacity!", size);
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    // a new reservation of this id means its previous range was released
+    m_seq[bufId]++;
+    Reclaim();
+
+    uint64_t start = m_head;
+    uint64_t pos = m_head;
+    if (m_entries.empty())
+    {
+        pos = m_begin;
+        start = m_begin;
+    }
+    else
+    {
+        uint64_t tail = m_entries.front().start;
+        if (m_head > tail)
+        {
+            // free space is [head, end) and [begin, tail)
+            if (m_head + reserved > m_end)
+            {
+                if (m_begin + reserved > tail) return MRDA_STATUS_NOT_READY;
+                pos = m_begin; // wrap, the padding up to end belongs to this entry
+            }
+        }
+        else if (m_head + reserved > tail)
+        {
+            // free space is [head, tail), head == tail means full
+            return MRDA_STATUS_NOT_READY;
+        }
+    }
+
+    RingEntry entry;
+    entry.bufId = bufId;
+    entry.seq = m_seq[bufId];
+    entry.start = start;
+    entry.end = pos + reserved;
+    m_entries.push_back(entry);
+    m_head = entry.end == m_end ? m_begin : entry.end;
+    offset = pos;
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
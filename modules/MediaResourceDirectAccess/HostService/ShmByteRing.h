@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmByteRing.h
+//! \brief Host side allocator of variable sized ranges in a byte ring
+//!        share memory region, used for encoded bitstream output.
+//! \date 2026-10-17
+//!
+
+#ifndef _SHM_BYTE_RING_H_
+#define _SHM_BYTE_RING_H_
+
+#include "../utils/common.h"
+#include "../SHMemory/ShmBufferIndex.h"
+
+#include <deque>
+#include <vector>
+
+VDI_NS_BEGIN
+
+class ShmByteRing
+{
+public:
+    //!
+    //! \brief Construct a new Shm Byte Ring object
+    //!
+    ShmByteRing();
+    //!
+    //! \brief Destroy the Shm Byte Ring object
+    //!
+    virtual ~ShmByteRing();
+    //!
+    //! \brief Initialize the ring on a validated byte ring region
+    //!
+    //! \param [in] shmMem
+    //!             share memory base addr
+    //! \param [in] layout
+    //!             region layout from the region header
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Init(char *shmMem, const ShmRegionLayout &layout);
+    //!
+    //! \brief Reserve a contiguous range for one buffer, ranges are given
+    //!        back once the guest has released the buffer
+    //!
+    //! \param [in] bufId
+    //!             buffer id acquired from the idle index
+    //! \param [in] size
+    //!             bytes needed
+    //! \param [out] offset
+    //!             offset of the range from the share memory base addr
+    //! \param [out] reserved
+    //!             bytes reserved, size rounded up to the granularity
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY if ring is full
+    //!
+    MRDAStatus Allocate(uint32_t bufId, uint64_t size, uint64_t &offset, uint64_t &reserved);
+    //!
+    //! \brief Get ring capacity in bytes
+    //!
+    //! \return uint64_t
+    //!
+    inline uint64_t Capacity() { return m_end - m_begin; }
+
+private:
+    //!
+    //! \brief Give back ranges at the tail whose buffers were released
+    //!
+    void Reclaim();
+
+    struct RingEntry
+    {
+        uint32_t bufId; //!< buffer id owning the range
+        uint32_t seq;   //!< reservation sequence of the buffer id
+        uint64_t start; //!< ring position before reservation, includes wrap padding
+        uint64_t end;   //!< ring position after reservation
+    };
+
+private:
+    char *m_shmMem;                  //!< share memory base addr
+    ShmRegionLayout m_layout;        //!< region layout
+    uint64_t m_begin;                //!< data area begin offset
+    uint64_t m_end;                  //!< data area end offset
+    uint64_t m_head;                 //!< next reservation position
+    std::deque<RingEntry> m_entries; //!< reserved ranges in ring order
+    std::vector<uint32_t> m_seq;     //!< latest reservation sequence per buffer id
+};
+
+VDI_NS_END
+#endif // _SHM_BYTE_RING_H_
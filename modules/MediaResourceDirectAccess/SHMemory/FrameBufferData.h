@@ -54,6 +54,9 @@ public:
         m_size = 0;
         m_occupiedSize = 0;
         m_state = BufferState::BUFFER_STATE_NONE;
+        m_pitch = 0;
+        m_chainNum = 1;
+        m_chainIndex = 0;
     }
     //!
     //! \brief Destroy the Mem Buffer object
@@ -68,6 +71,9 @@ public:
         m_size = 0;
         m_occupiedSize = 0;
         m_state = BufferState::BUFFER_STATE_NONE;
+        m_pitch = 0;
+        m_chainNum = 1;
+        m_chainIndex = 0;
     }
 
     //!
@@ -90,6 +96,9 @@ public:
         m_size = pItem->size;
         m_occupiedSize = pItem->occupied_size;
         m_state = pItem->state;
+        m_pitch = pItem->pitch;
+        m_chainNum = 1;
+        m_chainIndex = 0;
         return MRDA_STATUS_SUCCESS;
     }
 
@@ -142,6 +151,27 @@ public:
     //!
     inline BufferState State() { return m_state; }
     inline void SetState(BufferState state) { m_state = state; }
+    //!
+    //! \brief Get/Set row pitch of raw frame, 0 means tightly packed
+    //!
+    //! \return uint32_t
+    //!
+    inline uint32_t Pitch() { return m_pitch; }
+    inline void SetPitch(uint32_t pitch) { m_pitch = pitch; }
+    //!
+    //! \brief Get/Set number of slots a payload is chained over, 1 if not chained
+    //!
+    //! \return uint32_t
+    //!
+    inline uint32_t ChainNum() { return m_chainNum; }
+    inline void SetChainNum(uint32_t chainNum) { m_chainNum = chainNum; }
+    //!
+    //! \brief Get/Set index of this slot in its chain, 0 for the head
+    //!
+    //! \return uint32_t
+    //!
+    inline uint32_t ChainIndex() { return m_chainIndex; }
+    inline void SetChainIndex(uint32_t chainIndex) { m_chainIndex = chainIndex; }
 
 private:
     uint32_t     m_bufId;            //!< buffer id
@@ -151,6 +181,9 @@ private:
     uint64_t     m_size;             //!< buffer size
     uint64_t     m_occupiedSize;      //!< occupied buffer size
     BufferState  m_state;            //!< buffer available state
+    uint32_t     m_pitch;            //!< row pitch in bytes of raw frame
+    uint32_t     m_chainNum;         //!< number of slots the payload is chained over
+    uint32_t     m_chainIndex;       //!< index of this slot in the chain
 };
 
 class FrameBufferData
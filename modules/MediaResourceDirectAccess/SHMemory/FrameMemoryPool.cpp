@@ -50,18 +50,42 @@ MRDAStatus FrameMemoryPool::AllocateBufferPool()
         MRDA_LOG(LOG_ERROR, "invalid buffer size!");
         return MRDA_STATUS_INVALID_DATA;
     }
+    // layout computed in InitBufferPool is published in the control header
+    // once all buffers are ready
+    // attach idle buffer index in control area
+    if (MRDA_STATUS_SUCCESS != m_bufferIndex.Attach(m_shareMemPtr, m_bufferPoolCount))
+    {
+        MRDA_LOG(LOG_ERROR, "failed to attach buffer index!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    // attach descriptor ring in control area
+    if (MRDA_STATUS_SUCCESS != m_descRing.Attach(m_shareMemPtr, m_layout))
+    {
+        MRDA_LOG(LOG_ERROR, "failed to attach descriptor ring!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
     // allocate buffer pool
+    m_bufferPool.reserve(m_bufferPoolCount);
     for (uint32_t i = 1; i <= m_bufferPoolCount; i++)
     {
         std::shared_ptr<MemoryBuffer> buffer = std::make_shared<MemoryBuffer>();
         buffer->SetBufId(i);
-        buffer->SetStateOffset((uint64_t)(i - 1) * m_bufferSize);
-        buffer->SetMemOffset(buffer->StateOffset() + sizeof(uint32_t));
-        buffer->SetBufPtr(static_cast<uint8_t*>(m_shareMemPtr) + (uint64_t)(i - 1) * m_bufferSize);
-        buffer->SetSize(m_bufferSize);
+        buffer->SetStateOffset(m_layout.StateOffset(i));
+        if (m_layout.IsByteRing())
+        {
+            // range is reserved by the host per buffer
+            buffer->SetMemOffset(0);
+            buffer->SetBufPtr(nullptr);
+            buffer->SetSize(0);
+        }
+        else
+        {
+            buffer->SetMemOffset(m_layout.MemOffset(i));
+            buffer->SetBufPtr(static_cast<uint8_t*>(m_shareMemPtr) + buffer->MemOffset());
+            buffer->SetSize(m_layout.slotSize);
+        }
         buffer->SetState(BufferState::BUFFER_STATE_IDLE);
-        BufferState state = buffer->State();
-        memcpy(buffer->BufPtr(), &state, sizeof(BufferState));
+        ShmStoreState(static_cast<uint8_t*>(m_shareMemPtr) + buffer->StateOffset(), buffer->State());
 
         std::shared_ptr<FrameBufferData> bufData = std::make_shared<FrameBufferData>();
         bufData->SetMemBuffer(buffer);
@@ -72,94 +96,88 @@ MRDAStatus FrameMemoryPool::AllocateBufferPool()
         bufData->SetPts(0);
         m_bufferPool.push_back(bufData);
     }
+    // publish all buffers as idle and an empty ring, then the layout
+    m_bufferIndex.Reset();
+    m_descRing.Reset();
+    ShmWriteRegionHeader(m_shareMemPtr, m_shareMemSize, m_layout);
 
     return MRDA_STATUS_SUCCESS;
 }
 
 MRDAStatus FrameMemoryPool::GetBuffer(std::shared_ptr<FrameBufferData> &buffer)
 {
-    std::lock_guard<std::mutex> lock(m_bufferPoolMutex);
-    auto it = m_bufferPool.begin();
-    for (; it != m_bufferPool.end(); it++)
+    if (m_layout.IsByteRing())
     {
-        std::shared_ptr<MemoryBuffer> memBuf = (*it)->MemBuffer();
-        if (memBuf == nullptr)
-        {
-            MRDA_LOG(LOG_ERROR, "invalid mem buffer!");
-            return MRDA_STATUS_INVALID_DATA;
-        }
-        // aquire buffer state
-        BufferState state = BufferState::BUFFER_STATE_NONE;
-        memcpy(&state, memBuf->BufPtr(), sizeof(BufferState));
-        if (state == BufferState::BUFFER_STATE_IDLE)
-        {
-            memBuf->SetState(BufferState::BUFFER_STATE_BUSY);
-            // write state to buffer
-            state = BufferState::BUFFER_STATE_BUSY;
-            memcpy(memBuf->BufPtr(), &state, sizeof(BufferState));
-            buffer = *it;
-            break;
-        }
+        MRDA_LOG(LOG_ERROR, "byte ring buffers are only reserved by the host!");
+        return MRDA_STATUS_NOT_SUPPORTED;
     }
-    if (it == m_bufferPool.end())
+    uint32_t bufId = 0;
+    if (MRDA_STATUS_SUCCESS != m_bufferIndex.AcquireWait(bufId, m_acquireTimeoutUs))
     {
         MRDA_LOG(LOG_WARNING, "No idle buffer in buffer pool!");
         return MRDA_STATUS_INVALID_DATA;
     }
+    std::shared_ptr<MemoryBuffer> memBuf = m_bufferPool[bufId - 1]->MemBuffer();
+    if (memBuf == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "invalid mem buffer!");
+        m_bufferIndex.Release(bufId);
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    // write state to buffer
+    memBuf->SetState(BufferState::BUFFER_STATE_BUSY);
+    ShmStoreState(static_cast<uint8_t*>(m_shareMemPtr) + memBuf->StateOffset(), BufferState::BUFFER_STATE_BUSY);
+    buffer = m_bufferPool[bufId - 1];
     return MRDA_STATUS_SUCCESS;
 }
 
 MRDAStatus FrameMemoryPool::ReleaseBuffer(std::shared_ptr<FrameBufferData> buffer)
 {
-    std::lock_guard<std::mutex> lock(m_bufferPoolMutex);
-    auto it = m_bufferPool.begin();
-    for (; it != m_bufferPool.end(); it++)
+    if (buffer == nullptr || buffer->MemBuffer() == nullptr)
     {
-        std::shared_ptr<MemoryBuffer> iterMemBuf = (*it)->MemBuffer();
-        std::shared_ptr<MemoryBuffer> inputMemBuf = buffer->MemBuffer();
-        uint32_t iterId = iterMemBuf->BufId();
-        uint32_t inputId = inputMemBuf->BufId();
-        if (iterId == inputId) // find the buffer
-        {
-            iterMemBuf->SetState(BufferState::BUFFER_STATE_IDLE);
-            // write state to buffer
-            BufferState state = BufferState::BUFFER_STATE_IDLE;
-            memcpy(iterMemBuf->BufPtr(), &state, sizeof(BufferState));
-            break;
-        }
+        MRDA_LOG(LOG_ERROR, "invalid buffer to release!");
+        return MRDA_STATUS_INVALID;
     }
-    if (it == m_bufferPool.end())
+    uint32_t bufId = buffer->MemBuffer()->BufId();
+    if (bufId == 0 || bufId > m_bufferPool.size())
     {
         MRDA_LOG(LOG_ERROR, "No buffer in buffer pool!");
         return MRDA_STATUS_INVALID;
     }
-    else return MRDA_STATUS_SUCCESS;
+    std::shared_ptr<MemoryBuffer> memBuf = m_bufferPool[bufId - 1]->MemBuffer();
+    // write state to buffer before publishing it as idle
+    memBuf->SetState(BufferState::BUFFER_STATE_IDLE);
+    ShmStoreState(static_cast<uint8_t*>(m_shareMemPtr) + memBuf->StateOffset(), BufferState::BUFFER_STATE_IDLE);
+    return m_bufferIndex.Release(bufId);
 }
 
 MRDAStatus FrameMemoryPool::GetBufferFromId(uint32_t id, std::shared_ptr<FrameBufferData>& buffer)
 {
-    std::lock_guard<std::mutex> lock(m_bufferPoolMutex);
-    auto it = m_bufferPool.begin();
-    for (; it != m_bufferPool.end(); it++)
+    if (id == 0 || id > m_bufferPool.size())
     {
-        std::shared_ptr<MemoryBuffer> memBuf = (*it)->MemBuffer();
-        if (memBuf == nullptr)
-        {
-            MRDA_LOG(LOG_ERROR, "invalid mem buffer!");
-            return MRDA_STATUS_INVALID_DATA;
-        }
-        uint32_t buf_id = memBuf->BufId();
-        if (buf_id == id)
-        {
-            buffer->MemBuffer()->SetBufPtr(memBuf->BufPtr());
-            break;
-        }
+        MRDA_LOG(LOG_WARNING, "No request buffer in buffer pool!");
+        return MRDA_STATUS_INVALID_DATA;
     }
-    if (it == m_bufferPool.end())
+    std::shared_ptr<MemoryBuffer> memBuf = m_bufferPool[id - 1]->MemBuffer();
+    if (memBuf == nullptr || buffer == nullptr || buffer->MemBuffer() == nullptr)
     {
-        MRDA_LOG(LOG_WARNING, "No request buffer in buffer pool!");
+        MRDA_LOG(LOG_ERROR, "invalid mem buffer!");
         return MRDA_STATUS_INVALID_DATA;
     }
+    if (m_layout.IsByteRing())
+    {
+        // variable sized range reserved by the host
+        uint64_t memOffset = buffer->MemBuffer()->MemOffset();
+        if (memOffset < m_layout.dataOffset
+            || memOffset + buffer->MemBuffer()->OccupiedSize() > m_layout.dataOffset + m_layout.dataSize)
+        {
+            MRDA_LOG(LOG_ERROR, "buffer range out of byte ring!");
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        buffer->MemBuffer()->SetBufPtr(static_cast<uint8_t*>(m_shareMemPtr) + memOffset);
+        return MRDA_STATUS_SUCCESS;
+    }
+    buffer->MemBuffer()->SetBufPtr(memBuf->BufPtr());
     return MRDA_STATUS_SUCCESS;
 }
 
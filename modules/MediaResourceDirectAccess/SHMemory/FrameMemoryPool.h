@@ -28,18 +28,24 @@
 //!
 //! \file FrameMemoryPool.h
 //! \brief define a memory pool to manage the share memory
-//!        between host and windows VMs.
+//!        between host and guest VMs or local processes.
 //! \date 2024-04-01
 //!
 
 #ifndef _FRAMEMEMORYPOOL_
 #define _FRAMEMEMORYPOOL_
 
+#ifdef _WINDOWS_OS_
 #include "Ivshmem.h"
+#endif
+#ifdef _LINUX_OS_
+#include "LinuxSharedRegion.h"
+#endif
 #include "FrameBufferData.h"
+#include "ShmBufferIndex.h"
+#include "ShmDescRing.h"
 
 #include <vector>
-#include <mutex>
 
 VDI_NS_BEGIN
 
@@ -59,7 +65,8 @@ public:
     m_bufferSize(0),
     m_shareMemSize(0),
     m_shareMemPtr(nullptr),
-    m_ivshmem(nullptr)
+    m_acquireTimeoutUs(0),
+    m_shareRegion(nullptr)
     {
         m_bufferPool.clear();
     }
@@ -93,15 +100,24 @@ public:
     //!             size of each buffer in the pool
     //! \param [in] slot_number
     //!             memory device slot number
+    //! \param [in] dev_path
+    //!             share memory path of linux guests, empty to locate the
+    //!             device by slot number
+    //! \param [in] alignment
+    //!             payload alignment, power of two, 0 for default 4 KiB
+    //! \param [in] byte_ring
+    //!             buffers reserve variable sized ranges of one byte ring
+    //!             filled by the host instead of fixed size slots
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fail
     //!
-    MRDAStatus InitBufferPool(const uint32_t buffer_num, const uint64_t buffer_size, const uint32_t slot_number)
+    MRDAStatus InitBufferPool(const uint32_t buffer_num, const uint64_t buffer_size, const uint32_t slot_number,
+                              const std::string &dev_path, const uint64_t alignment = SHM_DEFAULT_ALIGNMENT, const bool byte_ring = false)
     {
-        // initialize ivshmem device
-        if (MRDA_STATUS_SUCCESS != InitializeMemoryDevice(slot_number))
+        // initialize share memory device
+        if (MRDA_STATUS_SUCCESS != InitializeMemoryDevice(slot_number, dev_path))
         {
-            MRDA_LOG(LOG_ERROR, "Failed to initialize ivshmem device!");
+            MRDA_LOG(LOG_ERROR, "Failed to initialize share memory device!");
             return MRDA_STATUS_INVALID;
         }
 
@@ -116,11 +132,11 @@ public:
             return MRDA_STATUS_INVALID;
         }
 
-        // reset all share memory
-        memset(m_shareMemPtr, 0, m_shareMemSize);
+        // only the control area is (re)initialized in AllocateBufferPool,
+        // frame payloads are always overwritten before use
 
-        if (m_bufferPoolCount * m_bufferSize > m_shareMemSize
-            || m_bufferPoolCount < 1)
+        if (m_bufferPoolCount < 1 || m_bufferPoolCount > SHM_MAX_BUFFER_NUM
+            || MRDA_STATUS_SUCCESS != ShmComputeLayout(m_bufferPoolCount, m_bufferSize, alignment, m_shareMemSize, byte_ring, m_layout))
         {
             MRDA_LOG(LOG_ERROR, "Invalid buffer pool parameters!");
             return MRDA_STATUS_INVALID;
@@ -129,6 +145,27 @@ public:
         return MRDA_STATUS_SUCCESS;
     }
     //!
+    //! \brief Set how long GetBuffer waits for the other side to release
+    //!        a buffer when none is idle
+    //!
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to fail at once
+    //!
+    void SetAcquireTimeout(const uint32_t timeoutUs)
+    {
+        m_acquireTimeoutUs = timeoutUs;
+    }
+    //!
+    //! \brief Get the descriptor ring in the control area of the pool
+    //!
+    //! \return ShmDescRing*
+    //!         nullptr if the pool is not allocated yet
+    //!
+    ShmDescRing* DescRing()
+    {
+        return m_descRing.IsAttached() ? &m_descRing : nullptr;
+    }
+    //!
     //! \brief Allocate buffer pool
     //!
     //! \return MRDAStatus
@@ -166,52 +203,62 @@ public:
 
 private:
     //!
-    //! \brief Initialize ivshmem device
+    //! \brief Initialize share memory device
     //!
     //! \param       [in] slot_number
     //!              memory device slot number
+    //!              [in] dev_path
+    //!              share memory path of linux guests
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fail
     //!
-    MRDAStatus InitializeMemoryDevice(const uint32_t slot_number)
+    MRDAStatus InitializeMemoryDevice(const uint32_t slot_number, const std::string &dev_path)
     {
-        m_ivshmem = std::make_unique<Ivshmem>();
-        if (m_ivshmem->Init(slot_number) != MRDA_STATUS_SUCCESS)
+#ifdef _WINDOWS_OS_
+        m_shareRegion = std::make_unique<Ivshmem>();
+#endif
+#ifdef _LINUX_OS_
+        m_shareRegion = std::make_unique<LinuxSharedRegion>();
+#endif
+        if (m_shareRegion == nullptr || m_shareRegion->Init(slot_number, dev_path) != MRDA_STATUS_SUCCESS)
         {
-            MRDA_LOG(LOG_ERROR, "Failed to initialize IVSHMEM!");
+            MRDA_LOG(LOG_ERROR, "Failed to initialize share memory region!");
             return MRDA_STATUS_INVALID;
         }
 
-        if (m_ivshmem->Open() != MRDA_STATUS_SUCCESS)
+        if (m_shareRegion->Open() != MRDA_STATUS_SUCCESS)
         {
-            MRDA_LOG(LOG_ERROR, "Failed to open IVSHMEM!");
+            MRDA_LOG(LOG_ERROR, "Failed to open share memory region!");
             return MRDA_STATUS_INVALID;
         }
         return MRDA_STATUS_SUCCESS;
     }
     //!
-    //! \brief Get the Memory Pointer from ivshmem device
+    //! \brief Get the Memory Pointer from share memory device
     //!
-    //! \return PVOID
-    //!         memory pointer from ivshmem device
+    //! \return void*
+    //!         memory pointer from share memory device
     //!
-    const PVOID GetMemoryPtr() const {return m_ivshmem->GetMemory();}
+    void* GetMemoryPtr() const {return m_shareRegion->GetMemory();}
     //!
     //! \brief Get the Memory Size object
     //!
     //! \return uint64_t
-    //!         memory size of the ivshmem device
+    //!         memory size of the share memory device
     //!
-    const uint64_t GetMemorySize() const {return m_ivshmem->GetSize();}
+    uint64_t GetMemorySize() const {return m_shareRegion->GetSize();}
 
 protected:
-    std::mutex m_bufferPoolMutex; //!< mutex for buffer pool
-    std::vector<std::shared_ptr<T>> m_bufferPool; //!< buffer pool
+    std::vector<std::shared_ptr<T>> m_bufferPool; //!< buffer pool, indexed by buf id - 1
+    ShmBufferIndex m_bufferIndex; //!< lock-free idle buffer index in share memory
+    ShmDescRing m_descRing;       //!< buffer descriptor ring in share memory
+    ShmRegionLayout m_layout;     //!< layout published in the region header
     uint32_t m_bufferPoolCount; //!< number of buffers in the pool
     uint64_t m_bufferSize;      //!< size of each buffer in the pool
     uint64_t m_shareMemSize;    //!< size of share memory
-    PVOID m_shareMemPtr;        //!< pointer of share memory
-    std::unique_ptr<Ivshmem> m_ivshmem; //!< ivshmem object
+    void* m_shareMemPtr;        //!< pointer of share memory
+    uint32_t m_acquireTimeoutUs; //!< max wait for a release in GetBuffer
+    std::unique_ptr<SharedRegion> m_shareRegion; //!< platform share memory region
 };
 
 class FrameMemoryPool : public MemoryPool<FrameBufferData> {
@@ -31,6 +31,8 @@
  //! \brief    Implement class for Ivshmem driver library.
  //!
 
+#ifdef _WINDOWS_OS_
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <Windows.h>
@@ -59,7 +61,7 @@ Ivshmem::~Ivshmem()
 	DeInit();
 }
 
-MRDAStatus Ivshmem::Init(const UINT32 slot_number)
+MRDAStatus Ivshmem::Init(const uint32_t slot_number, const std::string &dev_path)
 {
 	HDEVINFO devInfoSet;
 	PSP_DEVICE_INTERFACE_DETAIL_DATA devInfDetailData = NULL;
@@ -188,8 +190,7 @@ MRDAStatus Ivshmem::Open()
 		MRDA_LOG(LOG_ERROR, "map pointer is NULL, please check again!");
 		return MRDA_STATUS_INVALID;
 	}
-	// memory pointer assignment
-	memset(map.ptr, 0x00, m_size);
+	// memory pointer assignment, the pool owner initializes the control area
 	m_memory = map.ptr;
 
 	if (map.size != m_size)
@@ -218,4 +219,6 @@ MRDAStatus Ivshmem::Close()
 	return MRDA_STATUS_SUCCESS;
 }
 
-VDI_NS_END
\ No newline at end of file
+VDI_NS_END
+
+#endif // _WINDOWS_OS_
@@ -31,17 +31,20 @@
 //! \date 2024-04-01
 //!
 
+#ifdef _WINDOWS_OS_
+
 #ifndef _IVSHMEM_H_
 #define _IVSHMEM_H_
 
 #include <windows.h>
 #include "../utils/common.h"
+#include "SharedRegion.h"
 
 VDI_NS_BEGIN
 
 using HANDLE = PVOID;
 
-class Ivshmem
+class Ivshmem : public SharedRegion
 {
 public:
 	//!
@@ -57,45 +60,47 @@ public:
     //!
     //! \param [in] slot_number
     //!             memory device slot number
+    //! \param [in] dev_path
+    //!             unused, the device is located by slot number
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fail
     //!
-	MRDAStatus Init(const UINT32 slot_number);
+	MRDAStatus Init(const uint32_t slot_number, const std::string &dev_path) override;
     //!
     //! \brief Deinitialize ivshmem
     //!
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fail
     //!
-	MRDAStatus DeInit();
+	MRDAStatus DeInit() override;
     //!
     //! \brief Open the ivshmem device
     //!
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fail
     //!
-	MRDAStatus Open();
+	MRDAStatus Open() override;
     //!
     //! \brief Close the ivshmem device
     //!
     //! \return MRDAStatus
     //!         MRDA_STATUS_SUCCESS if success, else fail
     //!
-	MRDAStatus Close();
+	MRDAStatus Close() override;
     //!
     //! \brief Get the Memory pointer
     //!
-    //! \return PVOID
+    //! \return void*
     //!         the memory pointer
     //!
-	inline PVOID  GetMemory() const { return m_memory; }
+	inline void*  GetMemory() const override { return m_memory; }
     //!
     //! \brief Get the Memory size
     //!
-    //! \return UINT64
+    //! \return uint64_t
     //!         the memory size
     //!
-	inline UINT64 GetSize() const { return m_size; }
+	inline uint64_t GetSize() const override { return m_size; }
     //!
     //! \brief Set the Offset object
     //!
@@ -142,4 +147,6 @@ private:
 };
 
 VDI_NS_END
-#endif // _IVSHMEM_H_
\ No newline at end of file
+#endif // _IVSHMEM_H_
+
+#endif // _WINDOWS_OS_
\ No newline at end of file
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+ //!
+ //! \file     LinuxSharedRegion.cpp
+ //! \brief    Implement share memory region of linux guests.
+ //!
+
+#ifdef _LINUX_OS_
+
+#include "LinuxSharedRegion.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+VDI_NS_BEGIN
+
+static const char UIO_DEV_PREFIX[] = "/dev/uio";
+
+LinuxSharedRegion::LinuxSharedRegion()
+{
+    m_fd = -1;
+    m_memory = nullptr;
+    m_size = 0;
+    m_mapOffset = 0;
+}
+
+LinuxSharedRegion::~LinuxSharedRegion()
+{
+    Close();
+    DeInit();
+}
+
+MRDAStatus LinuxSharedRegion::Init(const uint32_t slot_number, const std::string &dev_path)
+{
+    m_path = dev_path;
+    if (m_path.empty())
+    {
+        // same convention as the windows location path PCI(<slot>00),
+        // the decimal digits of the slot number are the PCI device number
+        char pciPath[256];
+        snprintf(pciPath, sizeof(pciPath), "/sys/bus/pci/devices/0000:00:%02u.0/resource2", slot_number);
+        m_path = pciPath;
+    }
+
+    m_size = 0;
+    m_mapOffset = 0;
+    bool isUio = m_path.compare(0, sizeof(UIO_DEV_PREFIX) - 1, UIO_DEV_PREFIX) == 0;
+    if (isUio && MRDA_STATUS_SUCCESS != GetUioMapInfo(m_path.substr(m_path.rfind('/') + 1)))
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to get uio map info of %s!", m_path.c_str());
+        return MRDA_STATUS_INVALID;
+    }
+
+    m_fd = open(m_path.c_str(), O_RDWR | O_CLOEXEC);
+    if (m_fd < 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to open %s: %s", m_path.c_str(), strerror(errno));
+        return MRDA_STATUS_INVALID;
+    }
+
+    if (!isUio)
+    {
+        // sysfs PCI resource files report the BAR size
+        struct stat st;
+        if (fstat(m_fd, &st) != 0)
+        {
+            MRDA_LOG(LOG_ERROR, "Failed to stat %s: %s", m_path.c_str(), strerror(errno));
+            return MRDA_STATUS_INVALID;
+        }
+        m_size = static_cast<uint64_t>(st.st_size);
+    }
+
+    if (m_size == 0)
+    {
+        MRDA_LOG(LOG_ERROR, "share memory size of %s is 0, please check again!", m_path.c_str());
+        return MRDA_STATUS_INVALID;
+    }
+
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus LinuxSharedRegion::GetUioMapInfo(const std::string &dev_name)
+{
+    // ivshmem exposes its registers as map0 and the share memory BAR as map1
+    for (int mapIndex = 1; mapIndex >= 0; mapIndex--)
+    {
+        std::string sizePath = "/sys/class/uio/" + dev_name + "/maps/map" + std::to_string(mapIndex) + "/size";
+        FILE *fp = fopen(sizePath.c_str(), "r");
+        if (fp == nullptr) continue;
+
+        char value[64] = {0};
+        bool readOk = fgets(value, sizeof(value), fp) != nullptr;
+        fclose(fp);
+        if (!readOk) continue;
+
+        m_size = strtoull(value, nullptr, 0);
+        // uio selects map N by an mmap offset of N pages
+        m_mapOffset = static_cast<uint64_t>(mapIndex) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        return MRDA_STATUS_SUCCESS;
+    }
+
+    return MRDA_STATUS_INVALID;
+}
+
+MRDAStatus LinuxSharedRegion::DeInit()
+{
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+
+    m_fd = -1;
+
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus LinuxSharedRegion::Open()
+{
+    if (m_fd < 0 || m_size == 0) return MRDA_STATUS_INVALID;
+
+    void *mem = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, static_cast<off_t>(m_mapOffset));
+    if (mem == MAP_FAILED)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to map %s: %s", m_path.c_str(), strerror(errno));
+        return MRDA_STATUS_INVALID;
+    }
+    // memory pointer assignment, the pool owner initializes the control area
+    m_memory = mem;
+
+    return MRDA_STATUS_SUCCESS;
+}
+
+MRDAStatus LinuxSharedRegion::Close()
+{
+    if (nullptr == m_memory) return MRDA_STATUS_INVALID;
+
+    if (munmap(m_memory, m_size) != 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Failed to unmap %s: %s", m_path.c_str(), strerror(errno));
+        return MRDA_STATUS_INVALID;
+    }
+
+    m_memory = nullptr;
+
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
+
+#endif // _LINUX_OS_
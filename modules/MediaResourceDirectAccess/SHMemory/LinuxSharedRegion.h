@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file LinuxSharedRegion.h
+//! \brief Share memory region of linux guests and local processes,
+//!        mapped from a file, memfd, /dev/shm, uio or PCI BAR path.
+//! \date 2026-10-17
+//!
+
+#ifdef _LINUX_OS_
+
+#ifndef _LINUX_SHARED_REGION_H_
+#define _LINUX_SHARED_REGION_H_
+
+#include "../utils/common.h"
+#include "SharedRegion.h"
+
+VDI_NS_BEGIN
+
+class LinuxSharedRegion : public SharedRegion
+{
+public:
+    //!
+    //! \brief Construct a new Linux Shared Region object
+    //!
+    LinuxSharedRegion();
+    //!
+    //! \brief Destroy the Linux Shared Region object
+    //!
+    virtual ~LinuxSharedRegion();
+    //!
+    //! \brief Open the backing file of the region
+    //!
+    //! \param [in] slot_number
+    //!             memory device slot number, used only if dev_path is empty
+    //! \param [in] dev_path
+    //!             regular, hugetlbfs or /dev/shm file, /proc/<pid>/fd/<n>
+    //!             of a memfd, /dev/uioN, or PCI BAR resource file in sysfs.
+    //!             If empty, the ivshmem BAR2 resource file of the PCI device
+    //!             at slot_number is used
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Init(const uint32_t slot_number, const std::string &dev_path) override;
+    //!
+    //! \brief Close the backing file of the region
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus DeInit() override;
+    //!
+    //! \brief Map the region
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Open() override;
+    //!
+    //! \brief Unmap the region
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Close() override;
+    //!
+    //! \brief Get the Memory pointer
+    //!
+    //! \return void*
+    //!         the memory pointer
+    //!
+    inline void* GetMemory() const override { return m_memory; }
+    //!
+    //! \brief Get the Memory size
+    //!
+    //! \return uint64_t
+    //!         the memory size
+    //!
+    inline uint64_t GetSize() const override { return m_size; }
+
+private:
+    //!
+    //! \brief Get size and mmap offset of the share memory map of a uio device
+    //!
+    //! \param [in] dev_name
+    //!             uio device name, e.g. uio0
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus GetUioMapInfo(const std::string &dev_name);
+
+private:
+    std::string m_path;   //!< backing file path
+    int         m_fd;     //!< backing file descriptor
+    void*       m_memory; //!< mmap pointer, shared memory entry point
+    uint64_t    m_size;   //!< shared memory region size
+    uint64_t    m_mapOffset; //!< mmap offset in the backing file
+};
+
+VDI_NS_END
+#endif // _LINUX_SHARED_REGION_H_
+
+#endif // _LINUX_OS_
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file SharedRegion.h
+//! \brief define the interface of a share memory region mapped by the
+//!        guest memory pools, implemented per platform.
+//! \date 2026-10-17
+//!
+
+#ifndef _SHARED_REGION_H_
+#define _SHARED_REGION_H_
+
+#include "../utils/common.h"
+
+#include <cstdint>
+
+VDI_NS_BEGIN
+
+class SharedRegion
+{
+public:
+    //!
+    //! \brief Construct a new Shared Region object
+    //!
+    SharedRegion() {}
+    //!
+    //! \brief Destroy the Shared Region object
+    //!
+    virtual ~SharedRegion() {}
+    //!
+    //! \brief Locate the backing device of the region
+    //!
+    //! \param [in] slot_number
+    //!             memory device slot number
+    //! \param [in] dev_path
+    //!             backing device or file path, empty to locate the
+    //!             device by slot number
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    virtual MRDAStatus Init(const uint32_t slot_number, const std::string &dev_path) = 0;
+    //!
+    //! \brief Release the backing device of the region
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    virtual MRDAStatus DeInit() = 0;
+    //!
+    //! \brief Map the region into the process
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    virtual MRDAStatus Open() = 0;
+    //!
+    //! \brief Unmap the region
+    //!
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    virtual MRDAStatus Close() = 0;
+    //!
+    //! \brief Get the Memory pointer
+    //!
+    //! \return void*
+    //!         the memory pointer, nullptr if not mapped
+    //!
+    virtual void* GetMemory() const = 0;
+    //!
+    //! \brief Get the Memory size
+    //!
+    //! \return uint64_t
+    //!         the memory size
+    //!
+    virtual uint64_t GetSize() const = 0;
+};
+
+VDI_NS_END
+#endif // _SHARED_REGION_H_
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmBufferIndex.h
+//! \brief define a lock-free free-buffer index shared by the buffer
+//!        owner (guest) and the host service through share memory.
+//! \date 2026-10-17
+//!
+
+#ifndef _SHM_BUFFER_INDEX_H_
+#define _SHM_BUFFER_INDEX_H_
+
+#include "ShmRegionHeader.h"
+
+#include <atomic>
+#include <cstdint>
+#ifdef _WINDOWS_OS_
+#include <intrin.h>
+#endif
+
+VDI_NS_BEGIN
+
+static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic free word must be plain 64 bit");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "atomic state word must be plain 32 bit");
+
+//!
+//! \brief Free word in share memory, one bit per buffer (1 = idle),
+//!        padded to a cache line so guest and host only contend on
+//!        the same word when they touch the same group of buffers.
+//!
+struct alignas(SHM_CACHE_LINE_SIZE) ShmFreeWord
+{
+    std::atomic<uint64_t> bits;                                   //!< idle bit mask
+    uint8_t pad[SHM_CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)]; //!< padding
+};
+
+static_assert(sizeof(ShmFreeWord) == SHM_CACHE_LINE_SIZE, "free word must occupy one cache line");
+
+//!
+//! \brief Load/Store the buffer state word in share memory
+//!
+//! \param [in] statePtr
+//!             pointer to the state word
+//!
+inline BufferState ShmLoadState(void *statePtr)
+{
+    std::atomic<uint32_t> *word = reinterpret_cast<std::atomic<uint32_t>*>(statePtr);
+    return static_cast<BufferState>(word->load(std::memory_order_acquire));
+}
+
+inline void ShmStoreState(void *statePtr, BufferState state)
+{
+    std::atomic<uint32_t> *word = reinterpret_cast<std::atomic<uint32_t>*>(statePtr);
+    word->store(static_cast<uint32_t>(state), std::memory_order_release);
+}
+
+//!
+//! \brief Lock-free index of idle buffers living in the control area of
+//!        one share memory region, right after the region header. One side
+//!        acquires buffers and the other side releases them, both in O(1)
+//!        with atomic operations.
+//!
+class ShmBufferIndex
+{
+public:
+    //!
+    //! \brief Construct a new Shm Buffer Index object
+    //!
+    ShmBufferIndex():
+    m_header(nullptr),
+    m_freeWords(nullptr),
+    m_wordNum(0),
+    m_bufferNum(0),
+    m_hint(0)
+    {
+    }
+    //!
+    //! \brief Destroy the Shm Buffer Index object
+    //!
+    virtual ~ShmBufferIndex()
+    {
+        m_header = nullptr;
+        m_freeWords = nullptr;
+    }
+    //!
+    //! \brief Attach the index to the control area of a share memory region
+    //!
+    //! \param [in] basePtr
+    //!             share memory base addr
+    //! \param [in] bufferNum
+    //!             number of buffers in the region
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Attach(void *basePtr, uint32_t bufferNum)
+    {
+        if (basePtr == nullptr || bufferNum == 0 || bufferNum > SHM_MAX_BUFFER_NUM)
+        {
+            MRDA_LOG(LOG_ERROR, "Invalid buffer index parameters, buffer num %u!", bufferNum);
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+        m_header = reinterpret_cast<ShmRegionHeader*>(basePtr);
+        m_freeWords = reinterpret_cast<ShmFreeWord*>(static_cast<uint8_t*>(basePtr) + SHM_HEADER_AREA_SIZE);
+        m_bufferNum = bufferNum;
+        m_wordNum = (bufferNum + SHM_BITS_PER_WORD - 1) / SHM_BITS_PER_WORD;
+        m_hint.store(0, std::memory_order_relaxed);
+        m_releaseBell.Attach(&m_header->releaseBell);
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Mark all buffers idle, only called by the region owner
+    //!
+    void Reset()
+    {
+        if (m_freeWords == nullptr) return;
+        for (uint32_t i = 0; i < SHM_MAX_FREE_WORD_NUM; i++)
+        {
+            uint64_t bits = 0;
+            if (i < m_wordNum)
+            {
+                uint32_t valid = m_bufferNum - i * SHM_BITS_PER_WORD;
+                bits = valid >= SHM_BITS_PER_WORD ? ~0ULL : ((1ULL << valid) - 1);
+            }
+            m_freeWords[i].bits.store(bits, std::memory_order_release);
+        }
+        m_hint.store(0, std::memory_order_relaxed);
+    }
+    //!
+    //! \brief Acquire one idle buffer
+    //!
+    //! \param [out] bufId
+    //!              acquired buffer id, starts from 1
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY if no idle buffer
+    //!
+    MRDAStatus Acquire(uint32_t &bufId)
+    {
+        if (m_freeWords == nullptr) return MRDA_STATUS_INVALID_STATE;
+        uint32_t hint = m_hint.load(std::memory_order_relaxed);
+        for (uint32_t n = 0; n < m_wordNum; n++)
+        {
+            uint32_t w = (hint + n) % m_wordNum;
+            std::atomic<uint64_t> &word = m_freeWords[w].bits;
+            uint64_t bits = word.load(std::memory_order_relaxed);
+            while (bits != 0)
+            {
+                uint32_t bit = CountTrailingZero(bits);
+                if (word.compare_exchange_weak(bits, bits & ~(1ULL << bit),
+                                               std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    m_hint.store(w, std::memory_order_relaxed);
+                    m_header->producerCount.fetch_add(1, std::memory_order_relaxed);
+                    bufId = w * SHM_BITS_PER_WORD + bit + 1;
+                    return MRDA_STATUS_SUCCESS;
+                }
+            }
+        }
+        return MRDA_STATUS_NOT_READY;
+    }
+    //!
+    //! \brief Release one buffer back to the index
+    //!
+    //! \param [in] bufId
+    //!             buffer id, starts from 1
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Release(uint32_t bufId)
+    {
+        MRDAStatus status = SetFree(bufId);
+        if (MRDA_STATUS_SUCCESS != status) return status;
+        m_header->consumerCount.fetch_add(1, std::memory_order_relaxed);
+        m_releaseBell.Ring();
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Give back a buffer the producer acquired but did not use, as
+    //!        if it was never acquired: no release is counted and waiters
+    //!        are not woken, since nothing a consumer did freed it
+    //!
+    //! \param [in] bufId
+    //!             buffer id, starts from 1
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus Restore(uint32_t bufId)
+    {
+        MRDAStatus status = SetFree(bufId);
+        if (MRDA_STATUS_SUCCESS != status) return status;
+        m_header->producerCount.fetch_sub(1, std::memory_order_relaxed);
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Acquire one idle buffer, waiting for a release if none is idle
+    //!
+    //! \param [out] bufId
+    //!              acquired buffer id, starts from 1
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to not wait
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY on timeout
+    //!
+    MRDAStatus AcquireWait(uint32_t &bufId, uint32_t timeoutUs)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+        while (true)
+        {
+            uint32_t seq = m_releaseBell.Sequence();
+            MRDAStatus status = Acquire(bufId);
+            if (MRDA_STATUS_NOT_READY != status)
+            {
+                return status;
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return MRDA_STATUS_NOT_READY;
+            }
+            uint64_t remainUs = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+            m_releaseBell.Wait(seq, static_cast<uint32_t>(remainUs));
+        }
+    }
+    //!
+    //! \brief Get the release sequence, read it before checking for idle
+    //!        buffers and pass it to WaitRelease so no release is missed
+    //!
+    //! \return uint32_t
+    //!
+    uint32_t ReleaseSequence() const
+    {
+        return m_releaseBell.Sequence();
+    }
+    //!
+    //! \brief Wait until a buffer is released after seq was read
+    //!
+    //! \param [in] seq
+    //!             release sequence read before the check
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds
+    //! \return bool
+    //!         true if a buffer was released, false on timeout
+    //!
+    bool WaitRelease(uint32_t seq, uint32_t timeoutUs)
+    {
+        return m_releaseBell.Wait(seq, timeoutUs);
+    }
+
+private:
+    //!
+    //! \brief Set the free bit of a buffer
+    //!
+    //! \param [in] bufId
+    //!             buffer id, starts from 1
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_INVALID_STATE if the buffer is free already
+    //!
+    MRDAStatus SetFree(uint32_t bufId)
+    {
+        if (m_freeWords == nullptr) return MRDA_STATUS_INVALID_STATE;
+        if (bufId == 0 || bufId > m_bufferNum)
+        {
+            MRDA_LOG(LOG_ERROR, "Invalid buffer id %u to release!", bufId);
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+        uint32_t idx = bufId - 1;
+        uint64_t mask = 1ULL << (idx % SHM_BITS_PER_WORD);
+        uint64_t old = m_freeWords[idx / SHM_BITS_PER_WORD].bits.fetch_or(mask, std::memory_order_release);
+        if (old & mask)
+        {
+            MRDA_LOG(LOG_WARNING, "Buffer %u released twice!", bufId);
+            return MRDA_STATUS_INVALID_STATE;
+        }
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Get the index of the lowest set bit
+    //!
+    //! \param [in] bits
+    //!             non-zero bit mask
+    //! \return uint32_t
+    //!
+    static inline uint32_t CountTrailingZero(uint64_t bits)
+    {
+#ifdef _WINDOWS_OS_
+        unsigned long idx = 0;
+        _BitScanForward64(&idx, bits);
+        return static_cast<uint32_t>(idx);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+    }
+
+private:
+    ShmRegionHeader *m_header; //!< region header in share memory
+    ShmFreeWord *m_freeWords; //!< free words in share memory
+    uint32_t m_wordNum;       //!< number of free words in use
+    uint32_t m_bufferNum;     //!< number of buffers
+    std::atomic<uint32_t> m_hint; //!< last word an idle buffer was found in
+    ShmDoorbell m_releaseBell; //!< rung on every release
+};
+
+VDI_NS_END
+#endif // _SHM_BUFFER_INDEX_H_
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmDescRing.h
+//! \brief define a single producer single consumer ring of buffer
+//!        descriptors in the control area of a share memory region, so
+//!        frames are handed over without a gRPC message per frame.
+//! \date 2026-10-17
+//!
+
+#ifndef _SHM_DESC_RING_H_
+#define _SHM_DESC_RING_H_
+
+#include "ShmRegionHeader.h"
+#include "FrameBufferData.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+VDI_NS_BEGIN
+
+//!
+//! \brief Flags of a buffer descriptor, the low byte holds flag bits,
+//!        the next two bytes the stream type and the buffer state
+//!
+enum ShmDescFlag : uint32_t
+{
+    SHM_DESC_FLAG_NONE = 0,
+    SHM_DESC_FLAG_EOS  = 1 << 0, //!< last frame of the stream
+};
+
+constexpr uint32_t SHM_DESC_TYPE_SHIFT = 8;   //!< stream type bits of the flags
+constexpr uint32_t SHM_DESC_STATE_SHIFT = 16; //!< buffer state bits of the flags
+
+//!
+//! \brief Buffer descriptor, the same fields a BufferInfo message carries
+//!
+struct ShmDescriptor
+{
+    uint32_t bufId;         //!< buffer id, 0 for a frame without buffer
+    uint32_t flags;         //!< ShmDescFlag bits, stream type and buffer state
+    uint64_t memOffset;     //!< payload offset from base addr
+    uint64_t stateOffset;   //!< state word offset from base addr
+    uint64_t bufSize;       //!< buffer size
+    uint64_t occupiedSize;  //!< occupied buffer size
+    uint64_t pts;           //!< frame pts
+    uint32_t width;         //!< frame width
+    uint32_t height;        //!< frame height
+    uint32_t pitch;         //!< row pitch in bytes of raw frame
+    uint16_t chainNum;      //!< number of slots the payload is chained over
+    uint16_t chainIndex;    //!< index of this slot in the chain
+};
+
+static_assert(sizeof(ShmDescriptor) == SHM_DESC_ENTRY_SIZE, "descriptor must occupy one ring entry");
+
+//!
+//! \brief Ring indexes and doorbells, each on its own cache line so the
+//!        producer and the consumer only write their own line
+//!
+struct ShmDescRingControl
+{
+    alignas(SHM_CACHE_LINE_SIZE) std::atomic<uint64_t> head; //!< next entry to fill, written by the producer
+    alignas(SHM_CACHE_LINE_SIZE) std::atomic<uint64_t> tail; //!< next entry to take, written by the consumer
+    alignas(SHM_CACHE_LINE_SIZE) ShmDoorbellWord pushBell;   //!< rung on every push
+    alignas(SHM_CACHE_LINE_SIZE) ShmDoorbellWord popBell;    //!< rung on every pop
+    std::atomic<uint32_t> closed;                            //!< set once by either side when the session ends
+};
+
+static_assert(sizeof(ShmDescRingControl) <= SHM_DESC_CONTROL_SIZE, "descriptor ring control exceeds its area");
+
+//!
+//! \brief Descriptor ring living in the control area of one share memory
+//!        region. The side filling the region's buffers pushes, the other
+//!        side pops: the guest submits input frames and the host completes
+//!        output frames. Indexes run free and only wrap at 64 bit.
+//!
+class ShmDescRing
+{
+public:
+    //!
+    //! \brief Construct a new Shm Desc Ring object
+    //!
+    ShmDescRing():
+    m_control(nullptr),
+    m_entries(nullptr),
+    m_descNum(0)
+    {
+    }
+    //!
+    //! \brief Destroy the Shm Desc Ring object
+    //!
+    virtual ~ShmDescRing()
+    {
+        m_control = nullptr;
+        m_entries = nullptr;
+    }
+    //!
+    //! \brief Attach the ring to the control area of a share memory region
+    //!
+    //! \param [in] basePtr
+    //!             share memory base addr
+    //! \param [in] layout
+    //!             region layout
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_SUPPORTED if
+    //!         the region has no descriptor ring
+    //!
+    MRDAStatus Attach(void *basePtr, const ShmRegionLayout &layout)
+    {
+        if (basePtr == nullptr)
+        {
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+        if (!layout.HasDescRing())
+        {
+            return MRDA_STATUS_NOT_SUPPORTED;
+        }
+        uint8_t *ringPtr = static_cast<uint8_t*>(basePtr) + layout.descOffset;
+        m_control = reinterpret_cast<ShmDescRingControl*>(ringPtr);
+        m_entries = reinterpret_cast<ShmDescriptor*>(ringPtr + SHM_DESC_CONTROL_SIZE);
+        m_descNum = layout.descNum;
+        m_pushBell.Attach(&m_control->pushBell);
+        m_popBell.Attach(&m_control->popBell);
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Empty the ring, only called by the region owner
+    //!
+    void Reset()
+    {
+        if (m_control == nullptr) return;
+        m_control->head.store(0, std::memory_order_relaxed);
+        m_control->tail.store(0, std::memory_order_relaxed);
+        m_control->pushBell.seq.store(0, std::memory_order_relaxed);
+        m_control->pushBell.waiters.store(0, std::memory_order_relaxed);
+        m_control->popBell.seq.store(0, std::memory_order_relaxed);
+        m_control->popBell.waiters.store(0, std::memory_order_relaxed);
+        m_control->closed.store(0, std::memory_order_release);
+    }
+    //!
+    //! \brief Close the ring for both sides and wake up their waiters,
+    //!        pushes fail from then on and pops drain what is left
+    //!
+    void Close()
+    {
+        if (m_control == nullptr) return;
+        m_control->closed.store(1, std::memory_order_release);
+        m_pushBell.Ring();
+        m_popBell.Ring();
+    }
+    //!
+    //! \brief Check whether either side has closed the ring
+    //!
+    //! \return bool
+    //!
+    inline bool IsClosed() const
+    {
+        return m_control != nullptr && m_control->closed.load(std::memory_order_acquire) != 0;
+    }
+    //!
+    //! \brief Check whether the ring is attached
+    //!
+    //! \return bool
+    //!
+    inline bool IsAttached() const { return m_control != nullptr; }
+    //!
+    //! \brief Push one descriptor, waiting for the consumer if the ring is full
+    //!
+    //! \param [in] desc
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to not wait
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY on timeout,
+    //!         MRDA_STATUS_INVALID_STATE if the ring is closed
+    //!
+    MRDAStatus Push(const ShmDescriptor &desc, uint32_t timeoutUs)
+    {
+        if (m_control == nullptr) return MRDA_STATUS_INVALID_STATE;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+        uint64_t head = m_control->head.load(std::memory_order_relaxed);
+        while (true)
+        {
+            uint32_t seq = m_popBell.Sequence();
+            if (IsClosed())
+            {
+                return MRDA_STATUS_INVALID_STATE;
+            }
+            uint64_t tail = m_control->tail.load(std::memory_order_acquire);
+            if (head - tail > m_descNum)
+            {
+                MRDA_LOG(LOG_ERROR, "Corrupted descriptor ring, head %lu, tail %lu!", head, tail);
+                return MRDA_STATUS_INVALID_DATA;
+            }
+            if (head - tail < m_descNum)
+            {
+                break;
+            }
+            if (!WaitUntil(m_popBell, seq, deadline))
+            {
+                return MRDA_STATUS_NOT_READY;
+            }
+        }
+        m_entries[head & (m_descNum - 1)] = desc;
+        m_control->head.store(head + 1, std::memory_order_release);
+        m_pushBell.Ring();
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Pop one descriptor, waiting for the producer if the ring is empty
+    //!
+    //! \param [out] desc
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to not wait
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY on timeout,
+    //!         MRDA_STATUS_NOT_ENOUGH_DATA if the ring is closed and drained
+    //!
+    MRDAStatus Pop(ShmDescriptor &desc, uint32_t timeoutUs)
+    {
+        if (m_control == nullptr) return MRDA_STATUS_INVALID_STATE;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+        uint64_t tail = m_control->tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            uint32_t seq = m_pushBell.Sequence();
+            uint64_t head = m_control->head.load(std::memory_order_acquire);
+            if (head - tail > m_descNum)
+            {
+                MRDA_LOG(LOG_ERROR, "Corrupted descriptor ring, head %lu, tail %lu!", head, tail);
+                return MRDA_STATUS_INVALID_DATA;
+            }
+            if (head != tail)
+            {
+                break;
+            }
+            if (IsClosed())
+            {
+                return MRDA_STATUS_NOT_ENOUGH_DATA;
+            }
+            if (!WaitUntil(m_pushBell, seq, deadline))
+            {
+                return MRDA_STATUS_NOT_READY;
+            }
+        }
+        desc = m_entries[tail & (m_descNum - 1)];
+        m_control->tail.store(tail + 1, std::memory_order_release);
+        m_popBell.Ring();
+        return MRDA_STATUS_SUCCESS;
+    }
+
+private:
+    //!
+    //! \brief Wait on a doorbell until it is rung or the deadline passes
+    //!
+    //! \return bool
+    //!         false if the deadline has passed
+    //!
+    static bool WaitUntil(ShmDoorbell &bell, uint32_t seq, std::chrono::steady_clock::time_point deadline)
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return false;
+        }
+        uint64_t remainUs = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+        bell.Wait(seq, static_cast<uint32_t>(remainUs));
+        return true;
+    }
+
+private:
+    ShmDescRingControl *m_control; //!< ring control in share memory
+    ShmDescriptor *m_entries;      //!< ring entries in share memory
+    uint32_t m_descNum;            //!< number of entries, power of two
+    ShmDoorbell m_pushBell;        //!< rung by the producer
+    ShmDoorbell m_popBell;         //!< rung by the consumer
+};
+
+//!
+//! \brief Fill a descriptor from a frame
+//!
+//! \param [in] frame
+//! \param [out] desc
+//!
+inline void ShmMakeDescriptor(std::shared_ptr<FrameBufferData> frame, ShmDescriptor &desc)
+{
+    desc = ShmDescriptor{};
+    desc.flags = frame->IsEOS() ? SHM_DESC_FLAG_EOS : SHM_DESC_FLAG_NONE;
+    desc.flags |= (static_cast<uint32_t>(frame->StreamType()) & 0xFF) << SHM_DESC_TYPE_SHIFT;
+    desc.pts = frame->Pts();
+    desc.width = frame->Width();
+    desc.height = frame->Height();
+    desc.chainNum = 1;
+    std::shared_ptr<MemoryBuffer> memBuf = frame->MemBuffer();
+    if (memBuf == nullptr) return;
+    desc.flags |= (static_cast<uint32_t>(memBuf->State()) & 0xFF) << SHM_DESC_STATE_SHIFT;
+    desc.bufId = memBuf->BufId();
+    desc.memOffset = memBuf->MemOffset();
+    desc.stateOffset = memBuf->StateOffset();
+    desc.bufSize = memBuf->Size();
+    desc.occupiedSize = memBuf->OccupiedSize();
+    desc.pitch = memBuf->Pitch();
+    desc.chainNum = static_cast<uint16_t>(memBuf->ChainNum());
+    desc.chainIndex = static_cast<uint16_t>(memBuf->ChainIndex());
+}
+
+//!
+//! \brief Fill a frame and its memory buffer from a descriptor
+//!
+//! \param [in] desc
+//! \param [in, out] frame
+//!             frame with a memory buffer attached
+//!
+inline void ShmMakeFrame(const ShmDescriptor &desc, std::shared_ptr<FrameBufferData> frame)
+{
+    // sign extend the byte so UNKNOWN survives the round trip
+    int8_t type = static_cast<int8_t>((desc.flags >> SHM_DESC_TYPE_SHIFT) & 0xFF);
+    frame->SetEOS((desc.flags & SHM_DESC_FLAG_EOS) != 0);
+    frame->SetStreamType(static_cast<InputStreamType>(type));
+    frame->SetPts(desc.pts);
+    frame->SetWidth(desc.width);
+    frame->SetHeight(desc.height);
+    std::shared_ptr<MemoryBuffer> memBuf = frame->MemBuffer();
+    if (memBuf == nullptr) return;
+    memBuf->SetBufId(desc.bufId);
+    memBuf->SetMemOffset(desc.memOffset);
+    memBuf->SetStateOffset(desc.stateOffset);
+    memBuf->SetSize(desc.bufSize);
+    memBuf->SetOccupiedSize(desc.occupiedSize);
+    memBuf->SetState(static_cast<BufferState>((desc.flags >> SHM_DESC_STATE_SHIFT) & 0xFF));
+    memBuf->SetPitch(desc.pitch);
+    memBuf->SetChainNum(desc.chainNum > 0 ? desc.chainNum : 1);
+    memBuf->SetChainIndex(desc.chainIndex);
+}
+
+VDI_NS_END
+#endif // _SHM_DESC_RING_H_
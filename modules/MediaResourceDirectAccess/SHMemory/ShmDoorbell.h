@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmDoorbell.h
+//! \brief define a doorbell word in share memory, rung by one side when a
+//!        buffer changes state and waited on by the other side.
+//! \date 2026-10-17
+//!
+
+#ifndef _SHM_DOORBELL_H_
+#define _SHM_DOORBELL_H_
+
+#include "../utils/common.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#ifdef _LINUX_OS_
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+VDI_NS_BEGIN
+
+constexpr uint32_t SHM_DOORBELL_MIN_SLICE_US = 50;    //!< first wait slice
+constexpr uint32_t SHM_DOORBELL_MAX_SLICE_US = 1000;  //!< longest wait slice
+constexpr uint32_t SHM_DOORBELL_WAIT_US = 100 * 1000; //!< default wait before the caller rechecks its stop flag
+constexpr uint32_t SHM_PEER_TIMEOUT_US = 10 * 1000 * 1000; //!< silence after which the other side is taken as gone
+
+//!
+//! \brief Doorbell word in share memory. The sequence is bumped on every
+//!        ring, the waiter count tells the ringer whether a wake up call
+//!        is needed at all.
+//!
+struct ShmDoorbellWord
+{
+    std::atomic<uint32_t> seq;     //!< ring sequence, futex word
+    std::atomic<uint32_t> waiters; //!< number of blocked waiters
+};
+
+static_assert(sizeof(ShmDoorbellWord) == 2 * sizeof(uint32_t), "doorbell word must be plain 32 bit words");
+
+//!
+//! \brief Wait and wake on a doorbell word.
+//!
+//!        On linux a blocked waiter sleeps on the word as a shared futex, so
+//!        a ring from another local process wakes it at once. A ring from
+//!        a guest VM writes the word without a syscall on the host, so each
+//!        wait is cut into slices growing from 50 us to 1 ms and the word is
+//!        rechecked after each slice. This bounds the wake up latency far
+//!        below a fixed sleep while keeping idle waiters off the CPU.
+//!
+class ShmDoorbell
+{
+public:
+    //!
+    //! \brief Construct a new Shm Doorbell object
+    //!
+    ShmDoorbell(): m_word(nullptr) {}
+    //!
+    //! \brief Attach to a doorbell word in share memory
+    //!
+    //! \param [in] word
+    //!
+    void Attach(ShmDoorbellWord *word) { m_word = word; }
+    //!
+    //! \brief Get the current sequence. Read it before checking the
+    //!        condition and pass it to Wait so no ring in between is lost.
+    //!
+    //! \return uint32_t
+    //!
+    uint32_t Sequence() const
+    {
+        return m_word != nullptr ? m_word->seq.load(std::memory_order_seq_cst) : 0;
+    }
+    //!
+    //! \brief Ring the doorbell and wake up local waiters
+    //!
+    void Ring()
+    {
+        if (m_word == nullptr) return;
+        m_word->seq.fetch_add(1, std::memory_order_seq_cst);
+        if (m_word->waiters.load(std::memory_order_seq_cst) > 0)
+        {
+            Wake();
+        }
+    }
+    //!
+    //! \brief Wait until the sequence moves away from seen
+    //!
+    //! \param [in] seen
+    //!             sequence read before the condition was checked
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds
+    //! \return bool
+    //!         true if the doorbell was rung, false on timeout
+    //!
+    bool Wait(uint32_t seen, uint32_t timeoutUs)
+    {
+        if (m_word == nullptr) return false;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeoutUs);
+        uint32_t sliceUs = SHM_DOORBELL_MIN_SLICE_US;
+        while (m_word->seq.load(std::memory_order_seq_cst) == seen)
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= deadline)
+            {
+                return false;
+            }
+            uint64_t remainUs = std::chrono::duration_cast<std::chrono::microseconds>(deadline - now).count();
+            uint32_t waitUs = static_cast<uint32_t>(std::min<uint64_t>(sliceUs, remainUs));
+
+            m_word->waiters.fetch_add(1, std::memory_order_seq_cst);
+            if (m_word->seq.load(std::memory_order_seq_cst) == seen)
+            {
+                Block(seen, waitUs);
+            }
+            m_word->waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+            sliceUs = std::min(sliceUs * 2, SHM_DOORBELL_MAX_SLICE_US);
+        }
+        return true;
+    }
+
+private:
+    //!
+    //! \brief Block the calling thread on the word for at most waitUs
+    //!
+    void Block(uint32_t seen, uint32_t waitUs)
+    {
+#ifdef _LINUX_OS_
+        // shared futex, the word may be mapped by another process
+        struct timespec ts;
+        ts.tv_sec = waitUs / 1000000;
+        ts.tv_nsec = (waitUs % 1000000) * 1000;
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_word->seq), FUTEX_WAIT, seen, &ts, nullptr, 0);
+#else
+        // no cross process wait on an address, the slice is the latency bound
+        std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+#endif
+    }
+    //!
+    //! \brief Wake all waiters blocked on the word
+    //!
+    void Wake()
+    {
+#ifdef _LINUX_OS_
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_word->seq), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+
+private:
+    ShmDoorbellWord *m_word; //!< doorbell word in share memory
+};
+
+VDI_NS_END
+#endif // _SHM_DOORBELL_H_
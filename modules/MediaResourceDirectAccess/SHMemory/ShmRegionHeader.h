@@ -0,0 +1,395 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmRegionHeader.h
+//! \brief define the self-describing control header written at the
+//!        beginning of every share memory region by the pool owner.
+//! \date 2026-10-17
+//!
+
+#ifndef _SHM_REGION_HEADER_H_
+#define _SHM_REGION_HEADER_H_
+
+#include "../utils/common.h"
+#include "ShmDoorbell.h"
+
+#include <atomic>
+#include <cstdint>
+
+VDI_NS_BEGIN
+
+constexpr uint64_t SHM_CACHE_LINE_SIZE = 64;       //!< cache line size
+constexpr uint64_t SHM_HEADER_AREA_SIZE = 4096;    //!< area reserved for the region header
+constexpr uint64_t SHM_FREE_INDEX_AREA_SIZE = 4096; //!< area reserved for the idle buffer index
+constexpr uint64_t SHM_CONTROL_AREA_SIZE = SHM_HEADER_AREA_SIZE + SHM_FREE_INDEX_AREA_SIZE; //!< header and idle index
+constexpr uint64_t SHM_STATE_ENTRY_SIZE = SHM_CACHE_LINE_SIZE; //!< one state word per cache line in the state table
+constexpr uint64_t SHM_DEFAULT_ALIGNMENT = 4096;  //!< default payload alignment
+constexpr uint64_t SHM_RING_GRANULARITY = SHM_CACHE_LINE_SIZE; //!< allocation granularity of a byte ring region
+constexpr uint64_t SHM_DESC_CONTROL_SIZE = 4 * SHM_CACHE_LINE_SIZE; //!< indexes and doorbells of the descriptor ring
+constexpr uint64_t SHM_DESC_ENTRY_SIZE = SHM_CACHE_LINE_SIZE; //!< one descriptor per cache line
+constexpr uint32_t SHM_DESC_MIN_NUM = 16;          //!< smallest descriptor ring
+constexpr uint32_t SHM_BITS_PER_WORD = 64;         //!< buffers tracked by one free word of the idle index
+constexpr uint32_t SHM_MAX_FREE_WORD_NUM = static_cast<uint32_t>(SHM_FREE_INDEX_AREA_SIZE / SHM_CACHE_LINE_SIZE);
+constexpr uint32_t SHM_MAX_BUFFER_NUM = SHM_MAX_FREE_WORD_NUM * SHM_BITS_PER_WORD; //!< max buffers in one region
+
+constexpr uint32_t SHM_REGION_MAGIC = 0x4144524D;  //!< "MRDA" in little endian
+constexpr uint32_t SHM_LAYOUT_VERSION = 5;         //!< current layout version
+
+//!
+//! \brief Feature flags announced by the region owner
+//!
+enum ShmFeatureFlag : uint64_t
+{
+    SHM_FEATURE_NONE       = 0,
+    SHM_FEATURE_FREE_INDEX = 1ULL << 0, //!< idle buffers are tracked by ShmBufferIndex
+    SHM_FEATURE_STATE_TABLE = 1ULL << 1, //!< state words live in a separate table, not in the slots
+    SHM_FEATURE_BYTE_RING  = 1ULL << 2, //!< data area is a byte ring, buffers reserve variable sized ranges
+    SHM_FEATURE_DOORBELL   = 1ULL << 3, //!< buffer releases ring the doorbell word in the header
+    SHM_FEATURE_DESC_RING  = 1ULL << 4, //!< control area holds a descriptor ring from the filling to the consuming side
+};
+
+//!
+//! \brief Control header at offset 0 of a share memory region. The owner
+//!        fills in all fields and publishes the magic last, the attaching
+//!        side only trusts the layout after the magic and version match.
+//!
+struct ShmRegionHeader
+{
+    std::atomic<uint32_t> magic;   //!< SHM_REGION_MAGIC once the header is valid
+    uint32_t version;              //!< layout version
+    uint32_t headerSize;           //!< sizeof(ShmRegionHeader) of the writer
+    uint32_t bufferNum;            //!< number of buffers
+    uint64_t slotSize;             //!< size of each buffer slot, allocation granularity for byte ring
+    uint64_t alignment;            //!< alignment of each buffer slot
+    uint64_t stateOffset;          //!< offset of the state table
+    uint64_t dataOffset;           //!< offset of the first buffer slot
+    uint64_t dataSize;             //!< size of the data area
+    uint64_t regionSize;           //!< size of the whole region
+    uint64_t featureFlags;         //!< ShmFeatureFlag bits
+    uint64_t descOffset;           //!< offset of the descriptor ring
+    uint32_t descNum;              //!< number of descriptor ring entries, power of two
+    uint32_t reserved;             //!< reserved
+    alignas(SHM_CACHE_LINE_SIZE) std::atomic<uint64_t> producerCount; //!< buffers handed out to producers
+    alignas(SHM_CACHE_LINE_SIZE) std::atomic<uint64_t> consumerCount; //!< buffers given back by consumers
+    alignas(SHM_CACHE_LINE_SIZE) ShmDoorbellWord releaseBell; //!< rung whenever a buffer is released
+};
+
+static_assert(sizeof(ShmRegionHeader) <= SHM_HEADER_AREA_SIZE, "region header exceeds header area");
+
+//!
+//! \brief Plain copy of a validated region layout
+//!
+struct ShmRegionLayout
+{
+    uint32_t bufferNum = 0;  //!< number of buffers
+    uint64_t slotSize = 0;   //!< size of each buffer slot
+    uint64_t alignment = 0;  //!< alignment of each buffer slot
+    uint64_t stateOffset = 0; //!< offset of the state table
+    uint64_t dataOffset = 0; //!< offset of the first buffer slot
+    uint64_t dataSize = 0;   //!< size of the data area
+    uint64_t featureFlags = 0; //!< ShmFeatureFlag bits
+    uint64_t descOffset = 0; //!< offset of the descriptor ring
+    uint32_t descNum = 0;    //!< number of descriptor ring entries
+
+    //!
+    //! \brief Check whether the data area is a byte ring
+    //!
+    //! \return bool
+    //!
+    inline bool IsByteRing() const
+    {
+        return (featureFlags & SHM_FEATURE_BYTE_RING) != 0;
+    }
+
+    //!
+    //! \brief Check whether the control area holds a descriptor ring
+    //!
+    //! \return bool
+    //!
+    inline bool HasDescRing() const
+    {
+        return (featureFlags & SHM_FEATURE_DESC_RING) != 0 && descNum != 0;
+    }
+
+    //!
+    //! \brief Get the state offset of one buffer
+    //!
+    //! \param [in] bufId
+    //!             buffer id, starts from 1
+    //! \return uint64_t
+    //!
+    inline uint64_t StateOffset(uint32_t bufId) const
+    {
+        return stateOffset + (uint64_t)(bufId - 1) * SHM_STATE_ENTRY_SIZE;
+    }
+    //!
+    //! \brief Get the payload offset of one buffer
+    //!
+    //! \param [in] bufId
+    //!             buffer id, starts from 1
+    //! \return uint64_t
+    //!
+    inline uint64_t MemOffset(uint32_t bufId) const
+    {
+        return dataOffset + (uint64_t)(bufId - 1) * slotSize;
+    }
+};
+
+//!
+//! \brief Align value up to a power of two
+//!
+inline uint64_t ShmAlignUp(uint64_t value, uint64_t alignment)
+{
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+//!
+//! \brief Add two sizes of a layout
+//!
+//! \param [in] a
+//! \param [in] b
+//! \param [out] sum
+//! \return bool
+//!         false if the sum does not fit 64 bits
+//!
+inline bool ShmAddSize(uint64_t a, uint64_t b, uint64_t &sum)
+{
+    sum = a + b;
+    return sum >= a;
+}
+
+//!
+//! \brief Multiply two sizes of a layout
+//!
+//! \param [in] a
+//! \param [in] b
+//! \param [out] product
+//! \return bool
+//!         false if the product does not fit 64 bits
+//!
+inline bool ShmMulSize(uint64_t a, uint64_t b, uint64_t &product)
+{
+    if (a != 0 && b > UINT64_MAX / a) return false;
+    product = a * b;
+    return true;
+}
+
+//!
+//! \brief Check whether a size is a non zero power of two
+//!
+inline bool ShmIsPowerOfTwo(uint64_t value)
+{
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+//!
+//! \brief Get the number of descriptor ring entries for a buffer count, every
+//!        buffer plus the EOS descriptor can be in flight at once
+//!
+//! \param [in] bufferNum
+//! \return uint32_t
+//!
+inline uint32_t ShmDescRingNum(uint32_t bufferNum)
+{
+    uint32_t descNum = SHM_DESC_MIN_NUM;
+    while (descNum < bufferNum + 1) descNum <<= 1;
+    return descNum;
+}
+
+//!
+//! \brief Compute the region layout: control area, descriptor ring, cache
+//!        line padded state table, then payload slots aligned and padded to
+//!        the alignment.
+//!        For a byte ring the whole aligned data area is shared by all
+//!        buffers, each reserving only the bytes it needs.
+//!
+//! \param [in] bufferNum
+//!             number of buffers
+//! \param [in] bufferSize
+//!             requested payload size of each buffer
+//! \param [in] alignment
+//!             payload alignment, power of two, 0 for default
+//! \param [in] regionSize
+//!             size of the share memory region
+//! \param [in] byteRing
+//!             lay out the data area as a byte ring
+//! \param [out] layout
+//!             computed layout
+//! \return MRDAStatus
+//!         MRDA_STATUS_SUCCESS if success, else fail
+//!
+inline MRDAStatus ShmComputeLayout(uint32_t bufferNum, uint64_t bufferSize, uint64_t alignment,
+                                   uint64_t regionSize, bool byteRing, ShmRegionLayout &layout)
+{
+    if (alignment == 0) alignment = SHM_DEFAULT_ALIGNMENT;
+    if (alignment < SHM_CACHE_LINE_SIZE || (alignment & (alignment - 1)) != 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid share memory alignment %llu!", (unsigned long long)alignment);
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    if (bufferNum == 0 || bufferNum > SHM_MAX_BUFFER_NUM || bufferSize == 0)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid buffer pool parameters!");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    layout.bufferNum = bufferNum;
+    layout.alignment = alignment;
+    layout.descOffset = SHM_CONTROL_AREA_SIZE;
+    layout.descNum = ShmDescRingNum(bufferNum);
+    layout.stateOffset = layout.descOffset + SHM_DESC_CONTROL_SIZE + layout.descNum * SHM_DESC_ENTRY_SIZE;
+    layout.dataOffset = ShmAlignUp(layout.stateOffset + bufferNum * SHM_STATE_ENTRY_SIZE, alignment);
+    layout.featureFlags = SHM_FEATURE_FREE_INDEX | SHM_FEATURE_STATE_TABLE | SHM_FEATURE_DOORBELL | SHM_FEATURE_DESC_RING;
+    if (byteRing)
+    {
+        layout.slotSize = SHM_RING_GRANULARITY;
+        layout.dataSize = regionSize > layout.dataOffset ? (regionSize - layout.dataOffset) & ~(alignment - 1) : 0;
+        layout.featureFlags |= SHM_FEATURE_BYTE_RING;
+    }
+    else
+    {
+        // the size is checked before it is aligned up, so the slot size cannot wrap
+        layout.slotSize = bufferSize <= UINT64_MAX - alignment ? ShmAlignUp(bufferSize, alignment) : 0;
+        if (layout.slotSize == 0 || !ShmMulSize(bufferNum, layout.slotSize, layout.dataSize))
+        {
+            MRDA_LOG(LOG_ERROR, "Buffer pool exceeds share memory size!");
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+    }
+    uint64_t dataEnd = 0;
+    if (layout.dataSize < bufferSize || !ShmAddSize(layout.dataOffset, layout.dataSize, dataEnd) || dataEnd > regionSize)
+    {
+        MRDA_LOG(LOG_ERROR, "Buffer pool exceeds share memory size!");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    return MRDA_STATUS_SUCCESS;
+}
+
+//!
+//! \brief Write the region header, only called by the region owner
+//!
+//! \param [in] basePtr
+//!             share memory base addr
+//! \param [in] regionSize
+//!             size of the share memory region
+//! \param [in] layout
+//!             layout to be published
+//!
+inline void ShmWriteRegionHeader(void *basePtr, uint64_t regionSize, const ShmRegionLayout &layout)
+{
+    ShmRegionHeader *header = reinterpret_cast<ShmRegionHeader*>(basePtr);
+    // invalidate first so a reader never sees a half written header
+    header->magic.store(0, std::memory_order_release);
+    header->version = SHM_LAYOUT_VERSION;
+    header->headerSize = sizeof(ShmRegionHeader);
+    header->bufferNum = layout.bufferNum;
+    header->slotSize = layout.slotSize;
+    header->alignment = layout.alignment;
+    header->stateOffset = layout.stateOffset;
+    header->dataOffset = layout.dataOffset;
+    header->dataSize = layout.dataSize;
+    header->regionSize = regionSize;
+    header->featureFlags = layout.featureFlags;
+    header->descOffset = layout.descOffset;
+    header->descNum = layout.descNum;
+    header->reserved = 0;
+    header->producerCount.store(0, std::memory_order_relaxed);
+    header->consumerCount.store(0, std::memory_order_relaxed);
+    header->releaseBell.seq.store(0, std::memory_order_relaxed);
+    header->releaseBell.waiters.store(0, std::memory_order_relaxed);
+    header->magic.store(SHM_REGION_MAGIC, std::memory_order_release);
+}
+
+//!
+//! \brief Validate the region header and get the layout
+//!
+//! \param [in] basePtr
+//!             share memory base addr
+//! \param [in] regionSize
+//!             size of the mapped share memory region
+//! \param [out] layout
+//!             validated layout
+//! \return MRDAStatus
+//!         MRDA_STATUS_SUCCESS if success, else fail
+//!
+inline MRDAStatus ShmReadRegionHeader(const void *basePtr, uint64_t regionSize, ShmRegionLayout &layout)
+{
+    if (basePtr == nullptr || regionSize < SHM_CONTROL_AREA_SIZE)
+    {
+        MRDA_LOG(LOG_ERROR, "Share memory region too small for control header!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    const ShmRegionHeader *header = reinterpret_cast<const ShmRegionHeader*>(basePtr);
+    if (header->magic.load(std::memory_order_acquire) != SHM_REGION_MAGIC)
+    {
+        MRDA_LOG(LOG_ERROR, "Share memory region header not initialized!");
+        return MRDA_STATUS_NOT_READY;
+    }
+    if (header->version != SHM_LAYOUT_VERSION || header->headerSize != sizeof(ShmRegionHeader))
+    {
+        MRDA_LOG(LOG_ERROR, "Unsupported share memory layout version %u!", header->version);
+        return MRDA_STATUS_NOT_SUPPORTED;
+    }
+    // the guest writes the header, every sum and product is checked so a
+    // wrapped value cannot pass the bounds below
+    bool byteRing = (header->featureFlags & SHM_FEATURE_BYTE_RING) != 0;
+    uint64_t fixedSize = 0, descEnd = 0, stateEnd = 0, dataEnd = 0;
+    if (header->bufferNum == 0 || header->bufferNum > SHM_MAX_BUFFER_NUM
+        || header->slotSize == 0 || header->dataSize == 0
+        || !ShmIsPowerOfTwo(header->alignment)
+        || header->dataOffset % header->alignment != 0
+        || (byteRing && !ShmIsPowerOfTwo(header->slotSize))
+        || (!byteRing && header->slotSize % header->alignment != 0)
+        || (!byteRing && (!ShmMulSize(header->bufferNum, header->slotSize, fixedSize) || header->dataSize != fixedSize))
+        || header->stateOffset < SHM_CONTROL_AREA_SIZE
+        || !ShmIsPowerOfTwo(header->descNum)
+        || header->descOffset < SHM_CONTROL_AREA_SIZE
+        || !ShmAddSize(header->descOffset, SHM_DESC_CONTROL_SIZE + (uint64_t)header->descNum * SHM_DESC_ENTRY_SIZE, descEnd)
+        || descEnd > header->stateOffset
+        || !ShmAddSize(header->stateOffset, (uint64_t)header->bufferNum * SHM_STATE_ENTRY_SIZE, stateEnd)
+        || header->dataOffset < stateEnd
+        || !ShmAddSize(header->dataOffset, header->dataSize, dataEnd)
+        || header->regionSize > regionSize
+        || dataEnd > regionSize)
+    {
+        MRDA_LOG(LOG_ERROR, "Invalid share memory layout in region header!");
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    layout.bufferNum = header->bufferNum;
+    layout.slotSize = header->slotSize;
+    layout.alignment = header->alignment;
+    layout.stateOffset = header->stateOffset;
+    layout.dataOffset = header->dataOffset;
+    layout.dataSize = header->dataSize;
+    layout.featureFlags = header->featureFlags;
+    layout.descOffset = header->descOffset;
+    layout.descNum = header->descNum;
+    return MRDA_STATUS_SUCCESS;
+}
+
+VDI_NS_END
+#endif // _SHM_REGION_HEADER_H_
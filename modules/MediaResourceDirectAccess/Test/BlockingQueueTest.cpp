@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file BlockingQueueTest.cpp
+//! \brief bounded blocking queue used between the threads of one side
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../utils/BlockingQueue.h"
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+VDI_USE_MRDALib
+
+constexpr uint32_t TEST_WAIT_US = 5 * 1000 * 1000; //!< upper bound of any wait that must succeed
+constexpr uint32_t SHORT_WAIT_US = 20 * 1000;       //!< wait that is expected to time out
+
+//!
+//! \brief elapsed microseconds since begin
+//!
+static int64_t ElapsedUs(std::chrono::steady_clock::time_point begin)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+}
+
+//!
+//! \brief order, capacity and timeouts on one thread
+//!
+static int TestCapacity()
+{
+    BlockingQueue<int> queue(3);
+    int item = 0;
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.Pop(item, 0));
+    for (int i = 0; i < 3; i++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(i, 0));
+    }
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.Push(3, 0));
+    auto begin = std::chrono::steady_clock::now();
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.Push(3, SHORT_WAIT_US));
+    MRDA_CHECK(ElapsedUs(begin) >= SHORT_WAIT_US);
+    MRDA_CHECK(queue.Size() == 3);
+
+    // growing the capacity makes room at once
+    queue.SetCapacity(4);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(3, 0));
+    for (int i = 0; i < 4; i++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == i);
+    }
+    begin = std::chrono::steady_clock::now();
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.Pop(item, SHORT_WAIT_US));
+    MRDA_CHECK(ElapsedUs(begin) >= SHORT_WAIT_US);
+
+    BlockingQueue<int> unbounded;
+    for (int i = 0; i < 10000; i++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == unbounded.Push(i, 0));
+    }
+    MRDA_CHECK(unbounded.Size() == 10000);
+    return 0;
+}
+
+//!
+//! \brief a range is queued back to back, an empty queue takes a range
+//!        larger than the capacity
+//!
+static int TestPushRange()
+{
+    BlockingQueue<int> queue(4);
+    std::vector<int> chain = {10, 11, 12};
+    std::vector<int> big = {20, 21, 22, 23, 24, 25};
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(1, 0));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.PushRange(chain.begin(), chain.end(), 0));
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.PushRange(chain.begin(), chain.end(), 0));
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.PushRange(big.begin(), big.end(), 0));
+
+    int item = 0;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == 1);
+    for (int expected : chain)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == expected);
+    }
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.PushRange(big.begin(), big.end(), 0));
+    MRDA_CHECK(queue.Size() == big.size());
+    return 0;
+}
+
+//!
+//! \brief close wakes blocked producers and consumers, pops drain the
+//!        queue before they fail, reset opens it again
+//!
+static int TestClose()
+{
+    BlockingQueue<int> queue(2);
+    std::atomic<int> popStatus(MRDA_STATUS_SUCCESS);
+    std::thread consumer([&]() {
+        int item = 0;
+        popStatus = queue.Pop(item, TEST_WAIT_US);
+    });
+    usleep(SHORT_WAIT_US);
+    auto begin = std::chrono::steady_clock::now();
+    queue.Close();
+    consumer.join();
+    MRDA_CHECK(popStatus == MRDA_STATUS_INVALID_STATE);
+    MRDA_CHECK(ElapsedUs(begin) < TEST_WAIT_US / 2);
+
+    queue.Reset();
+    MRDA_CHECK(!queue.IsClosed());
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(1, 0));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(2, 0));
+    std::atomic<int> pushStatus(MRDA_STATUS_SUCCESS);
+    std::thread producer([&]() {
+        pushStatus = queue.Push(3, TEST_WAIT_US);
+    });
+    usleep(SHORT_WAIT_US);
+    begin = std::chrono::steady_clock::now();
+    queue.Close();
+    producer.join();
+    MRDA_CHECK(pushStatus == MRDA_STATUS_INVALID_STATE);
+    MRDA_CHECK(ElapsedUs(begin) < TEST_WAIT_US / 2);
+    MRDA_CHECK(MRDA_STATUS_INVALID_STATE == queue.Push(4, 0));
+
+    int item = 0;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == 1);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == 2);
+    MRDA_CHECK(MRDA_STATUS_INVALID_STATE == queue.Pop(item, TEST_WAIT_US));
+
+    queue.Reset();
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(5, 0));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == 5);
+    return 0;
+}
+
+//!
+//! \brief listeners run outside the lock, so they may use the queue
+//!
+static int TestListeners()
+{
+    BlockingQueue<int> queue(1);
+    int pushes = 0;
+    int pops = 0;
+    int refill = 3;
+    queue.SetPushListener([&]() { pushes++; });
+    // hand the freed slot to the next item like an output pool does
+    queue.SetPopListener([&]() {
+        pops++;
+        if (refill > 0) queue.Push(refill--, 0);
+    });
+
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(4, 0));
+    int item = 0;
+    for (int expected = 4; expected > 0; expected--)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Pop(item, 0) && item == expected);
+    }
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == queue.Pop(item, 0));
+    MRDA_CHECK(pushes == 4 && pops == 4);
+    return 0;
+}
+
+//!
+//! \brief producers and consumers on a small queue, each producer's items
+//!        arrive in order and none is lost or duplicated
+//!
+static int TestManyThreads()
+{
+    constexpr uint32_t producerNum = 4;
+    constexpr uint32_t consumerNum = 4;
+    constexpr uint32_t itemNum = 20000;
+    BlockingQueue<uint32_t> queue(8);
+    std::vector<std::thread> producers;
+    std::vector<std::thread> consumers;
+    std::vector<std::vector<uint32_t>> received(consumerNum);
+    std::atomic<uint32_t> failures(0);
+
+    for (uint32_t c = 0; c < consumerNum; c++)
+    {
+        consumers.emplace_back([&, c]() {
+            uint32_t item = 0;
+            while (queue.Pop(item, TEST_WAIT_US) == MRDA_STATUS_SUCCESS)
+            {
+                received[c].push_back(item);
+            }
+            if (!queue.IsClosed()) failures++;
+        });
+    }
+    for (uint32_t p = 0; p < producerNum; p++)
+    {
+        producers.emplace_back([&, p]() {
+            for (uint32_t n = 0; n < itemNum; n++)
+            {
+                if (queue.Push(p * itemNum + n, TEST_WAIT_US) != MRDA_STATUS_SUCCESS) failures++;
+            }
+        });
+    }
+    for (auto &producer : producers) producer.join();
+    queue.Close();
+    for (auto &consumer : consumers) consumer.join();
+    MRDA_CHECK(failures == 0);
+
+    std::vector<uint32_t> seen(producerNum * itemNum, 0);
+    for (auto &items : received)
+    {
+        std::vector<int64_t> last(producerNum, -1);
+        for (uint32_t item : items)
+        {
+            MRDA_CHECK(item < seen.size());
+            seen[item]++;
+            // one consumer pops the items of a producer in push order
+            uint32_t p = item / itemNum;
+            MRDA_CHECK(static_cast<int64_t>(item % itemNum) > last[p]);
+            last[p] = item % itemNum;
+        }
+    }
+    for (uint32_t count : seen)
+    {
+        MRDA_CHECK(count == 1);
+    }
+    return 0;
+}
+
+//!
+//! \brief time from a push to the return of the pop on a consumer thread
+//!        already blocked on the empty queue, and the same with the 50 ms
+//!        sleep polling the queue replaced
+//!
+static int TestWakeLatency()
+{
+    using Clock = std::chrono::steady_clock;
+    constexpr uint32_t wakeNum = 2000;
+    constexpr uint32_t pollNum = 60;
+    constexpr uint32_t pushGapUs = 500;     //!< long enough for the consumer to block again
+    constexpr uint32_t pollSleepMs = 50;    //!< sleep of the old send thread on an empty queue
+
+    BlockingQueue<Clock::time_point> queue(8);
+    std::vector<uint64_t> wakeNs;
+    wakeNs.reserve(wakeNum);
+    std::thread consumer([&]() {
+        Clock::time_point pushed;
+        while (queue.Pop(pushed, TEST_WAIT_US) == MRDA_STATUS_SUCCESS)
+        {
+            wakeNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - pushed).count());
+        }
+    });
+    for (uint32_t n = 0; n < wakeNum; n++)
+    {
+        usleep(pushGapUs);
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == queue.Push(Clock::now(), 0));
+    }
+    queue.Close();
+    consumer.join();
+    MRDA_CHECK(wakeNs.size() == wakeNum);
+
+    std::deque<Clock::time_point> polled;
+    std::mutex pollMutex;
+    std::atomic<bool> stop(false);
+    std::vector<uint64_t> pollNs;
+    pollNs.reserve(pollNum);
+    std::thread poller([&]() {
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock(pollMutex);
+            if (polled.empty())
+            {
+                if (stop) break;
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(pollSleepMs));
+                continue;
+            }
+            Clock::time_point pushed = polled.front();
+            polled.pop_front();
+            pollNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - pushed).count());
+        }
+    });
+    // pushes do not line up with the poll period
+    for (uint32_t n = 0; n < pollNum; n++)
+    {
+        usleep(pollSleepMs * 1000 + 7 * 1000);
+        std::unique_lock<std::mutex> lock(pollMutex);
+        polled.push_back(Clock::now());
+    }
+    stop = true;
+    poller.join();
+    MRDA_CHECK(pollNs.size() == pollNum);
+
+    ReportLatency("blocking queue wake", wakeNs);
+    ReportLatency("50 ms sleep polling wake", pollNs);
+    // sorted by the report
+    MRDA_CHECK(wakeNs[wakeNum / 2] < pollNs[pollNum / 2]);
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"Capacity", TestCapacity},
+        {"PushRange", TestPushRange},
+        {"Close", TestClose},
+        {"Listeners", TestListeners},
+        {"ManyThreads", TestManyThreads},
+        {"WakeLatency", TestWakeLatency},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file ColorConvertBench.cpp
+//! \brief throughput of the colour space converter kernels of every
+//!        instruction set the CPU supports on 1080p frames, and of
+//!        swscale with the flags the decode service used when FFmpeg is
+//!        built in, together with the largest difference to swscale
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/ColorConvert/ColorConvert.h"
+
+#ifdef _FFMPEG_SUPPORT_
+extern "C" {
+#include <libswscale/swscale.h>
+}
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+VDI_USE_MRDALib
+
+constexpr int BENCH_WIDTH = 1920;      //!< frame width
+constexpr int BENCH_HEIGHT = 1080;     //!< frame height
+constexpr int BENCH_FRAME_NUM = 200;   //!< frames converted per measurement
+
+//!
+//! \brief tightly packed image of one format
+//!
+struct BenchImage
+{
+    CscImage image;
+    std::vector<uint8_t> planes[3];
+
+    BenchImage(CscFormat format, int width, int height)
+    {
+        image.format = format;
+        image.width = width;
+        image.height = height;
+        int chromaWidth = (width + 1) / 2;
+        int chromaHeight = (height + 1) / 2;
+        int planeNum = 1;
+        int rows[3] = {height, chromaHeight, chromaHeight};
+        image.linesize[0] = width;
+        if (format == CscFormat::CSC_FORMAT_BGRA)
+        {
+            image.linesize[0] = width * 4;
+        }
+        else if (format == CscFormat::CSC_FORMAT_NV12)
+        {
+            image.linesize[1] = chromaWidth * 2;
+            planeNum = 2;
+        }
+        else
+        {
+            image.linesize[1] = image.linesize[2] = chromaWidth;
+            planeNum = 3;
+        }
+        uint32_t seed = 12345;
+        for (int i = 0; i < planeNum; i++)
+        {
+            planes[i].resize(static_cast<size_t>(image.linesize[i]) * rows[i]);
+            for (uint8_t &value : planes[i])
+            {
+                seed = seed * 1664525u + 1013904223u;
+                value = static_cast<uint8_t>(seed >> 24);
+            }
+            image.data[i] = planes[i].data();
+        }
+    }
+};
+
+//!
+//! \brief one conversion of the benchmark
+//!
+struct BenchConversion
+{
+    const char *name;  //!< printed name
+    CscFormat in;      //!< source format
+    CscFormat out;     //!< destination format
+};
+
+static const BenchConversion g_conversions[] = {
+    {"BGRA->NV12", CscFormat::CSC_FORMAT_BGRA, CscFormat::CSC_FORMAT_NV12},
+    {"BGRA->I420", CscFormat::CSC_FORMAT_BGRA, CscFormat::CSC_FORMAT_I420},
+    {"NV12->BGRA", CscFormat::CSC_FORMAT_NV12, CscFormat::CSC_FORMAT_BGRA},
+    {"I420->BGRA", CscFormat::CSC_FORMAT_I420, CscFormat::CSC_FORMAT_BGRA},
+    {"NV12->I420", CscFormat::CSC_FORMAT_NV12, CscFormat::CSC_FORMAT_I420},
+    {"I420->NV12", CscFormat::CSC_FORMAT_I420, CscFormat::CSC_FORMAT_NV12},
+};
+
+//!
+//! \brief print the time per frame and the pixel rate of a measurement
+//!
+static void BenchReport(const char *conversion, const char *engine, std::chrono::steady_clock::duration elapsed)
+{
+    double frameMs = std::chrono::duration<double, std::milli>(elapsed).count() / BENCH_FRAME_NUM;
+    double mpixels = static_cast<double>(BENCH_WIDTH) * BENCH_HEIGHT / (frameMs * 1000.0);
+    printf("%-12s %-8s %8.3f ms/frame %9.1f Mpixel/s\n", conversion, engine, frameMs, mpixels);
+    fflush(stdout);
+}
+
+#ifdef _FFMPEG_SUPPORT_
+//!
+//! \brief pixel format of swscale for a converter format
+//!
+static AVPixelFormat BenchPixelFormat(CscFormat format)
+{
+    switch (format)
+    {
+        case CscFormat::CSC_FORMAT_NV12:
+            return AV_PIX_FMT_NV12;
+        case CscFormat::CSC_FORMAT_I420:
+            return AV_PIX_FMT_YUV420P;
+        case CscFormat::CSC_FORMAT_BGRA:
+            return AV_PIX_FMT_BGRA;
+        default:
+            return AV_PIX_FMT_NONE;
+    }
+}
+
+//!
+//! \brief largest difference of any byte of two images of one format
+//!
+static int BenchMaxDiff(BenchImage &a, BenchImage &b)
+{
+    int maxDiff = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        for (size_t n = 0; n < a.planes[i].size(); n++)
+        {
+            maxDiff = std::max(maxDiff, std::abs(a.planes[i][n] - b.planes[i][n]));
+        }
+    }
+    return maxDiff;
+}
+#endif
+
+//!
+//! \brief time every conversion with each instruction set, and swscale
+//!
+static int BenchConvert()
+{
+    const CscIsa isas[] = {CscIsa::CSC_ISA_SCALAR, CscIsa::CSC_ISA_AVX2, CscIsa::CSC_ISA_AVX512};
+    const char *isaNames[] = {"scalar", "avx2", "avx512"};
+    for (const BenchConversion &conversion : g_conversions)
+    {
+        BenchImage src(conversion.in, BENCH_WIDTH, BENCH_HEIGHT);
+        BenchImage dst(conversion.out, BENCH_WIDTH, BENCH_HEIGHT);
+        for (size_t i = 0; i < sizeof(isas) / sizeof(isas[0]); i++)
+        {
+            ColorConvert converter(isas[i]);
+            // the converter lowers what the CPU lacks, skip the repeat
+            if (converter.Isa() != isas[i]) continue;
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == converter.Convert(src.image, dst.image));
+            auto begin = std::chrono::steady_clock::now();
+            for (int n = 0; n < BENCH_FRAME_NUM; n++)
+            {
+                MRDA_CHECK(MRDA_STATUS_SUCCESS == converter.Convert(src.image, dst.image));
+            }
+            BenchReport(conversion.name, isaNames[i], std::chrono::steady_clock::now() - begin);
+        }
+#ifdef _FFMPEG_SUPPORT_
+        BenchImage swsDst(conversion.out, BENCH_WIDTH, BENCH_HEIGHT);
+        SwsContext *swsCtx = sws_getCachedContext(nullptr, BENCH_WIDTH, BENCH_HEIGHT, BenchPixelFormat(conversion.in),
+                                                  BENCH_WIDTH, BENCH_HEIGHT, BenchPixelFormat(conversion.out),
+                                                  SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+        MRDA_CHECK(swsCtx != nullptr);
+        auto begin = std::chrono::steady_clock::now();
+        for (int n = 0; n < BENCH_FRAME_NUM; n++)
+        {
+            sws_scale(swsCtx, src.image.data, src.image.linesize, 0, BENCH_HEIGHT, swsDst.image.data, swsDst.image.linesize);
+        }
+        BenchReport(conversion.name, "swscale", std::chrono::steady_clock::now() - begin);
+        sws_freeContext(swsCtx);
+        printf("%-12s max difference to swscale: %d\n", conversion.name, BenchMaxDiff(dst, swsDst));
+#endif
+    }
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"Convert", BenchConvert},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ColorConvertTest.cpp
+//! \brief colour space converter kernels of every instruction set against
+//!        a floating point BT.601 limited range reference
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/ColorConvert/ColorConvert.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+VDI_USE_MRDALib
+
+// The kernels use 8 bit fixed point coefficients and round the 2x2 RGB
+// average before the chroma matrix, so they are neither bit exact with the
+// float formulas nor with swscale. They stay within one code value of the
+// reference for every sample of random full range images:
+constexpr int LUMA_TOLERANCE = 1;   //!< Y from BGRA
+constexpr int CHROMA_TOLERANCE = 1; //!< U and V from BGRA, subsampled 2x2
+constexpr int RGB_TOLERANCE = 1;    //!< B, G and R from YUV
+
+constexpr int ROW_PADDING = 40;           //!< stride padding, not a multiple of any vector
+constexpr uint8_t GUARD_BYTE = 0xCD;      //!< fill of destination padding
+
+//!
+//! \brief image with padded planes, the padding must stay untouched
+//!
+struct TestImage
+{
+    CscImage image;
+    std::vector<uint8_t> planes[3];
+    int rowBytes[3] = {0, 0, 0};
+    int rows[3] = {0, 0, 0};
+
+    TestImage(const TestImage &) = delete;
+    TestImage &operator=(const TestImage &) = delete;
+
+    TestImage(CscFormat format, int width, int height)
+    {
+        image.format = format;
+        image.width = width;
+        image.height = height;
+        int chromaWidth = (width + 1) / 2;
+        int chromaHeight = (height + 1) / 2;
+        int planeNum = 1;
+        rowBytes[0] = width;
+        rows[0] = height;
+        if (format == CscFormat::CSC_FORMAT_BGRA)
+        {
+            rowBytes[0] = width * 4;
+        }
+        else if (format == CscFormat::CSC_FORMAT_NV12)
+        {
+            rowBytes[1] = chromaWidth * 2;
+            rows[1] = chromaHeight;
+            planeNum = 2;
+        }
+        else
+        {
+            rowBytes[1] = rowBytes[2] = chromaWidth;
+            rows[1] = rows[2] = chromaHeight;
+            planeNum = 3;
+        }
+        for (int i = 0; i < planeNum; i++)
+        {
+            image.linesize[i] = rowBytes[i] + ROW_PADDING;
+            planes[i].assign(static_cast<size_t>(image.linesize[i]) * rows[i], GUARD_BYTE);
+            image.data[i] = planes[i].data();
+        }
+    }
+
+    uint8_t &At(int plane, int x, int y)
+    {
+        return image.data[plane][static_cast<size_t>(y) * image.linesize[plane] + x];
+    }
+
+    void FillRandom(uint32_t seed)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int y = 0; y < rows[i]; y++)
+            {
+                for (int x = 0; x < rowBytes[i]; x++)
+                {
+                    seed = seed * 1664525u + 1013904223u;
+                    At(i, x, y) = static_cast<uint8_t>(seed >> 24);
+                }
+            }
+        }
+    }
+
+    bool GuardIntact()
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int y = 0; y < rows[i]; y++)
+            {
+                for (int x = rowBytes[i]; x < image.linesize[i]; x++)
+                {
+                    if (At(i, x, y) != GUARD_BYTE) return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    bool SameAs(TestImage &other)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            for (int y = 0; y < rows[i]; y++)
+            {
+                if (memcmp(&At(i, 0, y), &other.At(i, 0, y), rowBytes[i]) != 0) return false;
+            }
+        }
+        return true;
+    }
+
+    //! chroma sample of a pixel, U plane 1 and V plane 2 in both layouts
+    uint8_t Chroma(int uv, int x, int y)
+    {
+        if (image.format == CscFormat::CSC_FORMAT_NV12) return At(1, (x / 2) * 2 + uv, y / 2);
+        return At(1 + uv, x / 2, y / 2);
+    }
+};
+
+static double RefY(double r, double g, double b)
+{
+    return 16.0 + (65.481 * r + 128.553 * g + 24.966 * b) / 255.0;
+}
+
+static double RefU(double r, double g, double b)
+{
+    return 128.0 + (-37.797 * r - 74.203 * g + 112.0 * b) / 255.0;
+}
+
+static double RefV(double r, double g, double b)
+{
+    return 128.0 + (112.0 * r - 93.786 * g - 18.214 * b) / 255.0;
+}
+
+static int RefClamp(double value)
+{
+    long rounded = lround(value);
+    return rounded < 0 ? 0 : (rounded > 255 ? 255 : static_cast<int>(rounded));
+}
+
+static const char *IsaName(CscIsa isa)
+{
+    switch (isa)
+    {
+        case CscIsa::CSC_ISA_AVX512: return "avx512";
+        case CscIsa::CSC_ISA_AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+//!
+//! \brief Check a BGRA to YUV conversion against the reference, the 2x2
+//!        block of an odd edge repeats its last column or row
+//!
+static int CheckToYuv(TestImage &bgra, TestImage &yuv, int &maxLuma, int &maxChroma)
+{
+    int width = bgra.image.width;
+    int height = bgra.image.height;
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            const uint8_t *p = &bgra.At(0, x * 4, y);
+            int diff = std::abs(yuv.At(0, x, y) - RefClamp(RefY(p[2], p[1], p[0])));
+            maxLuma = std::max(maxLuma, diff);
+            MRDA_CHECK(diff <= LUMA_TOLERANCE);
+        }
+    }
+    for (int y = 0; y < height; y += 2)
+    {
+        for (int x = 0; x < width; x += 2)
+        {
+            int xs[2] = {x, std::min(x + 1, width - 1)};
+            int ys[2] = {y, std::min(y + 1, height - 1)};
+            double r = 0.0, g = 0.0, b = 0.0;
+            for (int j = 0; j < 2; j++)
+            {
+                for (int i = 0; i < 2; i++)
+                {
+                    const uint8_t *p = &bgra.At(0, xs[i] * 4, ys[j]);
+                    b += p[0] / 4.0;
+                    g += p[1] / 4.0;
+                    r += p[2] / 4.0;
+                }
+            }
+            int diffU = std::abs(yuv.Chroma(0, x, y) - RefClamp(RefU(r, g, b)));
+            int diffV = std::abs(yuv.Chroma(1, x, y) - RefClamp(RefV(r, g, b)));
+            maxChroma = std::max(maxChroma, std::max(diffU, diffV));
+            MRDA_CHECK(diffU <= CHROMA_TOLERANCE && diffV <= CHROMA_TOLERANCE);
+        }
+    }
+    return 0;
+}
+
+//!
+//! \brief Check a YUV to BGRA conversion against the reference
+//!
+static int CheckToBgra(TestImage &yuv, TestImage &bgra, int &maxRgb)
+{
+    for (int y = 0; y < yuv.image.height; y++)
+    {
+        for (int x = 0; x < yuv.image.width; x++)
+        {
+            double c = 1.164383 * (yuv.At(0, x, y) - 16);
+            double d = yuv.Chroma(0, x, y) - 128;
+            double e = yuv.Chroma(1, x, y) - 128;
+            int ref[3] = {RefClamp(c + 2.017232 * d), RefClamp(c - 0.391762 * d - 0.812968 * e), RefClamp(c + 1.596027 * e)};
+            const uint8_t *p = &bgra.At(0, x * 4, y);
+            for (int i = 0; i < 3; i++)
+            {
+                int diff = std::abs(p[i] - ref[i]);
+                maxRgb = std::max(maxRgb, diff);
+                MRDA_CHECK(diff <= RGB_TOLERANCE);
+            }
+            MRDA_CHECK(p[3] == 255);
+        }
+    }
+    return 0;
+}
+
+//! sizes with odd edges and widths off every vector length
+static const int TEST_SIZES[][2] = {{131, 67}, {64, 2}, {1, 1}, {258, 34}};
+static const CscIsa TEST_ISAS[] = {CscIsa::CSC_ISA_SCALAR, CscIsa::CSC_ISA_AVX2, CscIsa::CSC_ISA_AVX512};
+
+//!
+//! \brief Convert with every instruction set the cpu has, check against
+//!        the scalar kernels and hand each result to a checker
+//!
+static int ConvertAll(TestImage &src, CscFormat format, const std::function<int(TestImage&, CscIsa)> &check)
+{
+    int width = src.image.width;
+    int height = src.image.height;
+    TestImage scalar(format, width, height);
+    ColorConvert scalarConverter(CscIsa::CSC_ISA_SCALAR);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == scalarConverter.Convert(src.image, scalar.image));
+    for (CscIsa isa : TEST_ISAS)
+    {
+        ColorConvert converter(isa);
+        if (converter.Isa() != isa)
+        {
+            printf("  %s not supported by this cpu, skipped\n", IsaName(isa));
+            continue;
+        }
+        TestImage dst(format, width, height);
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == converter.Convert(src.image, dst.image));
+        MRDA_CHECK(dst.GuardIntact());
+        // every kernel computes the same integer formulas
+        MRDA_CHECK(dst.SameAs(scalar));
+        MRDA_CHECK(check(dst, isa) == 0);
+    }
+    return 0;
+}
+
+static const char *FormatName(CscFormat format)
+{
+    switch (format)
+    {
+        case CscFormat::CSC_FORMAT_NV12: return "nv12";
+        case CscFormat::CSC_FORMAT_I420: return "i420";
+        default: return "bgra";
+    }
+}
+
+//!
+//! \brief BGRA to NV12 and I420
+//!
+static int TestBgraToYuv()
+{
+    for (auto &size : TEST_SIZES)
+    {
+        TestImage bgra(CscFormat::CSC_FORMAT_BGRA, size[0], size[1]);
+        bgra.FillRandom(7);
+        for (CscFormat format : {CscFormat::CSC_FORMAT_NV12, CscFormat::CSC_FORMAT_I420})
+        {
+            MRDA_CHECK(ConvertAll(bgra, format, [&](TestImage &yuv, CscIsa isa) {
+                int maxLuma = 0, maxChroma = 0;
+                MRDA_CHECK(CheckToYuv(bgra, yuv, maxLuma, maxChroma) == 0);
+                printf("  %dx%d bgra to %s, %s: max diff luma %d, chroma %d\n", size[0], size[1],
+                       FormatName(format), IsaName(isa), maxLuma, maxChroma);
+                return 0;
+            }) == 0);
+        }
+    }
+    return 0;
+}
+
+//!
+//! \brief NV12 and I420 to BGRA
+//!
+static int TestYuvToBgra()
+{
+    for (auto &size : TEST_SIZES)
+    {
+        for (CscFormat format : {CscFormat::CSC_FORMAT_NV12, CscFormat::CSC_FORMAT_I420})
+        {
+            TestImage yuv(format, size[0], size[1]);
+            yuv.FillRandom(11);
+            MRDA_CHECK(ConvertAll(yuv, CscFormat::CSC_FORMAT_BGRA, [&](TestImage &bgra, CscIsa isa) {
+                int maxRgb = 0;
+                MRDA_CHECK(CheckToBgra(yuv, bgra, maxRgb) == 0);
+                printf("  %dx%d %s to bgra, %s: max diff %d\n", size[0], size[1], FormatName(format), IsaName(isa), maxRgb);
+                return 0;
+            }) == 0);
+        }
+    }
+    return 0;
+}
+
+//!
+//! \brief NV12 and I420 into each other and same format copies are exact
+//!
+static int TestExactConversions()
+{
+    const CscFormat formats[] = {CscFormat::CSC_FORMAT_NV12, CscFormat::CSC_FORMAT_I420, CscFormat::CSC_FORMAT_BGRA};
+    for (auto &size : TEST_SIZES)
+    {
+        for (CscFormat in : formats)
+        {
+            TestImage src(in, size[0], size[1]);
+            src.FillRandom(13);
+            for (CscFormat out : formats)
+            {
+                bool rgb = in == CscFormat::CSC_FORMAT_BGRA || out == CscFormat::CSC_FORMAT_BGRA;
+                if (rgb && in != out) continue;
+                MRDA_CHECK(ConvertAll(src, out, [&](TestImage &dst, CscIsa) {
+                    for (int y = 0; y < size[1]; y++)
+                    {
+                        for (int x = 0; x < size[0]; x++)
+                        {
+                            if (rgb)
+                            {
+                                MRDA_CHECK(memcmp(&dst.At(0, x * 4, y), &src.At(0, x * 4, y), 4) == 0);
+                                continue;
+                            }
+                            MRDA_CHECK(dst.At(0, x, y) == src.At(0, x, y));
+                            MRDA_CHECK(dst.Chroma(0, x, y) == src.Chroma(0, x, y));
+                            MRDA_CHECK(dst.Chroma(1, x, y) == src.Chroma(1, x, y));
+                        }
+                    }
+                    return 0;
+                }) == 0);
+            }
+        }
+    }
+    return 0;
+}
+
+//!
+//! \brief Stripes converted one by one give the whole image
+//!
+static int TestStripes()
+{
+    int width = 131, height = 67;
+    TestImage bgra(CscFormat::CSC_FORMAT_BGRA, width, height);
+    bgra.FillRandom(17);
+    TestImage whole(CscFormat::CSC_FORMAT_NV12, width, height);
+    TestImage striped(CscFormat::CSC_FORMAT_NV12, width, height);
+    ColorConvert converter;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == converter.Convert(bgra.image, whole.image));
+    const int bounds[] = {0, 8, 30, 32, 66, height};
+    for (size_t i = 0; i + 1 < sizeof(bounds) / sizeof(bounds[0]); i++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == converter.ConvertRows(bgra.image, striped.image, bounds[i], bounds[i + 1]));
+    }
+    MRDA_CHECK(striped.SameAs(whole));
+    MRDA_CHECK(striped.GuardIntact());
+
+    // stripes start on even rows and stay inside the image
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == converter.ConvertRows(bgra.image, striped.image, 1, 8));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == converter.ConvertRows(bgra.image, striped.image, 8, height + 1));
+    MRDA_CHECK(!ColorConvert::IsSupported(CscFormat::CSC_FORMAT_NONE, CscFormat::CSC_FORMAT_NV12));
+    return 0;
+}
+
+int main()
+{
+    printf("cpu kernels: %s\n", IsaName(ColorConvert().Isa()));
+    const TestCase cases[] = {
+        {"BgraToYuv", TestBgraToYuv},
+        {"YuvToBgra", TestYuvToBgra},
+        {"ExactConversions", TestExactConversions},
+        {"Stripes", TestStripes},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
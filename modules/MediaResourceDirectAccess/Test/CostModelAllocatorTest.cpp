@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file CostModelAllocatorTest.cpp
+//! \brief session placement and refusal of the cost model on a simulated
+//!        device inventory
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/CostModelAllocator.h"
+
+#include <cmath>
+#include <vector>
+
+VDI_USE_MRDALib
+
+constexpr float COST_TOLERANCE = 1e-4f; //!< float rounding of the cost units
+
+static bool Near(float value, float expected)
+{
+    return std::fabs(value - expected) <= COST_TOLERANCE;
+}
+
+//!
+//! \brief device of the simulated inventory
+//!
+static DeviceLoad MakeDevice(DeviceType type, uint32_t id, float capacity, float usage = 0.0f)
+{
+    DeviceLoad device;
+    device.device = {type, id};
+    device.capacity = capacity;
+    device.usage = usage;
+    return device;
+}
+
+//!
+//! \brief Place one session and return the device it got
+//!
+static MRDAStatus Place(CostModelAllocatorStrategy &allocator, uint32_t taskId, TASKTYPE taskType, HWDevice &device)
+{
+    TaskInfo taskInfo;
+    taskInfo.taskType = taskType;
+    taskInfo.taskStatus = TASKStatus::TASK_STATUS_INITIALIZED;
+    taskInfo.taskID = taskId;
+    taskInfo.taskDevice = {DeviceType::NONE, 0};
+    MRDAStatus st = allocator.AllocateResource(&taskInfo);
+    device = taskInfo.taskDevice;
+    return st;
+}
+
+static bool IsDevice(const HWDevice &device, DeviceType type, uint32_t id)
+{
+    return device.deviceType == type && device.deviceID == id;
+}
+
+//!
+//! \brief encode params of a stream
+//!
+static MediaParams StreamParams(StreamCodecID codec, uint32_t width, uint32_t height, int32_t fps, TargetUsage targetUsage)
+{
+    MediaParams params = {};
+    params.encodeParams.codec_id = codec;
+    params.encodeParams.frame_width = width;
+    params.encodeParams.frame_height = height;
+    params.encodeParams.framerate_num = fps;
+    params.encodeParams.framerate_den = 1;
+    params.encodeParams.target_usage = targetUsage;
+    return params;
+}
+
+//!
+//! \brief cost units of common sessions
+//!
+static int TestEstimateCost()
+{
+    MediaParams avc = StreamParams(StreamCodecID::CodecID_AVC, 1920, 1080, 30, TargetUsage::Balanced);
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskOneVPLEncode, avc), 1.0f));
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskNullEncode, avc), 0.0f));
+
+    MediaParams hevc = StreamParams(StreamCodecID::CodecID_HEVC, 3840, 2160, 60, TargetUsage::Balanced);
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskFFmpegEncode, hevc), 12.0f));
+    MediaParams av1 = StreamParams(StreamCodecID::CodecID_AV1, 1920, 1080, 30, TargetUsage::BestQuality);
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskFFmpegEncode, av1), 3.0f));
+    MediaParams fast = StreamParams(StreamCodecID::CodecID_AVC, 1920, 1080, 30, TargetUsage::BestSpeed);
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskFFmpegEncode, fast), 0.7f));
+
+    // params not known yet fall back to 1080p30
+    MediaParams unknown = StreamParams(StreamCodecID::CodecID_AVC, 0, 0, 0, TargetUsage::Balanced);
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskOneVPLEncode, unknown), 1.0f));
+
+    MediaParams decode = {};
+    decode.decodeParams.codec_id = StreamCodecID::CodecID_HEVC;
+    decode.decodeParams.frame_width = 1920;
+    decode.decodeParams.frame_height = 1080;
+    decode.decodeParams.framerate_num = 60;
+    decode.decodeParams.framerate_den = 1;
+    MRDA_CHECK(Near(CostModelAllocatorStrategy::EstimateCost(TASKTYPE::taskFFmpegDecode, decode), 0.75f));
+    return 0;
+}
+
+//!
+//! \brief sessions spread over the GPUs, spill to the CPU once the GPUs are
+//!        full and are refused once nothing has room
+//!
+static int TestSpreadSpillRefuse()
+{
+    CostModelAllocatorStrategy allocator;
+    allocator.SetInventory({MakeDevice(DeviceType::GPU, 0, 4.0f), MakeDevice(DeviceType::GPU, 1, 4.0f),
+                            MakeDevice(DeviceType::CPU, 0, 1.0f)});
+    HWDevice device;
+    for (uint32_t taskId = 1; taskId <= 8; taskId++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, taskId, TASKTYPE::taskOneVPLEncode, device));
+        MRDA_CHECK(IsDevice(device, DeviceType::GPU, (taskId - 1) % 2));
+    }
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 9, TASKTYPE::taskFFmpegEncode, device));
+    MRDA_CHECK(IsDevice(device, DeviceType::CPU, 0));
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == Place(allocator, 10, TASKTYPE::taskFFmpegEncode, device));
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == Place(allocator, 10, TASKTYPE::taskFFmpegDecode, device));
+    // a synthetic session costs nothing and still runs
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 11, TASKTYPE::taskNullEncode, device));
+
+    MRDA_CHECK(MRDA_STATUS_INVALID_STATE == Place(allocator, 1, TASKTYPE::taskOneVPLEncode, device));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == allocator.AllocateResource(nullptr));
+
+    std::vector<DeviceLoad> inventory = allocator.GetInventory();
+    MRDA_CHECK(inventory.size() == 3);
+    MRDA_CHECK(Near(inventory[0].committed, 4.0f) && inventory[0].sessionNum == 5);
+    MRDA_CHECK(Near(inventory[1].committed, 4.0f) && inventory[1].sessionNum == 4);
+    MRDA_CHECK(Near(inventory[2].committed, 1.0f) && inventory[2].sessionNum == 1);
+
+    // a finished session frees room for the refused one
+    allocator.ReleaseResource(4);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 10, TASKTYPE::taskFFmpegEncode, device));
+    MRDA_CHECK(IsDevice(device, DeviceType::GPU, 1));
+    return 0;
+}
+
+//!
+//! \brief measured usage of other tenants steers sessions away
+//!
+static int TestMeasuredUsage()
+{
+    CostModelAllocatorStrategy allocator;
+    allocator.SetInventory({MakeDevice(DeviceType::GPU, 0, 4.0f, 80.0f), MakeDevice(DeviceType::GPU, 1, 4.0f)});
+    HWDevice device;
+    for (uint32_t taskId = 1; taskId <= 3; taskId++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, taskId, TASKTYPE::taskOneVPLEncode, device));
+        MRDA_CHECK(IsDevice(device, DeviceType::GPU, 1));
+    }
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 4, TASKTYPE::taskOneVPLEncode, device));
+    MRDA_CHECK(IsDevice(device, DeviceType::GPU, 0));
+
+    // a saturated device takes nothing however little is committed to it
+    PlacementConfig config;
+    config.maxLoad = 0.9f;
+    CostModelAllocatorStrategy busy(config);
+    busy.SetInventory({MakeDevice(DeviceType::GPU, 0, 16.0f, 95.0f)});
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == Place(busy, 1, TASKTYPE::taskOneVPLDecode, device));
+    return 0;
+}
+
+//!
+//! \brief the real cost replaces the reserved one only if the device takes it
+//!
+static int TestCommitRelease()
+{
+    CostModelAllocatorStrategy allocator;
+    allocator.SetInventory({MakeDevice(DeviceType::GPU, 0, 4.0f)});
+    HWDevice device;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 1, TASKTYPE::taskFFmpegEncode, device));
+
+    MediaParams uhd = StreamParams(StreamCodecID::CodecID_HEVC, 3840, 2160, 60, TargetUsage::Balanced);
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == allocator.CommitResource(1, uhd));
+    MRDA_CHECK(Near(allocator.GetInventory()[0].committed, 1.0f));
+
+    MediaParams hd60 = StreamParams(StreamCodecID::CodecID_HEVC, 1920, 1080, 60, TargetUsage::Balanced);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == allocator.CommitResource(1, hd60));
+    MRDA_CHECK(Near(allocator.GetInventory()[0].committed, 3.0f));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 2, TASKTYPE::taskFFmpegEncode, device));
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == Place(allocator, 3, TASKTYPE::taskFFmpegEncode, device));
+
+    // a cheaper commit always fits
+    MediaParams fast = StreamParams(StreamCodecID::CodecID_AVC, 1280, 720, 30, TargetUsage::BestSpeed);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == allocator.CommitResource(2, fast));
+    MRDA_CHECK(MRDA_STATUS_NOT_FOUND == allocator.CommitResource(3, fast));
+
+    allocator.ReleaseResource(1);
+    allocator.ReleaseResource(1);
+    allocator.ReleaseResource(3);
+    std::vector<DeviceLoad> inventory = allocator.GetInventory();
+    MRDA_CHECK(inventory[0].sessionNum == 1);
+    MRDA_CHECK(Near(inventory[0].committed, 0.7f * 1280 * 720 / (1920 * 1080)));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, 3, TASKTYPE::taskFFmpegEncode, device));
+    return 0;
+}
+
+//!
+//! \brief best fit packs a device before it opens the next one
+//!
+static int TestBestFit()
+{
+    PlacementConfig config;
+    config.policy = PlacementPolicy::BEST_FIT;
+    CostModelAllocatorStrategy allocator(config);
+    allocator.SetInventory({MakeDevice(DeviceType::GPU, 0, 4.0f), MakeDevice(DeviceType::GPU, 1, 4.0f)});
+    HWDevice device;
+    for (uint32_t taskId = 1; taskId <= 8; taskId++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(allocator, taskId, TASKTYPE::taskOneVPLEncode, device));
+        MRDA_CHECK(IsDevice(device, DeviceType::GPU, taskId <= 4 ? 0 : 1));
+    }
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == Place(allocator, 9, TASKTYPE::taskOneVPLEncode, device));
+
+    // without the GPU preference the CPU competes with the GPUs
+    config.policy = PlacementPolicy::LEAST_LOADED;
+    config.preferGPU = false;
+    CostModelAllocatorStrategy mixed(config);
+    mixed.SetInventory({MakeDevice(DeviceType::GPU, 0, 4.0f), MakeDevice(DeviceType::CPU, 0, 8.0f)});
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == Place(mixed, 1, TASKTYPE::taskFFmpegEncode, device));
+    MRDA_CHECK(IsDevice(device, DeviceType::CPU, 0));
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"EstimateCost", TestEstimateCost},
+        {"SpreadSpillRefuse", TestSpreadSpillRefuse},
+        {"MeasuredUsage", TestMeasuredUsage},
+        {"CommitRelease", TestCommitRelease},
+        {"BestFit", TestBestFit},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file DataPlaneBench.cpp
+//! \brief per frame round trip of the two data planes: a descriptor
+//!        through the submit and complete rings of two share memory
+//!        regions, and a BufferInfo message each way on a gRPC stream.
+//!        Guest and host run in separate processes, the host sends every
+//!        frame straight back so only the transport is measured.
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../SHMemory/ShmDescRing.h"
+#include "MRDAService.pb.h"
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/generic/generic_stub.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <functional>
+#include <string>
+
+VDI_USE_MRDALib
+
+constexpr uint32_t BENCH_FRAME_NUM = 20000;        //!< measured frames of each data plane
+constexpr uint32_t BENCH_WARMUP_NUM = 500;         //!< frames sent before measuring
+constexpr uint32_t BENCH_BUFFER_NUM = 8;           //!< buffers of each region
+constexpr uint32_t BENCH_WAIT_US = 5 * 1000 * 1000; //!< longest wait for the other process
+constexpr const char *BENCH_METHOD = "/MRDA.MRDAService/FrameRoundTrip"; //!< method of the echo stream
+
+//!
+//! \brief anonymous share memory region inherited by the forked host
+//!
+struct BenchRegion
+{
+    char *mem = nullptr;     //!< shared mapping
+    size_t size = 0;         //!< mapping size
+    ShmRegionLayout layout;  //!< layout read back from the header
+
+    ~BenchRegion()
+    {
+        if (mem != nullptr) munmap(mem, size);
+    }
+
+    MRDAStatus Create()
+    {
+        ShmRegionLayout owner;
+        MRDAStatus st = ShmComputeLayout(BENCH_BUFFER_NUM, 4096, 0, UINT32_MAX, false, owner);
+        if (MRDA_STATUS_SUCCESS != st) return st;
+        size = owner.dataOffset + owner.dataSize;
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) return MRDA_STATUS_OPERATION_FAIL;
+        mem = static_cast<char*>(ptr);
+        ShmWriteRegionHeader(mem, size, owner);
+        return ShmReadRegionHeader(mem, size, layout);
+    }
+};
+
+//!
+//! \brief forked host process, killed if the guest side fails first
+//!
+struct BenchHost
+{
+    pid_t pid = -1;
+
+    explicit BenchHost(const std::function<int()> &func)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            int ret = func();
+            fflush(stderr);
+            _exit(ret);
+        }
+    }
+
+    ~BenchHost()
+    {
+        if (pid > 0)
+        {
+            kill(pid, SIGKILL);
+            Wait();
+        }
+    }
+
+    //! \return int exit code of the host, -1 if it did not exit normally
+    int Wait()
+    {
+        int status = 0;
+        pid_t ret = waitpid(pid, &status, 0);
+        pid = -1;
+        return (ret > 0 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+    }
+};
+
+//!
+//! \brief frame the guest submits, the last one carries EOS
+//!
+static std::shared_ptr<FrameBufferData> BenchFrame(uint32_t n, bool eos)
+{
+    std::shared_ptr<FrameBufferData> frame = std::make_shared<FrameBufferData>();
+    std::shared_ptr<MemoryBuffer> memBuf = std::make_shared<MemoryBuffer>();
+    frame->SetMemBuffer(memBuf);
+    frame->SetEOS(eos);
+    frame->SetStreamType(InputStreamType::RAW);
+    frame->SetPts(n);
+    frame->SetWidth(1920);
+    frame->SetHeight(1080);
+    memBuf->SetBufId(n % BENCH_BUFFER_NUM + 1);
+    memBuf->SetMemOffset(65536 + (n % BENCH_BUFFER_NUM) * 4096);
+    memBuf->SetStateOffset(8192 + (n % BENCH_BUFFER_NUM) * 64);
+    memBuf->SetSize(4096);
+    memBuf->SetOccupiedSize(3000);
+    memBuf->SetState(BufferState::BUFFER_STATE_BUSY);
+    memBuf->SetPitch(1920 * 4);
+    return frame;
+}
+
+//!
+//! \brief same fields the gRPC sessions copy into a BufferInfo
+//!
+static void BenchMakeBufferInfo(std::shared_ptr<FrameBufferData> frame, MRDA::BufferInfo &info)
+{
+    std::shared_ptr<MemoryBuffer> memBuf = frame->MemBuffer();
+    MRDA::MemBuffer *mrda_memBuffer = info.mutable_buffer();
+    mrda_memBuffer->set_buf_id(memBuf->BufId());
+    mrda_memBuffer->set_state_offset(memBuf->StateOffset());
+    mrda_memBuffer->set_mem_offset(memBuf->MemOffset());
+    mrda_memBuffer->set_buf_size(memBuf->Size());
+    mrda_memBuffer->set_state(static_cast<int32_t>(memBuf->State()));
+    mrda_memBuffer->set_occupied_buf_size(memBuf->OccupiedSize());
+    mrda_memBuffer->set_pitch(memBuf->Pitch());
+    mrda_memBuffer->set_chain_num(memBuf->ChainNum());
+    mrda_memBuffer->set_chain_index(memBuf->ChainIndex());
+    info.set_width(frame->Width());
+    info.set_height(frame->Height());
+    info.set_type(static_cast<int32_t>(frame->StreamType()));
+    info.set_pts(frame->Pts());
+    info.set_iseos(frame->IsEOS());
+}
+
+//!
+//! \brief same fields the gRPC sessions copy back from a BufferInfo
+//!
+static std::shared_ptr<FrameBufferData> BenchMakeBufferInfoBack(const MRDA::BufferInfo &info)
+{
+    std::shared_ptr<FrameBufferData> frame = std::make_shared<FrameBufferData>();
+    std::shared_ptr<MemoryBuffer> memBuf = std::make_shared<MemoryBuffer>();
+    const MRDA::MemBuffer &mrda_memBuffer = info.buffer();
+    frame->SetWidth(info.width());
+    frame->SetHeight(info.height());
+    frame->SetStreamType(static_cast<InputStreamType>(info.type()));
+    frame->SetPts(info.pts());
+    frame->SetEOS(info.iseos());
+    memBuf->SetBufId(mrda_memBuffer.buf_id());
+    memBuf->SetMemOffset(mrda_memBuffer.mem_offset());
+    memBuf->SetStateOffset(mrda_memBuffer.state_offset());
+    memBuf->SetSize(mrda_memBuffer.buf_size());
+    memBuf->SetState(static_cast<BufferState>(mrda_memBuffer.state()));
+    memBuf->SetOccupiedSize(mrda_memBuffer.occupied_buf_size());
+    memBuf->SetPitch(mrda_memBuffer.pitch());
+    memBuf->SetChainNum(mrda_memBuffer.chain_num() > 0 ? mrda_memBuffer.chain_num() : 1);
+    memBuf->SetChainIndex(mrda_memBuffer.chain_index());
+    frame->SetMemBuffer(memBuf);
+    return frame;
+}
+
+//!
+//! \brief guest submits each frame on the input region's ring and waits
+//!        for the host to complete it on the output region's ring
+//!
+static int BenchDescRing()
+{
+    BenchRegion inRegion, outRegion;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == inRegion.Create());
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == outRegion.Create());
+    ShmDescRing submitRing, completeRing;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == submitRing.Attach(inRegion.mem, inRegion.layout));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == completeRing.Attach(outRegion.mem, outRegion.layout));
+    submitRing.Reset();
+    completeRing.Reset();
+
+    BenchHost host([&]() {
+        ShmDescRing submit, complete;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == submit.Attach(inRegion.mem, inRegion.layout));
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == complete.Attach(outRegion.mem, outRegion.layout));
+        std::shared_ptr<FrameBufferData> frame = std::make_shared<FrameBufferData>();
+        frame->SetMemBuffer(std::make_shared<MemoryBuffer>());
+        do
+        {
+            ShmDescriptor desc;
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == submit.Pop(desc, BENCH_WAIT_US));
+            ShmMakeFrame(desc, frame);
+            ShmMakeDescriptor(frame, desc);
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == complete.Push(desc, BENCH_WAIT_US));
+        } while (!frame->IsEOS());
+        return 0;
+    });
+
+    std::vector<uint64_t> samples;
+    samples.reserve(BENCH_FRAME_NUM);
+    std::shared_ptr<FrameBufferData> out = std::make_shared<FrameBufferData>();
+    out->SetMemBuffer(std::make_shared<MemoryBuffer>());
+    for (uint32_t n = 0; n < BENCH_WARMUP_NUM + BENCH_FRAME_NUM; n++)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        ShmDescriptor desc;
+        ShmMakeDescriptor(BenchFrame(n, n + 1 == BENCH_WARMUP_NUM + BENCH_FRAME_NUM), desc);
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == submitRing.Push(desc, BENCH_WAIT_US));
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == completeRing.Pop(desc, BENCH_WAIT_US));
+        ShmMakeFrame(desc, out);
+        auto end = std::chrono::steady_clock::now();
+        MRDA_CHECK(out->Pts() == n);
+        if (n >= BENCH_WARMUP_NUM)
+        {
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+    }
+    MRDA_CHECK(host.Wait() == 0);
+    ReportLatency("descriptor ring round trip", samples);
+    return 0;
+}
+
+//!
+//! \brief wait for the one operation in flight on a completion queue
+//!
+static bool BenchNext(grpc::CompletionQueue &cq)
+{
+    void *tag = nullptr;
+    bool ok = false;
+    return cq.Next(&tag, &ok) && ok;
+}
+
+//!
+//! \brief host end of the gRPC stream, sends every BufferInfo straight back
+//!
+static int BenchGrpcHost(int portFd)
+{
+    grpc::AsyncGenericService service;
+    grpc::ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.RegisterAsyncGenericService(&service);
+    std::unique_ptr<grpc::ServerCompletionQueue> cq = builder.AddCompletionQueue();
+    std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+    MRDA_CHECK(server != nullptr && port > 0);
+    MRDA_CHECK(write(portFd, &port, sizeof(port)) == static_cast<ssize_t>(sizeof(port)));
+    close(portFd);
+
+    grpc::GenericServerContext ctx;
+    grpc::GenericServerAsyncReaderWriter stream(&ctx);
+    service.RequestCall(&ctx, &stream, cq.get(), cq.get(), &stream);
+    MRDA_CHECK(BenchNext(*cq));
+    bool eos = false;
+    while (!eos)
+    {
+        grpc::ByteBuffer request;
+        stream.Read(&request, &stream);
+        MRDA_CHECK(BenchNext(*cq));
+        MRDA::BufferInfo info;
+        MRDA_CHECK(grpc::SerializationTraits<MRDA::BufferInfo>::Deserialize(&request, &info).ok());
+        std::shared_ptr<FrameBufferData> frame = BenchMakeBufferInfoBack(info);
+        eos = frame->IsEOS();
+
+        MRDA::BufferInfo reply;
+        BenchMakeBufferInfo(frame, reply);
+        grpc::ByteBuffer response;
+        bool own = false;
+        MRDA_CHECK(grpc::SerializationTraits<MRDA::BufferInfo>::Serialize(reply, &response, &own).ok());
+        stream.Write(response, &stream);
+        MRDA_CHECK(BenchNext(*cq));
+    }
+    stream.Finish(grpc::Status::OK, &stream);
+    MRDA_CHECK(BenchNext(*cq));
+    server->Shutdown();
+    cq->Shutdown();
+    void *tag = nullptr;
+    bool ok = false;
+    while (cq->Next(&tag, &ok)) {}
+    return 0;
+}
+
+//!
+//! \brief guest writes each frame as a BufferInfo on a gRPC stream over
+//!        loopback TCP and waits for the host's reply, the same messages
+//!        SendInputData and ReceiveOutputData carry on their two streams
+//!
+static int BenchGrpc()
+{
+    int fds[2] = {-1, -1};
+    MRDA_CHECK(pipe(fds) == 0);
+    // fork before this process touches gRPC, neither side inherits its threads
+    BenchHost host([&]() {
+        close(fds[0]);
+        return BenchGrpcHost(fds[1]);
+    });
+    close(fds[1]);
+    int port = 0;
+    ssize_t ret = read(fds[0], &port, sizeof(port));
+    close(fds[0]);
+    MRDA_CHECK(ret == static_cast<ssize_t>(sizeof(port)) && port > 0);
+
+    std::shared_ptr<grpc::Channel> channel =
+        grpc::CreateChannel("127.0.0.1:" + std::to_string(port), grpc::InsecureChannelCredentials());
+    grpc::GenericStub stub(channel);
+    grpc::ClientContext ctx;
+    grpc::CompletionQueue cq;
+    std::unique_ptr<grpc::GenericClientAsyncReaderWriter> call = stub.PrepareCall(&ctx, BENCH_METHOD, &cq);
+    call->StartCall(&ctx);
+    MRDA_CHECK(BenchNext(cq));
+
+    std::vector<uint64_t> samples;
+    samples.reserve(BENCH_FRAME_NUM);
+    for (uint32_t n = 0; n < BENCH_WARMUP_NUM + BENCH_FRAME_NUM; n++)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        MRDA::BufferInfo info;
+        BenchMakeBufferInfo(BenchFrame(n, n + 1 == BENCH_WARMUP_NUM + BENCH_FRAME_NUM), info);
+        grpc::ByteBuffer request;
+        bool own = false;
+        MRDA_CHECK(grpc::SerializationTraits<MRDA::BufferInfo>::Serialize(info, &request, &own).ok());
+        call->Write(request, &ctx);
+        MRDA_CHECK(BenchNext(cq));
+        grpc::ByteBuffer response;
+        call->Read(&response, &ctx);
+        MRDA_CHECK(BenchNext(cq));
+        MRDA::BufferInfo reply;
+        MRDA_CHECK(grpc::SerializationTraits<MRDA::BufferInfo>::Deserialize(&response, &reply).ok());
+        std::shared_ptr<FrameBufferData> out = BenchMakeBufferInfoBack(reply);
+        auto end = std::chrono::steady_clock::now();
+        MRDA_CHECK(out->Pts() == n);
+        if (n >= BENCH_WARMUP_NUM)
+        {
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+        }
+    }
+    call->WritesDone(&ctx);
+    MRDA_CHECK(BenchNext(cq));
+    grpc::Status status;
+    call->Finish(&status, &ctx);
+    MRDA_CHECK(BenchNext(cq) && status.ok());
+    cq.Shutdown();
+    void *tag = nullptr;
+    bool ok = false;
+    while (cq.Next(&tag, &ok)) {}
+    MRDA_CHECK(host.Wait() == 0);
+    ReportLatency("gRPC stream round trip", samples);
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"DescRing", BenchDescRing},
+        {"gRPC", BenchGrpc},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file HostObjectPoolTest.cpp
+//! \brief recycling of pooled host objects across threads
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/HostObjectPool.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+VDI_USE_MRDALib
+
+//!
+//! \brief object written by its holder, checked by the next one
+//!
+struct PoolItem
+{
+    uint64_t values[16] = {};
+};
+
+//!
+//! \brief an object is reused only once no one holds it, reuse allocates
+//!        nothing and an object outlives its pool
+//!
+static int TestReuse()
+{
+    std::shared_ptr<PoolItem> kept;
+    {
+        HostObjectPool<PoolItem> pool(2);
+        std::shared_ptr<PoolItem> a = pool.Get();
+        std::shared_ptr<PoolItem> b = pool.Get();
+        MRDA_CHECK(a != nullptr && b != nullptr && a != b);
+        MRDA_CHECK(pool.AllocCount() == 2);
+
+        // beyond the bound objects are allocated and not recycled
+        std::shared_ptr<PoolItem> c = pool.Get();
+        MRDA_CHECK(c != a && c != b && pool.AllocCount() == 3);
+        c.reset();
+
+        PoolItem *first = a.get();
+        std::shared_ptr<PoolItem> copy = a;
+        a.reset();
+        std::shared_ptr<PoolItem> other = pool.Get();
+        MRDA_CHECK(other.get() != first);
+        other.reset();
+        copy.reset();
+        std::shared_ptr<PoolItem> again = pool.Get();
+        MRDA_CHECK(again.get() == first);
+        MRDA_CHECK(pool.AllocCount() == 4);
+        again.reset();
+        for (int i = 0; i < 1000; i++)
+        {
+            MRDA_CHECK(pool.Get() != nullptr);
+        }
+        MRDA_CHECK(pool.AllocCount() == 4);
+        kept = pool.Get();
+        kept->values[0] = 42;
+    }
+    MRDA_CHECK(kept->values[0] == 42);
+    return 0;
+}
+
+//!
+//! \brief objects go from the getting thread to another one that gives
+//!        them up, the next holder sees every write of the last one
+//!
+static int TestHandOff()
+{
+    constexpr uint32_t rounds = 200000;
+    HostObjectPool<PoolItem> pool(4);
+    std::vector<std::shared_ptr<PoolItem>> slots(rounds);
+    std::atomic<uint32_t> published(0);
+    std::atomic<uint32_t> failures(0);
+
+    std::thread consumer([&]() {
+        for (uint32_t n = 0; n < rounds; n++)
+        {
+            while (published.load(std::memory_order_acquire) <= n) std::this_thread::yield();
+            std::shared_ptr<PoolItem> item = std::move(slots[n]);
+            if (item->values[0] != n) failures++;
+            // the last writes before the object goes back to the pool
+            for (auto &value : item->values) value = UINT64_MAX;
+        }
+    });
+    for (uint32_t n = 0; n < rounds; n++)
+    {
+        std::shared_ptr<PoolItem> item = pool.Get();
+        for (auto &value : item->values)
+        {
+            if (value != 0 && value != UINT64_MAX) failures++;
+        }
+        for (auto &value : item->values) value = n;
+        slots[n] = std::move(item);
+        published.store(n + 1, std::memory_order_release);
+    }
+    consumer.join();
+    MRDA_CHECK(failures == 0);
+    MRDA_CHECK(pool.AllocCount() < rounds);
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"Reuse", TestReuse},
+        {"HandOff", TestHandOff},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file HostServiceSelectTest.cpp
+//! \brief service the factory builds for each task type and device
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/HostServiceSelect.h"
+
+VDI_USE_MRDALib
+
+//!
+//! \brief GPU encode tasks keep their codec library, CPU placed encode
+//!        tasks of any library run on the software encoders
+//!
+static int TestEncode()
+{
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskFFmpegEncode, DeviceType::GPU) == HostServiceKind::FFMPEG_ENCODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskOneVPLEncode, DeviceType::GPU) == HostServiceKind::VPL_ENCODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskEncode, DeviceType::GPU) == HostServiceKind::NONE);
+
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskFFmpegEncode, DeviceType::CPU) == HostServiceKind::FFMPEG_SW_ENCODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskOneVPLEncode, DeviceType::CPU) == HostServiceKind::FFMPEG_SW_ENCODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskEncode, DeviceType::CPU) == HostServiceKind::FFMPEG_SW_ENCODE);
+    return 0;
+}
+
+//!
+//! \brief GPU decode runs on VAAPI, CPU placed decode tasks of any
+//!        library run on the software decoders
+//!
+static int TestDecode()
+{
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskFFmpegDecode, DeviceType::GPU) == HostServiceKind::FFMPEG_DECODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskOneVPLDecode, DeviceType::GPU) == HostServiceKind::NONE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskDecode, DeviceType::GPU) == HostServiceKind::NONE);
+
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskFFmpegDecode, DeviceType::CPU) == HostServiceKind::FFMPEG_SW_DECODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskOneVPLDecode, DeviceType::CPU) == HostServiceKind::FFMPEG_SW_DECODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskDecode, DeviceType::CPU) == HostServiceKind::FFMPEG_SW_DECODE);
+    MRDA_CHECK(IsDecodeTask(TASKTYPE::taskDecode) && !IsEncodeTask(TASKTYPE::taskDecode));
+    return 0;
+}
+
+//!
+//! \brief synthetic encode needs no codec, so it runs where it is placed
+//!
+static int TestNullEncode()
+{
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskNullEncode, DeviceType::GPU) == HostServiceKind::NULL_ENCODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskNullEncode, DeviceType::CPU) == HostServiceKind::NULL_ENCODE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskNullEncode, DeviceType::NONE) == HostServiceKind::NULL_ENCODE);
+    return 0;
+}
+
+//!
+//! \brief a task without a device or a type gets no service
+//!
+static int TestUnplaced()
+{
+    MRDA_CHECK(SelectHostService(TASKTYPE::taskFFmpegEncode, DeviceType::NONE) == HostServiceKind::NONE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::NONE, DeviceType::GPU) == HostServiceKind::NONE);
+    MRDA_CHECK(SelectHostService(TASKTYPE::NONE, DeviceType::CPU) == HostServiceKind::NONE);
+    MRDA_CHECK(!IsEncodeTask(TASKTYPE::NONE) && !IsDecodeTask(TASKTYPE::NONE));
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"Encode", TestEncode},
+        {"Decode", TestDecode},
+        {"NullEncode", TestNullEncode},
+        {"Unplaced", TestUnplaced},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file HostTopologyTest.cpp
+//! \brief NUMA topology read from a fixture sys tree and the node a
+//!        session is bound to under each affinity policy
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/HostTopology.h"
+
+#include <ftw.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <string>
+
+VDI_USE_MRDALib
+
+//!
+//! \brief fixture root, removed with everything below it
+//!
+struct TestTree
+{
+    std::string root;
+
+    TestTree()
+    {
+        char path[] = "/tmp/mrda_topology_XXXXXX";
+        if (mkdtemp(path) != nullptr) root = path;
+    }
+    ~TestTree()
+    {
+        if (root.empty()) return;
+        nftw(root.c_str(), [](const char *path, const struct stat *, int, struct FTW *) {
+            return remove(path);
+        }, 16, FTW_DEPTH | FTW_PHYS);
+    }
+    //!
+    //! \brief Write a file below the root, creating its directories
+    //!
+    bool Write(const std::string &path, const std::string &content)
+    {
+        for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+        {
+            std::string dir = root + path.substr(0, pos);
+            if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+        }
+        FILE *fp = fopen((root + path).c_str(), "w");
+        if (fp == nullptr) return false;
+        bool ok = fputs(content.c_str(), fp) >= 0;
+        return fclose(fp) == 0 && ok;
+    }
+};
+
+//!
+//! \brief dual socket host with a memory only node and two render nodes
+//!
+static bool WriteDualSocket(TestTree &tree)
+{
+    return tree.Write("/sys/devices/system/node/node0/cpulist", "0-3,8-11\n")
+        && tree.Write("/sys/devices/system/node/node1/cpulist", "4-7,12-15\n")
+        && tree.Write("/sys/devices/system/node/node2/cpulist", "\n")
+        && tree.Write("/sys/devices/system/node/online", "0-2\n")
+        && tree.Write("/sys/devices/system/node/possible", "0-3\n")
+        && tree.Write("/sys/bus/pci/devices/0000:03:00.0/numa_node", "1\n")
+        && tree.Write("/sys/bus/pci/devices/0000:83:00.0/numa_node", "-1\n")
+        && tree.Write("/sys/bus/pci/devices/0000:84:00.0/numa_node", "7\n");
+}
+
+//!
+//! \brief sysfs cpulists in both directions, malformed ones are rejected
+//!
+static int TestCpuList()
+{
+    std::vector<uint32_t> cpus;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == HostTopology::ParseCpuList("8-9,0-2,5", cpus));
+    MRDA_CHECK((cpus == std::vector<uint32_t>{0, 1, 2, 5, 8, 9}));
+    MRDA_CHECK(HostTopology::FormatCpuList(cpus) == "0-2,5,8-9");
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == HostTopology::ParseCpuList("", cpus) && cpus.empty());
+    MRDA_CHECK(HostTopology::FormatCpuList(cpus).empty());
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == HostTopology::ParseCpuList("3-1", cpus));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == HostTopology::ParseCpuList("0-", cpus));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == HostTopology::ParseCpuList("0;1", cpus));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == HostTopology::ParseCpuList("a", cpus));
+    return 0;
+}
+
+//!
+//! \brief nodes and device locality of a dual socket host
+//!
+static int TestDiscover()
+{
+    TestTree tree;
+    MRDA_CHECK(!tree.root.empty());
+    MRDA_CHECK(WriteDualSocket(tree));
+    HostTopology topology(tree.root + "/");
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == topology.Discover());
+    MRDA_CHECK(topology.NodeNum() == 3);
+    const NumaNodeInfo *node = topology.GetNode(1);
+    MRDA_CHECK(node != nullptr && HostTopology::FormatCpuList(node->cpus) == "4-7,12-15");
+    node = topology.GetNode(2);
+    MRDA_CHECK(node != nullptr && node->cpus.empty());
+    MRDA_CHECK(topology.GetNode(3) == nullptr);
+
+    MRDA_CHECK(topology.GetDeviceNode("0000:03:00.0") == 1);
+    // no firmware locality, a node that does not exist, no such device
+    MRDA_CHECK(topology.GetDeviceNode("0000:83:00.0") == -1);
+    MRDA_CHECK(topology.GetDeviceNode("0000:84:00.0") == -1);
+    MRDA_CHECK(topology.GetDeviceNode("0000:00:02.0") == -1);
+    MRDA_CHECK(topology.GetDeviceNode("") == -1);
+    return 0;
+}
+
+//!
+//! \brief a kernel without node entries is one node holding every cpu
+//!
+static int TestNoNuma()
+{
+    TestTree tree;
+    MRDA_CHECK(!tree.root.empty());
+    HostTopology topology(tree.root);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == topology.Discover());
+    MRDA_CHECK(topology.NodeNum() == 1);
+    const NumaNodeInfo *node = topology.GetNode(0);
+    MRDA_CHECK(node != nullptr && node->cpus.size() == static_cast<size_t>(sysconf(_SC_NPROCESSORS_ONLN)));
+    // nothing to choose between, threads stay unbound
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::DEVICE, 0, 0) == -1);
+    return 0;
+}
+
+//!
+//! \brief each policy prefers its own node and falls back to the other,
+//!        nodes without cpus or unknown nodes bind nothing
+//!
+static int TestChooseNode()
+{
+    TestTree tree;
+    MRDA_CHECK(!tree.root.empty());
+    MRDA_CHECK(WriteDualSocket(tree));
+    HostTopology topology(tree.root);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == topology.Discover());
+
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::DEVICE, 1, 0) == 1);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::DEVICE, -1, 0) == 0);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::MEMORY, 1, 0) == 0);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::MEMORY, 1, -1) == 1);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::NONE, 1, 0) == -1);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::DEVICE, -1, -1) == -1);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::MEMORY, 0, 2) == -1);
+    MRDA_CHECK(topology.ChooseNode(AffinityPolicy::DEVICE, 5, 0) == -1);
+
+    // a node without cpus is refused before anything is bound
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == topology.BindThread(2));
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == topology.BindThread(5));
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"CpuList", TestCpuList},
+        {"Discover", TestDiscover},
+        {"NoNuma", TestNoNuma},
+        {"ChooseNode", TestChooseNode},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
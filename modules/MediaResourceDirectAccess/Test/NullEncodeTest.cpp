@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file NullEncodeTest.cpp
+//! \brief configuration and packet sizes of the synthetic encoder
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/EncodeService/NullEncode/NullPacketModel.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+VDI_USE_MRDALib
+
+static bool Near(float a, float b, float tolerance)
+{
+    return std::fabs(a - b) <= tolerance * std::fabs(b);
+}
+
+static void ClearNullEncodeEnv()
+{
+    unsetenv(NULL_SERVICE_US_ENV);
+    unsetenv(NULL_PACKET_BYTES_ENV);
+    unsetenv(NULL_KEY_RATIO_ENV);
+    unsetenv(NULL_PACKET_SPREAD_ENV);
+    unsetenv(NULL_READ_INPUT_ENV);
+}
+
+//!
+//! \brief a constant bit rate stream sets the mean packet size, other
+//!        streams keep the default
+//!
+static int TestConfigBitRate()
+{
+    EncodeParams encodeParams = {};
+    encodeParams.rc_mode = 1;
+    encodeParams.bit_rate = 4000;
+    encodeParams.framerate_num = 30;
+    encodeParams.framerate_den = 1;
+    NullEncodeConfig config = GetNullEncodeConfig(encodeParams);
+    MRDA_CHECK(config.packetBytes == 4000 * 1000 / 8 / 30);
+    MRDA_CHECK(config.serviceTimeUs == NULL_DEFAULT_SERVICE_US);
+    MRDA_CHECK(config.readInput);
+
+    encodeParams.framerate_num = 60000;
+    encodeParams.framerate_den = 1001;
+    MRDA_CHECK(GetNullEncodeConfig(encodeParams).packetBytes == 4000ull * 1000 / 8 * 1001 / 60000);
+
+    encodeParams.rc_mode = 0;
+    MRDA_CHECK(GetNullEncodeConfig(encodeParams).packetBytes == NULL_DEFAULT_PACKET_BYTES);
+    encodeParams.rc_mode = 1;
+    encodeParams.framerate_num = 0;
+    MRDA_CHECK(GetNullEncodeConfig(encodeParams).packetBytes == NULL_DEFAULT_PACKET_BYTES);
+    encodeParams.framerate_num = 30;
+    encodeParams.bit_rate = 0;
+    MRDA_CHECK(GetNullEncodeConfig(encodeParams).packetBytes == NULL_DEFAULT_PACKET_BYTES);
+    return 0;
+}
+
+//!
+//! \brief the host environment overrides the session, values a packet
+//!        size cannot use fall back to the defaults
+//!
+static int TestConfigEnv()
+{
+    EncodeParams encodeParams = {};
+    ClearNullEncodeEnv();
+    NullEncodeConfig config = GetNullEncodeConfig(encodeParams);
+    ApplyNullEncodeEnv(config);
+    MRDA_CHECK(config.packetBytes == NULL_DEFAULT_PACKET_BYTES);
+    MRDA_CHECK(config.keyRatio == NULL_DEFAULT_KEY_RATIO && config.spread == NULL_DEFAULT_PACKET_SPREAD);
+
+    setenv(NULL_SERVICE_US_ENV, "500", 1);
+    setenv(NULL_PACKET_BYTES_ENV, "1000", 1);
+    setenv(NULL_KEY_RATIO_ENV, "4.5", 1);
+    setenv(NULL_PACKET_SPREAD_ENV, "0", 1);
+    setenv(NULL_READ_INPUT_ENV, "0", 1);
+    config = GetNullEncodeConfig(encodeParams);
+    ApplyNullEncodeEnv(config);
+    MRDA_CHECK(config.serviceTimeUs == 500 && config.packetBytes == 1000);
+    MRDA_CHECK(config.keyRatio == 4.5f && config.spread == 0.0f && !config.readInput);
+
+    setenv(NULL_PACKET_BYTES_ENV, "8", 1);
+    setenv(NULL_KEY_RATIO_ENV, "0.5", 1);
+    setenv(NULL_PACKET_SPREAD_ENV, "-1", 1);
+    setenv(NULL_READ_INPUT_ENV, "1", 1);
+    config = GetNullEncodeConfig(encodeParams);
+    ApplyNullEncodeEnv(config);
+    MRDA_CHECK(config.packetBytes == NULL_DEFAULT_PACKET_BYTES);
+    MRDA_CHECK(config.keyRatio == NULL_DEFAULT_KEY_RATIO && config.spread == NULL_DEFAULT_PACKET_SPREAD);
+    MRDA_CHECK(config.readInput);
+
+    setenv(NULL_KEY_RATIO_ENV, "nan", 1);
+    config = GetNullEncodeConfig(encodeParams);
+    ApplyNullEncodeEnv(config);
+    MRDA_CHECK(config.keyRatio == NULL_DEFAULT_KEY_RATIO);
+    ClearNullEncodeEnv();
+    return 0;
+}
+
+//!
+//! \brief one key packet and the inter packets of a GOP average the
+//!        configured size
+//!
+static int TestGopSplit()
+{
+    NullEncodeConfig config = {0, 20000, 8.0f, 0.0f, true};
+    NullPacketModel model(1);
+    model.Initialize(config, 30);
+    MRDA_CHECK(model.GopSize() == 30);
+    MRDA_CHECK(model.IsKeyFrame(0) && model.IsKeyFrame(30) && !model.IsKeyFrame(1) && !model.IsKeyFrame(29));
+    MRDA_CHECK(Near(model.MeanSize(true), model.MeanSize(false) * 8.0f, 1e-5f));
+    MRDA_CHECK(Near((model.MeanSize(true) + 29 * model.MeanSize(false)) / 30, 20000.0f, 1e-5f));
+    // no spread draws the means themselves
+    MRDA_CHECK(model.NextPacketSize(true) == static_cast<uint64_t>(model.MeanSize(true)));
+    MRDA_CHECK(model.NextPacketSize(false) == static_cast<uint64_t>(model.MeanSize(false)));
+
+    // a GOP of 0 or 1 is all key packets of the mean size
+    model.Initialize(config, 0);
+    MRDA_CHECK(model.GopSize() == 1 && model.IsKeyFrame(0) && model.IsKeyFrame(7));
+    MRDA_CHECK(Near(model.MeanSize(true), 20000.0f, 1e-5f));
+    return 0;
+}
+
+//!
+//! \brief drawn sizes average the mean, stay in bounds and repeat per seed
+//!
+static int TestPacketSizes()
+{
+    NullEncodeConfig config = {0, 20000, 8.0f, NULL_DEFAULT_PACKET_SPREAD, true};
+    NullPacketModel model(7);
+    NullPacketModel same(7);
+    NullPacketModel other(8);
+    model.Initialize(config, 30);
+    same.Initialize(config, 30);
+    other.Initialize(config, 30);
+
+    const uint32_t frames = 30 * 2000;
+    uint64_t total = 0;
+    bool differs = false;
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        bool keyFrame = model.IsKeyFrame(i);
+        uint64_t size = model.NextPacketSize(keyFrame);
+        MRDA_CHECK(size == same.NextPacketSize(keyFrame));
+        differs |= size != other.NextPacketSize(keyFrame);
+        total += size;
+    }
+    MRDA_CHECK(differs);
+    MRDA_CHECK(Near(static_cast<float>(total) / frames, 20000.0f, 0.02f));
+
+    // a wide spread is cut at the minimum and at four times the mean
+    config.spread = 10.0f;
+    model.Initialize(config, 30);
+    bool floor = false;
+    bool ceiling = false;
+    for (uint32_t i = 0; i < 10000; i++)
+    {
+        uint64_t size = model.NextPacketSize(false);
+        MRDA_CHECK(size >= NULL_MIN_PACKET_BYTES && size <= static_cast<uint64_t>(model.MeanSize(false) * 4));
+        floor |= size == NULL_MIN_PACKET_BYTES;
+        ceiling |= size == static_cast<uint64_t>(model.MeanSize(false) * 4);
+    }
+    MRDA_CHECK(floor && ceiling);
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"ConfigBitRate", TestConfigBitRate},
+        {"ConfigEnv", TestConfigEnv},
+        {"GopSplit", TestGopSplit},
+        {"PacketSizes", TestPacketSizes},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ResourceTelemetryTest.cpp
+//! \brief host resource sampler reading a fixture proc and sys tree
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/ResourceTelemetry.h"
+
+#include <ftw.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+VDI_USE_MRDALib
+
+constexpr float USAGE_TOLERANCE = 0.01f; //!< float rounding of the smoothed usage
+
+//!
+//! \brief fixture root, removed with everything below it
+//!
+struct TestTree
+{
+    std::string root;
+
+    TestTree()
+    {
+        char path[] = "/tmp/mrda_telemetry_XXXXXX";
+        if (mkdtemp(path) != nullptr) root = path;
+    }
+    ~TestTree()
+    {
+        if (root.empty()) return;
+        nftw(root.c_str(), [](const char *path, const struct stat *, int, struct FTW *) {
+            return remove(path);
+        }, 16, FTW_DEPTH | FTW_PHYS);
+    }
+    //!
+    //! \brief Write a file below the root, creating its directories
+    //!
+    bool Write(const std::string &path, const std::string &content)
+    {
+        for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+        {
+            std::string dir = root + path.substr(0, pos);
+            if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+        }
+        FILE *fp = fopen((root + path).c_str(), "w");
+        if (fp == nullptr) return false;
+        bool ok = fputs(content.c_str(), fp) >= 0;
+        return fclose(fp) == 0 && ok;
+    }
+    //!
+    //! \brief Write /proc/stat of four cpus with the given total times
+    //!
+    bool WriteStat(uint64_t user, uint64_t system, uint64_t idle, uint64_t iowait)
+    {
+        std::string line = "cpu  " + std::to_string(user) + " 0 " + std::to_string(system) + " " +
+                           std::to_string(idle) + " " + std::to_string(iowait) + " 0 0 0 0 0\n";
+        for (int i = 0; i < 4; i++)
+        {
+            line += "cpu" + std::to_string(i) + " 1 0 1 1 0 0 0 0 0 0\n";
+        }
+        return Write("/proc/stat", line + "intr 12345\nctxt 6789\nbtime 1700000000\n");
+    }
+    //!
+    //! \brief Write the fdinfo of a drm client with one engine class
+    //!
+    bool WriteClient(const std::string &pidFd, const std::string &pdev, uint32_t clientId,
+                     const std::string &engine, uint64_t busyNs, uint32_t capacity)
+    {
+        std::string content = "pos:\t0\nflags:\t02100002\ndrm-driver:\ti915\n";
+        content += "drm-pdev:\t" + pdev + "\n";
+        content += "drm-client-id:\t" + std::to_string(clientId) + "\n";
+        content += "drm-engine-" + engine + ":\t" + std::to_string(busyNs) + " ns\n";
+        content += "drm-engine-capacity-" + engine + ":\t" + std::to_string(capacity) + "\n";
+        return Write("/proc/" + pidFd, content);
+    }
+};
+
+static bool Near(float value, float expected)
+{
+    return std::fabs(value - expected) <= USAGE_TOLERANCE;
+}
+
+//!
+//! \brief cpu times and memory of a host without accelerators
+//!
+static int TestCpuAndMemory()
+{
+    TestTree tree;
+    MRDA_CHECK(!tree.root.empty());
+    MRDA_CHECK(tree.WriteStat(100, 100, 700, 100));
+    MRDA_CHECK(tree.Write("/proc/meminfo", "MemTotal:       16384000 kB\nMemFree:         1024000 kB\n"
+                                           "MemAvailable:    8192000 kB\nBuffers:          102400 kB\n"));
+
+    TelemetryConfig config;
+    config.rootPath = tree.root + "/";
+    ResourceTelemetry telemetry(config);
+    ResourceSnapshot snapshot;
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == telemetry.GetSnapshot(snapshot));
+
+    // the first sample averages since boot: 200 busy of 1000
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.Sample());
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.GetSnapshot(snapshot));
+    MRDA_CHECK(snapshot.sampleNum == 1 && snapshot.cpuCores == 4);
+    MRDA_CHECK(Near(snapshot.cpuUsage, 20.0f));
+    MRDA_CHECK(snapshot.memTotalKB == 16384000 && snapshot.memAvailableKB == 8192000);
+    MRDA_CHECK(snapshot.gpus.empty());
+
+    // 300 busy of 1000 since, 0.3 * 30 + 0.7 * 20
+    MRDA_CHECK(tree.WriteStat(350, 150, 1300, 200));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.Sample());
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.GetSnapshot(snapshot));
+    MRDA_CHECK(snapshot.sampleNum == 2 && Near(snapshot.cpuUsage, 23.0f));
+
+    // no tick since the last sample keeps the smoothed value
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.Sample());
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.GetSnapshot(snapshot));
+    MRDA_CHECK(snapshot.sampleNum == 3 && Near(snapshot.cpuUsage, 23.0f));
+
+    // a broken file fails the sample and keeps the last snapshot
+    MRDA_CHECK(tree.Write("/proc/meminfo", "MemTotal:       16384000 kB\n"));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS != telemetry.Sample());
+    MRDA_CHECK(tree.Write("/proc/stat", "intr 12345\n"));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS != telemetry.Sample());
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.GetSnapshot(snapshot));
+    MRDA_CHECK(snapshot.sampleNum == 3 && snapshot.memAvailableKB == 8192000);
+    return 0;
+}
+
+//!
+//! \brief render nodes of sysfs and the engine time of the drm clients
+//!
+static int TestGpu()
+{
+    const std::string gpu0 = "0000:03:00.0";
+    const std::string gpu1 = "0000:04:00.0";
+    TestTree tree;
+    MRDA_CHECK(!tree.root.empty());
+    MRDA_CHECK(tree.WriteStat(100, 100, 700, 100));
+    MRDA_CHECK(tree.Write("/proc/meminfo", "MemTotal: 1000 kB\nMemAvailable: 500 kB\n"));
+    MRDA_CHECK(tree.Write("/sys/class/drm/renderD129/device/uevent", "DRIVER=i915\nPCI_CLASS=30000\nPCI_SLOT_NAME=" + gpu1 + "\n"));
+    MRDA_CHECK(tree.Write("/sys/class/drm/renderD128/device/uevent", "DRIVER=i915\nPCI_CLASS=30000\nPCI_SLOT_NAME=" + gpu0 + "\n"));
+    MRDA_CHECK(tree.Write("/sys/class/drm/renderD130/device/uevent", "DRIVER=ast\nPCI_SLOT_NAME=0000:05:00.0\n"));
+    MRDA_CHECK(tree.Write("/sys/class/drm/card0/device/uevent", "DRIVER=i915\nPCI_SLOT_NAME=" + gpu0 + "\n"));
+    MRDA_CHECK(tree.Write("/proc/self/fdinfo/3", "drm-pdev:\t" + gpu0 + "\ndrm-client-id:\t99\ndrm-engine-video:\t1 ns\n"));
+
+    // a client of gpu0 on two fds, one of gpu1 on a two engine class
+    MRDA_CHECK(tree.WriteClient("100/fdinfo/5", gpu0, 7, "video", 1000, 1));
+    MRDA_CHECK(tree.WriteClient("100/fdinfo/6", gpu0, 7, "video", 1000, 1));
+    MRDA_CHECK(tree.WriteClient("200/fdinfo/4", gpu1, 8, "render", 5000, 2));
+    MRDA_CHECK(tree.WriteClient("200/fdinfo/9", gpu1, 8, "render", 5000, 2));
+
+    TelemetryConfig config;
+    config.rootPath = tree.root;
+    ResourceTelemetry telemetry(config);
+    auto before = std::chrono::steady_clock::now();
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.Sample());
+    auto sampled = std::chrono::steady_clock::now();
+
+    ResourceSnapshot snapshot;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.GetSnapshot(snapshot));
+    MRDA_CHECK(snapshot.gpus.size() == 2);
+    MRDA_CHECK(snapshot.gpus[0].id == 0 && snapshot.gpus[0].pciSlot == gpu0);
+    MRDA_CHECK(snapshot.gpus[1].id == 1 && snapshot.gpus[1].pciSlot == gpu1);
+    MRDA_CHECK(snapshot.gpus[0].driver == ACCResourceDriver::I915DRIVER);
+    // nothing to compare the engine time with yet
+    MRDA_CHECK(snapshot.gpus[0].usage == 0.0f && snapshot.gpus[1].usage == 0.0f);
+
+    // gpu0 saturated, gpu1 busy for 100 ms on one of its two engines
+    constexpr uint64_t busyNs = 100 * 1000 * 1000;
+    MRDA_CHECK(tree.WriteClient("100/fdinfo/5", gpu0, 7, "video", 1000ULL * 1000 * 1000 * 1000, 1));
+    MRDA_CHECK(tree.WriteClient("100/fdinfo/6", gpu0, 7, "video", 1000ULL * 1000 * 1000 * 1000, 1));
+    MRDA_CHECK(tree.WriteClient("200/fdinfo/4", gpu1, 8, "render", 5000 + busyNs, 2));
+    MRDA_CHECK(tree.WriteClient("200/fdinfo/9", gpu1, 8, "render", 5000 + busyNs, 2));
+    usleep(busyNs / 1000);
+    auto resample = std::chrono::steady_clock::now();
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.Sample());
+    auto after = std::chrono::steady_clock::now();
+
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == telemetry.GetSnapshot(snapshot));
+    MRDA_CHECK(snapshot.gpus.size() == 2);
+    MRDA_CHECK(Near(snapshot.gpus[0].usage, TELEMETRY_EWMA_ALPHA * 100.0f));
+    // the wall time between the samples is only known within bounds
+    float minElapsed = std::chrono::duration<float>(resample - sampled).count();
+    float maxElapsed = std::chrono::duration<float>(after - before).count();
+    float busy = static_cast<float>(busyNs) / 1e9f;
+    float minUsage = TELEMETRY_EWMA_ALPHA * 100.0f * busy / (maxElapsed * 2);
+    float maxUsage = TELEMETRY_EWMA_ALPHA * 100.0f * busy / (minElapsed * 2);
+    MRDA_CHECK(snapshot.gpus[1].usage >= minUsage - USAGE_TOLERANCE);
+    MRDA_CHECK(snapshot.gpus[1].usage <= maxUsage + USAGE_TOLERANCE);
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"CpuAndMemory", TestCpuAndMemory},
+        {"Gpu", TestGpu},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file SWCodecParamsTest.cpp
+//! \brief session parameters mapped to the settings of the FFmpeg
+//!        software codecs, checked without FFmpeg
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../HostService/EncodeService/FFmpegEncode/SWEncodeOptions.h"
+#include "../HostService/DecodeService/FFmpegDecode/SWDecodeThreading.h"
+
+#include <string>
+
+VDI_USE_MRDALib
+
+//!
+//! \brief value of an option, empty if it is not set
+//!
+static std::string OptionValue(const SWEncodeOptionList &options, const std::string &name)
+{
+    for (auto &option : options)
+    {
+        if (option.first == name) return option.second;
+    }
+    return "";
+}
+
+//!
+//! \brief encode parameters of a 1080p session
+//!
+static EncodeParams TestEncodeParams(StreamCodecID codecId, TargetUsage targetUsage, uint32_t rcMode)
+{
+    EncodeParams encodeParams = {};
+    encodeParams.codec_id = codecId;
+    encodeParams.target_usage = targetUsage;
+    encodeParams.rc_mode = rcMode;
+    encodeParams.qp = 26;
+    encodeParams.bit_rate = 5000;
+    encodeParams.async_depth = 4;
+    encodeParams.max_b_frames = 0;
+    encodeParams.frame_width = 1920;
+    encodeParams.frame_height = 1080;
+    return encodeParams;
+}
+
+static int TestEncoderName()
+{
+    MRDA_CHECK(GetSWEncoderName(StreamCodecID::CodecID_AVC) == "libx264");
+    MRDA_CHECK(GetSWEncoderName(StreamCodecID::CodecID_HEVC) == "libx265");
+    MRDA_CHECK(GetSWEncoderName(StreamCodecID::CodecID_AV1) == "libsvtav1");
+    MRDA_CHECK(GetSWEncoderName(StreamCodecID::CodecID_NONE).empty());
+    return 0;
+}
+
+//!
+//! \brief target usage picks the preset of each encoder family
+//!
+static int TestEncodePreset()
+{
+    const TargetUsage usages[] = {TargetUsage::BestQuality, TargetUsage::Balanced, TargetUsage::BestSpeed};
+    const char *x26xPresets[] = {"medium", "veryfast", "ultrafast"};
+    const char *svtPresets[] = {"8", "10", "12"};
+    SWEncodeOptionList options;
+    for (int i = 0; i < 3; i++)
+    {
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AVC, usages[i], 0), options));
+        MRDA_CHECK(options.front().first == "preset" && options.front().second == x26xPresets[i]);
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_HEVC, usages[i], 0), options));
+        MRDA_CHECK(options.front().first == "preset" && options.front().second == x26xPresets[i]);
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AV1, usages[i], 0), options));
+        MRDA_CHECK(options.front().first == "preset" && options.front().second == svtPresets[i]);
+    }
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AVC, TargetUsage::Unknown, 0), options));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_NONE, TargetUsage::Balanced, 0), options));
+    return 0;
+}
+
+//!
+//! \brief cqp sets the qp, cbr the hrd or rate control mode, lookahead is
+//!        always off and async depth sets the frame threads
+//!
+static int TestEncodeRateControl()
+{
+    SWEncodeOptionList options;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AVC, TargetUsage::Balanced, 0), options));
+    MRDA_CHECK(OptionValue(options, "qp") == "26" && OptionValue(options, "nal-hrd").empty());
+    MRDA_CHECK(OptionValue(options, "x264-params") == "rc-lookahead=0:sync-lookahead=0:sliced-threads=0");
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AVC, TargetUsage::Balanced, 1), options));
+    MRDA_CHECK(OptionValue(options, "qp").empty() && OptionValue(options, "nal-hrd") == "cbr");
+    // the params string goes last, after the options it may depend on
+    MRDA_CHECK(options.back().first == "x264-params");
+
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_HEVC, TargetUsage::Balanced, 0), options));
+    MRDA_CHECK(OptionValue(options, "profile") == "main" && OptionValue(options, "qp") == "26");
+    MRDA_CHECK(OptionValue(options, "x265-params") == "rc-lookahead=0:bframes=0:frame-threads=4");
+    EncodeParams hevc = TestEncodeParams(StreamCodecID::CodecID_HEVC, TargetUsage::Balanced, 1);
+    hevc.async_depth = 0;
+    hevc.max_b_frames = 2;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(hevc, options));
+    MRDA_CHECK(OptionValue(options, "qp").empty());
+    MRDA_CHECK(OptionValue(options, "x265-params") == "rc-lookahead=0:bframes=2");
+
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AV1, TargetUsage::Balanced, 0), options));
+    MRDA_CHECK(OptionValue(options, "qp") == "26");
+    MRDA_CHECK(OptionValue(options, "svtav1-params") == "pred-struct=1:rc=0:lp=4");
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWEncodeOptions(TestEncodeParams(StreamCodecID::CodecID_AV1, TargetUsage::Balanced, 1), options));
+    MRDA_CHECK(OptionValue(options, "qp").empty());
+    MRDA_CHECK(OptionValue(options, "svtav1-params") == "pred-struct=1:rc=2:lp=4");
+    return 0;
+}
+
+//!
+//! \brief decode parameters of a session at a resolution
+//!
+static DecodeParams TestDecodeParams(uint32_t width, uint32_t height, DecodeThreadMode mode, uint32_t threadNum)
+{
+    DecodeParams decodeParams = {};
+    decodeParams.codec_id = StreamCodecID::CodecID_AVC;
+    decodeParams.frame_width = width;
+    decodeParams.frame_height = height;
+    decodeParams.thread_mode = mode;
+    decodeParams.thread_num = threadNum;
+    return decodeParams;
+}
+
+//!
+//! \brief the thread number follows the resolution unless the session
+//!        sets one, and never exceeds the cpus
+//!
+static int TestDecodeThreadNum()
+{
+    SWDecodeThreading threading;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_AUTO, 0), 16, threading));
+    MRDA_CHECK(threading.threadNum == 4);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(3840, 2160, DecodeThreadMode::DECODE_THREAD_AUTO, 0), 16, threading));
+    MRDA_CHECK(threading.threadNum == 16);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(3840, 2160, DecodeThreadMode::DECODE_THREAD_AUTO, 0), 6, threading));
+    MRDA_CHECK(threading.threadNum == 6);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(320, 240, DecodeThreadMode::DECODE_THREAD_AUTO, 0), 16, threading));
+    MRDA_CHECK(threading.threadNum == 1);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(0, 0, DecodeThreadMode::DECODE_THREAD_AUTO, 0), 16, threading));
+    MRDA_CHECK(threading.threadNum == 1);
+
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_AUTO, 2), 16, threading));
+    MRDA_CHECK(threading.threadNum == 2);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_AUTO, 64), 16, threading));
+    MRDA_CHECK(threading.threadNum == 16);
+    // a host reporting no cpus still decodes on one thread
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_AUTO, 8), 0, threading));
+    MRDA_CHECK(threading.threadNum == 1);
+    return 0;
+}
+
+//!
+//! \brief each thread mode enables its threading, slice mode adds low delay
+//!
+static int TestDecodeThreadMode()
+{
+    SWDecodeThreading threading;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_AUTO, 0), 16, threading));
+    MRDA_CHECK(threading.frameThreads && threading.sliceThreads && !threading.lowDelay);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_FRAME, 0), 16, threading));
+    MRDA_CHECK(threading.frameThreads && !threading.sliceThreads && !threading.lowDelay);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == GetSWDecodeThreading(TestDecodeParams(1920, 1080, DecodeThreadMode::DECODE_THREAD_SLICE, 0), 16, threading));
+    MRDA_CHECK(!threading.frameThreads && threading.sliceThreads && threading.lowDelay);
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == GetSWDecodeThreading(
+        TestDecodeParams(1920, 1080, static_cast<DecodeThreadMode>(7), 0), 16, threading));
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"EncoderName", TestEncoderName},
+        {"EncodePreset", TestEncodePreset},
+        {"EncodeRateControl", TestEncodeRateControl},
+        {"DecodeThreadNum", TestDecodeThreadNum},
+        {"DecodeThreadMode", TestDecodeThreadMode},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,581 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file ShmRegionTest.cpp
+//! \brief share memory region primitives used by guest and host, each
+//!        side runs in its own process on one shared mapping
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../SHMemory/ShmBufferIndex.h"
+#include "../SHMemory/ShmDescRing.h"
+#include "../HostService/ShmByteRing.h"
+
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <set>
+
+VDI_USE_MRDALib
+
+constexpr uint32_t TEST_WAIT_US = 5 * 1000 * 1000; //!< longest wait for the other process
+
+//!
+//! \brief share memory region laid out by its owner and read back the way
+//!        the other side attaches it
+//!
+struct TestRegion
+{
+    char *mem = nullptr;     //!< shared mapping, inherited by forked children
+    size_t size = 0;         //!< mapping size
+    ShmRegionLayout layout;  //!< layout read back from the header
+
+    ~TestRegion()
+    {
+        if (mem != nullptr) munmap(mem, size);
+    }
+
+    MRDAStatus Create(uint32_t bufferNum, uint64_t bufferSize, size_t regionSize, bool byteRing)
+    {
+        // fixed slots size the region from the layout
+        ShmRegionLayout owner;
+        uint64_t maxSize = byteRing ? regionSize : UINT32_MAX;
+        MRDAStatus st = ShmComputeLayout(bufferNum, bufferSize, 0, maxSize, byteRing, owner);
+        if (MRDA_STATUS_SUCCESS != st) return st;
+        size = byteRing ? regionSize : owner.dataOffset + owner.dataSize;
+        void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) return MRDA_STATUS_OPERATION_FAIL;
+        mem = static_cast<char*>(ptr);
+        ShmWriteRegionHeader(mem, size, owner);
+        return ShmReadRegionHeader(mem, size, layout);
+    }
+
+    std::atomic<uint32_t> *State(uint32_t bufId)
+    {
+        return reinterpret_cast<std::atomic<uint32_t>*>(mem + layout.StateOffset(bufId));
+    }
+};
+
+//!
+//! \brief pipe between parent and child for the messages the descriptor
+//!        ring or gRPC would carry
+//!
+struct TestPipe
+{
+    int fds[2] = {-1, -1};
+
+    TestPipe() { if (pipe(fds) != 0) fds[0] = fds[1] = -1; }
+    ~TestPipe() { CloseRead(); CloseWrite(); }
+
+    void CloseRead() { if (fds[0] >= 0) close(fds[0]); fds[0] = -1; }
+    void CloseWrite() { if (fds[1] >= 0) close(fds[1]); fds[1] = -1; }
+
+    template <typename T>
+    bool Write(const T &msg)
+    {
+        return write(fds[1], &msg, sizeof(T)) == static_cast<ssize_t>(sizeof(T));
+    }
+
+    template <typename T>
+    bool Read(T &msg)
+    {
+        char *ptr = reinterpret_cast<char*>(&msg);
+        size_t done = 0;
+        while (done < sizeof(T))
+        {
+            ssize_t ret = read(fds[0], ptr + done, sizeof(T) - done);
+            if (ret <= 0) return false;
+            done += static_cast<size_t>(ret);
+        }
+        return true;
+    }
+};
+
+//!
+//! \brief child process running one side, killed if the parent side fails
+//!        before waiting for it
+//!
+struct TestChild
+{
+    pid_t pid = -1;
+
+    explicit TestChild(const std::function<int()> &func)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            int ret = func();
+            fflush(stderr);
+            _exit(ret);
+        }
+    }
+
+    ~TestChild()
+    {
+        if (pid > 0)
+        {
+            kill(pid, SIGKILL);
+            Wait();
+        }
+    }
+
+    //! \return int exit code of the child, -1 if it did not exit normally
+    int Wait()
+    {
+        int status = 0;
+        pid_t ret = waitpid(pid, &status, 0);
+        pid = -1;
+        return (ret > 0 && WIFEXITED(status)) ? WEXITSTATUS(status) : -1;
+    }
+};
+
+//!
+//! \brief one side drains a multi word index, the other releases into it
+//!
+static int TestIndexAcquireRelease()
+{
+    constexpr uint32_t bufferNum = 130; // two full free words and a partial one
+    TestRegion region;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == region.Create(bufferNum, 4096, 0, false));
+    ShmBufferIndex index;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Attach(region.mem, region.layout.bufferNum));
+    index.Reset();
+
+    TestPipe ids;
+    MRDA_CHECK(ids.fds[0] >= 0);
+    TestChild child([&region, &ids]() {
+        ids.CloseRead();
+        ShmBufferIndex guest;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Attach(region.mem, region.layout.bufferNum));
+        uint32_t bufId = 0;
+        for (uint32_t i = 0; i < bufferNum; i++)
+        {
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Acquire(bufId));
+            MRDA_CHECK(ids.Write(bufId));
+        }
+        MRDA_CHECK(MRDA_STATUS_NOT_READY == guest.Acquire(bufId));
+        // woken by the release of the other process
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.AcquireWait(bufId, TEST_WAIT_US));
+        MRDA_CHECK(ids.Write(bufId));
+        return 0;
+    });
+    ids.CloseWrite();
+
+    std::set<uint32_t> taken;
+    uint32_t bufId = 0;
+    for (uint32_t i = 0; i < bufferNum; i++)
+    {
+        MRDA_CHECK(ids.Read(bufId));
+        MRDA_CHECK(bufId >= 1 && bufId <= bufferNum);
+        MRDA_CHECK(taken.insert(bufId).second);
+    }
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Release(77));
+    MRDA_CHECK(ids.Read(bufId));
+    MRDA_CHECK(bufId == 77);
+    MRDA_CHECK(child.Wait() == 0);
+
+    ShmRegionHeader *header = reinterpret_cast<ShmRegionHeader*>(region.mem);
+    MRDA_CHECK(header->producerCount.load() == bufferNum + 1);
+    MRDA_CHECK(header->consumerCount.load() == 1);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Release(77));
+    MRDA_CHECK(MRDA_STATUS_INVALID_STATE == index.Release(77));
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == index.Release(0));
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == index.Release(bufferNum + 1));
+
+    // an unused buffer given back is neither counted nor wakes a waiter
+    uint32_t seq = index.ReleaseSequence();
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Acquire(bufId) && bufId == 77);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Restore(bufId));
+    MRDA_CHECK(MRDA_STATUS_INVALID_STATE == index.Restore(bufId));
+    MRDA_CHECK(index.ReleaseSequence() == seq);
+    MRDA_CHECK(!index.WaitRelease(seq, 1000));
+    MRDA_CHECK(header->producerCount.load() == bufferNum + 1);
+    MRDA_CHECK(header->consumerCount.load() == 2);
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Acquire(bufId) && bufId == 77);
+    return 0;
+}
+
+//!
+//! \brief buffers go round between two processes, a buffer is never held
+//!        by both sides at once
+//!
+static int TestIndexPingPong()
+{
+    constexpr uint32_t bufferNum = 8;
+    constexpr uint32_t rounds = 20000;
+    TestRegion region;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == region.Create(bufferNum, 4096, 0, false));
+    ShmBufferIndex index;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Attach(region.mem, region.layout.bufferNum));
+    index.Reset();
+    // owner flag per buffer in a slot nobody else writes
+    std::atomic<uint32_t> *owner = reinterpret_cast<std::atomic<uint32_t>*>(region.mem + region.layout.MemOffset(1));
+
+    TestPipe ids;
+    MRDA_CHECK(ids.fds[0] >= 0);
+    TestChild child([&]() {
+        ids.CloseRead();
+        ShmBufferIndex guest;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Attach(region.mem, region.layout.bufferNum));
+        for (uint32_t i = 0; i < rounds; i++)
+        {
+            uint32_t bufId = 0;
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.AcquireWait(bufId, TEST_WAIT_US));
+            uint32_t expected = 0;
+            MRDA_CHECK(owner[bufId].compare_exchange_strong(expected, 1));
+            MRDA_CHECK(ids.Write(bufId));
+        }
+        return 0;
+    });
+    ids.CloseWrite();
+
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        uint32_t bufId = 0;
+        MRDA_CHECK(ids.Read(bufId));
+        MRDA_CHECK(bufId >= 1 && bufId <= bufferNum);
+        uint32_t expected = 1;
+        MRDA_CHECK(owner[bufId].compare_exchange_strong(expected, 0));
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Release(bufId));
+    }
+    MRDA_CHECK(child.Wait() == 0);
+    return 0;
+}
+
+//!
+//! \brief range of the byte ring handed to the guest
+//!
+struct RingPacket
+{
+    uint32_t bufId;
+    uint32_t seq;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static uint8_t PacketByte(uint32_t seq, uint64_t i)
+{
+    return static_cast<uint8_t>(seq * 131 + i * 7);
+}
+
+//!
+//! \brief host fills variable sized packets into the byte ring as the
+//!        encoder does, the guest checks and releases them
+//!
+static int TestByteRingAcrossProcesses()
+{
+    constexpr uint32_t bufferNum = 16;
+    constexpr uint32_t packetNum = 5000;
+    constexpr uint64_t maxPacket = 6000;
+    TestRegion region;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == region.Create(bufferNum, maxPacket, 96 * 1024, true));
+    MRDA_CHECK(region.layout.IsByteRing());
+    ShmBufferIndex index;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Attach(region.mem, region.layout.bufferNum));
+    index.Reset();
+    ShmByteRing ring;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == ring.Init(region.mem, region.layout));
+    MRDA_CHECK(ring.Capacity() == region.layout.dataSize);
+
+    TestPipe packets;
+    MRDA_CHECK(packets.fds[0] >= 0);
+    TestChild child([&]() {
+        packets.CloseWrite();
+        ShmBufferIndex guest;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Attach(region.mem, region.layout.bufferNum));
+        for (uint32_t n = 0; n < packetNum; n++)
+        {
+            RingPacket packet;
+            MRDA_CHECK(packets.Read(packet));
+            MRDA_CHECK(packet.seq == n);
+            MRDA_CHECK(region.State(packet.bufId)->load() == static_cast<uint32_t>(BufferState::BUFFER_STATE_BUSY));
+            const uint8_t *data = reinterpret_cast<const uint8_t*>(region.mem + packet.offset);
+            for (uint64_t i = 0; i < packet.size; i++)
+            {
+                MRDA_CHECK(data[i] == PacketByte(packet.seq, i));
+            }
+            // state first, the host reclaims ranges of idle buffers
+            ShmStoreState(region.State(packet.bufId), BufferState::BUFFER_STATE_IDLE);
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Release(packet.bufId));
+        }
+        return 0;
+    });
+    packets.CloseRead();
+
+    uint64_t dataEnd = region.layout.dataOffset + region.layout.dataSize;
+    std::map<uint32_t, std::pair<uint64_t, uint64_t>> ranges;
+    uint32_t wraps = 0;
+    uint64_t lastOffset = 0;
+    uint64_t seed = 1;
+    for (uint32_t n = 0; n < packetNum; n++)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint64_t size = 1 + (seed >> 33) % maxPacket;
+        uint32_t bufId = 0;
+        uint64_t offset = 0, reserved = 0;
+        while (true)
+        {
+            // same order as the encode service: sequence, index, ring
+            uint32_t seq = index.ReleaseSequence();
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == index.AcquireWait(bufId, TEST_WAIT_US));
+            MRDAStatus st = ring.Allocate(bufId, size, offset, reserved);
+            if (MRDA_STATUS_SUCCESS == st) break;
+            MRDA_CHECK(MRDA_STATUS_NOT_READY == st);
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == index.Release(bufId));
+            MRDA_CHECK(index.WaitRelease(seq, TEST_WAIT_US));
+        }
+        MRDA_CHECK(reserved >= size && reserved % SHM_RING_GRANULARITY == 0);
+        MRDA_CHECK(offset >= region.layout.dataOffset && offset + reserved <= dataEnd);
+        // no live range of the guest is handed out again
+        for (auto &range : ranges)
+        {
+            if (range.first == bufId) continue;
+            if (region.State(range.first)->load() != static_cast<uint32_t>(BufferState::BUFFER_STATE_BUSY)) continue;
+            bool overlap = offset < range.second.first + range.second.second && range.second.first < offset + reserved;
+            MRDA_CHECK(!overlap);
+        }
+        ranges[bufId] = {offset, reserved};
+        if (n > 0 && offset < lastOffset) wraps++;
+        lastOffset = offset;
+
+        uint8_t *data = reinterpret_cast<uint8_t*>(region.mem + offset);
+        for (uint64_t i = 0; i < size; i++) data[i] = PacketByte(n, i);
+        ShmStoreState(region.State(bufId), BufferState::BUFFER_STATE_BUSY);
+        RingPacket packet = {bufId, n, offset, size};
+        MRDA_CHECK(packets.Write(packet));
+    }
+    MRDA_CHECK(child.Wait() == 0);
+    MRDA_CHECK(wraps > 0);
+    return 0;
+}
+
+//!
+//! \brief descriptor of the n-th frame, every field differs per frame
+//!
+static ShmDescriptor TestDescriptor(uint32_t n, uint32_t bufferNum)
+{
+    ShmDescriptor desc = {};
+    desc.bufId = n % bufferNum + 1;
+    desc.flags = static_cast<uint32_t>(InputStreamType::RAW) << SHM_DESC_TYPE_SHIFT;
+    desc.memOffset = 4096ULL * n;
+    desc.occupiedSize = n * 3;
+    desc.pts = n;
+    desc.width = 1920 + n;
+    desc.chainNum = 1;
+    return desc;
+}
+
+//!
+//! \brief guest submits descriptors through a small ring faster than the
+//!        host takes them, both sides wait on the other's doorbell
+//!
+static int TestDescRingAcrossProcesses()
+{
+    constexpr uint32_t bufferNum = 8;
+    constexpr uint32_t descNum = 20000;
+    TestRegion region;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == region.Create(bufferNum, 4096, 0, false));
+    MRDA_CHECK(region.layout.HasDescRing() && region.layout.descNum == SHM_DESC_MIN_NUM);
+    ShmDescRing ring;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == ring.Attach(region.mem, region.layout));
+    ring.Reset();
+
+    TestChild child([&]() {
+        ShmDescRing guest;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Attach(region.mem, region.layout));
+        for (uint32_t n = 0; n < descNum; n++)
+        {
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Push(TestDescriptor(n, bufferNum), TEST_WAIT_US));
+        }
+        return 0;
+    });
+
+    for (uint32_t n = 0; n < descNum; n++)
+    {
+        ShmDescriptor desc;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == ring.Pop(desc, TEST_WAIT_US));
+        ShmDescriptor expected = TestDescriptor(n, bufferNum);
+        MRDA_CHECK(memcmp(&desc, &expected, sizeof(desc)) == 0);
+        // let the producer fill the ring now and then
+        if (n % 1000 == 0) usleep(1000);
+    }
+    MRDA_CHECK(child.Wait() == 0);
+    ShmDescriptor desc;
+    MRDA_CHECK(MRDA_STATUS_NOT_READY == ring.Pop(desc, 0));
+    return 0;
+}
+
+//!
+//! \brief closing the ring wakes a producer blocked on a full ring, the
+//!        consumer drains what is left and then sees the end
+//!
+static int TestDescRingClose()
+{
+    constexpr uint32_t bufferNum = 8;
+    TestRegion region;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == region.Create(bufferNum, 4096, 0, false));
+    ShmDescRing ring;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == ring.Attach(region.mem, region.layout));
+    ring.Reset();
+    uint32_t descNum = region.layout.descNum;
+
+    TestPipe ready;
+    MRDA_CHECK(ready.fds[0] >= 0);
+    TestChild child([&]() {
+        ready.CloseRead();
+        ShmDescRing guest;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Attach(region.mem, region.layout));
+        for (uint32_t n = 0; n < descNum; n++)
+        {
+            MRDA_CHECK(MRDA_STATUS_SUCCESS == guest.Push(TestDescriptor(n, bufferNum), 0));
+        }
+        MRDA_CHECK(MRDA_STATUS_NOT_READY == guest.Push(TestDescriptor(descNum, bufferNum), 0));
+        MRDA_CHECK(ready.Write(descNum));
+        // blocks on the full ring until the host closes it
+        auto begin = std::chrono::steady_clock::now();
+        MRDA_CHECK(MRDA_STATUS_INVALID_STATE == guest.Push(TestDescriptor(descNum, bufferNum), TEST_WAIT_US));
+        MRDA_CHECK(std::chrono::steady_clock::now() - begin < std::chrono::microseconds(TEST_WAIT_US / 2));
+        return 0;
+    });
+    ready.CloseWrite();
+
+    uint32_t filled = 0;
+    MRDA_CHECK(ready.Read(filled) && filled == descNum);
+    usleep(50 * 1000);
+    ring.Close();
+    MRDA_CHECK(child.Wait() == 0);
+
+    for (uint32_t n = 0; n < descNum; n++)
+    {
+        ShmDescriptor desc;
+        MRDA_CHECK(MRDA_STATUS_SUCCESS == ring.Pop(desc, 0));
+        MRDA_CHECK(desc.pts == n);
+    }
+    ShmDescriptor desc;
+    MRDA_CHECK(MRDA_STATUS_NOT_ENOUGH_DATA == ring.Pop(desc, TEST_WAIT_US));
+    MRDA_CHECK(MRDA_STATUS_INVALID_STATE == ring.Push(desc, 0));
+    return 0;
+}
+
+//!
+//! \brief a frame survives the trip through a descriptor, including EOS
+//!        and the unknown stream type
+//!
+static int TestDescriptorRoundTrip()
+{
+    std::shared_ptr<FrameBufferData> frame = std::make_shared<FrameBufferData>();
+    std::shared_ptr<MemoryBuffer> memBuf = std::make_shared<MemoryBuffer>();
+    frame->SetMemBuffer(memBuf);
+    frame->SetEOS(true);
+    frame->SetStreamType(InputStreamType::UNKNOWN);
+    frame->SetPts(1234);
+    frame->SetWidth(1920);
+    frame->SetHeight(1080);
+    memBuf->SetBufId(5);
+    memBuf->SetMemOffset(65536);
+    memBuf->SetStateOffset(8192);
+    memBuf->SetSize(4096);
+    memBuf->SetOccupiedSize(100);
+    memBuf->SetState(BufferState::BUFFER_STATE_BUSY);
+    memBuf->SetPitch(2048);
+    memBuf->SetChainNum(3);
+    memBuf->SetChainIndex(2);
+
+    ShmDescriptor desc;
+    ShmMakeDescriptor(frame, desc);
+    std::shared_ptr<FrameBufferData> out = std::make_shared<FrameBufferData>();
+    out->SetMemBuffer(std::make_shared<MemoryBuffer>());
+    ShmMakeFrame(desc, out);
+    std::shared_ptr<MemoryBuffer> outBuf = out->MemBuffer();
+    MRDA_CHECK(out->IsEOS() && out->Pts() == 1234 && out->Width() == 1920 && out->Height() == 1080);
+    MRDA_CHECK(out->StreamType() == InputStreamType::UNKNOWN);
+    MRDA_CHECK(outBuf->BufId() == 5 && outBuf->MemOffset() == 65536 && outBuf->StateOffset() == 8192);
+    MRDA_CHECK(outBuf->Size() == 4096 && outBuf->OccupiedSize() == 100 && outBuf->Pitch() == 2048);
+    MRDA_CHECK(outBuf->State() == BufferState::BUFFER_STATE_BUSY);
+    MRDA_CHECK(outBuf->ChainNum() == 3 && outBuf->ChainIndex() == 2);
+    return 0;
+}
+
+//!
+//! \brief a header corrupted by the guest is rejected even when its sizes
+//!        wrap back into the region
+//!
+static int TestHeaderOverflow()
+{
+    ShmRegionLayout layout;
+    MRDA_CHECK(ShmComputeLayout(SHM_MAX_BUFFER_NUM + 1, 4096, 0, UINT64_MAX, false, layout) == MRDA_STATUS_INVALID_PARAM);
+    MRDA_CHECK(ShmComputeLayout(4, UINT64_MAX - 16, 0, UINT64_MAX, false, layout) == MRDA_STATUS_INVALID_PARAM);
+    MRDA_CHECK(ShmComputeLayout(64, 1ULL << 58, 0, UINT64_MAX, false, layout) == MRDA_STATUS_INVALID_PARAM);
+
+    TestRegion region;
+    MRDA_CHECK(region.Create(4, 4096, 0, false) == MRDA_STATUS_SUCCESS);
+    ShmRegionHeader *header = reinterpret_cast<ShmRegionHeader*>(region.mem);
+    unsigned char saved[sizeof(ShmRegionHeader)];
+    std::memcpy(saved, region.mem, sizeof(saved));
+    auto check = [&](const std::function<void()> &corrupt) {
+        std::memcpy(region.mem, saved, sizeof(saved));
+        corrupt();
+        return ShmReadRegionHeader(region.mem, region.size, layout) == MRDA_STATUS_INVALID_DATA;
+    };
+
+    // bufferNum * slotSize wraps to the real data size
+    MRDA_CHECK(check([&]() { header->slotSize += 1ULL << 62; }));
+    // dataOffset + dataSize wraps to zero
+    MRDA_CHECK(check([&]() { header->dataOffset = 0 - header->dataSize; }));
+    MRDA_CHECK(check([&]() { header->stateOffset = UINT64_MAX - SHM_STATE_ENTRY_SIZE; }));
+    MRDA_CHECK(check([&]() { header->descOffset = UINT64_MAX - SHM_DESC_CONTROL_SIZE; }));
+    MRDA_CHECK(check([&]() { header->bufferNum = SHM_MAX_BUFFER_NUM + 1; }));
+    MRDA_CHECK(check([&]() { header->slotSize = 0; }));
+    MRDA_CHECK(check([&]() { header->featureFlags |= SHM_FEATURE_BYTE_RING; header->slotSize = 96; }));
+
+    std::memcpy(region.mem, saved, sizeof(saved));
+    MRDA_CHECK(ShmReadRegionHeader(region.mem, region.size, layout) == MRDA_STATUS_SUCCESS);
+    return 0;
+}
+
+int main()
+{
+    // a child that fails closes its pipe end, report it instead of dying
+    signal(SIGPIPE, SIG_IGN);
+    const TestCase cases[] = {
+        {"IndexAcquireRelease", TestIndexAcquireRelease},
+        {"IndexPingPong", TestIndexPingPong},
+        {"ByteRingAcrossProcesses", TestByteRingAcrossProcesses},
+        {"DescRingAcrossProcesses", TestDescRingAcrossProcesses},
+        {"DescRingClose", TestDescRingClose},
+        {"DescriptorRoundTrip", TestDescriptorRoundTrip},
+        {"HeaderOverflow", TestHeaderOverflow},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+//!
+//! \file SyntheticFrameTest.cpp
+//! \brief layout, formats and repeatability of the synthetic desktop frames
+//! \date 2026-10-17
+//!
+
+#include "TestCommon.h"
+#include "../utils/SyntheticFrameGenerator.h"
+
+#include <vector>
+
+VDI_USE_MRDALib
+
+constexpr uint32_t TEST_WIDTH = 640;
+constexpr uint32_t TEST_HEIGHT = 360;
+
+static std::vector<uint8_t> Generate(SyntheticFrameGenerator &generator, uint64_t frameIndex, uint32_t pitch)
+{
+    std::vector<uint8_t> frame(generator.FrameSize(pitch), 0xAB);
+    if (MRDA_STATUS_SUCCESS != generator.Generate(frameIndex, frame.data(), pitch, frame.size())) frame.clear();
+    return frame;
+}
+
+//!
+//! \brief sizes and buffers a frame cannot be drawn into are refused
+//!
+static int TestInvalid()
+{
+    SyntheticFrameGenerator generator;
+    std::vector<uint8_t> frame(TEST_WIDTH * TEST_HEIGHT * 4);
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == generator.Generate(0, frame.data(), TEST_WIDTH * 4, frame.size()));
+
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == generator.Initialize(32, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_RGBA32));
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == generator.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_NONE));
+    MRDA_CHECK(MRDA_STATUS_INVALID_PARAM == generator.Initialize(TEST_WIDTH + 1, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_NV12));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == generator.Initialize(TEST_WIDTH + 1, TEST_HEIGHT + 1, ColorFormat::COLOR_FORMAT_RGBA32));
+
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == generator.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_RGBA32));
+    MRDA_CHECK(generator.FrameSize(TEST_WIDTH * 4) == TEST_WIDTH * 4 * TEST_HEIGHT);
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == generator.Generate(0, nullptr, TEST_WIDTH * 4, frame.size()));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == generator.Generate(0, frame.data(), TEST_WIDTH * 4 - 4, frame.size()));
+    MRDA_CHECK(MRDA_STATUS_INVALID_DATA == generator.Generate(0, frame.data(), TEST_WIDTH * 4, frame.size() - 1));
+    return 0;
+}
+
+//!
+//! \brief a frame depends on its index only, not on the frames before it
+//!
+static int TestRepeatable()
+{
+    SyntheticFrameGenerator generator;
+    SyntheticFrameGenerator other;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == generator.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_RGBA32));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == other.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_RGBA32));
+    std::vector<uint8_t> first = Generate(generator, 5, TEST_WIDTH * 4);
+    for (uint64_t i = 0; i < 5; i++) Generate(other, i, TEST_WIDTH * 4);
+    MRDA_CHECK(!first.empty() && first == Generate(other, 5, TEST_WIDTH * 4));
+    MRDA_CHECK(first == Generate(generator, 5, TEST_WIDTH * 4));
+    MRDA_CHECK(first != Generate(generator, 6, TEST_WIDTH * 4));
+    return 0;
+}
+
+//!
+//! \brief the desktop stays, the video window changes and the text
+//!        window moves between two frames
+//!
+static int TestScene()
+{
+    SyntheticFrameGenerator generator;
+    const uint32_t pitch = TEST_WIDTH * 4;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == generator.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_RGBA32));
+    std::vector<uint8_t> frame0 = Generate(generator, 0, pitch);
+    std::vector<uint8_t> frame1 = Generate(generator, 1, pitch);
+    MRDA_CHECK(!frame0.empty() && !frame1.empty());
+
+    // wallpaper corner in BGRA with an opaque alpha
+    MRDA_CHECK(frame0[0] == 40 && frame0[1] == 20 && frame0[2] == 13 && frame0[3] == 0xFF);
+
+    uint64_t changed = 0;
+    for (uint64_t i = 0; i < frame0.size(); i += 4)
+    {
+        if (frame0[i] != frame1[i] || frame0[i + 1] != frame1[i + 1] || frame0[i + 2] != frame1[i + 2]) changed++;
+        MRDA_CHECK(frame1[i + 3] == 0xFF);
+    }
+    // the video and the text windows cover about a third of the screen
+    uint64_t pixels = static_cast<uint64_t>(TEST_WIDTH) * TEST_HEIGHT;
+    MRDA_CHECK(changed > pixels / 10 && changed < pixels / 2);
+
+    auto pixelChanged = [&](uint32_t x, uint32_t y) {
+        size_t offset = static_cast<size_t>(y) * pitch + x * 4;
+        return frame0[offset] != frame1[offset] || frame0[offset + 1] != frame1[offset + 1]
+            || frame0[offset + 2] != frame1[offset + 2];
+    };
+    // static document window, wallpaper and taskbar
+    for (uint32_t y = TEST_HEIGHT * 10 / 100; y < TEST_HEIGHT * 50 / 100; y++) MRDA_CHECK(!pixelChanged(TEST_WIDTH * 20 / 100, y));
+    for (uint32_t x = 0; x < TEST_WIDTH; x++) MRDA_CHECK(!pixelChanged(x, TEST_HEIGHT - 1) && !pixelChanged(x, 0));
+    // every row of the video window changes
+    uint32_t videoRows = 0;
+    for (uint32_t y = TEST_HEIGHT * 20 / 100; y < TEST_HEIGHT * 50 / 100; y++)
+    {
+        bool rowChanged = false;
+        for (uint32_t x = TEST_WIDTH * 50 / 100; x < TEST_WIDTH * 96 / 100 && !rowChanged; x++) rowChanged = pixelChanged(x, y);
+        videoRows += rowChanged;
+    }
+    MRDA_CHECK(videoRows == TEST_HEIGHT * 50 / 100 - TEST_HEIGHT * 20 / 100);
+    // the text window scrolls
+    bool scrolled = false;
+    for (uint32_t y = TEST_HEIGHT * 70 / 100; y < TEST_HEIGHT * 85 / 100 && !scrolled; y++)
+    {
+        for (uint32_t x = TEST_WIDTH * 5 / 100; x < TEST_WIDTH * 45 / 100 && !scrolled; x++) scrolled = pixelChanged(x, y);
+    }
+    MRDA_CHECK(scrolled);
+    return 0;
+}
+
+//!
+//! \brief NV12 and I420 carry the same samples in their own plane
+//!        layouts, limited range, and leave the row padding alone
+//!
+static int TestYUV()
+{
+    SyntheticFrameGenerator nv12;
+    SyntheticFrameGenerator i420;
+    const uint32_t pitch = TEST_WIDTH + 64;
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == nv12.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_NV12));
+    MRDA_CHECK(MRDA_STATUS_SUCCESS == i420.Initialize(TEST_WIDTH, TEST_HEIGHT, ColorFormat::COLOR_FORMAT_YUV420P));
+    MRDA_CHECK(nv12.FrameSize(pitch) == static_cast<uint64_t>(pitch) * TEST_HEIGHT * 3 / 2);
+    std::vector<uint8_t> nv12Frame = Generate(nv12, 3, pitch);
+    std::vector<uint8_t> i420Frame = Generate(i420, 3, pitch);
+    MRDA_CHECK(!nv12Frame.empty() && !i420Frame.empty());
+
+    for (uint32_t y = 0; y < TEST_HEIGHT; y++)
+    {
+        const uint8_t *nv12Row = &nv12Frame[static_cast<size_t>(y) * pitch];
+        const uint8_t *i420Row = &i420Frame[static_cast<size_t>(y) * pitch];
+        for (uint32_t x = 0; x < TEST_WIDTH; x++)
+        {
+            MRDA_CHECK(nv12Row[x] == i420Row[x] && nv12Row[x] >= 16 && nv12Row[x] <= 235);
+        }
+        for (uint32_t x = TEST_WIDTH; x < pitch; x++) MRDA_CHECK(nv12Row[x] == 0xAB);
+    }
+
+    const uint8_t *uv = &nv12Frame[static_cast<size_t>(pitch) * TEST_HEIGHT];
+    const uint8_t *u = &i420Frame[static_cast<size_t>(pitch) * TEST_HEIGHT];
+    const uint8_t *v = u + static_cast<size_t>(pitch / 2) * (TEST_HEIGHT / 2);
+    for (uint32_t y = 0; y < TEST_HEIGHT / 2; y++)
+    {
+        for (uint32_t x = 0; x < TEST_WIDTH / 2; x++)
+        {
+            uint8_t cb = uv[static_cast<size_t>(y) * pitch + 2 * x];
+            uint8_t cr = uv[static_cast<size_t>(y) * pitch + 2 * x + 1];
+            MRDA_CHECK(cb == u[static_cast<size_t>(y) * (pitch / 2) + x]);
+            MRDA_CHECK(cr == v[static_cast<size_t>(y) * (pitch / 2) + x]);
+            MRDA_CHECK(cb >= 16 && cb <= 240 && cr >= 16 && cr <= 240);
+        }
+    }
+    return 0;
+}
+
+int main()
+{
+    const TestCase cases[] = {
+        {"Invalid", TestInvalid},
+        {"Repeatable", TestRepeatable},
+        {"Scene", TestScene},
+        {"YUV", TestYUV},
+    };
+    return RunTests(cases, sizeof(cases) / sizeof(cases[0]));
+}
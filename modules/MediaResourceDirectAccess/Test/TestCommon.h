@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file TestCommon.h
+//! \brief minimal checks shared by the unit test executables, each test
+//!        is a function returning 0 on success
+//! \date 2026-10-17
+//!
+
+#ifndef _TEST_COMMON_H_
+#define _TEST_COMMON_H_
+
+#include <stdio.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//!
+//! \brief fail the current test function with the location of the check
+//!
+#define MRDA_CHECK(cond)                                                              \
+    do                                                                                \
+    {                                                                                 \
+        if (!(cond))                                                                  \
+        {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            return 1;                                                                 \
+        }                                                                             \
+    } while (0)
+
+//!
+//! \brief one test of an executable
+//!
+struct TestCase
+{
+    const char *name;  //!< test name
+    int (*func)();     //!< returns 0 on success
+};
+
+//!
+//! \brief Run all tests, a failed one does not stop the others
+//!
+//! \param [in] cases
+//! \param [in] num
+//! \return int
+//!         0 if all tests pass, 1 otherwise, the exit code for ctest
+//!
+inline int RunTests(const TestCase *cases, size_t num)
+{
+    size_t failed = 0;
+    for (size_t i = 0; i < num; i++)
+    {
+        printf("[ RUN      ] %s\n", cases[i].name);
+        fflush(stdout);
+        bool ok = cases[i].func() == 0;
+        printf("[ %s ] %s\n", ok ? "      OK" : "  FAILED", cases[i].name);
+        if (!ok) failed++;
+    }
+    printf("%zu of %zu tests passed\n", num - failed, num);
+    return failed == 0 ? 0 : 1;
+}
+
+//!
+//! \brief Print the median and 99th percentile of latency samples, used
+//!        by the benchmarks and the tests that measure a wake up
+//!
+//! \param [in] name
+//! \param [in] samplesNs
+//!        samples in nanoseconds, sorted in place
+//!
+inline void ReportLatency(const char *name, std::vector<uint64_t> &samplesNs)
+{
+    if (samplesNs.empty()) return;
+    std::sort(samplesNs.begin(), samplesNs.end());
+    size_t num = samplesNs.size();
+    printf("%s: %zu samples, median %.1f us, p99 %.1f us, max %.1f us\n", name, num,
+        samplesNs[num / 2] / 1000.0, samplesNs[num * 99 / 100] / 1000.0, samplesNs[num - 1] / 1000.0);
+    fflush(stdout);
+}
+
+#endif // _TEST_COMMON_H_
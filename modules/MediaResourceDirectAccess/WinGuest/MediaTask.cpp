@@ -157,7 +157,7 @@ MRDAStatus MediaTask::ReceiveFrame(std::shared_ptr<FrameBufferItem> &data)
 
         item->assign(memBuf->BufId(), memBuf->MemOffset(), memBuf->StateOffset(),
                      memBuf->BufPtr(), memBuf->Size(), memBuf->OccupiedSize(),
-                     memBuf->State());
+                     memBuf->State(), memBuf->Pitch());
         data->init(item.get(), frameData->Width(), frameData->Height(),
                    frameData->StreamType(), frameData->Pts(), frameData->IsEOS());
     }
@@ -192,7 +192,7 @@ MRDAStatus MediaTask::GetOneInputBuffer(std::shared_ptr<FrameBufferItem> &data)
 
     item->assign(memBuf->BufId(), memBuf->MemOffset(), memBuf->StateOffset(),
                  memBuf->BufPtr(), memBuf->Size(), memBuf->OccupiedSize(),
-                 memBuf->State());
+                 memBuf->State(), memBuf->Pitch());
     data->init(item.get(), frameData->Width(), frameData->Height(), frameData->StreamType(), frameData->Pts(), frameData->IsEOS());
 
     return MRDA_STATUS_SUCCESS;
@@ -228,7 +228,8 @@ MRDAStatus MediaTask::CheckMediaParams(const MediaParams *params)
     // check encode params
     if ((m_taskManager->TaskType() == TASKTYPE::taskEncode ||
         m_taskManager->TaskType() == TASKTYPE::taskFFmpegEncode ||
-        m_taskManager->TaskType() == TASKTYPE::taskOneVPLEncode) &&
+        m_taskManager->TaskType() == TASKTYPE::taskOneVPLEncode ||
+        m_taskManager->TaskType() == TASKTYPE::taskNullEncode) &&
      (params->encodeParams.frame_width <= 0 || params->encodeParams.frame_height <= 0
         || params->encodeParams.framerate_den <= 0 || params->encodeParams.gop_size <= 0
         || (params->encodeParams.rc_mode == 1 && params->encodeParams.bit_rate <= 0)
@@ -246,8 +247,8 @@ MRDAStatus MediaTask::CheckMediaParams(const MediaParams *params)
     if (params->shareMemoryInfo.bufferNum <=0 || params->shareMemoryInfo.bufferSize <=0
         || params->shareMemoryInfo.in_mem_dev_path == "" || params->shareMemoryInfo.out_mem_dev_path == ""
         || params->shareMemoryInfo.totalMemorySize <=0
-        || params->shareMemoryInfo.in_mem_dev_slot_number <= 0
-        || params->shareMemoryInfo.out_mem_dev_slot_number <= 0)
+        || (params->shareMemoryInfo.in_mem_dev_slot_number <= 0 && params->shareMemoryInfo.in_mem_guest_dev_path == "")
+        || (params->shareMemoryInfo.out_mem_dev_slot_number <= 0 && params->shareMemoryInfo.out_mem_guest_dev_path == ""))
     {
         MRDA_LOG(LOG_ERROR, "invalid share memory parameters setting!");
         return MRDA_STATUS_INVALID_DATA;
@@ -36,6 +36,7 @@
 
 #include "../utils/common.h"
 #include "../SHMemory/FrameBufferData.h"
+#include "../SHMemory/ShmDescRing.h"
 
 VDI_NS_BEGIN
 
@@ -66,6 +67,18 @@ public:
     //!
     virtual MRDAStatus SetInitParams(const MediaParams *params) = 0;
     //!
+    //! \brief Pass frames through descriptor rings in share memory instead
+    //!        of the session transport, called before SetInitParams
+    //!
+    //! \param [in] submitRing
+    //!             ring of the input pool, input frames are pushed to it
+    //! \param [in] completeRing
+    //!             ring of the output pool, output frames are popped from it
+    //! \return MRDAStatus
+    //!         MRDA_SUCCESS if success, else fail
+    //!
+    virtual MRDAStatus AttachDescRings(ShmDescRing *submitRing, ShmDescRing *completeRing) = 0;
+    //!
     //! \brief Send the data to the remote host
     //!
     //! \param [in] data
@@ -39,18 +39,18 @@ TaskDataSession_gRPC::TaskDataSession_gRPC(std::shared_ptr<TaskInfo> taskInfo)
 {
     std::shared_ptr<Channel> channel = grpc::CreateChannel(taskInfo->ipAddr, grpc::InsecureChannelCredentials());
     m_stub = MRDA::MRDAService::NewStub(channel);
-    m_inputQueue.clear();
-    m_outputQueue.clear();
     m_taskInfo = taskInfo;
     m_frameNum = 0;
 }
 
 TaskDataSession_gRPC::~TaskDataSession_gRPC()
 {
-    m_sendThread.join();
-    m_receiveThread.join();
-    m_inputQueue.clear();
-    m_outputQueue.clear();
+    // a send thread still waiting for EOS finishes the stream at once
+    m_inputQueue.Close();
+    if (m_sendThread.joinable()) m_sendThread.join();
+    if (m_receiveThread.joinable()) m_receiveThread.join();
+    m_inputQueue.Reset();
+    m_outputQueue.Reset();
     m_frameNum = 0;
 }
 
@@ -69,6 +69,10 @@ MRDA::MediaParams TaskDataSession_gRPC::MakeMediaParams(const MediaParams *param
     mrda_shmInfo->set_buffer_size(params->shareMemoryInfo.bufferSize);
     mrda_shmInfo->set_in_mem_dev_path(params->shareMemoryInfo.in_mem_dev_path);
     mrda_shmInfo->set_out_mem_dev_path(params->shareMemoryInfo.out_mem_dev_path);
+    mrda_shmInfo->set_host_map_options(params->shareMemoryInfo.hostMapOptions);
+    mrda_shmInfo->set_host_numa_node(params->shareMemoryInfo.hostNumaNode);
+    mrda_shmInfo->set_host_stripes(params->shareMemoryInfo.hostStripes);
+    mrda_shmInfo->set_data_plane(static_cast<uint32_t>(params->shareMemoryInfo.dataPlane));
     mrda_encParams->set_codec_id(static_cast<uint32_t>(params->encodeParams.codec_id));
     mrda_encParams->set_gop_size(params->encodeParams.gop_size);
     mrda_encParams->set_async_depth(params->encodeParams.async_depth);
@@ -84,6 +88,9 @@ MRDA::MediaParams TaskDataSession_gRPC::MakeMediaParams(const MediaParams *param
     mrda_encParams->set_codec_profile(static_cast<uint32_t>(params->encodeParams.codec_profile));
     mrda_encParams->set_max_b_frames(params->encodeParams.max_b_frames);
     mrda_encParams->set_frame_num(params->encodeParams.frame_num);
+    mrda_encParams->set_record_format(static_cast<uint32_t>(params->encodeParams.record_format));
+    mrda_encParams->set_record_path(params->encodeParams.record_path);
+    mrda_encParams->set_record_buffer_size(params->encodeParams.record_buffer_size);
     MRDA::DecodeParams *mrda_decParams = mrda_mediaParams.mutable_dec_params();
     mrda_decParams->set_codec_id(static_cast<uint32_t>(params->decodeParams.codec_id));
     mrda_decParams->set_frame_width(params->decodeParams.frame_width);
@@ -92,6 +99,8 @@ MRDA::MediaParams TaskDataSession_gRPC::MakeMediaParams(const MediaParams *param
     mrda_decParams->set_frame_num(params->decodeParams.frame_num);
     mrda_decParams->set_framerate_den(params->decodeParams.framerate_den);
     mrda_decParams->set_framerate_num(params->decodeParams.framerate_num);
+    mrda_decParams->set_thread_mode(static_cast<uint32_t>(params->decodeParams.thread_mode));
+    mrda_decParams->set_thread_num(params->decodeParams.thread_num);
 
     return mrda_mediaParams;
 }
@@ -117,6 +126,7 @@ MRDA::BufferInfo TaskDataSession_gRPC::MakeBufferInfo(const std::shared_ptr<Fram
     mrda_memBuffer->set_buf_size(memoryBuffer->Size());
     mrda_memBuffer->set_state(static_cast<int32_t>(memoryBuffer->State()));
     mrda_memBuffer->set_occupied_buf_size(memoryBuffer->OccupiedSize());
+    mrda_memBuffer->set_pitch(memoryBuffer->Pitch());
     mrda_bufferInfo.set_width(data->Width());
     mrda_bufferInfo.set_height(data->Height());
     mrda_bufferInfo.set_type(static_cast<int32_t>(data->StreamType()));
@@ -151,10 +161,26 @@ std::shared_ptr<FrameBufferData> TaskDataSession_gRPC::MakeBufferInfoBack(MRDA::
     memoryBuffer->SetSize(mrda_memBuffer->buf_size());
     memoryBuffer->SetState(static_cast<BufferState>(mrda_memBuffer->state()));
     memoryBuffer->SetOccupiedSize(mrda_memBuffer->occupied_buf_size());
+    memoryBuffer->SetPitch(mrda_memBuffer->pitch());
+    // hosts without chaining leave the chain fields unset
+    memoryBuffer->SetChainNum(mrda_memBuffer->chain_num() > 0 ? mrda_memBuffer->chain_num() : 1);
+    memoryBuffer->SetChainIndex(mrda_memBuffer->chain_index());
     frameBufferData->SetMemBuffer(memoryBuffer);
     return frameBufferData;
 }
 
+MRDAStatus TaskDataSession_gRPC::AttachDescRings(ShmDescRing *submitRing, ShmDescRing *completeRing)
+{
+    if (submitRing == nullptr || completeRing == nullptr)
+    {
+        MRDA_LOG(LOG_ERROR, "invalid descriptor rings!");
+        return MRDA_STATUS_INVALID_PARAM;
+    }
+    m_submitRing = submitRing;
+    m_completeRing = completeRing;
+    return MRDA_STATUS_SUCCESS;
+}
+
 MRDAStatus TaskDataSession_gRPC::SetInitParams(const MediaParams *params)
 {
     if (params == nullptr) return MRDA_STATUS_INVALID_PARAM;
@@ -167,7 +193,8 @@ MRDAStatus TaskDataSession_gRPC::SetInitParams(const MediaParams *params)
     }
     else if (m_taskInfo->taskType == TASKTYPE::taskEncode ||
              m_taskInfo->taskType == TASKTYPE::taskFFmpegEncode ||
-             m_taskInfo->taskType == TASKTYPE::taskOneVPLEncode)
+             m_taskInfo->taskType == TASKTYPE::taskOneVPLEncode ||
+             m_taskInfo->taskType == TASKTYPE::taskNullEncode)
     {
         m_frameNum = params->encodeParams.frame_num;
     }
@@ -177,6 +204,8 @@ MRDAStatus TaskDataSession_gRPC::SetInitParams(const MediaParams *params)
         return MRDA_STATUS_INVALID_PARAM;
     }
     grpc::ClientContext context;
+    context.AddMetadata(MRDA_TASK_ID_KEY, std::to_string(m_taskInfo->taskID));
+    context.AddMetadata(MRDA_SESSION_TOKEN_KEY, m_taskInfo->sessionToken);
     MRDA::MediaParams in_mrda_mediaParams = MakeMediaParams(params);
     MRDA::TaskStatus out_mrda_taskStatus;
     Status status = m_stub->SetInitParams(&context, in_mrda_mediaParams, &out_mrda_taskStatus);
@@ -189,6 +218,13 @@ MRDAStatus TaskDataSession_gRPC::SetInitParams(const MediaParams *params)
     {
         return MRDA_STATUS_INVALID_STATE;
     }
+    if (m_submitRing != nullptr)
+    {
+        // frames go through the descriptor rings, no stream threads
+        return MRDA_STATUS_SUCCESS;
+    }
+    // SendFrame blocks instead of queueing more than the host can take
+    m_inputQueue.SetCapacity(params->shareMemoryInfo.bufferNum + 1);
     // start send and receive thread
     m_sendThread = std::thread(&TaskDataSession_gRPC::SendThread, this);
     m_receiveThread = std::thread(&TaskDataSession_gRPC::ReceiveThread, this);
@@ -198,21 +234,19 @@ MRDAStatus TaskDataSession_gRPC::SetInitParams(const MediaParams *params)
 void TaskDataSession_gRPC::SendThread()
 {
     ClientContext inputContext;     // input client context
+    inputContext.AddMetadata(MRDA_TASK_ID_KEY, std::to_string(m_taskInfo->taskID));
+    inputContext.AddMetadata(MRDA_SESSION_TOKEN_KEY, m_taskInfo->sessionToken);
     MRDA::TaskStatus taskStatus;
     std::shared_ptr<ClientWriter<MRDA::BufferInfo>> writer(m_stub->SendInputData(&inputContext, &taskStatus));
     bool isSendRunning = true;
     while (isSendRunning)
     {
         std::shared_ptr<FrameBufferData> data = nullptr;
+        if (MRDA_STATUS_SUCCESS != m_inputQueue.Pop(data))
         {
-        if (m_inputQueue.empty())
-        {
-            Sleep(50);
-            continue;
-        }
-        std::unique_lock<std::mutex> lock(m_inputMutex);
-        data = m_inputQueue.front();
-        m_inputQueue.pop_front();
+            // closed before EOS, end the stream
+            writer->WritesDone();
+            break;
         }
 
         MRDA::BufferInfo in_mrda_bufferInfo = MakeBufferInfo(data);
@@ -242,6 +276,8 @@ void TaskDataSession_gRPC::SendThread()
 void TaskDataSession_gRPC::ReceiveThread()
 {
     ClientContext outputContext;                   // output client context
+    outputContext.AddMetadata(MRDA_TASK_ID_KEY, std::to_string(m_taskInfo->taskID));
+    outputContext.AddMetadata(MRDA_SESSION_TOKEN_KEY, m_taskInfo->sessionToken);
     MRDA::Pts pts = MakePts(static_cast<uint64_t>(m_frameNum));
     std::shared_ptr<ClientReader<MRDA::BufferInfo>> reader(m_stub->ReceiveOutputData(&outputContext, pts));
     int cur_pts = 0;
@@ -256,12 +292,13 @@ void TaskDataSession_gRPC::ReceiveThread()
             continue;
         }
         std::shared_ptr<FrameBufferData> data = MakeBufferInfoBack(out_mrda_bufferInfo);
-        std::unique_lock<std::mutex> lock(m_outputMutex);
-        m_outputQueue.push_back(data);
+        m_outputQueue.Push(data);
 #ifdef _ENABLE_TRACE_
         MRDA_LOG(LOG_INFO, "MRDA trace log: receive gRPC frame buffer in VM, pts: %llu", data->Pts());
 #endif
     }
+    // receivers drain the queue, then fail instead of waiting forever
+    m_outputQueue.Close();
     Status status = reader->Finish();
     if (!status.ok())
     {
@@ -277,30 +314,98 @@ MRDAStatus TaskDataSession_gRPC::SendFrame(const std::shared_ptr<FrameBufferData
         MRDA_LOG(LOG_ERROR, "Failed to send input frame!");
         return MRDA_STATUS_INVALID_DATA;
     }
-    std::unique_lock<std::mutex> lock(m_inputMutex);
+    if (m_submitRing != nullptr)
+    {
+        ShmDescriptor desc;
+        ShmMakeDescriptor(data, desc);
+        // single producer ring, serialize callers
+        std::unique_lock<std::mutex> lock(m_submitMutex);
+        // the host takes every descriptor as it comes, a ring that stays
+        // full means the host is gone
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(SHM_PEER_TIMEOUT_US);
+        MRDAStatus st = m_submitRing->Push(desc, SHM_DOORBELL_WAIT_US);
+        while (MRDA_STATUS_NOT_READY == st)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                MRDA_LOG(LOG_ERROR, "Host has not taken input frames for %u ms!", SHM_PEER_TIMEOUT_US / 1000);
+                return MRDA_STATUS_TIMEOUT;
+            }
+            st = m_submitRing->Push(desc, SHM_DOORBELL_WAIT_US);
+        }
+        if (MRDA_STATUS_INVALID_STATE == st)
+        {
+            MRDA_LOG(LOG_ERROR, "Input ring is closed!");
+            return st;
+        }
+        if (MRDA_STATUS_SUCCESS == st)
+        {
+            m_lastSubmitTime = std::chrono::steady_clock::now().time_since_epoch().count();
+        }
+#ifdef _ENABLE_TRACE_
+        MRDA_LOG(LOG_INFO, "MRDA trace log: push frame descriptor in VM, pts: %llu", data->Pts());
+#endif
+        return st;
+    }
 #ifdef _ENABLE_TRACE_
     MRDA_LOG(LOG_INFO, "MRDA trace log: push back frame in input queue in task data session, pts: %llu", data->Pts());
 #endif
-    m_inputQueue.push_back(data);
+    if (MRDA_STATUS_SUCCESS != m_inputQueue.Push(data))
+    {
+        MRDA_LOG(LOG_ERROR, "Input queue is closed!");
+        return MRDA_STATUS_INVALID_STATE;
+    }
     return MRDA_STATUS_SUCCESS;
-
 }
 
 MRDAStatus TaskDataSession_gRPC::ReceiveFrame(std::shared_ptr<FrameBufferData> &data)
 {
+    if (m_completeRing != nullptr)
     {
-    while (m_outputQueue.empty())
+        ShmDescriptor desc;
+        // single consumer ring, serialize callers
+        std::unique_lock<std::mutex> lock(m_completeMutex);
+        MRDAStatus st = m_completeRing->Pop(desc, SHM_DOORBELL_WAIT_US);
+        while (MRDA_STATUS_NOT_READY == st)
+        {
+            // an idle stream may wait forever, a host silent long after
+            // the last input frame is gone
+            int64_t lastSubmit = m_lastSubmitTime;
+            int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+            if (lastSubmit > m_lastCompleteTime
+                && std::chrono::steady_clock::duration(now - lastSubmit) >= std::chrono::microseconds(SHM_PEER_TIMEOUT_US))
+            {
+                MRDA_LOG(LOG_ERROR, "Host has not completed frames for %u ms!", SHM_PEER_TIMEOUT_US / 1000);
+                return MRDA_STATUS_TIMEOUT;
+            }
+            st = m_completeRing->Pop(desc, SHM_DOORBELL_WAIT_US);
+        }
+        if (MRDA_STATUS_NOT_ENOUGH_DATA == st)
+        {
+            MRDA_LOG(LOG_WARNING, "Output stream has ended!");
+            return st;
+        }
+        if (MRDA_STATUS_SUCCESS != st)
+        {
+            return st;
+        }
+        m_lastCompleteTime = std::chrono::steady_clock::now().time_since_epoch().count();
+        data = std::make_shared<FrameBufferData>();
+        data->SetMemBuffer(std::make_shared<MemoryBuffer>());
+        ShmMakeFrame(desc, data);
+#ifdef _ENABLE_TRACE_
+        MRDA_LOG(LOG_INFO, "MRDA trace log: pop frame descriptor in VM, pts: %llu", data->Pts());
+#endif
+        return MRDA_STATUS_SUCCESS;
+    }
+    if (MRDA_STATUS_SUCCESS != m_outputQueue.Pop(data))
     {
-        Sleep(50);
-        continue;
+        MRDA_LOG(LOG_WARNING, "Output stream has ended!");
+        return MRDA_STATUS_NOT_ENOUGH_DATA;
     }
-    std::unique_lock<std::mutex> lock(m_outputMutex);
-    data = m_outputQueue.front();
-    m_outputQueue.pop_front();
 #ifdef _ENABLE_TRACE_
     MRDA_LOG(LOG_INFO, "MRDA trace log: pop front frame in output queue in task data session, pts: %llu", data->Pts());
 #endif
-    }
 
     return MRDA_STATUS_SUCCESS;
 }
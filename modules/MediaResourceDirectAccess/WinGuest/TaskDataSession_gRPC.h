@@ -35,6 +35,7 @@
 #define _TASK_DATA_SESSION_GRPC_H_
 
 #include "TaskDataSession.h"
+#include "../utils/BlockingQueue.h"
 
 #include <grpc/grpc.h>
 // #include <grpcpp/alarm.h>
@@ -51,8 +52,9 @@ using grpc::ClientWriter;
 using grpc::Status;
 using grpc::Channel;
 
+#include <atomic>
+#include <chrono>
 #include <thread>
-#include <list>
 #include <mutex>
 
 VDI_NS_BEGIN
@@ -93,6 +95,16 @@ public:
     //!
     virtual MRDAStatus SetInitParams(const MediaParams *params);
     //!
+    //! \brief Pass frames through descriptor rings in share memory, gRPC
+    //!        then only carries the init params
+    //!
+    //! \param [in] submitRing
+    //! \param [in] completeRing
+    //! \return MRDAStatus
+    //!         MRDA_SUCCESS if success, else fail
+    //!
+    virtual MRDAStatus AttachDescRings(ShmDescRing *submitRing, ShmDescRing *completeRing);
+    //!
     //! \brief Send the data to the remote host
     //!
     //! \param [in] data
@@ -161,11 +173,15 @@ private:
     std::unique_ptr<MRDA::MRDAService::Stub> m_stub;             //!< client gRPC root
     std::thread m_sendThread;                                    //!< send frame thread
     std::thread m_receiveThread;                                 //!< receive frame thread
-    std::mutex m_inputMutex;                                     //!< input queue mutex
-    std::mutex m_outputMutex;                                    //!< output queue mutex
-    std::list<std::shared_ptr<FrameBufferData>> m_inputQueue;    //!< input queue
-    std::list<std::shared_ptr<FrameBufferData>> m_outputQueue;   //!< output queue
+    std::mutex m_submitMutex;                                    //!< serializes pushes to the input descriptor ring
+    std::mutex m_completeMutex;                                  //!< serializes pops from the output descriptor ring
+    BlockingQueue<std::shared_ptr<FrameBufferData>> m_inputQueue;  //!< input queue, bounded by the input buffers plus EOS
+    BlockingQueue<std::shared_ptr<FrameBufferData>> m_outputQueue; //!< output queue, closed when the output stream ends
     uint32_t m_frameNum;                                         //!< frame number
+    ShmDescRing *m_submitRing = nullptr;                         //!< input descriptor ring, null for the gRPC data plane
+    ShmDescRing *m_completeRing = nullptr;                       //!< output descriptor ring, null for the gRPC data plane
+    std::atomic<int64_t> m_lastSubmitTime{0};                    //!< steady clock ticks of the last pushed input descriptor
+    std::atomic<int64_t> m_lastCompleteTime{0};                  //!< steady clock ticks of the last popped output descriptor
 };
 
 VDI_NS_END
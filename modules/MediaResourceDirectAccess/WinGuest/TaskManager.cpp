@@ -35,6 +35,8 @@
 
 VDI_NS_BEGIN
 
+constexpr uint32_t INPUT_BUFFER_WAIT_US = 10 * 1000; //!< max wait for the host to release an input buffer
+
 TaskManager::TaskManager():
     m_taskInfo(nullptr),
     m_encodeParams(nullptr),
@@ -129,7 +131,7 @@ MRDAStatus TaskManager::SetInitParams(const MediaParams *params)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    if (MRDA_STATUS_SUCCESS != m_inMemoryPool->InitBufferPool(m_shareMemInfo->bufferNum, m_shareMemInfo->bufferSize, m_shareMemInfo->in_mem_dev_slot_number))
+    if (MRDA_STATUS_SUCCESS != m_inMemoryPool->InitBufferPool(m_shareMemInfo->bufferNum, m_shareMemInfo->bufferSize, m_shareMemInfo->in_mem_dev_slot_number, m_shareMemInfo->in_mem_guest_dev_path, m_shareMemInfo->bufferAlignment))
     {
         MRDA_LOG(LOG_ERROR, "failed to create in memory pool");
         return MRDA_STATUS_INVALID_DATA;
@@ -140,6 +142,8 @@ MRDAStatus TaskManager::SetInitParams(const MediaParams *params)
         MRDA_LOG(LOG_ERROR, "failed to allocate in memory pool");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // block briefly on the release doorbell instead of failing at once
+    m_inMemoryPool->SetAcquireTimeout(INPUT_BUFFER_WAIT_US);
 
     m_outMemoryPool = std::make_shared<FrameMemoryPool>();
     if (m_outMemoryPool == nullptr)
@@ -148,7 +152,22 @@ MRDAStatus TaskManager::SetInitParams(const MediaParams *params)
         return MRDA_STATUS_INVALID_DATA;
     }
 
-    if (MRDA_STATUS_SUCCESS != m_outMemoryPool->InitBufferPool(m_shareMemInfo->bufferNum, m_shareMemInfo->bufferSize,m_shareMemInfo->out_mem_dev_slot_number))
+    // encoded bitstreams are small and vary in size, so the output of encode
+    // tasks is a byte ring and each packet only reserves the bytes it needs,
+    // or fixed slots sized for typical packets with larger ones chained
+    bool isEncode = m_taskInfo != nullptr
+        && (m_taskInfo->taskType == TASKTYPE::taskFFmpegEncode
+        || m_taskInfo->taskType == TASKTYPE::taskOneVPLEncode
+        || m_taskInfo->taskType == TASKTYPE::taskNullEncode);
+    bool outChained = isEncode && m_shareMemInfo->outSlotSize > 0;
+    bool outByteRing = isEncode && !outChained;
+    uint32_t outBufferNum = m_shareMemInfo->bufferNum;
+    uint64_t outBufferSize = outChained ? m_shareMemInfo->outSlotSize : m_shareMemInfo->bufferSize;
+    if (isEncode && m_shareMemInfo->outBufferNum > 0)
+    {
+        outBufferNum = m_shareMemInfo->outBufferNum;
+    }
+    if (MRDA_STATUS_SUCCESS != m_outMemoryPool->InitBufferPool(outBufferNum, outBufferSize, m_shareMemInfo->out_mem_dev_slot_number, m_shareMemInfo->out_mem_guest_dev_path, m_shareMemInfo->bufferAlignment, outByteRing))
     {
         MRDA_LOG(LOG_ERROR, "failed to create out memory pool");
         return MRDA_STATUS_INVALID_DATA;
@@ -159,6 +178,20 @@ MRDAStatus TaskManager::SetInitParams(const MediaParams *params)
         MRDA_LOG(LOG_ERROR, "failed to allocate out memory pool");
         return MRDA_STATUS_OPERATION_FAIL;
     }
+    // one reassembly buffer per head slot, kept while the head is not released
+    m_chainBuffers.clear();
+    if (outChained)
+    {
+        m_chainBuffers.resize(outBufferNum);
+    }
+
+    // frame descriptors go through the pool control areas instead of gRPC
+    if (m_shareMemInfo->dataPlane == DataPlane::DATA_PLANE_SHM
+        && MRDA_STATUS_SUCCESS != m_taskDataSession->AttachDescRings(m_inMemoryPool->DescRing(), m_outMemoryPool->DescRing()))
+    {
+        MRDA_LOG(LOG_ERROR, "failed to attach descriptor rings");
+        return MRDA_STATUS_OPERATION_FAIL;
+    }
 
     // 2. send init params to data sender
     if (MRDA_STATUS_SUCCESS != m_dataSender->SetInitParams(params))
@@ -199,12 +232,70 @@ MRDAStatus TaskManager::ReceiveFrame(std::shared_ptr<FrameBufferData> &data)
             return MRDA_STATUS_INVALID_DATA;
         }
         GetBufferFromId(data->MemBuffer()->BufId(), data);
+        if (data->MemBuffer()->ChainNum() > 1)
+        {
+            return ReassembleChain(data);
+        }
         return status;
     }
 
     return status;
 }
 
+MRDAStatus TaskManager::ReassembleChain(std::shared_ptr<FrameBufferData> &data)
+{
+    std::shared_ptr<MemoryBuffer> head = data->MemBuffer();
+    uint32_t chainNum = head->ChainNum();
+    if (head->ChainIndex() != 0 || head->BufPtr() == nullptr
+        || head->BufId() == 0 || head->BufId() > m_chainBuffers.size())
+    {
+        MRDA_LOG(LOG_ERROR, "invalid chain head, buffer id %u", head->BufId());
+        return MRDA_STATUS_INVALID_DATA;
+    }
+    // capacity is kept across packets, so only growing IDR frames allocate
+    std::vector<uint8_t> &chain = m_chainBuffers[head->BufId() - 1];
+    chain.assign(head->BufPtr(), head->BufPtr() + head->OccupiedSize());
+
+    // the host queues a chain in one go, so the rest follows in order
+    MRDAStatus status = MRDA_STATUS_SUCCESS;
+    for (uint32_t i = 1; i < chainNum; i++)
+    {
+        std::shared_ptr<FrameBufferData> next = nullptr;
+        if (MRDA_STATUS_SUCCESS != m_dataReceiver->ReceiveFrame(next) || next == nullptr || next->MemBuffer() == nullptr)
+        {
+            MRDA_LOG(LOG_ERROR, "failed to receive chained buffer %u of %u", i, chainNum);
+            // segments taken so far are back already, the head is not
+            ReleaseOneOutputBuffer(data);
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        std::shared_ptr<MemoryBuffer> seg = next->MemBuffer();
+        if (seg->ChainIndex() != i || seg->ChainNum() != chainNum
+            || MRDA_STATUS_SUCCESS != GetBufferFromId(seg->BufId(), next))
+        {
+            MRDA_LOG(LOG_ERROR, "unexpected chained buffer %u of %u", seg->ChainIndex(), chainNum);
+            status = MRDA_STATUS_INVALID_DATA;
+        }
+        else
+        {
+            chain.insert(chain.end(), seg->BufPtr(), seg->BufPtr() + seg->OccupiedSize());
+        }
+        // the payload is copied out, continuation slots go back at once
+        ReleaseOneOutputBuffer(next);
+    }
+    if (MRDA_STATUS_SUCCESS != status)
+    {
+        ReleaseOneOutputBuffer(data);
+        return status;
+    }
+
+    // the head keeps its slot until released and points at the whole packet
+    head->SetBufPtr(chain.data());
+    head->SetSize(chain.size());
+    head->SetOccupiedSize(chain.size());
+    head->SetChainNum(1);
+    return MRDA_STATUS_SUCCESS;
+}
+
 MRDAStatus TaskManager::GetOneInputBuffer(std::shared_ptr<FrameBufferData> &data)
 {
     if (m_inMemoryPool == nullptr)
@@ -223,12 +314,16 @@ MRDAStatus TaskManager::GetOneInputBuffer(std::shared_ptr<FrameBufferData> &data
 
     if (m_encodeParams != nullptr && m_taskInfo != nullptr &&
         (m_taskInfo->taskType == TASKTYPE::taskFFmpegEncode
-        || m_taskInfo->taskType == TASKTYPE::taskOneVPLEncode)
+        || m_taskInfo->taskType == TASKTYPE::taskOneVPLEncode
+        || m_taskInfo->taskType == TASKTYPE::taskNullEncode)
        )
     {
         buffer->SetStreamType(InputStreamType::RAW);
         buffer->SetWidth(m_encodeParams->frame_width);
         buffer->SetHeight(m_encodeParams->frame_height);
+        // tightly packed rows by default, the app may use a larger pitch
+        uint32_t bytesPerPixel = m_encodeParams->color_format == ColorFormat::COLOR_FORMAT_RGBA32 ? 4 : 1;
+        buffer->MemBuffer()->SetPitch(m_encodeParams->frame_width * bytesPerPixel);
         buffer->SetPts(0); // will be filled in the following process
    }
     else if (m_decodeParams != nullptr && m_taskInfo != nullptr &&
@@ -298,7 +393,12 @@ MRDAStatus TaskManager::StopTask()
     }
 
     TASKStatus status;
-    return m_taskManagerSession->StopTask(m_taskInfo.get(), &status);
+    MRDAStatus st = m_taskManagerSession->StopTask(m_taskInfo.get(), &status);
+    // the host closes the descriptor rings when it stops the session, close
+    // them here too so callers waiting on a host that is gone return
+    if (m_inMemoryPool != nullptr && m_inMemoryPool->DescRing() != nullptr) m_inMemoryPool->DescRing()->Close();
+    if (m_outMemoryPool != nullptr && m_outMemoryPool->DescRing() != nullptr) m_outMemoryPool->DescRing()->Close();
+    return st;
 }
 
 MRDAStatus TaskManager::ResetTask(const TaskInfo *taskInfo)
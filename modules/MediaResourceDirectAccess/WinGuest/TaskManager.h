@@ -45,6 +45,8 @@
 #include "TaskDataSession.h"
 #include "TaskDataSession_gRPC.h"
 
+#include <vector>
+
 VDI_NS_BEGIN
 
 class TaskManager {
@@ -165,6 +167,17 @@ public:
         return m_taskInfo ? m_taskInfo->taskType : TASKTYPE::NONE;
     }
 
+private:
+    //!
+    //! \brief Receive the rest of a chained packet and join it behind the head
+    //!
+    //! \param [in, out] data
+    //!         head of the chain, points at the whole packet on return
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, else fail
+    //!
+    MRDAStatus ReassembleChain(std::shared_ptr<FrameBufferData> &data);
+
 private:
     std::shared_ptr<TaskInfo> m_taskInfo;             //!< task info
     // StreamInfo  m_streamInfo;                      //!< stream info
@@ -178,6 +191,7 @@ private:
     std::shared_ptr<DataSender> m_dataSender;                       //!< data sender
     std::shared_ptr<DataReceiver> m_dataReceiver;                   //!< data receiver
     std::shared_ptr<TaskDataSession> m_taskDataSession;             //!< task data session
+    std::vector<std::vector<uint8_t>> m_chainBuffers;               //!< reassembled chained packets, by head buffer id
 };
 
 VDI_NS_END
@@ -51,6 +51,7 @@ MRDA::TaskInfo TaskManagerSession_gRPC::MakeTaskInfo(const TaskInfo *taskInfo)
     mrda_info.set_deviceid(taskInfo->taskDevice.deviceID);
     mrda_info.set_devicetype(static_cast<int32_t>(taskInfo->taskDevice.deviceType));
     mrda_info.set_ipaddr(taskInfo->ipAddr);
+    mrda_info.set_sessiontoken(taskInfo->sessionToken);
     return mrda_info;
 }
 
@@ -63,6 +64,7 @@ TaskInfo TaskManagerSession_gRPC::MakeTaskInfoBack(const MRDA::TaskInfo *mrda_ta
     taskInfo.taskDevice.deviceID = mrda_taskInfo->deviceid();
     taskInfo.taskDevice.deviceType = static_cast<DeviceType>(mrda_taskInfo->devicetype());
     taskInfo.ipAddr = mrda_taskInfo->ipaddr();
+    taskInfo.sessionToken = mrda_taskInfo->sessiontoken();
     return taskInfo;
 }
 
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file BlockingQueue.h
+//! \brief define a bounded blocking queue handing frames between the
+//!        threads of one side, with timed waits and close semantics.
+//! \date 2026-10-17
+//!
+
+#ifndef _BLOCKING_QUEUE_H_
+#define _BLOCKING_QUEUE_H_
+
+#include "common.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+
+VDI_NS_BEGIN
+
+constexpr uint32_t QUEUE_WAIT_FOREVER = UINT32_MAX; //!< wait without timeout
+constexpr size_t QUEUE_UNBOUNDED = 0;               //!< capacity of a queue that never blocks producers
+
+//!
+//! \brief Bounded FIFO queue for any number of producers and consumers.
+//!
+//!        Push blocks while the queue is full and Pop while it is empty,
+//!        both wake up on the other side's condition variable instead of
+//!        polling. Close wakes up all waiters: pushes fail from then on
+//!        and pops drain what is left before they fail, so a consumer sees
+//!        every item queued before the close.
+//!
+template<typename T>
+class BlockingQueue
+{
+public:
+    //!
+    //! \brief Construct a new Blocking Queue object
+    //!
+    //! \param [in] capacity
+    //!             max number of queued items, QUEUE_UNBOUNDED for no limit
+    //!
+    explicit BlockingQueue(size_t capacity = QUEUE_UNBOUNDED):
+    m_capacity(capacity),
+    m_closed(false)
+    {
+    }
+    //!
+    //! \brief Destroy the Blocking Queue object
+    //!
+    virtual ~BlockingQueue() = default;
+    //!
+    //! \brief Set the capacity, waiting producers recheck it at once
+    //!
+    //! \param [in] capacity
+    //!             max number of queued items, QUEUE_UNBOUNDED for no limit
+    //!
+    void SetCapacity(size_t capacity)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_capacity = capacity;
+        m_notFull.notify_all();
+    }
+    //!
+    //! \brief Set a listener called after each push, outside the lock, so
+    //!        a consumer that is not waiting on the queue learns of new items.
+    //!        Must be set before any producer runs.
+    //!
+    //! \param [in] listener
+    //!             must not block, may pop from the queue
+    //!
+    void SetPushListener(std::function<void()> listener)
+    {
+        m_pushListener = std::move(listener);
+    }
+    //!
+    //! \brief Set a listener called after each pop, outside the lock, so
+    //!        a producer that is not waiting on the queue learns of free room.
+    //!        Must be set before any consumer runs.
+    //!
+    //! \param [in] listener
+    //!             must not block, may push to the queue
+    //!
+    void SetPopListener(std::function<void()> listener)
+    {
+        m_popListener = std::move(listener);
+    }
+    //!
+    //! \brief Push one item, waiting while the queue is full
+    //!
+    //! \param [in] item
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to not wait
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY on
+    //!         timeout, MRDA_STATUS_INVALID_STATE if the queue is closed
+    //!
+    MRDAStatus Push(T item, uint32_t timeoutUs = QUEUE_WAIT_FOREVER)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!WaitFor(m_notFull, lock, timeoutUs, [this] { return m_closed || !IsFull(1); }))
+        {
+            return MRDA_STATUS_NOT_READY;
+        }
+        if (m_closed) return MRDA_STATUS_INVALID_STATE;
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        if (m_pushListener) m_pushListener();
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Push a range of items back to back, so no other producer
+    //!        interleaves with them. An empty queue always takes the range.
+    //!
+    //! \param [in] first
+    //! \param [in] last
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to not wait
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY on
+    //!         timeout, MRDA_STATUS_INVALID_STATE if the queue is closed
+    //!
+    template<typename It>
+    MRDAStatus PushRange(It first, It last, uint32_t timeoutUs = QUEUE_WAIT_FOREVER)
+    {
+        size_t num = static_cast<size_t>(std::distance(first, last));
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!WaitFor(m_notFull, lock, timeoutUs, [this, num] { return m_closed || m_items.empty() || !IsFull(num); }))
+        {
+            return MRDA_STATUS_NOT_READY;
+        }
+        if (m_closed) return MRDA_STATUS_INVALID_STATE;
+        m_items.insert(m_items.end(), first, last);
+        lock.unlock();
+        m_notEmpty.notify_all();
+        if (m_pushListener) m_pushListener();
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Pop the oldest item, waiting while the queue is empty
+    //!
+    //! \param [out] item
+    //! \param [in] timeoutUs
+    //!             max wait time in microseconds, 0 to not wait
+    //! \return MRDAStatus
+    //!         MRDA_STATUS_SUCCESS if success, MRDA_STATUS_NOT_READY on
+    //!         timeout, MRDA_STATUS_INVALID_STATE if the queue is closed
+    //!         and drained
+    //!
+    MRDAStatus Pop(T &item, uint32_t timeoutUs = QUEUE_WAIT_FOREVER)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!WaitFor(m_notEmpty, lock, timeoutUs, [this] { return m_closed || !m_items.empty(); }))
+        {
+            return MRDA_STATUS_NOT_READY;
+        }
+        if (m_items.empty()) return MRDA_STATUS_INVALID_STATE;
+        item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        if (m_popListener) m_popListener();
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Close the queue and wake up all waiters
+    //!
+    void Close()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+    //!
+    //! \brief Drop all items and open the queue again
+    //!
+    void Reset()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_items.clear();
+            m_closed = false;
+        }
+        m_notFull.notify_all();
+    }
+    //!
+    //! \brief Get the number of queued items
+    //!
+    //! \return size_t
+    //!
+    size_t Size()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_items.size();
+    }
+    //!
+    //! \brief Check whether the queue is closed
+    //!
+    //! \return bool
+    //!
+    bool IsClosed()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_closed;
+    }
+
+private:
+    //!
+    //! \brief Check whether num more items exceed the capacity, lock held
+    //!
+    inline bool IsFull(size_t num) const
+    {
+        return m_capacity != QUEUE_UNBOUNDED && m_items.size() + num > m_capacity;
+    }
+    //!
+    //! \brief Wait on a condition variable until pred holds or the timeout
+    //!
+    //! \return bool
+    //!         pred after the wait
+    //!
+    template<typename Pred>
+    static bool WaitFor(std::condition_variable &cond, std::unique_lock<std::mutex> &lock, uint32_t timeoutUs, Pred pred)
+    {
+        if (timeoutUs == QUEUE_WAIT_FOREVER)
+        {
+            cond.wait(lock, pred);
+            return true;
+        }
+        return cond.wait_for(lock, std::chrono::microseconds(timeoutUs), pred);
+    }
+
+private:
+    std::mutex m_mutex;                 //!< guards the items and the closed flag
+    std::condition_variable m_notEmpty; //!< signaled on push and close
+    std::condition_variable m_notFull;  //!< signaled on pop, capacity change and close
+    std::deque<T> m_items;              //!< queued items, oldest first
+    size_t m_capacity;                  //!< max number of queued items
+    bool m_closed;                      //!< no more pushes accepted
+    std::function<void()> m_pushListener; //!< called after each push
+    std::function<void()> m_popListener;  //!< called after each pop
+};
+
+VDI_NS_END
+#endif // _BLOCKING_QUEUE_H_
@@ -0,0 +1,361 @@
+/*
+ * Copyright (c) 2024, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright notice, this
+ *   list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright notice,
+ *   this list of conditions and the following disclaimer in the documentation
+ *   and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+
+ */
+
+//!
+//! \file SyntheticFrameGenerator.h
+//! \brief generate desktop-like raw frames for benchmarks that run
+//!        without a captured source.
+//! \date 2026-10-17
+//!
+
+#ifndef _SYNTHETIC_FRAME_GENERATOR_H_
+#define _SYNTHETIC_FRAME_GENERATOR_H_
+
+#include "common.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+VDI_NS_BEGIN
+
+//!
+//! \brief Draws a remote desktop scene into raw frames: a static wallpaper
+//!        with a taskbar and a document window, a window of text scrolling
+//!        up, and a video window whose content changes every frame. This
+//!        mixes the unchanged, shifted and fully new areas that a desktop
+//!        encoder sees. Frames only depend on their index, so runs and
+//!        sessions are reproducible. RGBA32 is written in BGRA byte order
+//!        as desktop capture delivers it.
+//!
+class SyntheticFrameGenerator
+{
+public:
+    //!
+    //! \brief Construct a new Synthetic Frame Generator object
+    //!
+    SyntheticFrameGenerator():
+    m_width(0),
+    m_height(0),
+    m_format(ColorFormat::COLOR_FORMAT_NONE),
+    m_lineHeight(0),
+    m_scrollSpeed(0)
+    {
+    }
+    //!
+    //! \brief Destroy the Synthetic Frame Generator object
+    //!
+    virtual ~SyntheticFrameGenerator() = default;
+    //!
+    //! \brief Lay the scene out for the frame size and draw its static part
+    //!
+    //! \param [in] width
+    //! \param [in] height
+    //! \param [in] format
+    //! \return MRDAStatus
+    //!
+    MRDAStatus Initialize(uint32_t width, uint32_t height, ColorFormat format)
+    {
+        if (width < 64 || height < 64)
+        {
+            MRDA_LOG(LOG_ERROR, "Synthetic frame size %ux%u too small", width, height);
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+        if (format == ColorFormat::COLOR_FORMAT_NONE)
+        {
+            MRDA_LOG(LOG_ERROR, "Invalid synthetic frame color format");
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+        if (format != ColorFormat::COLOR_FORMAT_RGBA32 && ((width & 1) || (height & 1)))
+        {
+            MRDA_LOG(LOG_ERROR, "Synthetic YUV frame size %ux%u must be even", width, height);
+            return MRDA_STATUS_INVALID_PARAM;
+        }
+        m_width = width;
+        m_height = height;
+        m_format = format;
+        m_lineHeight = height / 60 < 8 ? 8 : height / 60;
+        m_scrollSpeed = m_lineHeight / 4 < 1 ? 1 : m_lineHeight / 4;
+
+        uint32_t titleHeight = m_lineHeight * 2;
+        m_docRect = {width * 4 / 100, height * 6 / 100, width * 42 / 100, height * 50 / 100};
+        m_scrollRect = {width * 4 / 100, height * 60 / 100 + titleHeight, width * 42 / 100, height * 28 / 100 - titleHeight};
+        m_videoRect = {width * 50 / 100, height * 10 / 100 + titleHeight, width * 46 / 100, height * 46 / 100 - titleHeight};
+
+        m_canvas.assign(static_cast<size_t>(width) * height, 0);
+        DrawBackground();
+        DrawWindowFrame({m_docRect.x, m_docRect.y, m_docRect.w, titleHeight}, 0xFF2B579A);
+        Rect docBody = {m_docRect.x, m_docRect.y + titleHeight, m_docRect.w, m_docRect.h - titleHeight};
+        DrawText(docBody, 0, 1);
+        DrawWindowFrame({m_scrollRect.x, m_scrollRect.y - titleHeight, m_scrollRect.w, titleHeight}, 0xFF3C3C3C);
+        DrawWindowFrame({m_videoRect.x, m_videoRect.y - titleHeight, m_videoRect.w, titleHeight}, 0xFF202020);
+        return MRDA_STATUS_SUCCESS;
+    }
+    //!
+    //! \brief Get the bytes of one frame
+    //!
+    //! \param [in] pitch
+    //!             bytes per row of the first plane
+    //! \return uint64_t
+    //!
+    uint64_t FrameSize(uint32_t pitch) const
+    {
+        if (m_format == ColorFormat::COLOR_FORMAT_RGBA32) return static_cast<uint64_t>(pitch) * m_height;
+        return static_cast<uint64_t>(pitch) * m_height * 3 / 2;
+    }
+    //!
+    //! \brief Generate one frame, planes are packed one after the other and
+    //!        the chroma rows of I420 take half the pitch
+    //!
+    //! \param [in] frameIndex
+    //! \param [out] dst
+    //! \param [in] pitch
+    //!             bytes per row of the first plane
+    //! \param [in] size
+    //!             bytes available at dst
+    //! \return MRDAStatus
+    //!
+    MRDAStatus Generate(uint64_t frameIndex, uint8_t *dst, uint32_t pitch, uint64_t size)
+    {
+        uint32_t minPitch = m_format == ColorFormat::COLOR_FORMAT_RGBA32 ? m_width * 4 : m_width;
+        if (dst == nullptr || m_canvas.empty() || pitch < minPitch || size < FrameSize(pitch))
+        {
+            MRDA_LOG(LOG_ERROR, "Invalid synthetic frame buffer");
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        // only the moving windows are redrawn, the rest of the canvas stays
+        DrawText(m_scrollRect, static_cast<uint32_t>(frameIndex * m_scrollSpeed), 2);
+        DrawVideo(frameIndex);
+
+        switch (m_format)
+        {
+        case ColorFormat::COLOR_FORMAT_RGBA32:
+            for (uint32_t y = 0; y < m_height; y++)
+            {
+                const uint32_t *src = &m_canvas[static_cast<size_t>(y) * m_width];
+                uint8_t *row = dst + static_cast<size_t>(y) * pitch;
+                for (uint32_t x = 0; x < m_width; x++)
+                {
+                    row[4 * x] = static_cast<uint8_t>(src[x]);
+                    row[4 * x + 1] = static_cast<uint8_t>(src[x] >> 8);
+                    row[4 * x + 2] = static_cast<uint8_t>(src[x] >> 16);
+                    row[4 * x + 3] = static_cast<uint8_t>(src[x] >> 24);
+                }
+            }
+            break;
+        case ColorFormat::COLOR_FORMAT_NV12:
+        case ColorFormat::COLOR_FORMAT_YUV420P:
+            ConvertToYUV(dst, pitch);
+            break;
+        default:
+            return MRDA_STATUS_INVALID_DATA;
+        }
+        return MRDA_STATUS_SUCCESS;
+    }
+
+private:
+    //!
+    //! \brief Rectangle of the scene in pixels
+    //!
+    struct Rect
+    {
+        uint32_t x;
+        uint32_t y;
+        uint32_t w;
+        uint32_t h;
+    };
+
+    //!
+    //! \brief Hash to draw repeatable pseudo random content
+    //!
+    static uint32_t Hash(uint32_t a, uint32_t b, uint32_t c)
+    {
+        uint32_t h = a * 0x9E3779B1u ^ b * 0x85EBCA77u ^ c * 0xC2B2AE3Du;
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        return h;
+    }
+
+    void FillRect(const Rect &rect, uint32_t color)
+    {
+        for (uint32_t y = rect.y; y < rect.y + rect.h && y < m_height; y++)
+        {
+            uint32_t *row = &m_canvas[static_cast<size_t>(y) * m_width];
+            for (uint32_t x = rect.x; x < rect.x + rect.w && x < m_width; x++) row[x] = color;
+        }
+    }
+
+    void DrawBackground()
+    {
+        // wallpaper gradient over a taskbar
+        uint32_t taskbarHeight = m_lineHeight * 3;
+        for (uint32_t y = 0; y < m_height - taskbarHeight; y++)
+        {
+            uint32_t shade = 40 + y * 120 / m_height;
+            FillRect({0, y, m_width, 1}, 0xFF000000 | (shade / 3) << 16 | (shade / 2) << 8 | shade);
+        }
+        FillRect({0, m_height - taskbarHeight, m_width, taskbarHeight}, 0xFF1F1F1F);
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            uint32_t icon = taskbarHeight * 2 / 3;
+            FillRect({taskbarHeight + i * taskbarHeight * 3 / 2, m_height - taskbarHeight + taskbarHeight / 6, icon, icon},
+                     0xFF000000 | ((Hash(i, 1, 2) & 0x7F7F7F) + 0x404040));
+        }
+    }
+
+    void DrawWindowFrame(const Rect &title, uint32_t color)
+    {
+        FillRect(title, color);
+        // close, maximize and minimize buttons
+        uint32_t button = title.h / 2;
+        for (uint32_t i = 1; i <= 3; i++)
+        {
+            FillRect({title.x + title.w - i * button * 2, title.y + button / 2, button, button}, 0xFFE0E0E0);
+        }
+    }
+
+    //!
+    //! \brief Draw lines of dark glyphs on white, scrolled up by offset
+    //!        rows, the seed picks the document
+    //!
+    void DrawText(const Rect &rect, uint32_t offset, uint32_t seed)
+    {
+        uint32_t glyphWidth = m_lineHeight / 2;
+        for (uint32_t y = 0; y < rect.h; y++)
+        {
+            uint32_t *row = &m_canvas[static_cast<size_t>(rect.y + y) * m_width + rect.x];
+            uint32_t docRow = y + offset;
+            uint32_t line = Hash(docRow / m_lineHeight, seed, 0);
+            uint32_t lineRow = docRow % m_lineHeight;
+            uint32_t lineLength = rect.w / 4 + Hash(line, 7, 7) % (rect.w * 3 / 4);
+            bool inGlyphs = lineRow >= m_lineHeight / 5 && lineRow < m_lineHeight * 4 / 5;
+            for (uint32_t x = 0; x < rect.w; x++)
+            {
+                uint32_t color = 0xFFFFFFFF;
+                if (inGlyphs && x >= glyphWidth && x < lineLength)
+                {
+                    uint32_t glyph = x / glyphWidth;
+                    // about one glyph in six is a space between words
+                    bool space = Hash(line, glyph, 0) % 6 == 0;
+                    if (!space && (Hash(line, glyph, (lineRow * 3 / m_lineHeight) << 8 | (x % glyphWidth) * 3 / glyphWidth) & 3) == 0)
+                    {
+                        color = 0xFF202020;
+                    }
+                }
+                row[x] = color;
+            }
+        }
+    }
+
+    //!
+    //! \brief Draw moving gradients, a bouncing block and grain, so every
+    //!        pixel of the window changes from frame to frame
+    //!
+    void DrawVideo(uint64_t frameIndex)
+    {
+        uint32_t f = static_cast<uint32_t>(frameIndex);
+        uint32_t block = m_videoRect.h / 4;
+        uint32_t spanX = m_videoRect.w - block;
+        uint32_t spanY = m_videoRect.h - block;
+        uint32_t posX = (f * 7) % (2 * spanX);
+        uint32_t posY = (f * 5) % (2 * spanY);
+        posX = posX < spanX ? posX : 2 * spanX - posX;
+        posY = posY < spanY ? posY : 2 * spanY - posY;
+        for (uint32_t y = 0; y < m_videoRect.h; y++)
+        {
+            uint32_t *row = &m_canvas[static_cast<size_t>(m_videoRect.y + y) * m_width + m_videoRect.x];
+            for (uint32_t x = 0; x < m_videoRect.w; x++)
+            {
+                uint32_t grain = Hash(x, y, f) & 0x1F;
+                uint32_t r = ((x + f * 3) & 0xFF) * 3 / 4 + grain;
+                uint32_t g = ((y + f * 2) & 0xFF) * 3 / 4 + grain;
+                uint32_t b = (((x ^ y) + f * 5) & 0xFF) / 2 + grain;
+                if (x >= posX && x < posX + block && y >= posY && y < posY + block)
+                {
+                    r = 255 - r;
+                    g = 255 - g;
+                }
+                row[x] = 0xFF000000 | r << 16 | g << 8 | b;
+            }
+        }
+    }
+
+    //!
+    //! \brief Convert the canvas with BT.601 limited range, chroma is taken
+    //!        from the top left pixel of each 2x2 block
+    //!
+    void ConvertToYUV(uint8_t *dst, uint32_t pitch)
+    {
+        uint8_t *yPlane = dst;
+        uint8_t *uvPlane = dst + static_cast<size_t>(pitch) * m_height;
+        uint32_t chromaPitch = m_format == ColorFormat::COLOR_FORMAT_NV12 ? pitch : pitch / 2;
+        uint8_t *vPlane = uvPlane + static_cast<size_t>(chromaPitch) * (m_height / 2);
+        for (uint32_t y = 0; y < m_height; y++)
+        {
+            const uint32_t *src = &m_canvas[static_cast<size_t>(y) * m_width];
+            uint8_t *yRow = yPlane + static_cast<size_t>(y) * pitch;
+            uint8_t *uRow = uvPlane + static_cast<size_t>(y / 2) * chromaPitch;
+            uint8_t *vRow = vPlane + static_cast<size_t>(y / 2) * chromaPitch;
+            for (uint32_t x = 0; x < m_width; x++)
+            {
+                int32_t r = (src[x] >> 16) & 0xFF;
+                int32_t g = (src[x] >> 8) & 0xFF;
+                int32_t b = src[x] & 0xFF;
+                yRow[x] = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+                if ((y & 1) || (x & 1)) continue;
+                uint8_t u = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                uint8_t v = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+                if (m_format == ColorFormat::COLOR_FORMAT_NV12)
+                {
+                    uRow[x] = u;
+                    uRow[x + 1] = v;
+                }
+                else
+                {
+                    uRow[x / 2] = u;
+                    vRow[x / 2] = v;
+                }
+            }
+        }
+    }
+
+private:
+    uint32_t m_width;               //!< frame width
+    uint32_t m_height;              //!< frame height
+    ColorFormat m_format;           //!< output color format
+    uint32_t m_lineHeight;          //!< text line height, the unit of the layout
+    uint32_t m_scrollSpeed;         //!< rows the text window scrolls per frame
+    Rect m_docRect = {};            //!< static document window
+    Rect m_scrollRect = {};         //!< body of the scrolling text window
+    Rect m_videoRect = {};          //!< body of the video window
+    std::vector<uint32_t> m_canvas; //!< scene in ARGB, one word per pixel
+};
+
+VDI_NS_END
+
+#endif // _SYNTHETIC_FRAME_GENERATOR_H_
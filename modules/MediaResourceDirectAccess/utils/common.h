@@ -42,6 +42,9 @@ constexpr int LOG_INFO = 0;
 constexpr int LOG_WARNING = 1;
 constexpr int LOG_ERROR = 2;
 
+constexpr const char *MRDA_TASK_ID_KEY = "mrda-task-id"; // gRPC metadata key routing a data call to its session
+constexpr const char *MRDA_SESSION_TOKEN_KEY = "mrda-session-token"; // gRPC metadata key proving the caller owns the session
+
 #ifdef _WINDOWS_OS_
 #include <Windows.h>
 #define MRDA_LOG(level, format, ...) \